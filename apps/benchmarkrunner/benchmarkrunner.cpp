@@ -0,0 +1,415 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/common/inviwomodulefactoryobject.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/workspacemanager.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/templateproperty.h>
+#include <inviwo/core/util/consolelogger.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/profiler.h>
+#include <inviwo/core/util/raiiutils.h>
+#include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/moduleregistration.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <nlohmann/json.hpp>
+#include <warn/pop>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <sstream>
+
+using namespace inviwo;
+using json = nlohmann::json;
+
+namespace {
+
+/**
+ * Logs all messages to std::cerr, used instead of the ConsoleLogger, which writes info and
+ * warnings to std::cout, when the results are written to std::cout.
+ */
+class StdErrLogger : public Logger {
+public:
+    virtual void log(std::string logSource, LogLevel logLevel, LogAudience, const char*,
+                     const char*, int, std::string logMsg) override {
+        std::cerr << std::left << std::setw(5) << logLevel << " " << std::setw(25) << logSource
+                  << ": " << logMsg << std::endl;
+    }
+};
+
+/**
+ * A property assignment to sweep over, given on the command line as
+ * "processor.property.subproperty=value1,value2,...". Vector components are separated by spaces.
+ */
+struct Sweep {
+    std::string path;
+    std::vector<std::string> values;
+};
+
+Sweep parseSweep(const std::string& arg) {
+    const auto eq = arg.find('=');
+    if (eq == std::string::npos || eq == 0) {
+        throw Exception("Invalid sweep \"" + arg + "\", expected path=value1,value2,...",
+                        IVW_CONTEXT_CUSTOM("BenchmarkRunner"));
+    }
+    return Sweep{arg.substr(0, eq), splitString(arg.substr(eq + 1), ',')};
+}
+
+template <typename T>
+bool trySetTemplateProperty(Property* property, const std::string& value) {
+    auto prop = dynamic_cast<TemplateProperty<T>*>(property);
+    if (!prop) return false;
+
+    T result{};
+    std::istringstream is(value);
+    for (size_t i = 0; i < util::flat_extent<T>::value; ++i) {
+        is >> util::glmcomp(result, i);
+    }
+    if (is.fail()) {
+        throw Exception("Could not parse \"" + value + "\" for property " +
+                            joinString(property->getPath(), "."),
+                        IVW_CONTEXT_CUSTOM("BenchmarkRunner"));
+    }
+    prop->set(result);
+    return true;
+}
+
+template <typename... Ts>
+bool trySetTemplateProperties(Property* property, const std::string& value) {
+    return (trySetTemplateProperty<Ts>(property, value) || ...);
+}
+
+void setPropertyValue(ProcessorNetwork* network, const std::string& path,
+                      const std::string& value) {
+    auto property = network->getProperty(splitString(path, '.'));
+    if (!property) {
+        throw Exception("Could not find property " + path, IVW_CONTEXT_CUSTOM("BenchmarkRunner"));
+    }
+
+    if (auto prop = dynamic_cast<TemplateProperty<bool>*>(property)) {
+        prop->set(value == "1" || iCaseCmp(value, "true") || iCaseCmp(value, "on"));
+    } else if (auto prop = dynamic_cast<TemplateProperty<std::string>*>(property)) {
+        prop->set(value);
+    } else if (auto prop = dynamic_cast<BaseOptionProperty*>(property)) {
+        if (!prop->setSelectedIdentifier(value) && !prop->setSelectedDisplayName(value)) {
+            throw Exception("Property " + path + " has no option \"" + value + "\"",
+                            IVW_CONTEXT_CUSTOM("BenchmarkRunner"));
+        }
+    } else if (!trySetTemplateProperties<float, double, int, size_t, glm::i64, vec2, vec3, vec4,
+                                         dvec2, dvec3, dvec4, ivec2, ivec3, ivec4, size2_t,
+                                         size3_t>(property, value)) {
+        throw Exception("Unsupported property type " + property->getClassIdentifier() +
+                            " for property " + path,
+                        IVW_CONTEXT_CUSTOM("BenchmarkRunner"));
+    }
+}
+
+/**
+ * Invalidate every processor and let the network evaluate. Background jobs are awaited and their
+ * results delivered so that the iteration covers all the work triggered by the evaluation.
+ */
+void evaluateNetwork(InviwoApplication& app) {
+    auto network = app.getProcessorNetwork();
+    {
+        NetworkLock lock(network);
+        for (auto processor : network->getProcessors()) {
+            processor->invalidate(InvalidationLevel::InvalidOutput);
+        }
+    }  // Evaluation happens when the lock is released
+    app.waitForPool();
+    app.processFront();
+}
+
+json statistics(std::vector<double> ms) {
+    json res;
+    res["count"] = ms.size();
+    if (ms.empty()) return res;
+
+    std::sort(ms.begin(), ms.end());
+    const auto n = static_cast<double>(ms.size());
+    const auto mean = std::accumulate(ms.begin(), ms.end(), 0.0) / n;
+    const auto var = std::accumulate(ms.begin(), ms.end(), 0.0,
+                                     [&](double sum, double v) {
+                                         return sum + (v - mean) * (v - mean);
+                                     }) /
+                     n;
+    const auto mid = ms.size() / 2;
+    res["total"] = mean * n;
+    res["mean"] = mean;
+    res["median"] = ms.size() % 2 == 1 ? ms[mid] : 0.5 * (ms[mid - 1] + ms[mid]);
+    res["min"] = ms.front();
+    res["max"] = ms.back();
+    res["stddev"] = std::sqrt(var);
+    return res;
+}
+
+double toMilliseconds(Profiler::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+json runCase(InviwoApplication& app, size_t warmup, size_t iterations) {
+    auto profiler = Profiler::getPtr();
+
+    profiler->setEnabled(false);
+    for (size_t i = 0; i < warmup; ++i) evaluateNetwork(app);
+
+    profiler->clear();
+    profiler->setEnabled(true);
+    const auto start = Profiler::clock::now();
+    for (size_t i = 0; i < iterations; ++i) evaluateNetwork(app);
+    const auto elapsed = Profiler::clock::now() - start;
+    profiler->setEnabled(false);
+
+    std::vector<double> network;
+    std::map<std::string, std::vector<double>> process;
+    std::map<std::string, std::vector<double>> initialize;
+    for (const auto& event : profiler->getEvents()) {
+        switch (event.category) {
+            case Profiler::Category::Network:
+                network.push_back(toMilliseconds(event.duration));
+                break;
+            case Profiler::Category::Process:
+                process[event.name].push_back(toMilliseconds(event.duration));
+                break;
+            case Profiler::Category::InitializeResources:
+                initialize[event.name].push_back(toMilliseconds(event.duration));
+                break;
+            default:
+                break;
+        }
+    }
+
+    json res;
+    const auto seconds = std::chrono::duration<double>(elapsed).count();
+    res["seconds"] = seconds;
+    res["evaluationsPerSecond"] = seconds > 0.0 ? static_cast<double>(iterations) / seconds : 0.0;
+    res["network"] = statistics(network);
+
+    auto& processors = res["processors"] = json::object();
+    for (auto& item : process) {
+        auto& p = processors[item.first];
+        if (auto processor = app.getProcessorNetwork()->getProcessorByIdentifier(item.first)) {
+            p["class"] = processor->getClassIdentifier();
+        }
+        p["process"] = statistics(std::move(item.second));
+        auto it = initialize.find(item.first);
+        if (it != initialize.end()) {
+            p["initializeResources"] = statistics(std::move(it->second));
+        }
+    }
+    return res;
+}
+
+/**
+ * Removes the OpenGL module, the OpenGL context providers, and all modules depending on them.
+ */
+void removeOpenGLModules(std::vector<std::unique_ptr<InviwoModuleFactoryObject>>& modules) {
+    std::vector<std::string> removed{"opengl", "glfw", "openglqt"};
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const auto& module : modules) {
+            const auto name = toLower(module->name);
+            if (util::contains(removed, name)) continue;
+            if (util::contains_if(module->dependencies, [&](const auto& dep) {
+                    return util::contains(removed, toLower(dep.first));
+                })) {
+                removed.push_back(name);
+                changed = true;
+            }
+        }
+    }
+    util::erase_remove_if(modules, [&](const auto& module) {
+        return util::contains(removed, toLower(module->name));
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    LogCentral::init();
+    util::OnScopeExit deleteLogcentral([]() { LogCentral::deleteInstance(); });
+
+    // Some arguments are needed before the modules are registered and the command line is parsed
+    const auto hasArg = [&](const std::string& name) {
+        return std::any_of(argv + 1, argv + argc, [&](const char* arg) { return arg == name; });
+    };
+    // Keep stdout clean when the results are written there
+    std::shared_ptr<Logger> logger;
+    if (hasArg("--json")) {
+        logger = std::make_shared<ConsoleLogger>();
+    } else {
+        logger = std::make_shared<StdErrLogger>();
+    }
+    LogCentral::getPtr()->registerLogger(logger);
+
+    InviwoApplication inviwoApp(argc, argv, "Inviwo-Benchmark");
+    inviwoApp.setProgressCallback([](std::string m) {
+        LogCentral::getPtr()->log("InviwoApplication", LogLevel::Info, LogAudience::User, "", "", 0,
+                                  m);
+    });
+
+    auto modules = inviwo::getModuleList();
+    if (hasArg("--cpu-only")) removeOpenGLModules(modules);
+    inviwoApp.registerModules(std::move(modules));
+
+    auto& cmdparser = inviwoApp.getCommandLineParser();
+    TCLAP::ValueArg<size_t> iterationsArg("", "iterations", "Number of measured evaluations", false,
+                                          10, "count");
+    TCLAP::ValueArg<size_t> warmupArg("", "warmup",
+                                      "Number of evaluations before measuring each case", false, 1,
+                                      "count");
+    TCLAP::MultiArg<std::string> sweepArg(
+        "", "sweep",
+        "Property values to sweep, 'processor.property=value1,value2'. Vector components are "
+        "separated by spaces. Several sweeps are combined into all permutations.",
+        false, "sweep");
+    TCLAP::ValueArg<std::string> jsonArg("", "json", "Write the results to this file", false, "",
+                                         "file");
+    TCLAP::ValueArg<std::string> traceArg(
+        "", "trace", "Write a Chrome trace of the last case to this file", false, "", "file");
+    TCLAP::SwitchArg cpuOnlyArg(
+        "", "cpu-only", "Do not load any OpenGL modules, for networks without rendering");
+    cmdparser.add(&iterationsArg);
+    cmdparser.add(&warmupArg);
+    cmdparser.add(&sweepArg);
+    cmdparser.add(&jsonArg);
+    cmdparser.add(&traceArg);
+    cmdparser.add(&cpuOnlyArg);
+    cmdparser.parse(CommandLineParser::Mode::Normal);
+
+    if (!cmdparser.getLoadWorkspaceFromArg()) {
+        LogErrorCustom("BenchmarkRunner", "No workspace given, use -w <workspace>");
+        return 1;
+    }
+    const auto workspace = cmdparser.getWorkspacePath();
+    try {
+        NetworkLock lock(inviwoApp.getProcessorNetwork());
+        inviwoApp.getWorkspaceManager()->load(workspace, [&](ExceptionContext ec) {
+            try {
+                throw;
+            } catch (const IgnoreException& e) {
+                util::log(e.getContext(),
+                          "Incomplete network loading " + workspace + " due to " + e.getMessage(),
+                          LogLevel::Error);
+            }
+        });
+    } catch (const Exception& e) {
+        util::log(e.getContext(),
+                  "Unable to load network " + workspace + " due to " + e.getMessage(),
+                  LogLevel::Error);
+        return 1;
+    } catch (const ticpp::Exception& e) {
+        LogErrorCustom("BenchmarkRunner", "Unable to load network " + workspace +
+                                              " due to deserialization error: " + e.what());
+        return 1;
+    }
+    cmdparser.processCallbacks();
+
+    std::vector<Sweep> sweeps;
+    try {
+        for (const auto& arg : sweepArg.getValue()) sweeps.push_back(parseSweep(arg));
+    } catch (const Exception& e) {
+        util::log(e.getContext(), e.getMessage(), LogLevel::Error);
+        return 1;
+    }
+
+    // Make room for all events of a case
+    const auto processorCount = inviwoApp.getProcessorNetwork()->getProcessors().size();
+    Profiler::getPtr()->setCapacity(
+        std::max<size_t>(Profiler::getPtr()->getCapacity(),
+                         (iterationsArg.getValue() + 1) * (2 * processorCount + 1) + 1024));
+
+    json result;
+    result["workspace"] = workspace;
+    result["iterations"] = iterationsArg.getValue();
+    result["warmup"] = warmupArg.getValue();
+    result["poolSize"] = inviwoApp.getPoolSize();
+    auto& cases = result["cases"] = json::array();
+
+    // Iterate over all permutations of the sweep values
+    std::vector<size_t> index(sweeps.size(), 0);
+    try {
+        while (true) {
+            json parameters = json::object();
+            for (size_t i = 0; i < sweeps.size(); ++i) {
+                const auto& value = sweeps[i].values[index[i]];
+                setPropertyValue(inviwoApp.getProcessorNetwork(), sweeps[i].path, value);
+                parameters[sweeps[i].path] = value;
+            }
+
+            auto res = runCase(inviwoApp, warmupArg.getValue(), iterationsArg.getValue());
+            res["parameters"] = std::move(parameters);
+            cases.push_back(std::move(res));
+
+            size_t i = 0;
+            for (; i < sweeps.size(); ++i) {
+                if (++index[i] < sweeps[i].values.size()) break;
+                index[i] = 0;
+            }
+            if (i == sweeps.size()) break;
+        }
+    } catch (const Exception& e) {
+        util::log(e.getContext(), e.getMessage(), LogLevel::Error);
+        return 1;
+    }
+
+    if (traceArg.isSet()) {
+        Profiler::getPtr()->exportChromeTrace(traceArg.getValue());
+    }
+
+    if (jsonArg.isSet()) {
+        auto file = filesystem::ofstream(jsonArg.getValue());
+        if (!file) {
+            LogErrorCustom("BenchmarkRunner", "Could not write to " << jsonArg.getValue());
+            return 1;
+        }
+        file << result.dump(4) << std::endl;
+    } else {
+        std::cout << result.dump(4) << std::endl;
+    }
+
+    return 0;
+}
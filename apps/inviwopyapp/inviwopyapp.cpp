@@ -70,6 +70,7 @@ PYBIND11_MODULE(inviwopyapp, m) {
              [](InviwoApplicationQt* app) {
                  auto timer = new QTimer(app);
                  QObject::connect(timer, &QTimer::timeout, [app]() {
+                     py::gil_scoped_acquire gil;
                      try {
                          py::exec("lambda x: 1");
                      } catch (...) {
@@ -79,9 +80,12 @@ PYBIND11_MODULE(inviwopyapp, m) {
                  });
                  timer->start(100);
 
+                 // Let python code run on other threads while the event loop is running
+                 py::gil_scoped_release release;
                  app->exec();
              })
-        .def("update", [](InviwoApplicationQt* app) { app->processEvents(); })
+        .def("update", [](InviwoApplicationQt* app) { app->processEvents(); },
+             py::call_guard<py::gil_scoped_release>())
         .def("registerModules",
              [](InviwoApplicationQt* app) { app->registerModules(inviwo::getModuleList()); })
         .def("registerRuntimeModules",
@@ -41,6 +41,7 @@
 
 #include <warn/push>
 #include <warn/ignore/all>
+#include <chrono>
 #include <set>
 #include <warn/pop>
 
@@ -59,6 +60,15 @@ class IVW_CORE_API ModuleManager {
 public:
     using IdSet = std::set<std::string, CaseInsensitiveCompare>;
 
+    /**
+     * Time spent on loading and registering a module
+     */
+    struct ModuleTiming {
+        std::string name;
+        std::chrono::nanoseconds load{0};  ///< Loading the library, zero for linked modules
+        std::chrono::nanoseconds init{0};  ///< Constructing the module and its capabilities
+    };
+
     ModuleManager(InviwoApplication* app);
     ModuleManager(const ModuleManager& rhs) = delete;
     ModuleManager& operator=(const ModuleManager& that) = delete;
@@ -81,6 +91,10 @@ public:
      * Will recursively search for all dll/so/dylib/bundle files in the specified search paths.
      * The library filename must contain "inviwo-module" to be loaded.
      *
+     * Search paths that are inside of other search paths are only searched once, and if the
+     * same module library is found in several places only the first one is loaded. The
+     * directories are searched, and changed libraries copied for runtime reloading, in parallel.
+     *
      * @note Which modules to load can be specified by creating a file
      * (application_name-enabled-modules.txt) containing the names of the modules to load.
      */
@@ -133,11 +147,19 @@ public:
     static std::function<bool(const std::string&)> getEnabledFilter();
     void reloadModules();
 
+    /**
+     * Time spent on each module of the last registration pass, e.g. startup or a runtime reload,
+     * in the order the modules were registered. Logged when the application is started with
+     * --module-timing.
+     */
+    const std::vector<ModuleTiming>& getModuleTimings() const;
+
 private:
     void registerModule(std::unique_ptr<InviwoModule> module);
     bool checkDependencies(const InviwoModuleFactoryObject& obj) const;
     std::vector<std::string> deregisterDependetModules(
         const std::vector<std::string>& toDeregister);
+    ModuleTiming& moduleTiming(const std::string& name);
     static auto getProtectedDependencies(
         const IdSet& ptotectedIds,
         const std::vector<std::unique_ptr<InviwoModuleFactoryObject>>& modules) -> IdSet;
@@ -155,6 +177,7 @@ private:
     std::vector<std::unique_ptr<InviwoModuleFactoryObject>> factoryObjects_;
     std::vector<std::unique_ptr<InviwoModule>> modules_;
     util::OnScopeExit clearModules_;
+    std::vector<ModuleTiming> timings_;
 };
 
 template <class T>
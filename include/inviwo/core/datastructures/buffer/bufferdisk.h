@@ -0,0 +1,68 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_BUFFERDISK_H
+#define IVW_BUFFERDISK_H
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/diskrepresentation.h>
+#include <inviwo/core/datastructures/buffer/bufferrepresentation.h>
+
+namespace inviwo {
+
+/**
+ * \ingroup datastructures
+ * A BufferRepresentation whose data resides on disk. The data is read into a BufferRAM by the
+ * DiskRepresentationLoader once a RAM representation is requested for the first time, which
+ * makes it possible to open a file and only load the buffers that are actually used.
+ */
+class IVW_CORE_API BufferDisk : public BufferRepresentation,
+                                public DiskRepresentation<BufferRepresentation> {
+public:
+    BufferDisk(size_t size = 0, const DataFormatBase* format = DataFloat32::get(),
+               BufferUsage usage = BufferUsage::Static, BufferTarget target = BufferTarget::Data);
+    BufferDisk(std::string url, size_t size = 0, const DataFormatBase* format = DataFloat32::get(),
+               BufferUsage usage = BufferUsage::Static, BufferTarget target = BufferTarget::Data);
+    BufferDisk(const BufferDisk& rhs) = default;
+    BufferDisk& operator=(const BufferDisk& that) = default;
+    virtual BufferDisk* clone() const override;
+    virtual ~BufferDisk() = default;
+
+    virtual std::type_index getTypeIndex() const override final;
+
+    virtual void setSize(size_t size) override;
+    virtual size_t getSize() const override;
+
+private:
+    size_t size_;
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_BUFFERDISK_H
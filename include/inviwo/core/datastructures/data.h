@@ -32,7 +32,12 @@
 #include <inviwo/core/datastructures/representationfactory.h>
 #include <inviwo/core/datastructures/representationconverterfactory.h>
 #include <inviwo/core/datastructures/representationfactorymanager.h>
+#include <inviwo/core/util/profiler.h>
+#include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/stringconversion.h>
 
+#include <atomic>
+#include <cstdint>
 #include <typeindex>
 #include <mutex>
 #include <unordered_map>
@@ -40,6 +45,36 @@
 
 namespace inviwo {
 
+namespace detail {
+
+/**
+ * Estimate of the memory allocated by a representation, used for profiling. Representations with
+ * dimensions (volumes, layers) or a size (buffers) and a data format are supported, for other
+ * representations 0 is returned.
+ */
+template <typename Repr, typename = void>
+struct RepresentationByteSize {
+    static size_t get(const Repr&) { return 0; }
+};
+
+template <typename Repr>
+struct RepresentationByteSize<Repr, util::void_t<decltype(std::declval<Repr>().getDimensions())>> {
+    static size_t get(const Repr& repr) {
+        const auto& dims = repr.getDimensions();
+        size_t bytes = repr.getDataFormat()->getSize();
+        for (int i = 0; i < static_cast<int>(dims.length()); ++i) bytes *= dims[i];
+        return bytes;
+    }
+};
+
+template <typename Repr>
+struct RepresentationByteSize<Repr,
+                              util::void_t<decltype(std::declval<Repr>().getSizeOfElement())>> {
+    static size_t get(const Repr& repr) { return repr.getSize() * repr.getSizeOfElement(); }
+};
+
+}  // namespace detail
+
 /**
  * \defgroup datastructures Datastructures
  */
@@ -164,6 +199,15 @@ public:
      */
     void invalidateAllOther(const Repr* repr);
 
+    /**
+     * A counter that is increased every time the data might have been modified, i.e. when an
+     * editable representation is requested, or representations are invalidated, added, or
+     * cleared. Derived data, like search structures, can store the count and compare it to see if
+     * it needs to be recomputed. Copies start over at zero, so compare the identity of the object
+     * as well.
+     */
+    std::uint64_t getModificationCount() const;
+
 protected:
     Data() = default;
     Data(const Data<Self, Repr>& rhs);
@@ -179,6 +223,7 @@ protected:
     mutable std::unordered_map<std::type_index, std::shared_ptr<Repr>> representations_;
     // A pointer to the the most recently updated representation. Makes updates and creation faster.
     mutable std::shared_ptr<Repr> lastValidRepresentation_;
+    std::atomic<std::uint64_t> modificationCount_{0};
 };
 
 template <typename Self, typename Repr>
@@ -226,6 +271,10 @@ const T* Data<Self, Repr>::getValidRepresentation() const {
         for (auto converter : package->getConverters()) {
             auto dest = converter->getConverterID().second;
             auto it = representations_.find(dest);
+            ProfilerScope scope(Profiler::Category::Conversion, [&]() {
+                return "Convert " + parseTypeIdName(converter->getConverterID().first.name()) +
+                       " to " + parseTypeIdName(dest.name());
+            });
             if (it != representations_.end()) {  // Next repr. already exist, just update it
                 converter->update(lastValidRepresentation_, it->second);
                 lastValidRepresentation_ = it->second;
@@ -234,6 +283,10 @@ const T* Data<Self, Repr>::getValidRepresentation() const {
                 auto result = converter->createFrom(lastValidRepresentation_);
                 if (!result) throw ConverterException("Converter failed to create", IVW_CONTEXT);
                 lastValidRepresentation_ = addRepresentationInternal(result);
+                if (scope.isRecording()) {
+                    scope.setBytes(
+                        detail::RepresentationByteSize<Repr>::get(*lastValidRepresentation_));
+                }
             }
         }
         return dynamic_cast<const T*>(lastValidRepresentation_.get());
@@ -271,12 +324,19 @@ void Data<Self, Repr>::invalidateAllOther(const Repr* repr) {
         }
     }
     if (!found) throw Exception("Called with representation not in representations.", IVW_CONTEXT);
+    ++modificationCount_;
+}
+
+template <typename Self, typename Repr>
+std::uint64_t Data<Self, Repr>::getModificationCount() const {
+    return modificationCount_;
 }
 
 template <typename Self, typename Repr>
 void Data<Self, Repr>::clearRepresentations() {
     std::unique_lock<std::mutex> lock(mutex_);
     representations_.clear();
+    ++modificationCount_;
 }
 
 template <typename Self, typename Repr>
@@ -302,6 +362,7 @@ template <typename Self, typename Repr>
 void Data<Self, Repr>::addRepresentation(std::shared_ptr<Repr> representation) {
     std::unique_lock<std::mutex> lock(mutex_);
     lastValidRepresentation_ = addRepresentationInternal(representation);
+    ++modificationCount_;
 }
 
 template <typename Self, typename Repr>
@@ -58,6 +58,7 @@ public:
     bool hasSourceFile() const;
 
     void setLoader(DiskRepresentationLoader<Repr>* loader);
+    const DiskRepresentationLoader<Repr>* getLoader() const;
 
     std::shared_ptr<Repr> createRepresentation() const;
     void updateRepresentation(std::shared_ptr<Repr> dest) const;
@@ -94,6 +95,11 @@ void DiskRepresentation<Repr>::setLoader(DiskRepresentationLoader<Repr>* loader)
     loader_.reset(loader);
 }
 
+template <typename Repr>
+const DiskRepresentationLoader<Repr>* DiskRepresentation<Repr>::getLoader() const {
+    return loader_.get();
+}
+
 template <typename Repr>
 std::shared_ptr<Repr> DiskRepresentation<Repr>::createRepresentation() const {
     if (!loader_) throw Exception("No loader available to create representation", IVW_CONTEXT);
@@ -59,6 +59,8 @@ public:
 
     // Takes ownership of data pointer
     virtual void setData(void* data, size2_t dimensions) = 0;
+    // The current data will not be deleted by the representation, used to wrap external memory
+    virtual void removeDataOwnership() = 0;
 
     // uniform getters and setters
     virtual double getAsDouble(const size2_t& pos) const = 0;
@@ -52,7 +52,7 @@ public:
     LayerRAMPrecision(const LayerRAMPrecision<T>& rhs);
     LayerRAMPrecision<T>& operator=(const LayerRAMPrecision<T>& that);
     virtual LayerRAMPrecision<T>* clone() const override;
-    virtual ~LayerRAMPrecision() = default;
+    virtual ~LayerRAMPrecision();
 
     T* getDataTyped();
     const T* getDataTyped() const;
@@ -60,6 +60,7 @@ public:
     virtual void* getData() override;
     virtual const void* getData() const override;
     virtual void setData(void* data, size2_t dimensions) override;
+    virtual void removeDataOwnership() override;
 
     /**
      * Resize the representation to dimension. This is destructive, the data will not be
@@ -99,6 +100,7 @@ public:
 
 private:
     size2_t dimensions_;
+    bool ownsDataPtr_;
     std::unique_ptr<T[]> data_;
     SwizzleMask swizzleMask_;
 };
@@ -122,6 +124,7 @@ LayerRAMPrecision<T>::LayerRAMPrecision(size2_t dimensions, LayerType type,
                                         const SwizzleMask& swizzleMask)
     : LayerRAM(type, DataFormat<T>::get())
     , dimensions_(dimensions)
+    , ownsDataPtr_(true)
     , data_(new T[dimensions_.x * dimensions_.y]())
     , swizzleMask_(swizzleMask) {
     std::fill(data_.get(), data_.get() + glm::compMul(dimensions_),
@@ -133,6 +136,7 @@ LayerRAMPrecision<T>::LayerRAMPrecision(T* data, size2_t dimensions, LayerType t
                                         const SwizzleMask& swizzleMask)
     : LayerRAM(type, DataFormat<T>::get())
     , dimensions_(dimensions)
+    , ownsDataPtr_(true)
     , data_(data ? data : new T[dimensions_.x * dimensions_.y]())
     , swizzleMask_(swizzleMask) {
     if (!data) {
@@ -145,6 +149,7 @@ template <typename T>
 LayerRAMPrecision<T>::LayerRAMPrecision(const LayerRAMPrecision<T>& rhs)
     : LayerRAM(rhs)
     , dimensions_(rhs.dimensions_)
+    , ownsDataPtr_(true)
     , data_(new T[dimensions_.x * dimensions_.y])
     , swizzleMask_(rhs.swizzleMask_) {
     std::memcpy(data_.get(), rhs.data_.get(), dimensions_.x * dimensions_.y * sizeof(T));
@@ -159,6 +164,8 @@ LayerRAMPrecision<T>& LayerRAMPrecision<T>::operator=(const LayerRAMPrecision<T>
         auto data = std::make_unique<T[]>(dim.x * dim.y);
         std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * sizeof(T));
         data_.swap(data);
+        if (!ownsDataPtr_) data.release();
+        ownsDataPtr_ = true;
 
         dimensions_ = that.dimensions_;
         swizzleMask_ = that.swizzleMask_;
@@ -166,6 +173,11 @@ LayerRAMPrecision<T>& LayerRAMPrecision<T>::operator=(const LayerRAMPrecision<T>
     return *this;
 }
 
+template <typename T>
+LayerRAMPrecision<T>::~LayerRAMPrecision() {
+    if (!ownsDataPtr_) data_.release();
+}
+
 template <typename T>
 LayerRAMPrecision<T>* LayerRAMPrecision<T>::clone() const {
     return new LayerRAMPrecision<T>(*this);
@@ -195,6 +207,14 @@ void inviwo::LayerRAMPrecision<T>::setData(void* d, size2_t dimensions) {
     std::unique_ptr<T[]> data(static_cast<T*>(d));
     data_.swap(data);
     std::swap(dimensions_, dimensions);
+
+    if (!ownsDataPtr_) data.release();
+    ownsDataPtr_ = true;
+}
+
+template <typename T>
+void LayerRAMPrecision<T>::removeDataOwnership() {
+    ownsDataPtr_ = false;
 }
 
 template <typename T>
@@ -203,6 +223,8 @@ void LayerRAMPrecision<T>::setDimensions(size2_t dimensions) {
         auto data = std::make_unique<T[]>(dimensions.x * dimensions.y);
         data_.swap(data);
         std::swap(dimensions, dimensions_);
+        if (!ownsDataPtr_) data.release();
+        ownsDataPtr_ = true;
     }
     updateBaseMetaFromRepresentation();
 }
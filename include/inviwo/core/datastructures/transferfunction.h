@@ -35,6 +35,10 @@
 #include <inviwo/core/datastructures/tfprimitiveset.h>
 #include <inviwo/core/util/fileextension.h>
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 namespace inviwo {
 
 class Layer;
@@ -124,6 +128,39 @@ public:
      */
     vec4 sample(float v) const;
 
+    /**
+     * Sample the transfer function at count positions and write the color and opacity (rgba) to
+     * result. By default this gives the same colors as sample(double), i.e. the primitives are
+     * interpolated and the mask is ignored, without allocating anything per position.
+     * If applyMask is true, the lookup table of getData() is used instead, with linear
+     * interpolation between its getTextureSize() entries. This gives the same colors as rendering
+     * with the transfer function texture, i.e. zero opacity outside of [maskMin, maskMax].
+     * The table is only recomputed if the transfer function has changed. Both variants are safe
+     * to call concurrently, as long as the transfer function is not modified at the same time.
+     *
+     * @param positions sampling positions, clamped to [0,1]
+     * @param result    destination for count colors
+     * @param count     number of positions
+     * @param applyMask use the masked lookup table instead of the primitives
+     */
+    void sample(const double* positions, vec4* result, size_t count,
+                bool applyMask = false) const;
+    /**
+     * @see sample(const double*, vec4*, size_t, bool) const
+     */
+    void sample(const float* positions, vec4* result, size_t count, bool applyMask = false) const;
+    /**
+     * Sample all positions, result is resized to the number of positions.
+     * @see sample(const double*, vec4*, size_t, bool) const
+     */
+    void sample(const std::vector<double>& positions, std::vector<vec4>& result,
+                bool applyMask = false) const;
+    /**
+     * @see sample(const std::vector<double>&, std::vector<vec4>&, bool) const
+     */
+    void sample(const std::vector<float>& positions, std::vector<vec4>& result,
+                bool applyMask = false) const;
+
     friend bool operator==(const TransferFunction& lhs, const TransferFunction& rhs);
 
     virtual std::vector<FileExtension> getSupportedExtensions() const override;
@@ -143,6 +180,9 @@ public:
                                                  double delta = 0.01);
 
 protected:
+    /**
+     * Recompute the lookup table, does nothing if another thread already did it.
+     */
     void calcTransferValues() const;
 
     virtual std::string serializationKey() const override;
@@ -152,7 +192,8 @@ private:
     double maskMin_;
     double maskMax_;
 
-    mutable bool invalidData_;
+    mutable std::atomic<bool> invalidData_;
+    mutable std::mutex dataMutex_;
     std::shared_ptr<LayerRAMPrecision<vec4>> dataRepr_;
     std::unique_ptr<Layer> data_;
 };
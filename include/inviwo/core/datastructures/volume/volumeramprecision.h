@@ -170,6 +170,7 @@ VolumeRAMPrecision<T>& VolumeRAMPrecision<T>::operator=(const VolumeRAMPrecision
         std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * dim.z * sizeof(T));
         data_.swap(data);
         std::swap(dim, dimensions_);
+        if (!ownsDataPtr_) data.release();
         ownsDataPtr_ = true;
         swizzleMask_ = that.swizzleMask_;
     }
@@ -53,6 +53,14 @@ public:
     virtual std::shared_ptr<VolumeRepresentation> createRepresentation() const override;
     virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest) const override;
 
+    /**
+     * Read the z-slices [zBegin, zEnd) into a new VolumeRAM of dimensions
+     * (dim.x, dim.y, zEnd - zBegin). Makes it possible to process volumes slab by slab without
+     * loading all of the data.
+     * @throw Exception if the range is outside of the volume
+     */
+    std::shared_ptr<VolumeRAM> readSlices(size_t zBegin, size_t zEnd) const;
+
     using type = std::shared_ptr<VolumeRAM>;
 
     template <typename Result, typename T>
@@ -67,6 +67,13 @@ private:
 
 enum class SerializationTarget { Node, Attribute };
 
+/**
+ * Output format of the Serializer. Xml is human readable and the default, Binary is compact and
+ * much faster to read back. The Deserializer detects the format automatically.
+ * @see util::writeBinaryDocument
+ */
+enum class SerializationFormat { Xml, Binary };
+
 class NodeSwitch;
 class Serializable;
 
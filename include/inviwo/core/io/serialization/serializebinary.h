@@ -0,0 +1,70 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_SERIALIZE_BINARY_H
+#define IVW_SERIALIZE_BINARY_H
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/io/serialization/ticpp.h>
+
+#include <iosfwd>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * \brief Write the document in the compact binary serialization format.
+ *
+ * The binary format stores the same tree of elements, attributes and text as the xml format,
+ * but all names and values are interned into a string table that is written once, and the
+ * structure is encoded with tags and variable length integers. Reading it back does not need any
+ * xml parsing, character escaping or whitespace handling. Since the result is the same document
+ * tree, version conversion and deserialization work exactly as for xml.
+ * Comments and declarations are not stored.
+ * @see readBinaryDocument
+ */
+IVW_CORE_API void writeBinaryDocument(const TxDocument& doc, std::ostream& stream);
+
+/**
+ * \brief Read a document written by writeBinaryDocument into doc.
+ *
+ * Only the first character of the stream is inspected to determine the format. If the stream
+ * does not contain binary data nothing is consumed and false is returned, the stream can then be
+ * read as xml.
+ * @return true if the stream contained a binary document, otherwise false.
+ * @throws SerializationException if the binary data is invalid or truncated.
+ */
+IVW_CORE_API bool readBinaryDocument(std::istream& stream, TxDocument& doc);
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#endif  // IVW_SERIALIZE_BINARY_H
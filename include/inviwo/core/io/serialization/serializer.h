@@ -76,6 +76,16 @@ public:
      * @throws SerializationException
      */
     virtual void writeFile(std::ostream& stream, bool format = false);
+    /**
+     * \brief Writes serialized data to stream in the given format.
+     *
+     * Xml is written formatted, as by writeFile(stream, true). Binary streams need to be
+     * opened in binary mode.
+     * @param stream Stream to be written to.
+     * @param format Xml or Binary, both can be read by the Deserializer.
+     * @throws SerializationException
+     */
+    virtual void writeFile(std::ostream& stream, SerializationFormat format);
 
     // std containers
     template <typename T>
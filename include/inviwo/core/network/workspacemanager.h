@@ -89,20 +89,26 @@ public:
      *      saved file.
      * \param exceptionHandler A callback for handling errors.
      * \param mode to indicate if we are saving to disk or undo-stack
+     * \param format Xml or Binary. Binary is more compact and loads much faster, use it when the
+     *      workspace does not need to be human readable. Binary requires a stream opened in binary
+     *      mode. Both formats can be loaded by load().
      */
     void save(std::ostream& stream, const std::string& refPath,
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler(),
-              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk);
+              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk,
+              SerializationFormat format = SerializationFormat::Xml);
 
     /**
      * Save the current workspace to a file
      * \param path the file to save into.
      * \param exceptionHandler A callback for handling errors.
      * \param mode to indicate if we are saving to disk or undo-stack
+     * \param format Xml or Binary, see above.
      */
     void save(const std::string& path,
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler(),
-              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk);
+              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk,
+              SerializationFormat format = SerializationFormat::Xml);
 
     /**
      * Load a workspace from a stream
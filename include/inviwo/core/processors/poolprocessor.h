@@ -0,0 +1,213 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_POOLPROCESSOR_H
+#define IVW_POOLPROCESSOR_H
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/progressbarowner.h>
+
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace inviwo {
+
+namespace pool {
+
+namespace detail {
+struct State;
+}  // namespace detail
+
+/**
+ * Cancellation token handed to the jobs of a PoolProcessor. Evaluates to true once the result of
+ * the job is no longer wanted, i.e. when a newer job has been dispatched, when a later job in a
+ * progressive series has delivered its result, or when the processor is removed. Long running
+ * jobs should check it regularly and return early, whatever they return is discarded.
+ */
+class IVW_CORE_API Stop {
+public:
+    /**
+     * A token that never stops, for running a job synchronously
+     */
+    Stop() = default;
+    Stop(std::shared_ptr<const detail::State> state, size_t job);
+
+    bool operator()() const noexcept;
+
+private:
+    std::shared_ptr<const detail::State> state_;
+    size_t job_ = 0;
+};
+
+/**
+ * Progress reporter handed to the jobs of a PoolProcessor. Updates the progress bar of the
+ * processor from the main thread, reports arriving after the job was stopped are ignored.
+ */
+class IVW_CORE_API Progress {
+public:
+    /**
+     * A reporter that ignores all progress
+     */
+    Progress() = default;
+    explicit Progress(std::shared_ptr<detail::State> state);
+
+    /**
+     * @param progress in [0, 1]
+     */
+    void operator()(float progress) const;
+    void operator()(size_t i, size_t max) const;
+
+private:
+    std::shared_ptr<detail::State> state_;
+};
+
+}  // namespace pool
+
+/**
+ * \class PoolProcessor
+ * \brief Base class for processors that compute their results on the thread pool
+ *
+ * Jobs are dispatched from process() and called on a pool thread as
+ * `job(pool::Stop, pool::Progress)`. The result is handed to `done` on the main thread, after
+ * which the outports are invalidated so that the network picks up the new data. Hence `done`
+ * usually only sets the data of the outports. A job must not access the processor, everything
+ * it needs has to be captured by value.
+ *
+ * A new dispatch supersedes all jobs dispatched before it, their stop tokens are triggered and
+ * their results discarded. Invalidating the processor does not invalidate its outports, the
+ * network keeps using the last result until a new one arrives.
+ *
+ * \section example Example
+ * @code
+ *    void MyProcessor::process() {
+ *        auto calc = [volume = inport_.getData(), iso = iso_.get()](pool::Stop stop,
+ *                                                                  pool::Progress progress) {
+ *            return util::marchingCubesOpt(volume, iso, vec4(1.0f), false, false, progress,
+ *                                          nullptr, stop);
+ *        };
+ *        dispatchOne(calc, [this](std::shared_ptr<Mesh> mesh) { outport_.setData(mesh); });
+ *    }
+ * @endcode
+ */
+class IVW_CORE_API PoolProcessor : public Processor, public ProgressBarOwner {
+public:
+    PoolProcessor(const std::string& identifier = "", const std::string& displayName = "");
+    virtual ~PoolProcessor();
+
+    /**
+     * Only invalidates the processor itself, the outports are invalidated when new results
+     * arrive.
+     * @see newResults
+     */
+    virtual void invalidate(InvalidationLevel invalidationLevel,
+                            Property* modifiedProperty = nullptr) override;
+
+protected:
+    /**
+     * Run job on the thread pool and hand its result to done on the main thread.
+     */
+    template <typename Job, typename Done>
+    void dispatchOne(Job&& job, Done&& done);
+
+    /**
+     * Run a series of jobs computing increasingly refined versions of the same result, e.g. a
+     * coarse preview followed by the full resolution. The jobs run concurrently, each result is
+     * handed to done as it arrives unless a later job in the series has already delivered. A
+     * delivered result stops all earlier jobs of the series. Only the last job reports progress.
+     */
+    template <typename Job, typename Done>
+    void dispatchProgressive(std::vector<Job> jobs, Done&& done);
+
+    /**
+     * Stop all jobs and discard their results, e.g. when process() computes the output
+     * synchronously.
+     */
+    void stopJobs();
+
+    /**
+     * Invalidate the outports and mark them as changed. Called after each delivered result, call
+     * it from process() when setting new data synchronously.
+     */
+    void newResults();
+
+private:
+    std::shared_ptr<pool::detail::State> startJobs(size_t count);
+    static bool accept(const std::shared_ptr<pool::detail::State>& state, size_t job);
+    static void delivered(const std::shared_ptr<pool::detail::State>& state, size_t job);
+    static void failed(const std::shared_ptr<pool::detail::State>& state, size_t job,
+                       std::exception_ptr exception);
+
+    std::shared_ptr<pool::detail::State> state_;
+};
+
+template <typename Job, typename Done>
+void PoolProcessor::dispatchOne(Job&& job, Done&& done) {
+    std::vector<std::decay_t<Job>> jobs;
+    jobs.push_back(std::forward<Job>(job));
+    dispatchProgressive(std::move(jobs), std::forward<Done>(done));
+}
+
+template <typename Job, typename Done>
+void PoolProcessor::dispatchProgressive(std::vector<Job> jobs, Done&& done) {
+    using Result = std::invoke_result_t<Job&, pool::Stop, pool::Progress>;
+    static_assert(!std::is_void_v<Result>, "A job has to return its result");
+
+    auto state = startJobs(jobs.size());
+    auto doneFunc = std::make_shared<std::decay_t<Done>>(std::forward<Done>(done));
+
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const bool last = i + 1 == jobs.size();
+        dispatchPool([state, i, last, doneFunc, job = std::move(jobs[i])]() mutable {
+            const pool::Stop stop{state, i};
+            // Superseded before it even started
+            if (stop()) return;
+            try {
+                auto result = std::make_shared<Result>(
+                    job(stop, last ? pool::Progress{state} : pool::Progress{}));
+                dispatchFront([state, i, doneFunc, result]() {
+                    if (accept(state, i)) {
+                        (*doneFunc)(std::move(*result));
+                        delivered(state, i);
+                    }
+                });
+            } catch (...) {
+                dispatchFront(
+                    [state, i, e = std::current_exception()]() { failed(state, i, e); });
+            }
+        });
+    }
+}
+
+}  // namespace inviwo
+
+#endif  // IVW_POOLPROCESSOR_H
@@ -36,6 +36,8 @@
 #include <inviwo/core/properties/property.h>
 #include <inviwo/core/interaction/events/eventlistener.h>
 
+#include <unordered_map>
+
 namespace inviwo {
 
 class Processor;
@@ -97,8 +99,17 @@ public:
     const std::vector<Property*>& getProperties() const;
     const std::vector<CompositeProperty*>& getCompositeProperties() const;
     std::vector<Property*> getPropertiesRecursive() const;
+    /**
+     * \brief Find a property by its identifier using a hash lookup among the direct children.
+     * With \p recursiveSearch, composite properties are searched depth first if there is no
+     * direct match.
+     */
     Property* getPropertyByIdentifier(const std::string& identifier,
                                       bool recursiveSearch = false) const;
+    /**
+     * \brief Find a property by its path of identifiers relative to this owner, i.e. one hash
+     * lookup per level of composite properties. Returns nullptr if any part is not found.
+     */
     Property* getPropertyByPath(const std::vector<std::string>& path) const;
     template <class T>
     std::vector<T*> getPropertiesByType(bool recursiveSearch = false) const;
@@ -153,9 +164,15 @@ protected:
     std::vector<std::unique_ptr<Property>> ownedProperties_;
 
 private:
+    friend class Property;  // Keeps the identifier index up to date when a property is renamed
+
     Property* removeProperty(std::vector<Property*>::iterator it);
+    void propertyIdentifierChanged(Property* property, const std::string& oldIdentifier);
     bool findPropsForComposites(TxElement*);
     InvalidationLevel invalidationLevel_;
+
+    // Identifier to property for all properties in properties_, non-owning references.
+    std::unordered_map<std::string, Property*> propertyIndex_;
 };
 
 template <class T>
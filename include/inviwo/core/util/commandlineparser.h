@@ -109,6 +109,7 @@ public:
     bool getLogToFile() const;
     bool getLogToConsole() const;
     bool getDisableResourceManager() const;
+    bool getLogModuleTiming() const;
 
     int getARGC() const;
     char** getARGV() const;
@@ -135,6 +136,7 @@ private:
     TCLAP::SwitchArg helpQuiet_;
     TCLAP::SwitchArg versionQuiet_;
     TCLAP::SwitchArg disableResourceManager_;
+    TCLAP::SwitchArg moduleTiming_;
 
     std::vector<std::tuple<int, TCLAP::Arg*, std::function<void()>>> callbacks_;
 };
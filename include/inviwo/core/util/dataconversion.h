@@ -0,0 +1,162 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_DATACONVERSION_H
+#define IVW_DATACONVERSION_H
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace inviwo {
+
+namespace util {
+
+namespace detail {
+
+/**
+ * The type used for the arithmetic in the conversion kernels. Float when the values of both types
+ * fit in its mantissa, since that doubles the number of values per vector instruction, otherwise
+ * double.
+ */
+template <typename To, typename From>
+using conversion_compute_t =
+    typename std::conditional<(std::numeric_limits<To>::digits <=
+                                   std::numeric_limits<float>::digits &&
+                               std::numeric_limits<From>::digits <=
+                                   std::numeric_limits<float>::digits),
+                              float, double>::type;
+
+/**
+ * Clamps to the range of the integer type To and rounds to nearest. The limits are computed once
+ * outside of the loops, NaN is mapped to the lowest value.
+ */
+template <typename To, typename C>
+struct IntegerConverter {
+    IntegerConverter() : lowest{static_cast<C>(std::numeric_limits<To>::lowest())}, max{} {
+        // Large integers can not be represented exactly, use the closest value below the max
+        max = static_cast<C>(std::numeric_limits<To>::max());
+        if (std::numeric_limits<To>::digits > std::numeric_limits<C>::digits) {
+            max = std::nextafter(max, C{0});
+        }
+    }
+    To operator()(C v) const {
+        // Round half away from zero by truncation, std::round does not vectorize
+        if (std::numeric_limits<To>::is_signed) {
+            v += std::copysign(C{0.5}, v);
+        } else {
+            v += C{0.5};
+        }
+        // Written to map onto min/max instructions, branches here prevent vectorization
+        v = v > lowest ? v : lowest;
+        v = v < max ? v : max;
+        return static_cast<To>(v);
+    }
+    C lowest;
+    C max;
+};
+
+template <typename To, typename C>
+struct FloatConverter {
+    To operator()(C v) const { return static_cast<To>(v); }
+};
+
+template <typename To, typename C>
+using Converter = typename std::conditional<std::numeric_limits<To>::is_integer,
+                                            IntegerConverter<To, C>, FloatConverter<To, C>>::type;
+
+// Plain copy for identical types, only called when To and From are the same
+template <typename T>
+void copyIfSame(const T* begin, const T* end, T* dst) {
+    std::copy(begin, end, dst);
+}
+template <typename To, typename From>
+void copyIfSame(const From*, const From*, To*) {}
+
+}  // namespace detail
+
+/**
+ * Bulk version of glm_convert_normalized for scalar types, i.e. the conversion used by the
+ * normalized accessors of the RAM representations. Large arrays are split over the thread pool.
+ * The loops are written to be auto vectorized by the compiler.
+ */
+template <typename To, typename From>
+void convertNormalized(const From* src, To* dst, size_t count) {
+    util::forEachRangeParallel(count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            dst[i] = util::glm_convert_normalized<To>(src[i]);
+        }
+    });
+}
+
+/**
+ * Converts scalar values by mapping srcRange linearly onto dstRange. Values of integer
+ * destination types are rounded to nearest and clamped to the range of the type. Large arrays
+ * are split over the thread pool and the loops are written to be auto vectorized by the compiler.
+ * The typical use is to map the data range of a DataMapper onto the range of another format.
+ */
+template <typename To, typename From>
+void convertRange(const From* src, To* dst, size_t count, dvec2 srcRange, dvec2 dstRange) {
+    using C = detail::conversion_compute_t<To, From>;
+    const double srcWidth = srcRange.y - srcRange.x;
+    const double scale = srcWidth != 0.0 ? (dstRange.y - dstRange.x) / srcWidth : 0.0;
+    const C s = static_cast<C>(scale);
+    const C o = static_cast<C>(dstRange.x - srcRange.x * scale);
+    const detail::Converter<To, C> convert{};
+
+    if (std::is_same<To, From>::value && scale == 1.0 && dstRange.x == srcRange.x) {
+        util::forEachRangeParallel(count, [&](size_t begin, size_t end) {
+            detail::copyIfSame(src + begin, src + end, dst + begin);
+        });
+    } else if (scale == 1.0 && dstRange.x == srcRange.x) {
+        // Capture by value, stores through dst could otherwise alias the captured values
+        util::forEachRangeParallel(count, [src, dst, convert](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                dst[i] = convert(static_cast<C>(src[i]));
+            }
+        });
+    } else {
+        util::forEachRangeParallel(count, [src, dst, convert, s, o](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                dst[i] = convert(static_cast<C>(src[i]) * s + o);
+            }
+        });
+    }
+}
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#endif  // IVW_DATACONVERSION_H
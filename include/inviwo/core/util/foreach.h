@@ -35,8 +35,16 @@
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/settings/systemsettings.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace inviwo {
 
@@ -157,6 +165,68 @@ void forEachParallel(const Iterable& iterable, Callback&& callback, size_t jobs
     }
 }
 
+/**
+ * Split the index range [0, size) into contiguous parts and call `callback(begin, end)` for each
+ * part using the thread pool. If the range is small or there is no thread pool it is processed
+ * directly in the calling thread. The function returns once all parts are done.
+ *
+ * The calling thread works on the parts as well and never waits for a part that has not been
+ * started, hence it is safe to call from within a job already running on the thread pool. An
+ * exception thrown by the callback is rethrown in the calling thread.
+ *
+ * @param size the number of indices
+ * @param callback `[](size_t begin, size_t end){}`, called concurrently for different parts
+ * @param minRangeSize the smallest part to create, keeps the overhead per job low for cheap
+ * callbacks
+ */
+template <typename Callback>
+void forEachRangeParallel(size_t size, Callback&& callback, size_t minRangeSize = 1 << 16) {
+    size_t jobs = 0;
+    if (InviwoApplication::isInitialized()) {
+        jobs = std::min(4 * InviwoApplication::getPtr()->getPoolSize(),
+                        size / std::max(minRangeSize, size_t{1}));
+    }
+
+    if (jobs <= 1) {
+        callback(size_t{0}, size);
+        return;
+    }
+
+    // Shared with the pool jobs since they might start after this function has returned
+    struct State {
+        std::atomic<size_t> next{0};
+        size_t done{0};
+        std::exception_ptr exception;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto state = std::make_shared<State>();
+
+    // The callback is only used for claimed parts, which are all done before we return
+    auto work = [state, &callback, size, jobs]() {
+        for (size_t job = state->next++; job < jobs; job = state->next++) {
+            std::exception_ptr exception;
+            try {
+                callback((size * job) / jobs, (size * (job + 1)) / jobs);
+            } catch (...) {
+                exception = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock{state->mutex};
+            if (exception && !state->exception) state->exception = exception;
+            if (++state->done == jobs) state->finished.notify_all();
+        }
+    };
+
+    for (size_t i = 1; i < jobs; ++i) {
+        dispatchPool(work);
+    }
+    work();
+
+    std::unique_lock<std::mutex> lock{state->mutex};
+    state->finished.wait(lock, [&]() { return state->done == jobs; });
+    if (state->exception) std::rethrow_exception(state->exception);
+}
+
 }  // namespace util
 
 }  // namespace inviwo
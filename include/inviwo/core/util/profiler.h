@@ -0,0 +1,192 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_PROFILER_H
+#define IVW_PROFILER_H
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/singleton.h>
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class Profiler
+ * \brief Records timed events of the network evaluation into a ring buffer.
+ *
+ * The profiler is disabled by default. When disabled, recording an event amounts to a single
+ * atomic load, names are not even constructed. When enabled each event stores its name,
+ * category, thread, start time, duration, and optionally the number of bytes allocated. Only the
+ * latest getCapacity() events are kept.
+ *
+ * The recorded events can be exported in the Chrome trace event format, which can be opened in
+ * chrome://tracing or https://ui.perfetto.dev, or be aggregated into a call tree for a flame view.
+ * \see ProfilerScope
+ */
+class IVW_CORE_API Profiler : public Singleton<Profiler> {
+public:
+    using clock = std::chrono::steady_clock;
+    using duration = clock::duration;
+    using time_point = clock::time_point;
+
+    enum class Category {
+        Network,              ///< A full evaluation of the processor network
+        Process,              ///< Processor::process
+        InitializeResources,  ///< Processor::initializeResources
+        Conversion,           ///< Creating or updating a data representation
+        Custom                ///< User defined scopes
+    };
+
+    struct Event {
+        std::string name;
+        Category category;
+        std::thread::id threadId;
+        time_point start;
+        clock::duration duration;
+        size_t bytes;  ///< Memory allocated within the event, 0 if unknown.
+    };
+
+    /**
+     * Aggregated call tree. Events with the same name and the same parent are merged.
+     */
+    struct FlameNode {
+        std::string name;
+        Category category = Category::Custom;
+        duration total{0};
+        size_t count = 0;
+        size_t bytes = 0;
+        std::vector<FlameNode> children;
+    };
+
+    Profiler(size_t capacity = 65536);
+    virtual ~Profiler() = default;
+
+    /**
+     * Returns the profiler if it exists and is enabled, nullptr otherwise.
+     */
+    static Profiler* active();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /**
+     * Resizes the ring buffer, recorded events are discarded.
+     */
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const;
+
+    void record(Event event);
+
+    /**
+     * Returns the recorded events ordered from oldest to newest.
+     */
+    std::vector<Event> getEvents() const;
+    void clear();
+
+    /**
+     * Aggregates the recorded events into a call tree using the nesting of the events on each
+     * thread. The children of the returned root are the outermost events.
+     */
+    FlameNode getFlameGraph() const;
+
+    /**
+     * Writes the recorded events as a JSON object in the Chrome trace event format.
+     */
+    void exportChromeTrace(std::ostream& os) const;
+    void exportChromeTrace(const std::string& filename) const;
+
+    static const char* categoryName(Category category);
+
+private:
+    std::atomic<bool> enabled_;
+    mutable std::mutex mutex_;
+    std::vector<Event> events_;
+    size_t capacity_;
+    size_t next_ = 0;
+    time_point epoch_;
+
+    friend Singleton<Profiler>;
+    static Profiler* instance_;
+};
+
+/**
+ * \class ProfilerScope
+ * \brief Records an event covering the lifetime of the scope if the profiler is enabled.
+ *
+ * The name is given as a callable which is only invoked when the profiler is enabled.
+ * \code{.cpp}
+ * ProfilerScope scope(Profiler::Category::Process,
+ *                     [&]() { return processor->getIdentifier(); });
+ * \endcode
+ */
+class IVW_CORE_API ProfilerScope {
+public:
+    template <typename NameFunc>
+    ProfilerScope(Profiler::Category category, NameFunc&& name);
+    ProfilerScope(const ProfilerScope&) = delete;
+    ProfilerScope& operator=(const ProfilerScope&) = delete;
+    ~ProfilerScope();
+
+    /**
+     * Set the number of bytes allocated within the scope.
+     */
+    void setBytes(size_t bytes);
+
+    /**
+     * Returns true if the scope will be recorded.
+     */
+    bool isRecording() const;
+
+private:
+    Profiler* profiler_;
+    Profiler::Event event_;
+};
+
+template <typename NameFunc>
+ProfilerScope::ProfilerScope(Profiler::Category category, NameFunc&& name)
+    : profiler_{Profiler::active()} {
+    if (profiler_) {
+        event_.name = name();
+        event_.category = category;
+        event_.threadId = std::this_thread::get_id();
+        event_.bytes = 0;
+        event_.start = Profiler::clock::now();
+    }
+}
+
+}  // namespace inviwo
+
+#endif  // IVW_PROFILER_H
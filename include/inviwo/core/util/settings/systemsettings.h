@@ -61,6 +61,8 @@ public:
     TemplateOptionProperty<MessageBreakLevel> breakOnMessage_;
     BoolProperty breakOnException_;
     BoolProperty stackTraceInException_;
+    BoolProperty enableProfiler_;
+    IntSizeTProperty profilerCapacity_;
 
     static size_t defaultPoolSize();
 };
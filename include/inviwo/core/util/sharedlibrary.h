@@ -61,6 +61,19 @@ namespace util {
  */
 IVW_CORE_API std::vector<std::string> getLibrarySearchPaths();
 
+/**
+ * \brief Remove duplicates and paths inside other paths of \p paths.
+ * A recursive search of the remaining paths covers the same files as one of all paths, e.g.
+ * "C:/lib/sub" is removed if "C:/lib/" is also listed. The order of the remaining paths is kept.
+ * Trailing '/' are ignored, the paths are expected to use '/' as separator like the ones returned
+ * by filesystem::cleanupPath.
+ * @param paths the paths to filter
+ * @param caseSensitive compare the paths case sensitively, i.e. false for Windows paths.
+ * @return the filtered paths
+ */
+IVW_CORE_API std::vector<std::string> removeNestedPaths(std::vector<std::string> paths,
+                                                        bool caseSensitive);
+
 IVW_CORE_API bool hasAddLibrarySearchDirsFunction();
 IVW_CORE_API std::vector<void*> addLibrarySearchDirs(const std::vector<std::string>& dirs);
 IVW_CORE_API void removeLibrarySearchDirs(const std::vector<void*>& dirs);
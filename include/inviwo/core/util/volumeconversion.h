@@ -0,0 +1,78 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_VOLUMECONVERSION_H
+#define IVW_VOLUMECONVERSION_H
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <memory>
+
+namespace inviwo {
+
+class Volume;
+class VolumeRAM;
+class DataFormatBase;
+
+namespace util {
+
+/**
+ * Create a copy of the volume in another data format using the same conversion as the normalized
+ * accessors, i.e. util::glm_convert_normalized. The conversion is done in parallel in bulk.
+ * @throw Exception if the number of components of the formats differ.
+ */
+IVW_CORE_API std::shared_ptr<VolumeRAM> convertVolumeRAMNormalized(const VolumeRAM& volume,
+                                                                   const DataFormatBase* format);
+
+/**
+ * Create a copy of the volume in another data format by linearly mapping srcRange onto dstRange.
+ * Integer formats are rounded to nearest and clamped to the range of the type.
+ * @see util::convertRange
+ * @throw Exception if the number of components of the formats differ.
+ */
+IVW_CORE_API std::shared_ptr<VolumeRAM> convertVolumeRAM(const VolumeRAM& volume,
+                                                         const DataFormatBase* format,
+                                                         dvec2 srcRange, dvec2 dstRange);
+
+/**
+ * Create a copy of the volume in another data format taking the DataMapper into account. For
+ * integer formats the data range is mapped onto the full range of the new type, for floating point
+ * formats the values are kept. The value range, meta data, and transformations are kept, hence the
+ * result represents the same values as the source volume, up to the precision of the new format.
+ * @throw Exception if the number of components of the formats differ.
+ */
+IVW_CORE_API std::shared_ptr<Volume> convertVolume(const Volume& volume,
+                                                   const DataFormatBase* format);
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#endif  // IVW_VOLUMECONVERSION_H
@@ -36,39 +36,22 @@
 #include <inviwo/core/util/spatial4dsampler.h>
 #include <inviwo/core/util/volumesampler.h>
 
+#include <atomic>
+
 namespace inviwo {
 
 /**
  * \class VolumeSequenceSampler
- * \brief VERY_BRIEFLY_DESCRIBE_THE_CLASS
- * DESCRIBE_THE_CLASS
+ * \brief Samples a sequence of vector volumes with linear interpolation in time.
+ *
+ * The time steps are taken from the "timestamp" and "duration" meta data of the volumes, or spread
+ * evenly over [0,1] if not present. The sampler is meant for many consecutive queries close in
+ * time, as when tracing path lines: the pair of time steps bracketing the previous query is
+ * remembered and checked first, the voxel data of each time step is fetched through a function
+ * specialized for its data format, and the grid position is computed once for both time steps
+ * when they have the same dimensions. The sampler can be used from multiple threads.
  */
-
 class IVW_CORE_API VolumeSequenceSampler : public Spatial4DSampler<3, double> {
-    struct Wrapper {
-        std::weak_ptr<Wrapper> next_;
-        double duration_;
-        double timestamp_;
-        std::shared_ptr<Volume> volume_;
-        VolumeDoubleSampler<4> sampler_;
-
-        Wrapper(std::shared_ptr<Volume> volume)
-            : next_()
-            , duration_(std::numeric_limits<double>::infinity())
-            , timestamp_(std::numeric_limits<double>::infinity())
-            , volume_(volume)
-            , sampler_(volume) {
-            if (volume_->hasMetaData<DoubleMetaData>("timestamp")) {
-                timestamp_ = volume_->getMetaData<DoubleMetaData>("timestamp")->get();
-            }
-            if (volume_->hasMetaData<DoubleMetaData>("duration")) {
-                duration_ = volume_->getMetaData<DoubleMetaData>("duration")->get();
-            }
-        }
-
-        bool operator<(const Wrapper &w) const { return timestamp_ < w.timestamp_; }
-    };
-
 public:
     VolumeSequenceSampler(
         std::shared_ptr<const std::vector<std::shared_ptr<Volume>>> volumeSequence,
@@ -77,16 +60,44 @@ public:
 
     void setAllowedLooping(bool allowed = true) { allowLooping_ = allowed; }
 
+    using Spatial4DSampler<3, double>::sample;
+    /**
+     * Sample all \p positions and write the samples to \p result. Equivalent to calling sample()
+     * for each position, but the coordinate transformation is only looked up once. Ordering the
+     * positions by time makes the best use of the time step caching.
+     */
+    void sample(const std::vector<dvec4> &positions, std::vector<dvec3> &result,
+                Space space = Space::Data) const;
+
 protected:
-    virtual dvec3 sampleDataSpace(const dvec4 &pos) const;  // { return sample(pos).xyz(); }
-    virtual bool withinBoundsDataSpace(const dvec4 &pos) const;
+    virtual dvec3 sampleDataSpace(const dvec4 &pos) const override;
+    virtual bool withinBoundsDataSpace(const dvec4 &pos) const override;
 
 private:
-    std::vector<std::shared_ptr<Wrapper>> wrappers_;
+    /**
+     * Fetch the 8 voxels of the cell at index, clamped to the volume, as dvec3
+     */
+    using FetchCell = void (*)(const void *data, const size3_t &dims, const size3_t &index,
+                               dvec3 *cell);
+
+    struct Frame {
+        double timestamp;
+        double duration;
+        std::shared_ptr<const Volume> volume;
+        const void *data;
+        size3_t dims;
+        FetchCell fetch;
+    };
+
+    size_t findFrame(double t) const;
+    static dvec3 sampleFrame(const Frame &frame, const dvec3 &pos);
+
+    std::vector<Frame> frames_;
 
     bool allowLooping_;
     dvec2 timeRange_;
     double totDuration_;
+    mutable std::atomic<size_t> lastFrame_;
 };
 
 }  // namespace inviwo
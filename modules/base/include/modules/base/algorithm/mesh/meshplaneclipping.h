@@ -0,0 +1,117 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/geometry/geometrytype.h>
+#include <inviwo/core/datastructures/geometry/plane.h>
+#include <inviwo/core/datastructures/geometry/simplemesh.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+namespace meshutil {
+
+/**
+ * \brief Bounding boxes of clusters of consecutive triangles of an index buffer.
+ *
+ * Used by clipMeshAgainstPlane to copy or skip whole clusters that are entirely on one side of
+ * the clipping plane, only clusters intersecting the plane are clipped triangle by triangle.
+ * Building the bounds is linear in the number of triangles and done in parallel, keep them
+ * around as long as the mesh does not change to clip it repeatedly, e.g. while moving the plane.
+ */
+class IVW_MODULE_BASE_API TriangleClusterBounds {
+public:
+    /**
+     * @param positions vertex positions
+     * @param indices triangle indices
+     * @param ct connectivity of the indices, ConnectivityType::None (a triangle list) or
+     * ConnectivityType::Strip
+     * @param clusterSize number of triangles per cluster
+     * @throw Exception if the connectivity is not supported
+     */
+    TriangleClusterBounds(const std::vector<vec3>& positions,
+                          const std::vector<unsigned int>& indices, ConnectivityType ct,
+                          size_t clusterSize = 4096);
+
+    size_t getClusterSize() const;
+    size_t getNumberOfTriangles() const;
+    /**
+     * Minimum and maximum position of each cluster
+     */
+    const std::vector<std::pair<vec3, vec3>>& getBounds() const;
+
+private:
+    size_t clusterSize_;
+    size_t triangles_;
+    std::vector<std::pair<vec3, vec3>> bounds_;
+};
+
+/**
+ * \brief Clip a triangle mesh against a plane, keeping the parts on the inside of the plane.
+ *
+ * The triangles are clipped in parallel using the thread pool, each job writing into its own
+ * buffers which are merged into a single indexed triangle list. The vertices of the input are
+ * kept as is and the vertices created on the plane are appended after them. If bounds are given,
+ * clusters of triangles completely inside or outside of the plane are copied or skipped without
+ * looking at the individual triangles.
+ *
+ * With capping, each closed loop of intersection edges is filled with a triangle fan around its
+ * centroid, replacing the removed parts with triangles aligned with the plane. Loops are found
+ * by matching intersection points, which are computed identically for triangles sharing an edge.
+ * Open loops, for meshes that are not closed, are left uncapped.
+ *
+ * Texture coordinates and colors are interpolated if they have the same size as positions,
+ * otherwise zero texture coordinates and white are used.
+ *
+ * @param positions vertex positions
+ * @param texCoords vertex texture coordinates
+ * @param colors vertex colors
+ * @param indices triangle indices
+ * @param ct connectivity of the indices, ConnectivityType::None or ConnectivityType::Strip
+ * @param plane the clipping plane, in the same space as the positions
+ * @param capping close the clipped mesh with triangles on the plane
+ * @param bounds optional cluster bounds of the same indices
+ * @return a SimpleMesh with an indexed triangle list
+ * @throw Exception if the connectivity is not supported or the bounds do not match
+ */
+IVW_MODULE_BASE_API std::shared_ptr<SimpleMesh> clipMeshAgainstPlane(
+    const std::vector<vec3>& positions, const std::vector<vec3>& texCoords,
+    const std::vector<vec4>& colors, const std::vector<unsigned int>& indices,
+    ConnectivityType ct, const Plane& plane, bool capping = true,
+    const TriangleClusterBounds* bounds = nullptr);
+
+}  // namespace meshutil
+
+}  // namespace inviwo
@@ -0,0 +1,195 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace inviwo {
+
+namespace meshutil {
+
+/**
+ * \brief Bounding volume hierarchy over the triangles of a mesh for queries on the CPU.
+ *
+ * The hierarchy is built top down using the surface area heuristic (SAH) evaluated over a fixed
+ * number of bins per node. The upper levels are split using all threads of the pool, the
+ * resulting subtrees are then built in parallel. The nodes are stored in a single array in depth
+ * first order, the first child of an inner node is the node following it and only the index of
+ * the second child is stored. The triangles are reordered such that each leaf references a
+ * consecutive range.
+ *
+ * All queries are in the space of the positions, i.e. data space for a mesh. They only read the
+ * hierarchy and can be called concurrently.
+ */
+class IVW_MODULE_BASE_API TriangleBVH {
+public:
+    /**
+     * A node of the hierarchy, 32 bytes. For a leaf, count is the number of triangles and offset
+     * the first of them. For an inner node count is zero and offset is the index of the second
+     * child.
+     */
+    struct Node {
+        vec3 min;
+        std::uint32_t offset;
+        vec3 max;
+        std::uint32_t count;
+
+        bool isLeaf() const { return count != 0; }
+    };
+
+    struct RayHit {
+        float t;              ///< distance along the ray in units of the ray direction
+        size_t triangle;      ///< index of the triangle in the input order
+        vec3 barycentric;     ///< weights of the three vertices of the triangle
+    };
+
+    struct ClosestPoint {
+        vec3 point;
+        float distance;
+        size_t triangle;  ///< index of the triangle in the input order
+    };
+
+    /**
+     * @param positions vertex positions
+     * @param triangles vertex indices of each triangle
+     * @param maxLeafSize ranges of at most this many triangles become leafs, larger ranges are
+     * split unless the surface area heuristic favors a leaf of up to four times the size
+     * @throw RangeException if a triangle references a vertex out of range
+     */
+    TriangleBVH(std::vector<vec3> positions, std::vector<uvec3> triangles,
+                size_t maxLeafSize = 4);
+
+    /**
+     * Find the closest intersection of the ray origin + t * direction with t in [tMin, tMax].
+     */
+    std::optional<RayHit> raycast(const vec3& origin, const vec3& direction, float tMin = 0.0f,
+                                  float tMax = std::numeric_limits<float>::max()) const;
+    /**
+     * Test if the ray hits any triangle for t in [tMin, tMax], stops at the first hit found.
+     */
+    bool occluded(const vec3& origin, const vec3& direction, float tMin = 0.0f,
+                  float tMax = std::numeric_limits<float>::max()) const;
+    /**
+     * Find the point on the mesh closest to point, nothing if there are no triangles.
+     */
+    std::optional<ClosestPoint> closestPoint(const vec3& point) const;
+    /**
+     * Test if a point is inside the mesh by counting the intersections of rays in three
+     * different directions and taking the majority vote, which handles rays passing exactly
+     * through edges or vertices. Only meaningful for closed meshes.
+     */
+    bool isInside(const vec3& point) const;
+
+    const std::vector<Node>& getNodes() const;
+    /**
+     * The triangles in the order referenced by the leafs.
+     */
+    const std::vector<uvec3>& getTriangles() const;
+    /**
+     * The index in the input order of each triangle in getTriangles().
+     */
+    const std::vector<std::uint32_t>& getTriangleIndices() const;
+    const std::vector<vec3>& getPositions() const;
+    /**
+     * Bounds of all triangles, min and max
+     */
+    std::pair<vec3, vec3> getBounds() const;
+    /**
+     * Length of the longest path from the root to a leaf, counting the root.
+     */
+    size_t getDepth() const;
+
+private:
+    size_t countIntersections(const vec3& origin, const vec3& direction) const;
+
+    std::vector<vec3> positions_;
+    std::vector<uvec3> triangles_;
+    std::vector<std::uint32_t> indices_;
+    std::vector<Node> nodes_;
+    size_t depth_;
+};
+
+/**
+ * Build a TriangleBVH over all triangles of the mesh, from every index buffer with
+ * DrawType::Triangles, or from consecutive vertices if the mesh has no index buffers and is drawn
+ * as triangles. Positions are taken from the first PositionAttrib buffer.
+ * @throw Exception if the mesh has no floating point position buffer
+ */
+IVW_MODULE_BASE_API std::shared_ptr<const TriangleBVH> createTriangleBVH(const Mesh& mesh,
+                                                                         size_t maxLeafSize = 4);
+
+/**
+ * \brief Keeps the TriangleBVH of the last mesh around until the mesh or its buffers change.
+ *
+ * Changes are detected by comparing the buffer and representation pointers together with
+ * Data::getModificationCount, which increase whenever a buffer is edited. Meant to be held by a
+ * processor doing repeated queries, e.g. picking or mapping points to a surface, on a mesh from
+ * an inport.
+ */
+class IVW_MODULE_BASE_API TriangleBVHCache {
+public:
+    TriangleBVHCache(size_t maxLeafSize = 4);
+
+    /**
+     * Get the hierarchy for the mesh, rebuilding it if the mesh is not the same as in the last
+     * call or if any of its buffers have changed since.
+     */
+    std::shared_ptr<const TriangleBVH> get(const std::shared_ptr<const Mesh>& mesh);
+    void clear();
+
+private:
+    struct State {
+        std::weak_ptr<const Mesh> mesh;
+        std::vector<std::weak_ptr<const BufferBase>> buffers;
+        std::vector<Mesh::MeshInfo> infos;
+        std::vector<std::uint64_t> counts;
+
+        bool matches(const State& current) const;
+    };
+    static State getState(const std::shared_ptr<const Mesh>& mesh);
+
+    size_t maxLeafSize_;
+    std::mutex mutex_;
+    State state_;
+    std::shared_ptr<const TriangleBVH> bvh_;
+};
+
+}  // namespace meshutil
+
+}  // namespace inviwo
@@ -131,7 +131,7 @@ void forEachTriangle(const Mesh::MeshInfo& info, const IndexBuffer& ib, Callback
 
     else if (info.ct == ConnectivityType::Fan) {
         uint32_t a = static_cast<uint32_t>(ram.front());
-        for (size_t i = 1; i < ram.size(); i++) {
+        for (size_t i = 1; i + 1 < ram.size(); i++) {
             callback(a, ram[i], ram[i + 1]);
         }
     }
@@ -0,0 +1,81 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_VOLUMEDERIVATIVES_H
+#define IVW_VOLUMEDERIVATIVES_H
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+
+#include <flags/flags.h>
+
+#include <memory>
+
+namespace inviwo {
+
+enum class VolumeDerivative { Gradient = 1 << 0, Divergence = 1 << 1, Curl = 1 << 2 };
+ALLOW_FLAGS_FOR_ENUM(VolumeDerivative)
+using VolumeDerivatives = flags::flags<VolumeDerivative>;
+
+namespace util {
+
+/**
+ * The output volumes of util::volumeDerivatives, volumes that were not requested are nullptr.
+ */
+struct VolumeDerivativeResult {
+    std::unique_ptr<Volume> gradient;    ///< vec3, gradient of the selected channel
+    std::unique_ptr<Volume> divergence;  ///< float
+    std::unique_ptr<Volume> curl;        ///< vec3
+};
+
+/**
+ * Compute several first order derivative fields of a volume in one pass over the input data,
+ * using central differences in the interior and one-sided differences at the boundary.
+ * The traversal is done block-wise and in parallel by util::forEachVoxelStencil.
+ *
+ * @param volume input volume, divergence and curl require a volume with three components
+ * @param derivatives the derivative fields to compute
+ * @param gradientChannel the channel used for the gradient
+ * @throws Exception if divergence or curl is requested for a volume without three components
+ */
+IVW_MODULE_BASE_API VolumeDerivativeResult volumeDerivatives(const Volume& volume,
+                                                             VolumeDerivatives derivatives,
+                                                             int gradientChannel = 0);
+
+/**
+ * World space distance between neighbouring voxels along each of the volume axes.
+ */
+IVW_MODULE_BASE_API dvec3 volumeVoxelSpacing(const Volume& volume);
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#endif  // IVW_VOLUMEDERIVATIVES_H
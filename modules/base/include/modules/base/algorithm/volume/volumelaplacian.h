@@ -35,7 +35,9 @@
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/util/volumeramutils.h>
 #include <inviwo/core/util/indexmapper.h>
-#include <inviwo/core/util/templatesampler.h>
+#include <modules/base/algorithm/dataminmax.h>
+#include <modules/base/algorithm/volume/volumederivatives.h>
+#include <modules/base/algorithm/volume/volumestencil.h>
 
 namespace inviwo {
 
@@ -63,7 +65,7 @@ std::shared_ptr<Volume> VolumeLaplacianDispatcher::operator()(
     using T = typename DF::type;
     constexpr size_t comp = DF::comp;
     using R = typename util::same_extent<T, float>::type;
-    using Sampler = TemplateVolumeSampler<T, double, double>;
+    using D = typename util::same_extent<T, double>::type;
 
     static_assert(comp > 0, "zero extent");
 
@@ -73,39 +75,34 @@ std::shared_ptr<Volume> VolumeLaplacianDispatcher::operator()(
     newVolume->setModelMatrix(volume->getModelMatrix());
     newVolume->setWorldMatrix(volume->getWorldMatrix());
 
-    const dmat4 m{volume->getCoordinateTransformer().getDataToWorldMatrix()};
-    const auto a = m * dvec4(0, 0, 0, 1);
-    const auto b = m * dvec4(dvec3(1.0) / dvec3(volume->getDimensions() - size3_t(1)), 1);
-    const auto spacing = dvec3(b - a);
-
-    const auto o = glm::diagonal3x3(spacing);
-    const Sampler s(volume, CoordinateSpace::World);
-
-    const util::IndexMapper3D index{volume->getDimensions()};
-
-    const auto resDim = dvec3(1.0) / dvec3(volume->getDimensions() - size3_t(1));
+    const auto spacing = util::volumeVoxelSpacing(*volume);
     const auto resSpace2 = dvec3(1.0) / (spacing * spacing);
 
+    const util::IndexMapper3D index{volume->getDimensions()};
+    const auto data =
+        static_cast<const T*>(volume->template getRepresentation<VolumeRAM>()->getData());
+
+    util::forEachVoxelStencil(
+        data, volume->getDimensions(),
+        [&](const size3_t&, size_t i, const util::StencilNeighbourhood<T>& n) {
+            const auto center = 2.0 * util::glm_convert<D>(n.center);
+            const auto D2x =
+                (util::glm_convert<D>(n.xp) - center + util::glm_convert<D>(n.xm)) * resSpace2.x;
+            const auto D2y =
+                (util::glm_convert<D>(n.yp) - center + util::glm_convert<D>(n.ym)) * resSpace2.y;
+            const auto D2z =
+                (util::glm_convert<D>(n.zp) - center + util::glm_convert<D>(n.zm)) * resSpace2.z;
+            newData[i] = static_cast<R>(D2x + D2y + D2z);
+        });
+
+    const auto minmax =
+        util::dataMinMax(newData, glm::compMul(volume->getDimensions()), IgnoreSpecialValues::Yes);
     auto minval(std::numeric_limits<double>::max());
     auto maxval(std::numeric_limits<double>::lowest());
-
-    auto func = [&](const size3_t& pos) {
-        const dvec3 world{m * dvec4((dvec3(pos) + dvec3(0.5)) * resDim, 1.0)};
-
-        const auto center = 2.0 * s.sample(world);
-        const auto D2x = (s.sample(world + o[0]) + center - s.sample(world - o[0])) * resSpace2.x;
-        const auto D2y = (s.sample(world + o[1]) + center - s.sample(world - o[1])) * resSpace2.y;
-        const auto D2z = (s.sample(world + o[2]) + center - s.sample(world - o[2])) * resSpace2.z;
-        const auto laplacian = center + D2x + D2y + D2z;
-
-        for (size_t i = 0; i < comp; ++i) {
-            minval = glm::min(minval, util::glmcomp(laplacian, i));
-            maxval = glm::max(maxval, util::glmcomp(laplacian, i));
-        }
-        newData[index(pos)] = static_cast<R>(laplacian);
-    };
-
-    util::forEachVoxelParallel(*volume->getRepresentation<VolumeRAM>(), func);
+    for (size_t i = 0; i < comp; ++i) {
+        minval = std::min(minval, minmax.first[i]);
+        maxval = std::max(maxval, minmax.second[i]);
+    }
 
     // Make range symmetric
     auto rangemax = std::max(std::abs(minval), std::abs(maxval));
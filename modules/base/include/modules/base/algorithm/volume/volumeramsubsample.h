@@ -32,17 +32,73 @@
 
 #include <modules/base/basemoduledefine.h>
 #include <inviwo/core/util/glm.h>
+#include <functional>
 #include <memory>
 
 namespace inviwo {
 
+class Volume;
 class VolumeRAM;
+class DataFormatBase;
 
 namespace util {
 
+/**
+ * Reconstruction filters for volume subsampling. The filters are scaled by the subsample factor,
+ * i.e. they cover the footprint of an output voxel in the input volume.
+ */
+enum class SubsampleFilter {
+    Box,       ///< Average of the covered voxels, weighted by coverage for non-integer factors
+    Gaussian,  ///< Gaussian with a standard deviation of half an output voxel
+    Lanczos,   ///< Lanczos with three lobes, sharper than Gaussian but can ring at edges
+    Max        ///< Maximum of the covered voxels, keeps thin bright structures
+};
+
+/**
+ * Provides the z-slices [zBegin, zEnd) of a volume as a pointer to the first voxel of slice
+ * zBegin. The data has to stay valid for as long as the returned pointer is held. Used to
+ * subsample volumes that are not resident in memory.
+ */
+using VolumeSliceSource = std::function<std::shared_ptr<const void>(size_t zBegin, size_t zEnd)>;
+
+/**
+ * Create a slice source for a volume. If the volume only has a disk representation that can read
+ * slices the slices are read from disk on demand, otherwise the RAM representation is used.
+ */
+IVW_MODULE_BASE_API VolumeSliceSource volumeSliceSource(const Volume& volume);
+
+/**
+ * Subsample a volume by averaging blocks of factors voxels.
+ */
 IVW_MODULE_BASE_API std::shared_ptr<VolumeRAM> volumeSubSample(const VolumeRAM* in,
                                                                size3_t factors);
 
+/**
+ * Subsample a volume by factors that do not need to be integers. The new dimensions are
+ * max(1, floor(dims / factors)). The filter is applied separably along each axis and the work is
+ * split over the thread pool.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<VolumeRAM> volumeSubSample(const VolumeRAM* in,
+                                                               dvec3 factors,
+                                                               SubsampleFilter filter);
+
+constexpr size_t defaultSlabMemory = size_t{256} << 20;
+
+/**
+ * Subsample a volume slab by slab, reading the slices from source. Only a slab of slices of the
+ * input is kept in memory at a time, its size is bounded by slabMemory bytes but always contains
+ * at least the slices needed for one output slice.
+ * @param progressCallback if set, called after each slab with the progress in [0,1]
+ * @param stopCallback if set, called before each slab, returning true aborts the subsampling
+ * and nullptr is returned
+ * @see volumeSliceSource
+ */
+IVW_MODULE_BASE_API std::shared_ptr<VolumeRAM> volumeSubSample(
+    const VolumeSliceSource& source, size3_t dims, const DataFormatBase* format, dvec3 factors,
+    SubsampleFilter filter, size_t slabMemory = defaultSlabMemory,
+    std::function<void(float)> progressCallback = nullptr,
+    std::function<bool()> stopCallback = nullptr);
+
 }  // namespace util
 
 }  // namespace inviwo
@@ -0,0 +1,209 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_VOLUMESTENCIL_H
+#define IVW_VOLUMESTENCIL_H
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * The value of a voxel together with the values of its six face neighbours. At the volume
+ * boundary the missing neighbour is replaced by the voxel itself, and the corresponding component
+ * of `scale` is adjusted such that `(xp - xm) * scale.x` always is the derivative along x in voxel
+ * units, i.e. a central difference in the interior and a one-sided difference at the boundary.
+ */
+template <typename T>
+struct StencilNeighbourhood {
+    T center;
+    T xm;
+    T xp;
+    T ym;
+    T yp;
+    T zm;
+    T zp;
+    dvec3 scale;
+};
+
+/**
+ * Block of voxels [begin, end) used to tile a volume for the stencil traversal.
+ */
+struct StencilBlock {
+    size3_t begin;
+    size3_t end;
+};
+
+namespace detail {
+
+inline double stencilScale(size_t pos, size_t dim) {
+    if (dim < 2) return 0.0;
+    return (pos == 0 || pos + 1 == dim) ? 1.0 : 0.5;
+}
+
+/**
+ * Visit all voxels of one block. Neighbour offsets along y and z are resolved once per row, along
+ * x the first and last voxel of the volume are handled separately so that the inner loop runs
+ * without any boundary checks.
+ */
+template <typename T, typename Callback>
+void forEachVoxelStencilBlock(const T* data, const size3_t& dims, const StencilBlock& block,
+                              Callback& callback) {
+    const size_t strideY = dims.x;
+    const size_t strideZ = dims.x * dims.y;
+
+    StencilNeighbourhood<T> n;
+    size3_t pos;
+    for (pos.z = block.begin.z; pos.z < block.end.z; ++pos.z) {
+        const size_t zm = pos.z > 0 ? strideZ : 0;
+        const size_t zp = pos.z + 1 < dims.z ? strideZ : 0;
+        n.scale.z = stencilScale(pos.z, dims.z);
+
+        for (pos.y = block.begin.y; pos.y < block.end.y; ++pos.y) {
+            const size_t ym = pos.y > 0 ? strideY : 0;
+            const size_t yp = pos.y + 1 < dims.y ? strideY : 0;
+            n.scale.y = stencilScale(pos.y, dims.y);
+
+            const T* row = data + pos.y * strideY + pos.z * strideZ;
+            const auto visit = [&](size_t x, size_t xm, size_t xp) {
+                const T* v = row + x;
+                n.center = *v;
+                n.xm = *(v - xm);
+                n.xp = *(v + xp);
+                n.ym = *(v - ym);
+                n.yp = *(v + yp);
+                n.zm = *(v - zm);
+                n.zp = *(v + zp);
+                pos.x = x;
+                callback(pos, static_cast<size_t>(v - data), n);
+            };
+
+            if (block.begin.x == 0) {
+                n.scale.x = stencilScale(0, dims.x);
+                visit(0, 0, dims.x > 1 ? 1 : 0);
+            }
+            const size_t xBegin = std::max<size_t>(block.begin.x, 1);
+            const size_t xEnd = std::min<size_t>(block.end.x, dims.x - 1);
+            n.scale.x = 0.5;
+            for (size_t x = xBegin; x < xEnd; ++x) {
+                visit(x, 1, 1);
+            }
+            if (block.end.x == dims.x && dims.x > 1) {
+                n.scale.x = 1.0;
+                visit(dims.x - 1, 1, 0);
+            }
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Split a volume into blocks of at most blockSize voxels.
+ */
+inline std::vector<StencilBlock> stencilBlocks(const size3_t& dims, const size3_t& blockSize) {
+    const size3_t bs = glm::max(blockSize, size3_t{1});
+    std::vector<StencilBlock> blocks;
+    for (size_t z = 0; z < dims.z; z += bs.z) {
+        for (size_t y = 0; y < dims.y; y += bs.y) {
+            for (size_t x = 0; x < dims.x; x += bs.x) {
+                const size3_t begin{x, y, z};
+                blocks.push_back({begin, glm::min(begin + bs, dims)});
+            }
+        }
+    }
+    return blocks;
+}
+
+/**
+ * Traverse all voxels of a volume and call the callback with the voxel's 6-neighbourhood.
+ * The volume is tiled into cache sized blocks which are distributed over the thread pool, each
+ * block reads its own voxels plus a one voxel halo from the input. Since all neighbours are read
+ * from memory once per voxel, several derivative quantities can be computed by the same callback
+ * in one pass over the data.
+ *
+ * If the Inviwo pool size is zero, or the application is not initialized, all blocks are processed
+ * in the calling thread.
+ *
+ * @param data pointer to the voxel data, x fastest, then y, then z
+ * @param dims dimensions of the volume
+ * @param callback called for each voxel as
+ *     `callback(const size3_t& pos, size_t index, const StencilNeighbourhood<T>& n)`
+ *     callbacks for different blocks will run concurrently.
+ * @param blockSize size of the blocks, defaults to 64x16x16 voxels
+ */
+template <typename T, typename Callback>
+void forEachVoxelStencil(const T* data, const size3_t& dims, Callback callback,
+                         const size3_t& blockSize = size3_t{64, 16, 16}) {
+    if (glm::compMul(dims) == 0) return;
+
+    const auto blocks = stencilBlocks(dims, blockSize);
+
+    size_t jobs = 0;
+    if (InviwoApplication::isInitialized()) {
+        jobs = std::min(blocks.size(), InviwoApplication::getPtr()->getPoolSize());
+    }
+
+    if (jobs == 0) {
+        for (const auto& block : blocks) {
+            detail::forEachVoxelStencilBlock(data, dims, block, callback);
+        }
+        return;
+    }
+
+    // Blocks are handed out dynamically to even out the load between the workers
+    std::atomic<size_t> next{0};
+    std::vector<std::future<void>> futures;
+    for (size_t job = 0; job < jobs; ++job) {
+        futures.push_back(dispatchPool([&]() {
+            auto cb = callback;
+            for (size_t i = next++; i < blocks.size(); i = next++) {
+                detail::forEachVoxelStencilBlock(data, dims, blocks[i], cb);
+            }
+        }));
+    }
+    for (const auto& f : futures) {
+        f.wait();
+    }
+}
+
+}  // namespace util
+
+}  // namespace inviwo
+
+#endif  // IVW_VOLUMESTENCIL_H
@@ -0,0 +1,405 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_FLATKDTREE_H
+#define IVW_FLATKDTREE_H
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/glm.h>
+
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+namespace detail {
+
+/**
+ * Split [0, size) into chunks, four per pool thread. Returns a single chunk if the application is
+ * not initialized or the pool size is zero.
+ */
+inline std::vector<std::pair<size_t, size_t>> kdTreeChunks(size_t size) {
+    size_t jobs = 1;
+    if (InviwoApplication::isInitialized()) {
+        jobs = std::max<size_t>(1, 4 * InviwoApplication::getPtr()->getPoolSize());
+    }
+    jobs = std::max<size_t>(1, std::min(jobs, size));
+    std::vector<std::pair<size_t, size_t>> chunks;
+    for (size_t job = 0; job < jobs; ++job) {
+        chunks.emplace_back(job * size / jobs, (job + 1) * size / jobs);
+    }
+    return chunks;
+}
+
+/**
+ * Call func(i) for all i in [0, size) using the thread pool if available, waits for all jobs.
+ */
+template <typename Func>
+void kdTreeParallelFor(size_t size, Func&& func) {
+    if (size == 0) return;
+    if (size == 1 || !InviwoApplication::isInitialized() ||
+        InviwoApplication::getPtr()->getPoolSize() == 0) {
+        for (size_t i = 0; i < size; ++i) func(i);
+        return;
+    }
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i < size; ++i) {
+        futures.push_back(dispatchPool([&func, i]() { func(i); }));
+    }
+    for (const auto& f : futures) {
+        f.wait();
+    }
+}
+
+}  // namespace detail
+
+/**
+ * \class FlatKDTree
+ * \brief A static, array-backed KD-tree for fast nearest neighbour queries on large point sets
+ *
+ * In contrast to KDTree, which grows by inserting one node at a time, the FlatKDTree is built once
+ * from all points. Each node is stored implicitly: the range [begin, end) of the point array
+ * represents a subtree with its root at the median position (begin + end) / 2, the left subtree in
+ * [begin, median) and the right in [median + 1, end). Only the points, their original indices and
+ * the split dimension of each node are stored, all in flat arrays.
+ *
+ * The tree is built in O(n log n) by median partitioning along the dimension of largest extent,
+ * where the top levels are partitioned in parallel on the thread pool. The batched queries
+ * distribute the query points over the thread pool and return their results in flat buffers.
+ *
+ * All query results refer to the index of the point in the array given at construction.
+ */
+template <size_t N, typename P = double>
+class FlatKDTree {
+public:
+    using Point = Vector<N, P>;
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /**
+     * Result of a batched k nearest neighbours query. For query q the neighbours are found in
+     * [q * k, (q + 1) * k) sorted by increasing distance. If there are less than k points in the
+     * tree the remaining slots are npos.
+     */
+    struct NNearestResult {
+        size_t k = 0;
+        std::vector<size_t> indices;
+        std::vector<P> squaredDistances;
+    };
+
+    /**
+     * Result of a batched radius query. The points close to query q are found in
+     * indices[offsets[q]] to indices[offsets[q + 1]], i.e. offsets has one element more than the
+     * number of queries.
+     */
+    struct CloseToResult {
+        std::vector<size_t> offsets;
+        std::vector<size_t> indices;
+    };
+
+    FlatKDTree() = default;
+    explicit FlatKDTree(const std::vector<Point>& points) { build(points.data(), points.size()); }
+    FlatKDTree(const Point* points, size_t size) { build(points, size); }
+
+    /**
+     * Rebuild the tree from the given points, all previous points are discarded.
+     */
+    void build(const Point* points, size_t size);
+
+    size_t size() const { return points_.size(); }
+    bool empty() const { return points_.empty(); }
+    void clear();
+
+    /**
+     * The points in tree order, use getIndices() to map to the original order.
+     */
+    const std::vector<Point>& getPoints() const { return points_; }
+    const std::vector<size_t>& getIndices() const { return indices_; }
+
+    /**
+     * Index of the point closest to pos, or npos if the tree is empty
+     */
+    size_t findNearest(const Point& pos) const;
+
+    /**
+     * Find the k points closest to pos.
+     * @param pos query position
+     * @param k number of neighbours
+     * @param result will be filled with pairs of squared distance and index, sorted by increasing
+     * distance. Passing the same vector for repeated queries avoids reallocations.
+     */
+    void findNNearest(const Point& pos, size_t k, std::vector<std::pair<P, size_t>>& result) const;
+
+    /**
+     * Find all points within radius of pos, the result is appended to result in no particular
+     * order.
+     */
+    void findCloseTo(const Point& pos, P radius, std::vector<size_t>& result) const;
+
+    /**
+     * k nearest neighbours for all query points, evaluated in parallel
+     */
+    NNearestResult findNNearest(const std::vector<Point>& queries, size_t k) const;
+
+    /**
+     * All points within radius of each query point, evaluated in parallel
+     */
+    CloseToResult findCloseTo(const std::vector<Point>& queries, P radius) const;
+
+private:
+    static P distance2(const Point& a, const Point& b) {
+        const auto d = a - b;
+        return glm::dot(d, d);
+    }
+
+    void nearest(size_t begin, size_t end, const Point& pos, size_t& best, P& bestDist) const;
+    void nNearest(size_t begin, size_t end, const Point& pos, size_t k,
+                  std::vector<std::pair<P, size_t>>& heap) const;
+    void closeTo(size_t begin, size_t end, const Point& pos, P radius2,
+                 std::vector<size_t>& result) const;
+
+    std::vector<Point> points_;
+    std::vector<size_t> indices_;
+    std::vector<unsigned char> splitDims_;
+};
+
+template <size_t N, typename P>
+void FlatKDTree<N, P>::build(const Point* points, size_t size) {
+    std::vector<size_t> order(size);
+    std::iota(order.begin(), order.end(), size_t{0});
+    splitDims_.assign(size, 0);
+
+    // Place the median of [begin, end) along the dimension of largest extent in the middle
+    const auto partition = [&](size_t begin, size_t end) {
+        Point lo{std::numeric_limits<P>::max()};
+        Point hi{std::numeric_limits<P>::lowest()};
+        for (size_t i = begin; i < end; ++i) {
+            lo = glm::min(lo, points[order[i]]);
+            hi = glm::max(hi, points[order[i]]);
+        }
+        const auto extent = hi - lo;
+        unsigned char dim = 0;
+        for (unsigned char d = 1; d < N; ++d) {
+            if (extent[d] > extent[dim]) dim = d;
+        }
+        const size_t mid = begin + (end - begin) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                         [&](size_t a, size_t b) { return points[a][dim] < points[b][dim]; });
+        splitDims_[mid] = dim;
+        return mid;
+    };
+
+    const auto buildSerial = [&](size_t begin, size_t end, auto& self) -> void {
+        if (end - begin < 2) return;
+        const auto mid = partition(begin, end);
+        self(begin, mid, self);
+        self(mid + 1, end, self);
+    };
+
+    // Partition the top levels breadth first, all ranges of a level in parallel, until there are
+    // enough subtrees to keep the pool busy. Then build the subtrees independently.
+    const size_t targetRanges = detail::kdTreeChunks(size).size();
+    std::vector<std::pair<size_t, size_t>> ranges;
+    if (size > 1) ranges.emplace_back(0, size);
+    while (!ranges.empty() && ranges.size() < targetRanges) {
+        std::vector<size_t> mids(ranges.size());
+        detail::kdTreeParallelFor(ranges.size(), [&](size_t i) {
+            mids[i] = partition(ranges[i].first, ranges[i].second);
+        });
+        std::vector<std::pair<size_t, size_t>> next;
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            if (mids[i] - ranges[i].first > 1) next.emplace_back(ranges[i].first, mids[i]);
+            if (ranges[i].second - mids[i] > 2) next.emplace_back(mids[i] + 1, ranges[i].second);
+        }
+        ranges = std::move(next);
+    }
+    detail::kdTreeParallelFor(ranges.size(), [&](size_t i) {
+        buildSerial(ranges[i].first, ranges[i].second, buildSerial);
+    });
+
+    points_.resize(size);
+    std::transform(order.begin(), order.end(), points_.begin(),
+                   [&](size_t i) { return points[i]; });
+    indices_ = std::move(order);
+}
+
+template <size_t N, typename P>
+void FlatKDTree<N, P>::clear() {
+    points_.clear();
+    indices_.clear();
+    splitDims_.clear();
+}
+
+template <size_t N, typename P>
+void FlatKDTree<N, P>::nearest(size_t begin, size_t end, const Point& pos, size_t& best,
+                               P& bestDist) const {
+    if (begin >= end) return;
+    const size_t mid = begin + (end - begin) / 2;
+    const auto d2 = distance2(points_[mid], pos);
+    if (d2 < bestDist) {
+        bestDist = d2;
+        best = mid;
+    }
+    const auto dim = splitDims_[mid];
+    const P diff = pos[dim] - points_[mid][dim];
+    if (diff < 0) {
+        nearest(begin, mid, pos, best, bestDist);
+        if (diff * diff < bestDist) nearest(mid + 1, end, pos, best, bestDist);
+    } else {
+        nearest(mid + 1, end, pos, best, bestDist);
+        if (diff * diff < bestDist) nearest(begin, mid, pos, best, bestDist);
+    }
+}
+
+template <size_t N, typename P>
+size_t FlatKDTree<N, P>::findNearest(const Point& pos) const {
+    size_t best = npos;
+    P bestDist = std::numeric_limits<P>::max();
+    nearest(0, points_.size(), pos, best, bestDist);
+    return best == npos ? npos : indices_[best];
+}
+
+template <size_t N, typename P>
+void FlatKDTree<N, P>::nNearest(size_t begin, size_t end, const Point& pos, size_t k,
+                                std::vector<std::pair<P, size_t>>& heap) const {
+    if (begin >= end) return;
+    const size_t mid = begin + (end - begin) / 2;
+    const auto d2 = distance2(points_[mid], pos);
+    if (heap.size() < k) {
+        heap.emplace_back(d2, mid);
+        std::push_heap(heap.begin(), heap.end());
+    } else if (d2 < heap.front().first) {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = {d2, mid};
+        std::push_heap(heap.begin(), heap.end());
+    }
+    const auto dim = splitDims_[mid];
+    const P diff = pos[dim] - points_[mid][dim];
+    const auto visitFar = [&]() { return heap.size() < k || diff * diff < heap.front().first; };
+    if (diff < 0) {
+        nNearest(begin, mid, pos, k, heap);
+        if (visitFar()) nNearest(mid + 1, end, pos, k, heap);
+    } else {
+        nNearest(mid + 1, end, pos, k, heap);
+        if (visitFar()) nNearest(begin, mid, pos, k, heap);
+    }
+}
+
+template <size_t N, typename P>
+void FlatKDTree<N, P>::findNNearest(const Point& pos, size_t k,
+                                    std::vector<std::pair<P, size_t>>& result) const {
+    result.clear();
+    if (k == 0) return;
+    nNearest(0, points_.size(), pos, k, result);
+    std::sort_heap(result.begin(), result.end());
+    for (auto& item : result) item.second = indices_[item.second];
+}
+
+template <size_t N, typename P>
+void FlatKDTree<N, P>::closeTo(size_t begin, size_t end, const Point& pos, P radius2,
+                               std::vector<size_t>& result) const {
+    if (begin >= end) return;
+    const size_t mid = begin + (end - begin) / 2;
+    if (distance2(points_[mid], pos) <= radius2) result.push_back(indices_[mid]);
+
+    const auto dim = splitDims_[mid];
+    const P diff = pos[dim] - points_[mid][dim];
+    if (diff <= 0 || diff * diff <= radius2) closeTo(begin, mid, pos, radius2, result);
+    if (diff >= 0 || diff * diff <= radius2) closeTo(mid + 1, end, pos, radius2, result);
+}
+
+template <size_t N, typename P>
+void FlatKDTree<N, P>::findCloseTo(const Point& pos, P radius, std::vector<size_t>& result) const {
+    closeTo(0, points_.size(), pos, radius * radius, result);
+}
+
+template <size_t N, typename P>
+auto FlatKDTree<N, P>::findNNearest(const std::vector<Point>& queries, size_t k) const
+    -> NNearestResult {
+    NNearestResult res;
+    res.k = k;
+    res.indices.assign(queries.size() * k, npos);
+    res.squaredDistances.assign(queries.size() * k, std::numeric_limits<P>::max());
+
+    const auto chunks = detail::kdTreeChunks(queries.size());
+    detail::kdTreeParallelFor(chunks.size(), [&](size_t c) {
+        std::vector<std::pair<P, size_t>> neighbours;
+        neighbours.reserve(k);
+        for (size_t q = chunks[c].first; q < chunks[c].second; ++q) {
+            findNNearest(queries[q], k, neighbours);
+            for (size_t i = 0; i < neighbours.size(); ++i) {
+                res.squaredDistances[q * k + i] = neighbours[i].first;
+                res.indices[q * k + i] = neighbours[i].second;
+            }
+        }
+    });
+    return res;
+}
+
+template <size_t N, typename P>
+auto FlatKDTree<N, P>::findCloseTo(const std::vector<Point>& queries, P radius) const
+    -> CloseToResult {
+    const auto chunks = detail::kdTreeChunks(queries.size());
+
+    // Each chunk collects its own counts and indices, which are then concatenated
+    std::vector<std::vector<size_t>> chunkIndices(chunks.size());
+    CloseToResult res;
+    res.offsets.assign(queries.size() + 1, 0);
+    detail::kdTreeParallelFor(chunks.size(), [&](size_t c) {
+        auto& indices = chunkIndices[c];
+        for (size_t q = chunks[c].first; q < chunks[c].second; ++q) {
+            const auto before = indices.size();
+            findCloseTo(queries[q], radius, indices);
+            res.offsets[q + 1] = indices.size() - before;
+        }
+    });
+
+    std::partial_sum(res.offsets.begin(), res.offsets.end(), res.offsets.begin());
+    res.indices.reserve(res.offsets.back());
+    for (const auto& indices : chunkIndices) {
+        res.indices.insert(res.indices.end(), indices.begin(), indices.end());
+    }
+    return res;
+}
+
+template <typename P = double>
+using Flat2DTree = FlatKDTree<2, P>;
+template <typename P = double>
+using Flat3DTree = FlatKDTree<3, P>;
+template <typename P = double>
+using Flat4DTree = FlatKDTree<4, P>;
+
+}  // namespace inviwo
+
+#endif  // IVW_FLATKDTREE_H
@@ -0,0 +1,114 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_VOLUMESEQUENCERESIDENCY_H
+#define IVW_VOLUMESEQUENCERESIDENCY_H
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+
+#include <future>
+#include <list>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+namespace inviwo {
+
+/**
+ * \class VolumeSequenceResidency
+ * \brief Keeps a bounded window of the time steps of a volume sequence in memory.
+ *
+ * Each call to select() marks a time step as used and starts loading the next time steps in the
+ * playback direction on the thread pool. The playback direction is deduced from the previously
+ * selected time step, and the sequence is assumed to loop. When more than the maximum number of
+ * time steps are resident, the least recently used ones are evicted by removing all their
+ * representations except the VolumeDisk one, i.e. they will be read from disk again when needed.
+ * Volumes without a VolumeDisk representation are never evicted. Volumes that are referenced
+ * outside of the sequence, e.g. by an outport or a sampler, stay resident until a later select()
+ * finds them unreferenced. Time steps that can not be evicted do not count against the others,
+ * the next least recently used one is evicted instead. The selected time step is never evicted.
+ *
+ * select() must be called from the main thread since evicting a volume can release its OpenGL
+ * representation.
+ */
+class IVW_MODULE_BASE_API VolumeSequenceResidency {
+public:
+    VolumeSequenceResidency(size_t maxResident = 8, size_t prefetch = 4);
+    VolumeSequenceResidency(const VolumeSequenceResidency&) = delete;
+    VolumeSequenceResidency& operator=(const VolumeSequenceResidency&) = delete;
+    ~VolumeSequenceResidency();
+
+    void setSequence(std::shared_ptr<const VolumeSequence> sequence);
+
+    /**
+     * Set the maximum number of time steps kept in memory, including the selected one and the
+     * prefetched ones.
+     */
+    void setMaxResident(size_t maxResident);
+    size_t getMaxResident() const;
+
+    /**
+     * Set the number of time steps to load ahead of the selected one. At most getMaxResident() - 1
+     * time steps are prefetched.
+     */
+    void setPrefetch(size_t prefetch);
+    size_t getPrefetch() const;
+
+    /**
+     * Mark time step \p index as used, prefetch the following time steps and evict the least
+     * recently used time steps outside of the window.
+     */
+    void select(size_t index);
+
+    /**
+     * The time steps currently tracked as resident, most recently used first.
+     */
+    const std::list<size_t>& getResident() const;
+
+private:
+    void touch(size_t index);
+    void load(size_t index);
+    void evict();
+    bool unload(size_t index);
+    void collectFinished(bool wait);
+
+    std::shared_ptr<const VolumeSequence> sequence_;
+    size_t maxResident_;
+    size_t prefetch_;
+    std::optional<size_t> previous_;
+    bool forward_ = true;
+    std::list<size_t> resident_;
+    std::unordered_map<size_t, std::future<void>> pending_;
+};
+
+}  // namespace inviwo
+
+#endif  // IVW_VOLUMESEQUENCERESIDENCY_H
@@ -0,0 +1,124 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/diskrepresentation.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class BrickedVolumeRAMLoader
+ * \brief Loads volumes stored as independently compressed bricks, see util::writeBrickedVolume.
+ *
+ * The brick file starts with a header holding the data format as a string, like the "Format" of
+ * an ivf file, the byte order of the voxel data, the volume dimensions, the brick size, and an
+ * index with the location of each brick. The header itself is always little endian. Only the
+ * header is read on construction, voxel data of the other byte order is swapped when read.
+ * Loading a region only reads and decompresses the bricks that intersect it, the bricks are
+ * decompressed in parallel using the thread pool.
+ * Used by the IvfVolumeReader for ivf files with a "BrickSize".
+ */
+class IVW_MODULE_BASE_API BrickedVolumeRAMLoader
+    : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    /**
+     * Reads the header and brick index of the brick file.
+     * @throw DataReaderException if the file can not be read or is not a valid brick file
+     */
+    BrickedVolumeRAMLoader(const std::string& brickFile);
+    virtual BrickedVolumeRAMLoader* clone() const override;
+    virtual ~BrickedVolumeRAMLoader() = default;
+
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation() const override;
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation> dest) const override;
+
+    /**
+     * Read the region [offset, offset + dims) into a new VolumeRAM of dimensions dims. Only the
+     * bricks intersecting the region are decompressed.
+     * @throw Exception if the region is outside of the volume
+     * @throw DataReaderException if a brick can not be read
+     */
+    std::shared_ptr<VolumeRAM> readRegion(size3_t offset, size3_t dims) const;
+
+    /**
+     * Read the z-slices [zBegin, zEnd), same as RawVolumeRAMLoader::readSlices.
+     * @see readRegion
+     */
+    std::shared_ptr<VolumeRAM> readSlices(size_t zBegin, size_t zEnd) const;
+
+    size3_t getDimensions() const;
+    size3_t getBrickSize() const;
+    const DataFormatBase* getDataFormat() const;
+    /**
+     * The byte order of the voxel data in the file, i.e. that of the host that wrote it.
+     */
+    bool isLittleEndian() const;
+
+private:
+    void readInto(VolumeRAM& dest, size3_t offset) const;
+
+    std::string brickFile_;
+    size3_t dimensions_;
+    size3_t brickSize_;
+    const DataFormatBase* format_;
+    bool littleEndian_;
+    // offset of each brick into the file, with one extra entry for the end of the last brick
+    std::shared_ptr<const std::vector<std::uint64_t>> index_;
+};
+
+namespace util {
+
+/**
+ * Write the volume into a brick file that can be read by the BrickedVolumeRAMLoader. The volume
+ * is split into bricks of brickSize voxels, bricks at the upper borders are cropped to the volume.
+ * Each brick is compressed independently with zlib, in parallel using the thread pool, and
+ * stored uncompressed if that does not make it smaller. The bricks are compressed and written
+ * one layer of bricks at a time to bound the memory used.
+ * @param volume the volume to write
+ * @param filePath the brick file to write
+ * @param brickSize the size of the bricks, all components have to be larger than 0
+ * @param compressionLevel zlib compression level from 0 (none) to 9 (best), or -1 for the
+ * zlib default
+ * @throw Exception if the brick size is invalid
+ * @throw FileException if the file can not be written
+ */
+IVW_MODULE_BASE_API void writeBrickedVolume(const VolumeRAM& volume, const std::string& filePath,
+                                            size3_t brickSize, int compressionLevel = -1);
+
+}  // namespace util
+
+}  // namespace inviwo
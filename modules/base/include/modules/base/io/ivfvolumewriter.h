@@ -39,16 +39,40 @@ namespace inviwo {
 
 /**
  * \ingroup dataio
+ * Writes the volume into an ivf header and a raw data file. Optionally the data can be stored as
+ * independently compressed bricks instead, see util::writeBrickedVolume.
  */
 class IVW_MODULE_BASE_API IvfVolumeWriter : public DataWriterType<Volume> {
 public:
     IvfVolumeWriter();
+    /**
+     * Creates a writer storing the data as zlib compressed bricks of brickSize voxels, in a *.ivb
+     * file next to the ivf file. Uses the "ivfb" file extension, to not compete with the plain
+     * writer for "ivf", older readers can not open bricked files.
+     */
+    IvfVolumeWriter(size3_t brickSize, int compressionLevel = -1);
     IvfVolumeWriter(const IvfVolumeWriter& rhs);
     IvfVolumeWriter& operator=(const IvfVolumeWriter& that);
     virtual IvfVolumeWriter* clone() const;
     virtual ~IvfVolumeWriter() {}
 
     virtual void writeData(const Volume* data, const std::string filePath) const;
+
+    /**
+     * Set the brick size, a size of 0 writes a single uncompressed raw file.
+     */
+    void setBrickSize(size3_t brickSize);
+    size3_t getBrickSize() const;
+    /**
+     * Set the zlib compression level of the bricks, from 0 (none) to 9 (best), or -1 for the
+     * zlib default.
+     */
+    void setCompressionLevel(int compressionLevel);
+    int getCompressionLevel() const;
+
+private:
+    size3_t brickSize_;
+    int compressionLevel_;
 };
 
 }  // namespace inviwo
@@ -36,7 +36,7 @@
 #include <inviwo/core/util/clock.h>
 
 #include <inviwo/core/common/inviwo.h>
-#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/ports/volumeport.h>
 #include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/buttonproperty.h>
@@ -44,7 +44,6 @@
 #include <inviwo/core/properties/minmaxproperty.h>
 #include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/properties/stringproperty.h>
-#include <inviwo/core/processors/progressbarowner.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 
 namespace inviwo {
@@ -69,7 +68,8 @@ namespace inviwo {
 *   * __Use normalized threshold__ Use normalized values when comparing to the threshold.
 *   * __Scaling Factor__ Scaling factor to apply to the output distance field.
 *   * __Squared Distance__ Output the squared distance field
-*   * __Up sample__ Make the output volume have a higher resolution.
+*   * __Up sample__ Make the output volume have a higher resolution. A preview without up
+*     sampling is shown while the full resolution is computed.
 *   * __Data Range__ Data range to use for the output volume:
 *       * Diagonal use [0, volume diagonal].
 *       * MinMax use the minimal and maximal distance from the result
@@ -81,7 +81,7 @@ namespace inviwo {
 *
 */
 
-class IVW_MODULE_BASE_API DistanceTransformRAM : public Processor, public ProgressBarOwner {
+class IVW_MODULE_BASE_API DistanceTransformRAM : public PoolProcessor {
 public:
     enum class DataRangeMode { Diagonal, MinMax, Custom };
 
@@ -91,9 +91,6 @@ public:
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
 
-    virtual void invalidate(InvalidationLevel invalidationLevel,
-                            Property* source = nullptr) override;
-
 protected:
     virtual void process() override;
 
@@ -103,8 +100,6 @@ private:
     VolumeInport volumePort_;
     VolumeOutport outport_;
 
-    std::future<std::shared_ptr<const Volume>> newVolume_;
-
     DoubleProperty threshold_;
     BoolProperty flip_;
     BoolProperty normalize_;
@@ -121,7 +116,6 @@ private:
     ButtonProperty btnForceUpdate_;
 
     bool distTransformDirty_;
-    bool hasNewData_;
 };
 
 template <class Elem, class Traits>
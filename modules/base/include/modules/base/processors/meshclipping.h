@@ -40,6 +40,9 @@
 #include <inviwo/core/properties/buttonproperty.h>
 #include <inviwo/core/properties/cameraproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
+#include <modules/base/algorithm/mesh/meshplaneclipping.h>
+
+#include <memory>
 
 namespace inviwo {
 
@@ -51,7 +54,8 @@ namespace inviwo {
  * Link the camera property to move the camera along the plane, or to align plane with view
  * direction. Coordinates are specified in world space.
  *
- * Supports SimpleMesh and BasicMesh
+ * Supports SimpleMesh and BasicMesh with triangle lists or strips. The triangles are clipped in
+ * parallel and the output is an indexed triangle list.
  *
  * ### Inports
  *   * __inputMesh__ Input mesh
@@ -69,6 +73,8 @@ namespace inviwo {
  *   * __Camera__ Camera used for moving or aligning plane.
  *   * __Align Plane Normal To Camera Normal__ Aligns plane normal with camera
  *   * __Enable clipping__ Pass through mesh if disabled.
+ *   * __Use Cluster Bounds__ Keep bounding boxes of groups of triangles to skip the parts of the
+ *     mesh far away from the plane, speeds up moving the plane over large meshes.
  *
 
  */
@@ -85,7 +91,8 @@ protected:
 
     /**
      * Clip mesh against plane. Replaces removed parts with triangles aligned with the plane.
-     * @throws Exception if mesh is not a SimpleMesh or BasicMesh
+     * @throws Exception if mesh is not a SimpleMesh or BasicMesh, or if its triangles are
+     * neither a list nor a strip
      * @param mesh to clip
      * @param plane in world space coordinate system.
      */
@@ -106,10 +113,12 @@ private:
     FloatVec3Property planeNormal_;  ///< World space plane normal
     ButtonProperty alignPlaneNormalToCameraNormal_;
     CameraProperty camera_;
+    BoolProperty useClusterBounds_;
 
     float previousPointPlaneMove_;
 
-    static const float EPSILON;
+    std::unique_ptr<meshutil::TriangleClusterBounds> clusterBounds_;
+    const Mesh *clusterBoundsMesh_;
 };
 }  // namespace inviwo
 
@@ -32,8 +32,7 @@
 
 #include <modules/base/basemoduledefine.h>
 #include <inviwo/core/common/inviwo.h>
-#include <inviwo/core/processors/processor.h>
-#include <inviwo/core/processors/progressbarowner.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/ports/volumeport.h>
 #include <inviwo/core/ports/meshport.h>
 #include <inviwo/core/properties/ordinalproperty.h>
@@ -41,8 +40,6 @@
 #include <inviwo/core/properties/compositeproperty.h>
 #include <inviwo/core/properties/boolproperty.h>
 
-#include <future>
-
 namespace inviwo {
 /** \docpage{org.inviwo.SurfaceExtraction, Surface Extraction}
  * ![](org.inviwo.SurfaceExtraction.png?classIdentifier=org.inviwo.SurfaceExtraction)
@@ -60,7 +57,7 @@ namespace inviwo {
  *   * __Triangle Color__ ...
  *
  */
-class IVW_MODULE_BASE_API SurfaceExtraction : public Processor, public ProgressBarOwner {
+class IVW_MODULE_BASE_API SurfaceExtraction : public PoolProcessor {
 public:
     enum class Method {
         MarchingCubes,
@@ -80,33 +77,29 @@ public:
 protected:
     virtual void process() override;
     void updateColors();
-
-    virtual void invalidate(InvalidationLevel invalidationLevel,
-                            Property* modifiedProperty = nullptr) override;
-
-    struct task {
-        task() = default;
-        task(const task&) = delete;
-        task& operator=(const task&) = delete;
-        task(task&&);
-        task& operator=(task&&);
-
-        std::future<std::shared_ptr<Mesh>> result;
-        Method method;
+    void updateOutport();
+
+    /**
+     * The surface of one volume together with the volume and settings it was extracted with.
+     */
+    struct Surface {
+        std::shared_ptr<const Volume> volume;
+        std::shared_ptr<Mesh> mesh;
+        Method method = Method::MarchingCubes;
         float iso = 0.0f;
         vec4 color = vec4(0);
         bool invert = false;
         bool enclose = true;
-        float status = 0.0f;
 
-        bool isSame(Method m, float iso, vec4 color, bool invert, bool enclose) const;
-        void set(Method m, float iso, vec4 color, bool invert, bool enclose, float status,
-                 std::future<std::shared_ptr<Mesh>>&& result);
+        bool isSame(const Surface& rhs) const;
     };
 
+    static std::shared_ptr<Mesh> extract(const Surface& surface,
+                                         std::function<void(float)> progressCallback,
+                                         std::function<bool()> stopCallback);
+
     DataInport<Volume, 0> volume_;
     DataOutport<std::vector<std::shared_ptr<Mesh>>> outport_;
-    std::shared_ptr<std::vector<std::shared_ptr<Mesh>>> meshes_;
 
     TemplateOptionProperty<Method> method_;
     FloatProperty isoValue_;
@@ -114,8 +107,7 @@ protected:
     BoolProperty encloseSurface_;
     CompositeProperty colors_;
 
-    std::vector<task> result_;
-    bool dirty_;
+    std::vector<Surface> surfaces_;
 };
 
 }  // namespace inviwo
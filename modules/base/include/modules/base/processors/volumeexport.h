@@ -36,6 +36,7 @@
 #include <modules/base/processors/dataexport.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/ports/volumeport.h>
+#include <inviwo/core/properties/optionproperty.h>
 
 namespace inviwo {
 
@@ -51,11 +52,13 @@ namespace inviwo {
  *   * __Volume file name__ File to export to
  *   * __Export Volume__ Button to execute export
  *   * __Overwrite__ Should existing files be overwritten
+ *   * __Format__ Data format to export the volume in. Integer formats use the full range of the
+ *     type for the data range of the volume, floating point formats keep the values.
  *
  */
 class IVW_MODULE_BASE_API VolumeExport : public DataExport<Volume, VolumeInport> {
 public:
-    VolumeExport() = default;
+    VolumeExport();
     virtual ~VolumeExport() = default;
 
     virtual const ProcessorInfo getProcessorInfo() const override;
@@ -63,6 +66,10 @@ public:
 
 protected:
     virtual const Volume* getData() override;
+
+private:
+    TemplateOptionProperty<DataFormatId> format_;
+    std::shared_ptr<Volume> converted_;
 };
 
 }  // namespace inviwo
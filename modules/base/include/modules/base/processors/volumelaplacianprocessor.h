@@ -32,15 +32,12 @@
 
 #include <modules/base/basemoduledefine.h>
 #include <inviwo/core/common/inviwo.h>
-#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/ports/volumeport.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/core/properties/optionproperty.h>
 #include <modules/base/algorithm/volume/volumelaplacian.h>
 #include <modules/base/properties/volumeinformationproperty.h>
-#include <inviwo/core/processors/activityindicator.h>
-
-#include <future>
 
 namespace inviwo {
 
@@ -55,8 +52,7 @@ namespace inviwo {
  *   * __outputVolume__ Output volume
  *
  */
-class IVW_MODULE_BASE_API VolumeLaplacianProcessor : public Processor,
-                                                     public ActivityIndicatorOwner {
+class IVW_MODULE_BASE_API VolumeLaplacianProcessor : public PoolProcessor {
 public:
     VolumeLaplacianProcessor();
     virtual ~VolumeLaplacianProcessor() = default;
@@ -65,9 +61,6 @@ public:
 
     virtual const ProcessorInfo getProcessorInfo() const override;
 
-    virtual void invalidate(InvalidationLevel invalidationLevel,
-                            Property* modifiedProperty = nullptr) override;
-
     static const ProcessorInfo processorInfo_;
 
 private:
@@ -79,8 +72,6 @@ private:
 
     VolumeInformationProperty inVolume_;
     VolumeInformationProperty outVolume_;
-
-    std::future<std::shared_ptr<Volume>> result_;
 };
 
 }  // namespace inviwo
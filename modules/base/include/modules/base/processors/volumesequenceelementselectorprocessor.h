@@ -35,6 +35,9 @@
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/ports/volumeport.h>
 #include <modules/base/processors/vectorelementselectorprocessor.h>
+#include <modules/base/datastructures/volumesequenceresidency.h>
+#include <inviwo/core/properties/boolcompositeproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
 
 namespace inviwo {
 
@@ -50,6 +53,11 @@ namespace inviwo {
  *
  * ### Properties
  *   * __Step__ The volume sequence index to extract
+ *   * __Streaming__ Only keep a window of time steps in memory and load the following time
+ *     steps in the background. Evicted time steps are read from disk again when needed.
+ *     Only has an effect on volumes that were read from disk.
+ *   * __Resident Time Steps__ Maximum number of time steps to keep in memory
+ *   * __Prefetch__ Number of time steps to load ahead in the playback direction
  */
 class IVW_MODULE_BASE_API VolumeSequenceElementSelectorProcessor
     : public VectorElementSelectorProcessor<Volume> {
@@ -59,6 +67,14 @@ public:
 
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
+
+    virtual void process() override;
+
+private:
+    BoolCompositeProperty streaming_;
+    IntSizeTProperty maxResident_;
+    IntSizeTProperty prefetch_;
+    VolumeSequenceResidency residency_;
 };
 
 }  // namespace inviwo
@@ -33,13 +33,11 @@
 #include <modules/base/basemoduledefine.h>
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/ports/volumeport.h>
-#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
 #include <modules/base/algorithm/volume/volumeramsubsample.h>
-#include <inviwo/core/processors/activityindicator.h>
-
-#include <future>
 
 namespace inviwo {
 
@@ -56,10 +54,11 @@ namespace inviwo {
  *
  * ### Properties
  *   * __Enable Operation__ ...
- *   * __Factors__ ...
+ *   * __Factors__ Subsample factor along each axis, does not need to be an integer
+ *   * __Filter__ Box, Gaussian, Lanczos or Max filter used to compute the new voxels
  *
  */
-class IVW_MODULE_BASE_API VolumeSubsample : public Processor, public ActivityIndicatorOwner {
+class IVW_MODULE_BASE_API VolumeSubsample : public PoolProcessor {
 public:
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
@@ -70,10 +69,10 @@ public:
 protected:
     virtual void process() override;
 
-    std::shared_ptr<Volume> subsample(std::shared_ptr<const Volume> volume, size3_t f);
-
-    virtual void invalidate(InvalidationLevel invalidationLevel,
-                            Property* modifiedProperty = nullptr) override;
+    static std::shared_ptr<Volume> subsample(std::shared_ptr<const Volume> volume, dvec3 f,
+                                             util::SubsampleFilter filter,
+                                             pool::Stop stop = pool::Stop{},
+                                             pool::Progress progress = pool::Progress{});
 
 private:
     VolumeInport inport_;
@@ -81,10 +80,8 @@ private:
 
     BoolProperty enabled_;
     BoolProperty waitForCompletion_;
-    IntVec3Property subSampleFactors_;
-
-    std::future<std::shared_ptr<Volume>> result_;
-    bool dirty_;
+    DoubleVec3Property subSampleFactors_;
+    TemplateOptionProperty<util::SubsampleFilter> filter_;
 };
 }  // namespace inviwo
 
@@ -34,13 +34,37 @@
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
 
 namespace inviwo {
 
 std::pair<dvec4, dvec4> util::volumeMinMax(const VolumeRAM* volume, IgnoreSpecialValues ignore) {
     return volume->dispatch<std::pair<dvec4, dvec4>>([&ignore](auto vr) -> std::pair<dvec4, dvec4> {
         const auto dim = vr->getDimensions();
-        return dataMinMax(vr->getDataTyped(), dim.x * dim.y * dim.z, ignore);
+        const auto data = vr->getDataTyped();
+        const size_t size = dim.x * dim.y * dim.z;
+
+        // Large volumes are split over the thread pool, the partial results are then merged
+        const auto comps = vr->getDataFormat()->getComponents();
+        std::pair<dvec4, dvec4> minmax{dvec4{0.0}, dvec4{0.0}};
+        for (size_t i = 0; i < comps; ++i) {
+            minmax.first[i] = std::numeric_limits<double>::max();
+            minmax.second[i] = std::numeric_limits<double>::lowest();
+        }
+        std::mutex mutex;
+        util::forEachRangeParallel(size, [&](size_t begin, size_t end) {
+            const auto part = dataMinMax(data + begin, end - begin, ignore);
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t i = 0; i < comps; ++i) {
+                minmax.first[i] = std::min(minmax.first[i], part.first[i]);
+                minmax.second[i] = std::max(minmax.second[i], part.second[i]);
+            }
+        });
+        return minmax;
     });
 }
 
@@ -0,0 +1,467 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/mesh/meshplaneclipping.h>
+
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/hashcombine.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+namespace inviwo {
+
+namespace {
+
+size_t triangleCount(size_t indices, ConnectivityType ct) {
+    switch (ct) {
+        case ConnectivityType::None:
+            return indices / 3;
+        case ConnectivityType::Strip:
+            return indices >= 3 ? indices - 2 : 0;
+        default:
+            throw Exception("Unsupported connectivity type, only triangle lists and strips are "
+                            "supported",
+                            IVW_CONTEXT_CUSTOM("meshutil::clipMeshAgainstPlane"));
+    }
+}
+
+// The vertex indices of triangle t, every other triangle of a strip is flipped to keep the winding
+std::array<unsigned int, 3> triangle(const std::vector<unsigned int>& indices,
+                                     ConnectivityType ct, size_t t) {
+    if (ct == ConnectivityType::Strip) {
+        if (t & 1) return {{indices[t], indices[t + 2], indices[t + 1]}};
+        return {{indices[t], indices[t + 1], indices[t + 2]}};
+    }
+    return {{indices[3 * t], indices[3 * t + 1], indices[3 * t + 2]}};
+}
+
+bool degenerate(const std::array<unsigned int, 3>& tri) {
+    return tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2];
+}
+
+struct Vertex {
+    vec3 pos;
+    vec3 tex;
+    vec4 col;
+};
+
+struct Attributes {
+    Vertex get(unsigned int i) const {
+        return {positions[i], hasTex ? texCoords[i] : vec3{0.0f},
+                hasCol ? colors[i] : vec4{1.0f}};
+    }
+
+    const std::vector<vec3>& positions;
+    const std::vector<vec3>& texCoords;
+    const std::vector<vec4>& colors;
+    bool hasTex;
+    bool hasCol;
+};
+
+/**
+ * The point where the edge between a and b crosses the plane. The end points are sorted first,
+ * hence both triangles sharing an edge get exactly the same point, which is used when connecting
+ * the intersection edges into loops.
+ */
+Vertex intersect(Vertex a, float da, Vertex b, float db) {
+    if (std::tie(b.pos.x, b.pos.y, b.pos.z) < std::tie(a.pos.x, a.pos.y, a.pos.z)) {
+        std::swap(a, b);
+        std::swap(da, db);
+    }
+    // one end is inside (d >= 0) and the other one outside (d < 0), hence da != db
+    const float t = da / (da - db);
+    return {glm::mix(a.pos, b.pos, t), glm::mix(a.tex, b.tex, t), glm::mix(a.col, b.col, t)};
+}
+
+struct ClipResult {
+    size_t firstCluster;
+    // Vertices created by this job are numbered from the number of input vertices
+    std::vector<unsigned int> indices;
+    std::vector<Vertex> vertices;
+    // The points where a triangle leaves and enters the inside of the plane
+    std::vector<std::pair<Vertex, Vertex>> segments;
+};
+
+/*
+ * Sutherland-Hodgman clipping of one triangle. Traverse the edges [v1, v2]:
+ *   Case 1: If v1 and v2 are inside, add v2
+ *   Case 2: If v1 is inside and v2 outside, add the intersection
+ *   Case 3: If v1 is outside and v2 inside, add the intersection and then v2
+ *   Case 4: If v1 and v2 are outside, add nothing
+ * A clipped triangle has 3 or 4 corners, 4 corners are split into two triangles.
+ */
+void clipTriangle(const std::array<unsigned int, 3>& tri, const Attributes& attr,
+                  const Plane& plane, unsigned int firstNew, ClipResult& res) {
+    const std::array<float, 3> d{{plane.distance(attr.positions[tri[0]]),
+                                  plane.distance(attr.positions[tri[1]]),
+                                  plane.distance(attr.positions[tri[2]])}};
+    const std::array<bool, 3> in{{d[0] >= 0.0f, d[1] >= 0.0f, d[2] >= 0.0f}};
+    const int inside = in[0] + in[1] + in[2];
+    if (inside == 3) {
+        res.indices.insert(res.indices.end(), tri.begin(), tri.end());
+        return;
+    } else if (inside == 0) {
+        return;
+    }
+
+    std::array<unsigned int, 4> poly;
+    size_t corners = 0;
+    Vertex exit{};
+    Vertex entry{};
+    for (size_t i = 0; i < 3; ++i) {
+        const size_t j = (i == 2 ? 0 : i + 1);
+        if (in[i] != in[j]) {
+            const auto p = intersect(attr.get(tri[i]), d[i], attr.get(tri[j]), d[j]);
+            poly[corners++] = firstNew + static_cast<unsigned int>(res.vertices.size());
+            res.vertices.push_back(p);
+            (in[i] ? exit : entry) = p;
+        }
+        if (in[j]) poly[corners++] = tri[j];
+    }
+
+    res.indices.insert(res.indices.end(), {poly[0], poly[1], poly[2]});
+    if (corners == 4) res.indices.insert(res.indices.end(), {poly[0], poly[2], poly[3]});
+    res.segments.emplace_back(exit, entry);
+}
+
+struct PointHash {
+    size_t operator()(const vec3& p) const {
+        size_t h = 0;
+        util::hash_combine(h, p.x);
+        util::hash_combine(h, p.y);
+        util::hash_combine(h, p.z);
+        return h;
+    }
+};
+
+/**
+ * Mean value coordinates of point p inside the polygon v, see Hormann and Floater, "Mean value
+ * coordinates for arbitrary planar polygons". Falls back to equal weights if p is on the border.
+ */
+std::vector<float> meanValueWeights(vec2 p, const std::vector<vec2>& v) {
+    const size_t n = v.size();
+    std::vector<vec2> s(n);
+    std::vector<float> r(n);
+    for (size_t i = 0; i < n; ++i) {
+        s[i] = v[i] - p;
+        r[i] = glm::length(s[i]);
+    }
+    std::vector<float> tanA(n);
+    for (size_t i = 0; i < n; ++i) {
+        const size_t ip = (i + 1) % n;
+        const float a = s[i].x * s[ip].y - s[ip].x * s[i].y;
+        tanA[i] = (r[i] * r[ip] - glm::dot(s[i], s[ip])) / a;
+    }
+    std::vector<float> w(n);
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        const size_t im = (n - 1 + i) % n;
+        w[i] = 2.0f * (tanA[i] + tanA[im]) / r[i];
+        sum += w[i];
+    }
+    if (!std::isfinite(sum) || std::abs(sum) == 0.0f) {
+        std::fill(w.begin(), w.end(), 1.0f / n);
+    } else {
+        for (auto& wi : w) wi /= sum;
+    }
+    return w;
+}
+
+/**
+ * Connect the intersection segments into closed loops and fill each loop with a triangle fan
+ * around its centroid. For a consistently oriented mesh the segments of each loop are chained end
+ * to start, points are matched exactly using a hash map.
+ */
+void addCaps(const std::vector<std::pair<Vertex, Vertex>>& segments, const Plane& plane,
+             std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+             unsigned int firstNew) {
+    constexpr auto invalid = std::numeric_limits<size_t>::max();
+
+    std::unordered_map<vec3, size_t, PointHash> pointIds;
+    // adding 0 turns -0 into +0, which compare equal but hash differently
+    const auto pointId = [&](vec3 p) {
+        return pointIds.emplace(p + vec3{0.0f}, pointIds.size()).first->second;
+    };
+    std::vector<size_t> segmentEnd(segments.size());
+    std::vector<size_t> nextSegment;
+    for (size_t s = 0; s < segments.size(); ++s) {
+        const auto start = pointId(segments[s].first.pos);
+        segmentEnd[s] = pointId(segments[s].second.pos);
+        nextSegment.resize(pointIds.size(), invalid);
+        if (nextSegment[start] == invalid) nextSegment[start] = s;
+    }
+
+    const auto n = plane.getNormal();
+    const auto u = glm::normalize(
+        glm::cross(n, std::abs(n.x) < 0.9f ? vec3{1.0f, 0.0f, 0.0f} : vec3{0.0f, 1.0f, 0.0f}));
+    const auto v = glm::cross(n, u);
+
+    std::vector<bool> visited(segments.size(), false);
+    std::vector<size_t> loop;
+    std::vector<vec2> uv;
+    for (size_t first = 0; first < segments.size(); ++first) {
+        if (visited[first]) continue;
+
+        loop.clear();
+        bool closed = false;
+        for (size_t s = first; s != invalid && !visited[s];) {
+            visited[s] = true;
+            loop.push_back(s);
+            const auto next = nextSegment[segmentEnd[s]];
+            if (next == first) {
+                closed = true;
+                break;
+            }
+            s = next;
+        }
+        if (!closed || loop.size() < 3) continue;
+
+        // Area weighted centroid in the u-v coordinates of the plane
+        uv.clear();
+        for (auto s : loop) {
+            const auto& p = segments[s].first.pos;
+            uv.emplace_back(glm::dot(u, p), glm::dot(v, p));
+        }
+        float area = 0.0f;
+        vec2 centroid{0.0f};
+        vec2 average{0.0f};
+        for (size_t i = 0; i < uv.size(); ++i) {
+            const auto& a = uv[i];
+            const auto& b = uv[(i + 1) % uv.size()];
+            const float cross = a.x * b.y - b.x * a.y;
+            area += cross;
+            centroid += (a + b) * cross;
+            average += a;
+        }
+        average /= static_cast<float>(uv.size());
+        centroid = std::abs(area) > std::numeric_limits<float>::epsilon()
+                       ? centroid / (3.0f * area)
+                       : average;
+
+        const auto weights = meanValueWeights(centroid, uv);
+        Vertex center{u * centroid.x + v * centroid.y +
+                          n * glm::dot(n, segments[loop.front()].first.pos),
+                      vec3{0.0f}, vec4{0.0f}};
+        for (size_t i = 0; i < loop.size(); ++i) {
+            center.tex += segments[loop[i]].first.tex * weights[i];
+            center.col += segments[loop[i]].first.col * weights[i];
+        }
+
+        const auto c = firstNew + static_cast<unsigned int>(vertices.size());
+        vertices.push_back(center);
+        for (auto s : loop) vertices.push_back(segments[s].first);
+        for (unsigned int i = 0; i < loop.size(); ++i) {
+            const unsigned int next = (i + 1) % static_cast<unsigned int>(loop.size());
+            indices.insert(indices.end(), {c, c + 1 + next, c + 1 + i});
+        }
+    }
+}
+
+}  // namespace
+
+meshutil::TriangleClusterBounds::TriangleClusterBounds(const std::vector<vec3>& positions,
+                                                       const std::vector<unsigned int>& indices,
+                                                       ConnectivityType ct, size_t clusterSize)
+    : clusterSize_{std::max(clusterSize, size_t{1})}
+    , triangles_{triangleCount(indices.size(), ct)}
+    , bounds_((triangles_ + clusterSize_ - 1) / clusterSize_) {
+
+    util::forEachRangeParallel(
+        bounds_.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t c = begin; c < end; ++c) {
+                vec3 min{std::numeric_limits<float>::max()};
+                vec3 max{std::numeric_limits<float>::lowest()};
+                const auto last = std::min(triangles_, (c + 1) * clusterSize_);
+                for (size_t t = c * clusterSize_; t < last; ++t) {
+                    for (auto i : triangle(indices, ct, t)) {
+                        min = glm::min(min, positions[i]);
+                        max = glm::max(max, positions[i]);
+                    }
+                }
+                bounds_[c] = {min, max};
+            }
+        },
+        1);
+}
+
+size_t meshutil::TriangleClusterBounds::getClusterSize() const { return clusterSize_; }
+
+size_t meshutil::TriangleClusterBounds::getNumberOfTriangles() const { return triangles_; }
+
+const std::vector<std::pair<vec3, vec3>>& meshutil::TriangleClusterBounds::getBounds() const {
+    return bounds_;
+}
+
+std::shared_ptr<SimpleMesh> meshutil::clipMeshAgainstPlane(
+    const std::vector<vec3>& positions, const std::vector<vec3>& texCoords,
+    const std::vector<vec4>& colors, const std::vector<unsigned int>& indices,
+    ConnectivityType ct, const Plane& plane, bool capping, const TriangleClusterBounds* bounds) {
+
+    const auto triangles = triangleCount(indices.size(), ct);
+    if (bounds && bounds->getNumberOfTriangles() != triangles) {
+        throw Exception("Cluster bounds do not match the mesh",
+                        IVW_CONTEXT_CUSTOM("meshutil::clipMeshAgainstPlane"));
+    }
+    if (positions.size() > std::numeric_limits<unsigned int>::max()) {
+        throw Exception("Too many vertices to clip",
+                        IVW_CONTEXT_CUSTOM("meshutil::clipMeshAgainstPlane"));
+    }
+
+    const Attributes attr{positions, texCoords, colors, texCoords.size() == positions.size(),
+                          colors.size() == positions.size()};
+    const auto firstNew = static_cast<unsigned int>(positions.size());
+    const size_t clusterSize = bounds ? bounds->getClusterSize() : 4096;
+    const size_t clusters = (triangles + clusterSize - 1) / clusterSize;
+    const auto n = plane.getNormal();
+
+    std::vector<ClipResult> results;
+    std::mutex mutex;
+    util::forEachRangeParallel(
+        clusters,
+        [&](size_t begin, size_t end) {
+            ClipResult res{begin, {}, {}, {}};
+            for (size_t c = begin; c < end; ++c) {
+                const auto first = c * clusterSize;
+                const auto last = std::min(triangles, first + clusterSize);
+
+                bool clip = true;
+                if (bounds) {
+                    // Signed distance of the box center and the largest distance of a corner
+                    // from the center along the normal
+                    const auto& box = bounds->getBounds()[c];
+                    const float d = plane.distance(0.5f * (box.first + box.second));
+                    const float r = glm::dot(0.5f * (box.second - box.first), glm::abs(n));
+                    if (d + r < 0.0f) {
+                        continue;
+                    } else if (d - r >= 0.0f) {
+                        clip = false;
+                    }
+                }
+
+                for (size_t t = first; t < last; ++t) {
+                    const auto tri = triangle(indices, ct, t);
+                    if (degenerate(tri)) continue;
+                    if (clip) {
+                        clipTriangle(tri, attr, plane, firstNew, res);
+                    } else {
+                        res.indices.insert(res.indices.end(), tri.begin(), tri.end());
+                    }
+                }
+            }
+            std::lock_guard<std::mutex> lock{mutex};
+            results.push_back(std::move(res));
+        },
+        1);
+
+    // Merge in cluster order to get the same output independent of the scheduling
+    std::sort(results.begin(), results.end(), [](const ClipResult& a, const ClipResult& b) {
+        return a.firstCluster < b.firstCluster;
+    });
+    std::vector<size_t> vertexOffsets(results.size() + 1, 0);
+    std::vector<size_t> indexOffsets(results.size() + 1, 0);
+    for (size_t i = 0; i < results.size(); ++i) {
+        vertexOffsets[i + 1] = vertexOffsets[i] + results[i].vertices.size();
+        indexOffsets[i + 1] = indexOffsets[i] + results[i].indices.size();
+    }
+
+    std::vector<Vertex> newVertices;
+    newVertices.reserve(vertexOffsets.back());
+    std::vector<std::pair<Vertex, Vertex>> segments;
+    for (auto& res : results) {
+        newVertices.insert(newVertices.end(), res.vertices.begin(), res.vertices.end());
+        segments.insert(segments.end(), res.segments.begin(), res.segments.end());
+    }
+
+    std::vector<unsigned int> outIndices(indexOffsets.back());
+    util::forEachRangeParallel(
+        results.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const auto offset = static_cast<unsigned int>(vertexOffsets[i]);
+                std::transform(results[i].indices.begin(), results[i].indices.end(),
+                               outIndices.begin() + indexOffsets[i],
+                               [&](unsigned int index) {
+                                   return index >= firstNew ? index + offset : index;
+                               });
+            }
+        },
+        1);
+    results.clear();
+
+    if (capping) addCaps(segments, plane, newVertices, outIndices, firstNew);
+
+    if (positions.size() + newVertices.size() > std::numeric_limits<unsigned int>::max()) {
+        throw Exception("Too many vertices in the clipped mesh",
+                        IVW_CONTEXT_CUSTOM("meshutil::clipMeshAgainstPlane"));
+    }
+
+    std::vector<vec3> outPositions;
+    std::vector<vec3> outTexCoords;
+    std::vector<vec4> outColors;
+    outPositions.reserve(positions.size() + newVertices.size());
+    outTexCoords.reserve(positions.size() + newVertices.size());
+    outColors.reserve(positions.size() + newVertices.size());
+    outPositions.insert(outPositions.end(), positions.begin(), positions.end());
+    if (attr.hasTex) {
+        outTexCoords.insert(outTexCoords.end(), texCoords.begin(), texCoords.end());
+    } else {
+        outTexCoords.resize(positions.size(), vec3{0.0f});
+    }
+    if (attr.hasCol) {
+        outColors.insert(outColors.end(), colors.begin(), colors.end());
+    } else {
+        outColors.resize(positions.size(), vec4{1.0f});
+    }
+    for (const auto& vertex : newVertices) {
+        outPositions.push_back(vertex.pos);
+        outTexCoords.push_back(vertex.tex);
+        outColors.push_back(vertex.col);
+    }
+
+    auto mesh = std::make_shared<SimpleMesh>(DrawType::Triangles, ConnectivityType::None);
+    static_cast<Vec3BufferRAM*>(mesh->getBuffer(0)->getEditableRepresentation<BufferRAM>())
+        ->getDataContainer() = std::move(outPositions);
+    static_cast<Vec3BufferRAM*>(mesh->getBuffer(1)->getEditableRepresentation<BufferRAM>())
+        ->getDataContainer() = std::move(outTexCoords);
+    static_cast<Vec4BufferRAM*>(mesh->getBuffer(2)->getEditableRepresentation<BufferRAM>())
+        ->getDataContainer() = std::move(outColors);
+    mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None)->getDataContainer() =
+        std::move(outIndices);
+    return mesh;
+}
+
+}  // namespace inviwo
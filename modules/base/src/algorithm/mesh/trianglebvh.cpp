@@ -0,0 +1,695 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/mesh/trianglebvh.h>
+#include <modules/base/algorithm/meshutils.h>
+
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/stdextensions.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+
+namespace inviwo {
+
+namespace meshutil {
+
+namespace {
+
+constexpr size_t bins = 16;
+// Ranges with fewer triangles are built as separate subtrees, one job each
+constexpr size_t subtreeSize = 1 << 15;
+// Cost of visiting a node relative to intersecting a triangle
+constexpr float traversalCost = 1.0f;
+
+struct Box {
+    vec3 min{std::numeric_limits<float>::max()};
+    vec3 max{std::numeric_limits<float>::lowest()};
+
+    void extend(const vec3& p) {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+    void extend(const Box& b) {
+        min = glm::min(min, b.min);
+        max = glm::max(max, b.max);
+    }
+    float area() const {
+        const auto d = glm::max(max - min, vec3{0.0f});
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+};
+
+// A range of the triangle order with the bounds of its triangles and of their centroids
+struct Range {
+    size_t begin;
+    size_t end;
+    Box bounds;
+    Box centroids;
+
+    size_t size() const { return end - begin; }
+};
+
+class Builder {
+public:
+    Builder(const std::vector<Box>& boxes, const std::vector<vec3>& centroids,
+            std::vector<std::uint32_t>& order, size_t maxLeafSize)
+        : boxes_{boxes}, centroids_{centroids}, order_{order}, maxLeafSize_{maxLeafSize} {}
+
+    Range range(size_t begin, size_t end, bool parallel) const {
+        Range res{begin, end, Box{}, Box{}};
+        forRange(begin, end, parallel, [&](size_t b, size_t e, auto&& merge) {
+            Box bounds;
+            Box centroids;
+            for (size_t i = b; i < e; ++i) {
+                bounds.extend(boxes_[order_[i]]);
+                centroids.extend(centroids_[order_[i]]);
+            }
+            merge([&]() {
+                res.bounds.extend(bounds);
+                res.centroids.extend(centroids);
+            });
+        });
+        return res;
+    }
+
+    /**
+     * Split the range in two by binning the centroids along the longest axis and picking the
+     * bin boundary with the lowest SAH cost. Returns nothing if the range should be a leaf.
+     */
+    std::optional<std::pair<Range, Range>> split(const Range& r, bool parallel) const {
+        const size_t count = r.size();
+        if (count <= maxLeafSize_) return std::nullopt;
+
+        const auto extent = r.centroids.max - r.centroids.min;
+        const int axis = extent.x >= extent.y ? (extent.x >= extent.z ? 0 : 2)
+                                              : (extent.y >= extent.z ? 1 : 2);
+        // All centroids in the same place, binning can not separate them
+        if (!(extent[axis] > 0.0f)) {
+            const auto mid = r.begin + count / 2;
+            return std::make_pair(range(r.begin, mid, parallel), range(mid, r.end, parallel));
+        }
+
+        const float cmin = r.centroids.min[axis];
+        const float scale = static_cast<float>(bins) / extent[axis];
+        const auto binIndex = [&](std::uint32_t tri) {
+            const auto bin = static_cast<size_t>((centroids_[tri][axis] - cmin) * scale);
+            return std::min(bin, bins - 1);
+        };
+
+        struct Bin {
+            size_t count = 0;
+            Box bounds;
+            Box centroids;
+
+            void extend(const Bin& b) {
+                count += b.count;
+                bounds.extend(b.bounds);
+                centroids.extend(b.centroids);
+            }
+        };
+
+        std::array<Bin, bins> binned{};
+        forRange(r.begin, r.end, parallel, [&](size_t b, size_t e, auto&& merge) {
+            std::array<Bin, bins> local{};
+            for (size_t i = b; i < e; ++i) {
+                const auto tri = order_[i];
+                auto& bin = local[binIndex(tri)];
+                ++bin.count;
+                bin.bounds.extend(boxes_[tri]);
+                bin.centroids.extend(centroids_[tri]);
+            }
+            merge([&]() {
+                for (size_t i = 0; i < bins; ++i) binned[i].extend(local[i]);
+            });
+        });
+
+        // Sweep from the right to get what is to the right of each bin boundary
+        std::array<Bin, bins> right{};
+        for (size_t i = bins - 1; i > 0; --i) {
+            right[i] = binned[i];
+            if (i + 1 < bins) right[i].extend(right[i + 1]);
+        }
+
+        float bestCost = std::numeric_limits<float>::max();
+        size_t bestSplit = 0;
+        Bin left;
+        std::array<Bin, bins> lefts{};
+        for (size_t i = 1; i < bins; ++i) {
+            left.extend(binned[i - 1]);
+            lefts[i] = left;
+            if (left.count == 0 || right[i].count == 0) continue;
+            const float cost =
+                left.bounds.area() * left.count + right[i].bounds.area() * right[i].count;
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = i;
+            }
+        }
+        if (bestSplit == 0) return std::nullopt;
+
+        // Prefer a somewhat larger leaf if splitting is not expected to pay off
+        const float area = r.bounds.area();
+        const float splitCost =
+            area > 0.0f ? traversalCost + bestCost / area : static_cast<float>(count);
+        if (count <= 4 * maxLeafSize_ && splitCost >= static_cast<float>(count)) {
+            return std::nullopt;
+        }
+
+        const auto it =
+            std::partition(order_.begin() + r.begin, order_.begin() + r.end,
+                           [&](std::uint32_t tri) { return binIndex(tri) < bestSplit; });
+        const auto mid = static_cast<size_t>(it - order_.begin());
+        const auto& l = lefts[bestSplit];
+        const auto& rr = right[bestSplit];
+        return std::make_pair(Range{r.begin, mid, l.bounds, l.centroids},
+                              Range{mid, r.end, rr.bounds, rr.centroids});
+    }
+
+    // Build the subtree of the range depth first into nodes, the offsets of inner nodes are
+    // relative to the first node added. Returns the depth of the subtree.
+    size_t build(const Range& r, std::vector<TriangleBVH::Node>& nodes) const {
+        const auto first = nodes.size();
+        return build(r, nodes, first);
+    }
+
+private:
+    size_t build(const Range& r, std::vector<TriangleBVH::Node>& nodes, size_t first) const {
+        const auto index = nodes.size();
+        nodes.push_back({r.bounds.min, static_cast<std::uint32_t>(r.begin), r.bounds.max,
+                         static_cast<std::uint32_t>(r.size())});
+        const auto children = split(r, false);
+        if (!children) return 1;
+
+        nodes[index].count = 0;
+        const auto left = build(children->first, nodes, first);
+        nodes[index].offset = static_cast<std::uint32_t>(nodes.size() - first);
+        const auto right = build(children->second, nodes, first);
+        return 1 + std::max(left, right);
+    }
+
+    // Call callback(begin, end, merge) over parts of the range, in parallel if requested. The
+    // callback should compute its partial result and pass a function combining it with the total
+    // to merge, which is called under a lock.
+    template <typename Callback>
+    static void forRange(size_t begin, size_t end, bool parallel, Callback&& callback) {
+        if (!parallel) {
+            callback(begin, end, [](auto&& f) { f(); });
+            return;
+        }
+        std::mutex mutex;
+        util::forEachRangeParallel(end - begin, [&](size_t b, size_t e) {
+            callback(begin + b, begin + e, [&](auto&& f) {
+                std::lock_guard<std::mutex> lock{mutex};
+                f();
+            });
+        });
+    }
+
+    const std::vector<Box>& boxes_;
+    const std::vector<vec3>& centroids_;
+    std::vector<std::uint32_t>& order_;
+    size_t maxLeafSize_;
+};
+
+bool intersectBox(const TriangleBVH::Node& node, const vec3& origin, const vec3& invDir,
+                  float tMin, float tMax, float& tEntry) {
+    const auto t0 = (node.min - origin) * invDir;
+    const auto t1 = (node.max - origin) * invDir;
+    const auto tNear = glm::min(t0, t1);
+    const auto tFar = glm::max(t0, t1);
+    tEntry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, tMin));
+    const float tExit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, tMax));
+    return tEntry <= tExit;
+}
+
+// Möller-Trumbore, returns t, u, v
+std::optional<vec3> intersectTriangle(const vec3& a, const vec3& b, const vec3& c,
+                                      const vec3& origin, const vec3& dir, float tMin,
+                                      float tMax) {
+    const auto e1 = b - a;
+    const auto e2 = c - a;
+    const auto p = glm::cross(dir, e2);
+    const float det = glm::dot(e1, p);
+    if (det == 0.0f) return std::nullopt;
+    const float invDet = 1.0f / det;
+    const auto s = origin - a;
+    const float u = glm::dot(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f) return std::nullopt;
+    const auto q = glm::cross(s, e1);
+    const float v = glm::dot(dir, q) * invDet;
+    if (v < 0.0f || u + v > 1.0f) return std::nullopt;
+    const float t = glm::dot(e2, q) * invDet;
+    if (t < tMin || t > tMax) return std::nullopt;
+    return vec3{t, u, v};
+}
+
+// Closest point on a triangle, from Ericson, Real-Time Collision Detection
+vec3 closestPointOnTriangle(const vec3& p, const vec3& a, const vec3& b, const vec3& c) {
+    const auto ab = b - a;
+    const auto ac = c - a;
+    const auto ap = p - a;
+    const float d1 = glm::dot(ab, ap);
+    const float d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+    const auto bp = p - b;
+    const float d3 = glm::dot(ab, bp);
+    const float d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+
+    const auto cp = p - c;
+    const float d5 = glm::dot(ab, cp);
+    const float d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    const float denom = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+float distance2(const TriangleBVH::Node& node, const vec3& p) {
+    const auto d = glm::max(glm::max(node.min - p, p - node.max), vec3{0.0f});
+    return glm::dot(d, d);
+}
+
+}  // namespace
+
+TriangleBVH::TriangleBVH(std::vector<vec3> positions, std::vector<uvec3> triangles,
+                         size_t maxLeafSize)
+    : positions_{std::move(positions)}, depth_{0} {
+    if (triangles.size() >= std::numeric_limits<std::uint32_t>::max() / 2) {
+        throw RangeException("Too many triangles for a TriangleBVH",
+                             IVW_CONTEXT_CUSTOM("TriangleBVH"));
+    }
+    maxLeafSize = std::max<size_t>(maxLeafSize, 1);
+
+    const auto nTriangles = triangles.size();
+    const auto nPositions = positions_.size();
+    std::vector<Box> boxes(nTriangles);
+    std::vector<vec3> centroids(nTriangles);
+    std::atomic<bool> outOfRange{false};
+    util::forEachRangeParallel(nTriangles, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto& tri = triangles[i];
+            if (tri.x >= nPositions || tri.y >= nPositions || tri.z >= nPositions) {
+                outOfRange = true;
+                return;
+            }
+            Box box;
+            box.extend(positions_[tri.x]);
+            box.extend(positions_[tri.y]);
+            box.extend(positions_[tri.z]);
+            boxes[i] = box;
+            centroids[i] = 0.5f * (box.min + box.max);
+        }
+    });
+    if (outOfRange) {
+        throw RangeException("Triangle index out of range", IVW_CONTEXT_CUSTOM("TriangleBVH"));
+    }
+
+    std::vector<std::uint32_t> order(nTriangles);
+    std::iota(order.begin(), order.end(), std::uint32_t{0});
+
+    if (nTriangles > 0) {
+        Builder builder{boxes, centroids, order, maxLeafSize};
+
+        // Split the top levels using all threads until the ranges are small enough to be built
+        // by a single job each.
+        struct TopNode {
+            Box bounds;
+            size_t left = 0;
+            size_t right = 0;
+            size_t subtree = std::numeric_limits<size_t>::max();
+        };
+        std::vector<TopNode> top;
+        std::vector<Range> subtrees;
+        const auto buildTop = [&](auto& self, const Range& r) -> size_t {
+            const auto index = top.size();
+            top.push_back({r.bounds});
+            if (r.size() > subtreeSize) {
+                if (const auto children = builder.split(r, true)) {
+                    const auto left = self(self, children->first);
+                    const auto right = self(self, children->second);
+                    top[index].left = left;
+                    top[index].right = right;
+                    return index;
+                }
+            }
+            top[index].subtree = subtrees.size();
+            subtrees.push_back(r);
+            return index;
+        };
+        buildTop(buildTop, builder.range(0, nTriangles, true));
+
+        std::vector<std::vector<Node>> subtreeNodes(subtrees.size());
+        std::vector<size_t> subtreeDepth(subtrees.size());
+        util::forEachRangeParallel(
+            subtrees.size(),
+            [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    subtreeDepth[i] = builder.build(subtrees[i], subtreeNodes[i]);
+                }
+            },
+            1);
+
+        // Flatten, depth first
+        nodes_.reserve(2 * nTriangles / maxLeafSize + top.size());
+        const auto emit = [&](auto& self, size_t index, size_t depth) -> void {
+            const auto& node = top[index];
+            if (node.subtree != std::numeric_limits<size_t>::max()) {
+                const auto base = static_cast<std::uint32_t>(nodes_.size());
+                for (auto n : subtreeNodes[node.subtree]) {
+                    if (!n.isLeaf()) n.offset += base;
+                    nodes_.push_back(n);
+                }
+                depth_ = std::max(depth_, depth + subtreeDepth[node.subtree]);
+                subtreeNodes[node.subtree] = {};
+            } else {
+                const auto nodeIndex = nodes_.size();
+                nodes_.push_back({node.bounds.min, 0, node.bounds.max, 0});
+                self(self, node.left, depth + 1);
+                nodes_[nodeIndex].offset = static_cast<std::uint32_t>(nodes_.size());
+                self(self, node.right, depth + 1);
+            }
+        };
+        emit(emit, 0, 0);
+    }
+
+    triangles_.resize(nTriangles);
+    for (size_t i = 0; i < nTriangles; ++i) triangles_[i] = triangles[order[i]];
+    indices_ = std::move(order);
+}
+
+std::optional<TriangleBVH::RayHit> TriangleBVH::raycast(const vec3& origin, const vec3& direction,
+                                                        float tMin, float tMax) const {
+    if (nodes_.empty()) return std::nullopt;
+
+    const auto invDir = 1.0f / direction;
+    std::optional<RayHit> hit;
+    std::vector<std::uint32_t> stack;
+    stack.reserve(depth_);
+    float tEntry;
+    if (intersectBox(nodes_[0], origin, invDir, tMin, tMax, tEntry)) stack.push_back(0);
+
+    while (!stack.empty()) {
+        const auto& node = nodes_[stack.back()];
+        const auto index = stack.back();
+        stack.pop_back();
+
+        if (node.isLeaf()) {
+            for (auto i = node.offset; i < node.offset + node.count; ++i) {
+                const auto& tri = triangles_[i];
+                if (auto res = intersectTriangle(positions_[tri.x], positions_[tri.y],
+                                                 positions_[tri.z], origin, direction, tMin,
+                                                 tMax)) {
+                    tMax = res->x;
+                    hit = RayHit{res->x, indices_[i], vec3{1.0f - res->y - res->z, res->y, res->z}};
+                }
+            }
+        } else {
+            // Visit the closer child first
+            const std::uint32_t left = index + 1;
+            const std::uint32_t right = node.offset;
+            float tLeft, tRight;
+            const bool hitLeft = intersectBox(nodes_[left], origin, invDir, tMin, tMax, tLeft);
+            const bool hitRight = intersectBox(nodes_[right], origin, invDir, tMin, tMax, tRight);
+            if (hitLeft && hitRight) {
+                if (tLeft < tRight) {
+                    stack.push_back(right);
+                    stack.push_back(left);
+                } else {
+                    stack.push_back(left);
+                    stack.push_back(right);
+                }
+            } else if (hitLeft) {
+                stack.push_back(left);
+            } else if (hitRight) {
+                stack.push_back(right);
+            }
+        }
+    }
+    return hit;
+}
+
+bool TriangleBVH::occluded(const vec3& origin, const vec3& direction, float tMin,
+                           float tMax) const {
+    if (nodes_.empty()) return false;
+
+    const auto invDir = 1.0f / direction;
+    std::vector<std::uint32_t> stack;
+    stack.reserve(depth_);
+    stack.push_back(0);
+    float tEntry;
+    while (!stack.empty()) {
+        const auto index = stack.back();
+        stack.pop_back();
+        const auto& node = nodes_[index];
+        if (!intersectBox(node, origin, invDir, tMin, tMax, tEntry)) continue;
+
+        if (node.isLeaf()) {
+            for (auto i = node.offset; i < node.offset + node.count; ++i) {
+                const auto& tri = triangles_[i];
+                if (intersectTriangle(positions_[tri.x], positions_[tri.y], positions_[tri.z],
+                                      origin, direction, tMin, tMax)) {
+                    return true;
+                }
+            }
+        } else {
+            stack.push_back(node.offset);
+            stack.push_back(index + 1);
+        }
+    }
+    return false;
+}
+
+size_t TriangleBVH::countIntersections(const vec3& origin, const vec3& direction) const {
+    if (nodes_.empty()) return 0;
+
+    const auto invDir = 1.0f / direction;
+    const float tMax = std::numeric_limits<float>::max();
+    size_t count = 0;
+    std::vector<std::uint32_t> stack;
+    stack.reserve(depth_);
+    stack.push_back(0);
+    float tEntry;
+    while (!stack.empty()) {
+        const auto index = stack.back();
+        stack.pop_back();
+        const auto& node = nodes_[index];
+        if (!intersectBox(node, origin, invDir, 0.0f, tMax, tEntry)) continue;
+
+        if (node.isLeaf()) {
+            for (auto i = node.offset; i < node.offset + node.count; ++i) {
+                const auto& tri = triangles_[i];
+                if (intersectTriangle(positions_[tri.x], positions_[tri.y], positions_[tri.z],
+                                      origin, direction, 0.0f, tMax)) {
+                    ++count;
+                }
+            }
+        } else {
+            stack.push_back(node.offset);
+            stack.push_back(index + 1);
+        }
+    }
+    return count;
+}
+
+std::optional<TriangleBVH::ClosestPoint> TriangleBVH::closestPoint(const vec3& point) const {
+    if (nodes_.empty()) return std::nullopt;
+
+    float best = std::numeric_limits<float>::max();
+    ClosestPoint res{vec3{0.0f}, 0.0f, 0};
+    std::vector<std::uint32_t> stack;
+    stack.reserve(depth_);
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const auto index = stack.back();
+        stack.pop_back();
+        const auto& node = nodes_[index];
+        if (distance2(node, point) >= best) continue;
+
+        if (node.isLeaf()) {
+            for (auto i = node.offset; i < node.offset + node.count; ++i) {
+                const auto& tri = triangles_[i];
+                const auto p = closestPointOnTriangle(point, positions_[tri.x],
+                                                      positions_[tri.y], positions_[tri.z]);
+                const auto d = glm::dot(p - point, p - point);
+                if (d < best) {
+                    best = d;
+                    res.point = p;
+                    res.triangle = indices_[i];
+                }
+            }
+        } else {
+            // Visit the closer child first
+            const std::uint32_t left = index + 1;
+            const std::uint32_t right = node.offset;
+            if (distance2(nodes_[left], point) < distance2(nodes_[right], point)) {
+                stack.push_back(right);
+                stack.push_back(left);
+            } else {
+                stack.push_back(left);
+                stack.push_back(right);
+            }
+        }
+    }
+    res.distance = std::sqrt(best);
+    return res;
+}
+
+bool TriangleBVH::isInside(const vec3& point) const {
+    // Directions unlikely to be aligned with the edges of a mesh
+    static const std::array<vec3, 3> directions = {
+        glm::normalize(vec3{0.5377f, 0.8156f, 0.2137f}),
+        glm::normalize(vec3{-0.7291f, 0.1873f, 0.6583f}),
+        glm::normalize(vec3{0.2411f, -0.6178f, -0.7488f})};
+
+    size_t votes = 0;
+    for (const auto& dir : directions) {
+        if (countIntersections(point, dir) % 2 == 1) ++votes;
+    }
+    return votes >= 2;
+}
+
+const std::vector<TriangleBVH::Node>& TriangleBVH::getNodes() const { return nodes_; }
+
+const std::vector<uvec3>& TriangleBVH::getTriangles() const { return triangles_; }
+
+const std::vector<std::uint32_t>& TriangleBVH::getTriangleIndices() const { return indices_; }
+
+const std::vector<vec3>& TriangleBVH::getPositions() const { return positions_; }
+
+std::pair<vec3, vec3> TriangleBVH::getBounds() const {
+    if (nodes_.empty()) return {vec3{0.0f}, vec3{0.0f}};
+    return {nodes_[0].min, nodes_[0].max};
+}
+
+size_t TriangleBVH::getDepth() const { return depth_; }
+
+std::shared_ptr<const TriangleBVH> createTriangleBVH(const Mesh& mesh, size_t maxLeafSize) {
+    const auto& buffers = mesh.getBuffers();
+    auto it = util::find_if(buffers, [](const auto& buf) {
+        return buf.first.type == BufferType::PositionAttrib;
+    });
+    if (it == buffers.end()) {
+        throw Exception("Unsupported mesh, no buffers with the Position Attribute found",
+                        IVW_CONTEXT_CUSTOM("meshutil::createTriangleBVH"));
+    }
+
+    const auto ram = it->second->getRepresentation<BufferRAM>();
+    auto positions = ram->dispatch<std::vector<vec3>, dispatching::filter::Floats>([](auto pb) {
+        const auto& data = pb->getDataContainer();
+        std::vector<vec3> res(data.size());
+        std::transform(data.begin(), data.end(), res.begin(),
+                       [](const auto& v) { return util::glm_convert<vec3>(v); });
+        return res;
+    });
+
+    std::vector<uvec3> triangles;
+    for (const auto& ib : mesh.getIndexBuffers()) {
+        if (ib.first.dt != DrawType::Triangles || ib.second->getSize() < 3) continue;
+        forEachTriangle(ib.first, *ib.second,
+                        [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+                            // Skip degenerate triangles, i.e. restarts in strips
+                            if (a != b && b != c && a != c) triangles.emplace_back(a, b, c);
+                        });
+    }
+    if (mesh.getIndexBuffers().empty() && mesh.getDefaultMeshInfo().dt == DrawType::Triangles) {
+        const auto n = static_cast<std::uint32_t>(positions.size());
+        for (std::uint32_t i = 0; i + 2 < n; i += 3) triangles.emplace_back(i, i + 1, i + 2);
+    }
+
+    return std::make_shared<TriangleBVH>(std::move(positions), std::move(triangles), maxLeafSize);
+}
+
+TriangleBVHCache::TriangleBVHCache(size_t maxLeafSize) : maxLeafSize_{maxLeafSize} {}
+
+std::shared_ptr<const TriangleBVH> TriangleBVHCache::get(const std::shared_ptr<const Mesh>& mesh) {
+    if (!mesh) return nullptr;
+
+    std::lock_guard<std::mutex> lock{mutex_};
+    auto current = getState(mesh);
+    if (!bvh_ || !state_.matches(current)) {
+        bvh_ = createTriangleBVH(*mesh, maxLeafSize_);
+        state_ = std::move(current);
+    }
+    return bvh_;
+}
+
+void TriangleBVHCache::clear() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    state_ = State{};
+    bvh_.reset();
+}
+
+bool TriangleBVHCache::State::matches(const State& current) const {
+    if (mesh.lock() != current.mesh.lock() || buffers.size() != current.buffers.size() ||
+        infos != current.infos || counts != current.counts) {
+        return false;
+    }
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        if (buffers[i].lock() != current.buffers[i].lock()) return false;
+    }
+    return true;
+}
+
+auto TriangleBVHCache::getState(const std::shared_ptr<const Mesh>& mesh) -> State {
+    State state;
+    state.mesh = mesh;
+    for (const auto& buf : mesh->getBuffers()) {
+        state.buffers.push_back(buf.second);
+        state.counts.push_back(buf.second->getModificationCount());
+    }
+    for (const auto& ib : mesh->getIndexBuffers()) {
+        state.buffers.push_back(ib.second);
+        state.counts.push_back(ib.second->getModificationCount());
+        state.infos.push_back(ib.first);
+    }
+    state.infos.push_back(mesh->getDefaultMeshInfo());
+    return state;
+}
+
+}  // namespace meshutil
+
+}  // namespace inviwo
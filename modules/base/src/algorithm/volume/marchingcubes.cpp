@@ -574,7 +574,8 @@ namespace util {
 std::shared_ptr<Mesh> marchingcubes(std::shared_ptr<const Volume> volume, double iso,
                                     const vec4 &color, bool invert, bool enclose,
                                     std::function<void(float)> progressCallback,
-                                    std::function<bool(const size3_t &)> maskingCallback) {
+                                    std::function<bool(const size3_t &)> maskingCallback,
+                                    std::function<bool()> stopCallback) {
 
     return volume->getRepresentation<VolumeRAM>()->dispatch<std::shared_ptr<Mesh>>([&](auto ram) {
         using T = util::PrecisionValueType<decltype(ram)>;
@@ -609,6 +610,7 @@ std::shared_ptr<Mesh> marchingcubes(std::shared_ptr<const Volume> volume, double
         normals.reserve(volSize * 6);
 
         for (size_t k = 0; k < dim.z - 1; k++) {
+            if (stopCallback && stopCallback()) return std::shared_ptr<BasicMesh>{};
             for (size_t j = 0; j < dim.y - 1; j++) {
                 for (size_t i = 0; i < dim.x - 1; i++) {
                     if (!maskingCallback({i, j, k})) continue;
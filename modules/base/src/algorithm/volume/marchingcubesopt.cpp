@@ -435,7 +435,8 @@ namespace util {
 std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, double iso,
                                        const vec4 &color, bool invert, bool enclose,
                                        std::function<void(float)> progressCallback,
-                                       std::function<bool(const size3_t &)> maskingCallback) {
+                                       std::function<bool(const size3_t &)> maskingCallback,
+                                       std::function<bool()> stopCallback) {
 
     auto indexBuffer = std::make_shared<IndexBuffer>();
     auto vertexBuffer = std::make_shared<Buffer<vec3>>();
@@ -493,6 +494,7 @@ std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, dou
             static_cast<float>(4.0 * glm::epsilon<double>() * glm::epsilon<double>() * dr.x * dr.y);
 
         for (ind.z = 0, pos.z = 0.0; ind.z < dim1.z; ++ind.z, pos.z += dr.z) {
+            if (stopCallback && stopCallback()) return;
             vcache.incZ();
             for (ind.y = 0, pos.y = 0.0; ind.y < dim1.y; ++ind.y, pos.y += dr.y) {
                 ind.x = 0;
@@ -558,6 +560,8 @@ std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, dou
             });
     }
 
+    if (stopCallback && stopCallback()) return nullptr;
+
     ivwAssert(positions.size() == normals.size(), "positions and normals must be equal size");
 
     std::transform(normals.begin(), normals.end(), normals.begin(),
@@ -0,0 +1,148 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/volume/volumederivatives.h>
+#include <modules/base/algorithm/volume/volumestencil.h>
+#include <modules/base/algorithm/dataminmax.h>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+
+#include <limits>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+template <typename T>
+auto makeDerivativeVolume(const Volume& volume) {
+    auto rep = std::make_shared<VolumeRAMPrecision<T>>(volume.getDimensions());
+    auto vol = std::make_unique<Volume>(rep);
+    vol->setModelMatrix(volume.getModelMatrix());
+    vol->setWorldMatrix(volume.getWorldMatrix());
+    return std::make_pair(std::move(vol), rep->getDataTyped());
+}
+
+template <typename T>
+void setSymmetricRange(Volume& result, const Volume& volume, const T* data) {
+    const auto minmax = util::dataMinMax(data, glm::compMul(volume.getDimensions()),
+                                         IgnoreSpecialValues::Yes);
+    auto minV = std::numeric_limits<double>::max();
+    auto maxV = std::numeric_limits<double>::lowest();
+    for (size_t i = 0; i < util::extent<T>::value; ++i) {
+        minV = std::min(minV, minmax.first[i]);
+        maxV = std::max(maxV, minmax.second[i]);
+    }
+    const auto range = std::max(std::abs(minV), std::abs(maxV));
+    result.dataMap_ = volume.dataMap_;
+    result.dataMap_.dataRange = dvec2(-range, range);
+    result.dataMap_.valueRange = dvec2(minV, maxV);
+}
+
+}  // namespace
+
+dvec3 volumeVoxelSpacing(const Volume& volume) {
+    const dmat4 m{volume.getCoordinateTransformer().getDataToWorldMatrix()};
+    const auto a = m * dvec4(0, 0, 0, 1);
+    const auto b =
+        m * dvec4(dvec3(1.0) / dvec3(glm::max(volume.getDimensions(), size3_t(2)) - size3_t(1)), 1);
+    return dvec3(b - a);
+}
+
+VolumeDerivativeResult volumeDerivatives(const Volume& volume, VolumeDerivatives derivatives,
+                                         int gradientChannel) {
+    const bool gradient = static_cast<bool>(derivatives & VolumeDerivative::Gradient);
+    const bool divergence = static_cast<bool>(derivatives & VolumeDerivative::Divergence);
+    const bool curl = static_cast<bool>(derivatives & VolumeDerivative::Curl);
+
+    if ((divergence || curl) && volume.getDataFormat()->getComponents() != 3) {
+        throw Exception("Divergence and curl require a volume with three components, got " +
+                            volume.getDataFormat()->getString(),
+                        IVW_CONTEXT_CUSTOM("util::volumeDerivatives"));
+    }
+
+    VolumeDerivativeResult res;
+    vec3* gradientData = nullptr;
+    float* divergenceData = nullptr;
+    vec3* curlData = nullptr;
+    if (gradient) std::tie(res.gradient, gradientData) = makeDerivativeVolume<vec3>(volume);
+    if (divergence) std::tie(res.divergence, divergenceData) = makeDerivativeVolume<float>(volume);
+    if (curl) std::tie(res.curl, curlData) = makeDerivativeVolume<vec3>(volume);
+
+    const auto invSpacing = dvec3(1.0) / volumeVoxelSpacing(volume);
+    const size_t channel = static_cast<size_t>(
+        glm::clamp(gradientChannel, 0,
+                   static_cast<int>(volume.getDataFormat()->getComponents()) - 1));
+
+    volume.getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::All>(
+        [&](auto vrprecision) {
+            using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
+
+            forEachVoxelStencil(
+                vrprecision->getDataTyped(), volume.getDimensions(),
+                [&](const size3_t&, size_t index, const StencilNeighbourhood<ValueType>& n) {
+                    const auto w = n.scale * invSpacing;
+                    if (gradientData) {
+                        const auto c = [&](const ValueType& v) {
+                            return static_cast<double>(util::glmcomp(v, channel));
+                        };
+                        gradientData[index] = vec3(dvec3{c(n.xp) - c(n.xm), c(n.yp) - c(n.ym),
+                                                         c(n.zp) - c(n.zm)} *
+                                                   w);
+                    }
+                    if (divergenceData || curlData) {
+                        const dvec3 Fx = (util::glm_convert<dvec3>(n.xp) -
+                                          util::glm_convert<dvec3>(n.xm)) * w.x;
+                        const dvec3 Fy = (util::glm_convert<dvec3>(n.yp) -
+                                          util::glm_convert<dvec3>(n.ym)) * w.y;
+                        const dvec3 Fz = (util::glm_convert<dvec3>(n.zp) -
+                                          util::glm_convert<dvec3>(n.zm)) * w.z;
+                        if (divergenceData) {
+                            divergenceData[index] = static_cast<float>(Fx.x + Fy.y + Fz.z);
+                        }
+                        if (curlData) {
+                            curlData[index] = vec3(dvec3{Fy.z - Fz.y, Fz.x - Fx.z, Fx.y - Fy.x});
+                        }
+                    }
+                });
+        });
+
+    if (divergence) setSymmetricRange(*res.divergence, volume, divergenceData);
+    if (curl) setSymmetricRange(*res.curl, volume, curlData);
+
+    return res;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -28,63 +28,272 @@
  *********************************************************************************/
 
 #include <modules/base/algorithm/volume/volumeramsubsample.h>
+#include <modules/base/io/brickedvolumeio.h>
+#include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/foreach.h>
 #include <inviwo/core/util/indexmapper.h>
 
+#include <cmath>
+#include <vector>
+
 namespace inviwo {
 
-std::shared_ptr<VolumeRAM> util::volumeSubSample(const VolumeRAM* volume, size3_t f) {
-    return volume->dispatch<std::shared_ptr<VolumeRAM>>(
-        [&f](auto srcVol) -> std::shared_ptr<VolumeRAM> {
-            using ValueType = util::PrecisionValueType<decltype(srcVol)>;
-
-            // use a double type to perform the summation
-            using P = typename util::same_extent<ValueType, double>::type;
-
-            // calculate new size
-            const size3_t srcDims{srcVol->getDimensions()};
-            const size3_t destDims{srcDims / f};
-
-            // allocate space
-            auto destVol = std::make_shared<VolumeRAMPrecision<ValueType>>(destDims);
-
-            // get data pointers
-            const auto src = srcVol->getDataTyped();
-            auto dst = destVol->getDataTyped();
-
-            util::IndexMapper3D o(srcDims);
-            util::IndexMapper3D n(destDims);
-
-            const double samplesInv = 1.0 / (f.x * f.y * f.z);
-#pragma omp parallel for
-            for (long long z_ = 0; z_ < static_cast<long long>(destDims.z); ++z_) {
-                const size_t z = static_cast<size_t>(z_);  // OpenMP need signed integral type.
-                for (size_t y = 0; y < destDims.y; ++y) {
-                    for (size_t x = 0; x < destDims.x; ++x) {
-                        const size_t px{x * f.x};
-                        const size_t py{y * f.y};
-                        const size_t pz{z * f.z};
-                        P val{0.0};
-
-                        for (size_t oz = 0; oz < f.z; ++oz) {
-                            for (size_t oy = 0; oy < f.y; ++oy) {
-                                for (size_t ox = 0; ox < f.x; ++ox) {
-                                    val += src[o(px + ox, py + oy, pz + oz)];
-                                }
-                            }
+namespace {
+
+// The input voxels along one axis that contribute to an output voxel
+struct Contribution {
+    size_t first;
+    std::vector<double> weights;
+};
+
+double filterWeight(util::SubsampleFilter filter, double t) {
+    switch (filter) {
+        case util::SubsampleFilter::Gaussian:
+            // standard deviation of 0.5
+            return std::exp(-2.0 * t * t);
+        case util::SubsampleFilter::Lanczos: {
+            if (t == 0.0) return 1.0;
+            const double pt = glm::pi<double>() * t;
+            return 3.0 * std::sin(pt) * std::sin(pt / 3.0) / (pt * pt);
+        }
+        case util::SubsampleFilter::Box:
+        case util::SubsampleFilter::Max:
+        default:
+            return 1.0;
+    }
+}
+
+std::vector<Contribution> contributions(size_t srcSize, size_t dstSize, double f,
+                                        util::SubsampleFilter filter) {
+    std::vector<Contribution> res(dstSize);
+    for (size_t x = 0; x < dstSize; ++x) {
+        auto& c = res[x];
+        if (filter == util::SubsampleFilter::Box || filter == util::SubsampleFilter::Max) {
+            // Weight by the overlap of the input voxel with the footprint of the output voxel
+            const double begin = x * f;
+            const double end = (x + 1) * f;
+            c.first = static_cast<size_t>(begin);
+            const auto last = std::min(srcSize, static_cast<size_t>(std::ceil(end)));
+            for (size_t i = c.first; i < last; ++i) {
+                c.weights.push_back(std::min(i + 1.0, end) -
+                                    std::max(static_cast<double>(i), begin));
+            }
+        } else {
+            // The filter is scaled by f, t is measured in output voxels
+            const double radius = (filter == util::SubsampleFilter::Gaussian ? 1.5 : 3.0) * f;
+            const double center = (x + 0.5) * f;
+            c.first = static_cast<size_t>(std::max(0.0, std::floor(center - radius)));
+            const auto last =
+                std::min(srcSize, static_cast<size_t>(std::ceil(center + radius)));
+            for (size_t i = c.first; i < last; ++i) {
+                c.weights.push_back(filterWeight(filter, (i + 0.5 - center) / f));
+            }
+        }
+
+        // Voxels outside of the volume are left out, renormalize the remaining ones
+        double sum = 0.0;
+        for (auto w : c.weights) sum += w;
+        if (sum != 0.0) {
+            for (auto& w : c.weights) w /= sum;
+        }
+    }
+    return res;
+}
+
+template <typename P, typename Value>
+P apply(const Contribution& c, bool max, Value&& value) {
+    if (max) {
+        P res{value(c.first)};
+        for (size_t k = 1; k < c.weights.size(); ++k) {
+            res = glm::max(res, value(c.first + k));
+        }
+        return res;
+    } else {
+        P res{0.0};
+        for (size_t k = 0; k < c.weights.size(); ++k) {
+            res += c.weights[k] * value(c.first + k);
+        }
+        return res;
+    }
+}
+
+template <typename T, typename P,
+          typename std::enable_if<util::is_floating_point<typename DataFormat<T>::primitive>::value,
+                                  int>::type = 0>
+T toValue(const P& v) {
+    return static_cast<T>(v);
+}
+
+// Round and clamp, filters with negative lobes can go outside of the range of the input
+template <typename T, typename P,
+          typename std::enable_if<
+              !util::is_floating_point<typename DataFormat<T>::primitive>::value, int>::type = 0>
+T toValue(const P& v) {
+    return static_cast<T>(glm::clamp(glm::round(v), static_cast<P>(DataFormat<T>::lowest()),
+                                      static_cast<P>(DataFormat<T>::max())));
+}
+
+template <typename T>
+std::shared_ptr<VolumeRAMPrecision<T>> subsample(const util::VolumeSliceSource& source,
+                                                 size3_t srcDims, dvec3 f,
+                                                 util::SubsampleFilter filter, size_t slabMemory,
+                                                 const std::function<void(float)>& progress,
+                                                 const std::function<bool()>& stop) {
+    // use a double type to perform the summation
+    using P = typename util::same_extent<T, double>::type;
+
+    f = glm::max(f, dvec3(1.0));
+    const size3_t dstDims{glm::max(size3_t{1}, size3_t{dvec3{srcDims} / f})};
+    auto dstVol = std::make_shared<VolumeRAMPrecision<T>>(dstDims);
+    auto dst = dstVol->getDataTyped();
+
+    const auto cx = contributions(srcDims.x, dstDims.x, f.x, filter);
+    const auto cy = contributions(srcDims.y, dstDims.y, f.y, filter);
+    const auto cz = contributions(srcDims.z, dstDims.z, f.z, filter);
+    const bool max = filter == util::SubsampleFilter::Max;
+
+    const util::IndexMapper2D srcIndex(size2_t{srcDims});
+    const util::IndexMapper2D tmpIndex(size2_t{dstDims});
+    const util::IndexMapper3D dstIndex(dstDims);
+
+    // Memory needed per input slice, for the slice itself and for it filtered in x and y
+    const size_t sliceMemory =
+        srcDims.x * srcDims.y * sizeof(T) + dstDims.x * dstDims.y * sizeof(P);
+    const auto slabEnd = [&](size_t oz) { return cz[oz].first + cz[oz].weights.size(); };
+
+    // Process the output in slabs of slices, only the input slices needed for the slab are loaded
+    for (size_t oz0 = 0, oz1 = 1; oz0 < dstDims.z; oz0 = oz1++) {
+        if (stop && stop()) return nullptr;
+
+        const size_t zBegin = cz[oz0].first;
+        size_t zEnd = slabEnd(oz0);
+        while (oz1 < dstDims.z &&
+               (std::max(zEnd, slabEnd(oz1)) - zBegin) * sliceMemory <= slabMemory) {
+            zEnd = std::max(zEnd, slabEnd(oz1++));
+        }
+
+        const auto slab = source(zBegin, zEnd);
+        const auto src = static_cast<const T*>(slab.get());
+
+        // Filter each input slice in x and y
+        std::vector<P> tmp(dstDims.x * dstDims.y * (zEnd - zBegin));
+        util::forEachRangeParallel(
+            zEnd - zBegin,
+            [&](size_t begin, size_t end) {
+                std::vector<P> rows(dstDims.x * srcDims.y);
+                for (size_t z = begin; z < end; ++z) {
+                    const auto slice = src + z * srcDims.x * srcDims.y;
+                    for (size_t y = 0; y < srcDims.y; ++y) {
+                        for (size_t x = 0; x < dstDims.x; ++x) {
+                            rows[y * dstDims.x + x] = apply<P>(cx[x], max, [&](size_t i) {
+                                return static_cast<P>(slice[srcIndex(i, y)]);
+                            });
                         }
+                    }
+                    const auto tmpSlice = tmp.data() + z * dstDims.x * dstDims.y;
+                    for (size_t y = 0; y < dstDims.y; ++y) {
+                        for (size_t x = 0; x < dstDims.x; ++x) {
+                            tmpSlice[tmpIndex(x, y)] = apply<P>(cy[y], max, [&](size_t j) {
+                                return rows[j * dstDims.x + x];
+                            });
+                        }
+                    }
+                }
+            },
+            1);
 
-#include <warn/push>
-#include <warn/ignore/conversion>
-                        dst[n(x, y, z)] = static_cast<ValueType>(val * samplesInv);
-#include <warn/pop>
+        // Filter in z into the output, split over the output rows
+        util::forEachRangeParallel(
+            (oz1 - oz0) * dstDims.y,
+            [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; ++row) {
+                    const size_t z = oz0 + row / dstDims.y;
+                    const size_t y = row % dstDims.y;
+                    for (size_t x = 0; x < dstDims.x; ++x) {
+                        dst[dstIndex(x, y, z)] = toValue<T>(apply<P>(cz[z], max, [&](size_t k) {
+                            return tmp[(k - zBegin) * dstDims.x * dstDims.y + tmpIndex(x, y)];
+                        }));
                     }
                 }
-            }
+            },
+            16);
+
+        if (progress) progress(static_cast<float>(oz1) / static_cast<float>(dstDims.z));
+    }
+
+    return dstVol;
+}
+
+struct SubsampleDispatcher {
+    template <typename Result, typename Format>
+    Result operator()(const util::VolumeSliceSource& source, size3_t dims, dvec3 f,
+                      util::SubsampleFilter filter, size_t slabMemory,
+                      const std::function<void(float)>& progress,
+                      const std::function<bool()>& stop) {
+        return subsample<typename Format::type>(source, dims, f, filter, slabMemory, progress,
+                                                stop);
+    }
+};
+
+util::VolumeSliceSource ramSliceSource(const VolumeRAM* volume) {
+    return [volume](size_t zBegin, size_t) -> std::shared_ptr<const void> {
+        const auto dims = volume->getDimensions();
+        const auto data = static_cast<const char*>(volume->getData()) +
+                          zBegin * dims.x * dims.y * volume->getDataFormat()->getSize();
+        // Not owning, the data is kept alive by the volume
+        return std::shared_ptr<const void>(data, [](const void*) {});
+    };
+}
+
+}  // namespace
+
+util::VolumeSliceSource util::volumeSliceSource(const Volume& volume) {
+    if (!volume.hasRepresentation<VolumeRAM>() && volume.hasRepresentation<VolumeDisk>()) {
+        if (auto raw = dynamic_cast<const RawVolumeRAMLoader*>(
+                volume.getRepresentation<VolumeDisk>()->getLoader())) {
+            std::shared_ptr<const RawVolumeRAMLoader> loader{raw->clone()};
+            return [loader](size_t zBegin, size_t zEnd) -> std::shared_ptr<const void> {
+                auto slab = loader->readSlices(zBegin, zEnd);
+                return std::shared_ptr<const void>(slab, slab->getData());
+            };
+        }
+        if (auto bricked = dynamic_cast<const BrickedVolumeRAMLoader*>(
+                volume.getRepresentation<VolumeDisk>()->getLoader())) {
+            std::shared_ptr<const BrickedVolumeRAMLoader> loader{bricked->clone()};
+            return [loader](size_t zBegin, size_t zEnd) -> std::shared_ptr<const void> {
+                auto slab = loader->readSlices(zBegin, zEnd);
+                return std::shared_ptr<const void>(slab, slab->getData());
+            };
+        }
+    }
+    return ramSliceSource(volume.getRepresentation<VolumeRAM>());
+}
+
+std::shared_ptr<VolumeRAM> util::volumeSubSample(const VolumeRAM* volume, size3_t f) {
+    return volumeSubSample(volume, dvec3{f}, SubsampleFilter::Box);
+}
+
+std::shared_ptr<VolumeRAM> util::volumeSubSample(const VolumeRAM* volume, dvec3 f,
+                                                 SubsampleFilter filter) {
+    auto res = volumeSubSample(ramSliceSource(volume), volume->getDimensions(),
+                               volume->getDataFormat(), f, filter);
+    res->setSwizzleMask(volume->getSwizzleMask());
+    return res;
+}
 
-            return destVol;
-        });
+std::shared_ptr<VolumeRAM> util::volumeSubSample(const VolumeSliceSource& source, size3_t dims,
+                                                 const DataFormatBase* format, dvec3 f,
+                                                 SubsampleFilter filter, size_t slabMemory,
+                                                 std::function<void(float)> progressCallback,
+                                                 std::function<bool()> stopCallback) {
+    return dispatching::dispatch<std::shared_ptr<VolumeRAM>, dispatching::filter::All>(
+        format->getId(), SubsampleDispatcher{}, source, dims, f, filter, slabMemory,
+        progressCallback, stopCallback);
 }
 
 }  // namespace inviwo
@@ -0,0 +1,161 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/datastructures/volumesequenceresidency.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+namespace inviwo {
+
+VolumeSequenceResidency::VolumeSequenceResidency(size_t maxResident, size_t prefetch)
+    : maxResident_(std::max<size_t>(1, maxResident)), prefetch_(prefetch) {}
+
+VolumeSequenceResidency::~VolumeSequenceResidency() { collectFinished(true); }
+
+void VolumeSequenceResidency::setSequence(std::shared_ptr<const VolumeSequence> sequence) {
+    if (sequence == sequence_) return;
+    collectFinished(true);
+    resident_.clear();
+    previous_.reset();
+    forward_ = true;
+    sequence_ = std::move(sequence);
+}
+
+void VolumeSequenceResidency::setMaxResident(size_t maxResident) {
+    maxResident_ = std::max<size_t>(1, maxResident);
+    evict();
+}
+
+size_t VolumeSequenceResidency::getMaxResident() const { return maxResident_; }
+
+void VolumeSequenceResidency::setPrefetch(size_t prefetch) { prefetch_ = prefetch; }
+
+size_t VolumeSequenceResidency::getPrefetch() const { return prefetch_; }
+
+void VolumeSequenceResidency::select(size_t index) {
+    if (!sequence_ || sequence_->empty()) return;
+    const size_t size = sequence_->size();
+    index = std::min(index, size - 1);
+
+    if (previous_ && *previous_ != index) {
+        const size_t stepsForward = (index + size - *previous_) % size;
+        const size_t stepsBackward = (*previous_ + size - index) % size;
+        forward_ = stepsForward <= stepsBackward;
+    }
+    previous_ = index;
+
+    collectFinished(false);
+
+    const size_t count = std::min({prefetch_, size - 1, maxResident_ - 1});
+    // Touch the furthest step first such that the nearest ones are evicted last
+    for (size_t i = count; i > 0; --i) {
+        const size_t next = forward_ ? (index + i) % size : (index + size - i) % size;
+        touch(next);
+        load(next);
+    }
+    touch(index);
+    evict();
+}
+
+const std::list<size_t>& VolumeSequenceResidency::getResident() const { return resident_; }
+
+void VolumeSequenceResidency::touch(size_t index) {
+    auto it = std::find(resident_.begin(), resident_.end(), index);
+    if (it != resident_.end()) {
+        resident_.splice(resident_.begin(), resident_, it);
+    } else {
+        resident_.push_front(index);
+    }
+}
+
+void VolumeSequenceResidency::load(size_t index) {
+    if (pending_.count(index) != 0) return;
+    auto volume = (*sequence_)[index];
+    if (!volume || volume->hasRepresentation<VolumeRAM>()) return;
+
+    if (InviwoApplication::isInitialized() && InviwoApplication::getPtr()->getPoolSize() > 0) {
+        pending_.emplace(index,
+                         dispatchPool([volume]() { volume->getRepresentation<VolumeRAM>(); }));
+    } else {
+        volume->getRepresentation<VolumeRAM>();
+    }
+}
+
+void VolumeSequenceResidency::evict() {
+    // Walk from the least recently used time step towards the selected one, which is always kept,
+    // skipping time steps that are loading or can not be evicted right now. Those stay resident
+    // and are tried again on the next call.
+    auto it = resident_.end();
+    while (resident_.size() > maxResident_ && it != std::next(resident_.begin())) {
+        --it;
+        if (pending_.count(*it) == 0 && unload(*it)) it = resident_.erase(it);
+    }
+}
+
+bool VolumeSequenceResidency::unload(size_t index) {
+    if (!sequence_ || index >= sequence_->size()) return true;
+    const auto& volume = (*sequence_)[index];
+    if (!volume) return true;
+    // Without a disk representation the data could not be loaded again
+    if (!volume->hasRepresentation<VolumeDisk>()) return false;
+    // Volumes referenced outside of the sequence, i.e. by a sampler holding on to the
+    // representation, are kept
+    if (volume.use_count() > 1) return false;
+    try {
+        // Throws if the disk representation is out of date, then the volume is kept as is
+        const auto disk = volume->getRepresentation<VolumeDisk>();
+        volume->removeOtherRepresentations(disk);
+        return true;
+    } catch (const Exception&) {
+        return false;
+    }
+}
+
+void VolumeSequenceResidency::collectFinished(bool wait) {
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (wait || it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            try {
+                it->second.get();
+            } catch (const Exception& e) {
+                LogWarn("Failed to prefetch time step " << it->first + 1 << ": "
+                                                        << e.getMessage());
+            }
+            it = pending_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+}  // namespace inviwo
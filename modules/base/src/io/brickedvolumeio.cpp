@@ -0,0 +1,449 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/io/brickedvolumeio.h>
+
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/foreach.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+#include <zlib.h>
+
+namespace inviwo {
+
+namespace {
+
+constexpr std::array<char, 8> magic = {'I', 'V', 'W', 'B', 'R', 'I', 'C', 'K'};
+constexpr std::uint32_t version = 2;
+constexpr std::uint32_t zlibCompression = 1;
+constexpr std::uint32_t maxFormatLength = 64;
+
+// magic, version, format, compression, byte order, dimensions, brick size, brick count
+std::uint64_t headerSize(const std::string& format) {
+    return 8 + 4 + 4 + format.size() + 4 + 4 + 3 * 8 + 3 * 8 + 8;
+}
+
+bool isLittleEndianHost() {
+    const std::uint16_t one = 1;
+    unsigned char first = 0;
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+// All header fields are stored in little endian byte order, independent of the host
+template <typename T>
+void encode(T value, char* dest) {
+    static_assert(std::is_unsigned<T>::value, "only unsigned integers are supported");
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        dest[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+}
+
+template <typename T>
+T decode(const char* src) {
+    static_assert(std::is_unsigned<T>::value, "only unsigned integers are supported");
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<T>(static_cast<unsigned char>(src[i])) << (8 * i);
+    }
+    return value;
+}
+
+template <typename T>
+void write(std::ostream& os, T value) {
+    std::array<char, sizeof(T)> bytes;
+    encode(value, bytes.data());
+    os.write(bytes.data(), bytes.size());
+}
+
+void write(std::ostream& os, const std::vector<std::uint64_t>& values) {
+    std::vector<char> bytes(values.size() * sizeof(std::uint64_t));
+    for (size_t i = 0; i < values.size(); ++i) {
+        encode(values[i], bytes.data() + i * sizeof(std::uint64_t));
+    }
+    os.write(bytes.data(), bytes.size());
+}
+
+void readBytes(std::istream& is, char* dest, size_t size, const std::string& fileName) {
+    is.read(dest, size);
+    if (!is) {
+        throw DataReaderException("Unexpected end of brick file header: " + fileName,
+                                  IVW_CONTEXT_CUSTOM("BrickedVolumeRAMLoader"));
+    }
+}
+
+template <typename T>
+T read(std::istream& is, const std::string& fileName) {
+    std::array<char, sizeof(T)> bytes;
+    readBytes(is, bytes.data(), bytes.size(), fileName);
+    return decode<T>(bytes.data());
+}
+
+/**
+ * Reverse the bytes of each component of the elements in data
+ */
+void swapBytes(char* data, size_t size, size_t componentSize) {
+    if (componentSize < 2) return;
+    for (size_t i = 0; i + componentSize <= size; i += componentSize) {
+        std::reverse(data + i, data + i + componentSize);
+    }
+}
+
+size3_t brickCounts(size3_t dims, size3_t brickSize) {
+    return (dims + brickSize - size3_t{1}) / brickSize;
+}
+
+size_t voxels(size3_t dims) { return dims.x * dims.y * dims.z; }
+
+/**
+ * Returns the zlib compressed brick, or the raw brick if compression failed or did not reduce
+ * the size. A stored brick is thereby compressed if and only if it is smaller than the raw brick.
+ */
+std::vector<char> compressBrick(std::vector<char>& raw, int level) {
+    uLongf compressedSize = compressBound(static_cast<uLong>(raw.size()));
+    std::vector<char> compressed(compressedSize);
+    if (compress2(reinterpret_cast<Bytef*>(compressed.data()), &compressedSize,
+                  reinterpret_cast<const Bytef*>(raw.data()), static_cast<uLong>(raw.size()),
+                  level) != Z_OK ||
+        compressedSize >= raw.size()) {
+        return std::move(raw);
+    }
+    compressed.resize(compressedSize);
+    return compressed;
+}
+
+}  // namespace
+
+BrickedVolumeRAMLoader::BrickedVolumeRAMLoader(const std::string& brickFile)
+    : brickFile_(brickFile)
+    , dimensions_{0}
+    , brickSize_{0}
+    , format_{nullptr}
+    , littleEndian_{true} {
+
+    auto file = filesystem::ifstream(brickFile_, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        throw DataReaderException("Error could not open brick file: " + brickFile_, IVW_CONTEXT);
+    }
+    file.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<std::uint64_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+
+    std::array<char, 8> fileMagic;
+    readBytes(file, fileMagic.data(), fileMagic.size(), brickFile_);
+    if (fileMagic != magic) {
+        throw DataReaderException("Not a brick file: " + brickFile_, IVW_CONTEXT);
+    }
+    const auto fileVersion = read<std::uint32_t>(file, brickFile_);
+    if (fileVersion != version) {
+        throw DataReaderException("Unsupported brick file version " +
+                                      std::to_string(fileVersion) + " in " + brickFile_,
+                                  IVW_CONTEXT);
+    }
+    const auto formatLength = read<std::uint32_t>(file, brickFile_);
+    if (formatLength == 0 || formatLength > maxFormatLength) {
+        throw DataReaderException("Invalid data format in brick file: " + brickFile_,
+                                  IVW_CONTEXT);
+    }
+    std::string formatName(formatLength, ' ');
+    readBytes(file, &formatName[0], formatLength, brickFile_);
+    try {
+        format_ = DataFormatBase::get(formatName);
+    } catch (const DataFormatException&) {
+        format_ = nullptr;
+    }
+    if (!format_ || format_->getId() == DataFormatId::NotSpecialized) {
+        throw DataReaderException(
+            "Unsupported data format '" + formatName + "' in brick file: " + brickFile_,
+            IVW_CONTEXT);
+    }
+    if (read<std::uint32_t>(file, brickFile_) != zlibCompression) {
+        throw DataReaderException("Unsupported compression in brick file: " + brickFile_,
+                                  IVW_CONTEXT);
+    }
+    littleEndian_ = read<std::uint32_t>(file, brickFile_) != 0;
+    for (size_t i = 0; i < 3; ++i) {
+        dimensions_[i] = static_cast<size_t>(read<std::uint64_t>(file, brickFile_));
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        brickSize_[i] = static_cast<size_t>(read<std::uint64_t>(file, brickFile_));
+        if (brickSize_[i] == 0) {
+            throw DataReaderException("Invalid brick size in brick file: " + brickFile_,
+                                      IVW_CONTEXT);
+        }
+    }
+    const auto brickCount = read<std::uint64_t>(file, brickFile_);
+    const auto fixedSize = headerSize(formatName);
+    if (brickCount != voxels(brickCounts(dimensions_, brickSize_)) ||
+        fixedSize + (brickCount + 1) * sizeof(std::uint64_t) > fileSize) {
+        throw DataReaderException("Invalid brick count in brick file: " + brickFile_,
+                                  IVW_CONTEXT);
+    }
+
+    std::vector<char> indexBytes((brickCount + 1) * sizeof(std::uint64_t));
+    readBytes(file, indexBytes.data(), indexBytes.size(), brickFile_);
+    auto index = std::make_shared<std::vector<std::uint64_t>>(brickCount + 1);
+    for (size_t i = 0; i < index->size(); ++i) {
+        (*index)[i] = decode<std::uint64_t>(indexBytes.data() + i * sizeof(std::uint64_t));
+    }
+    const std::uint64_t dataOffset = fixedSize + indexBytes.size();
+    if (index->front() != dataOffset || index->back() > fileSize ||
+        !std::is_sorted(index->begin(), index->end())) {
+        throw DataReaderException("Invalid brick index in brick file: " + brickFile_,
+                                  IVW_CONTEXT);
+    }
+    index_ = std::move(index);
+}
+
+BrickedVolumeRAMLoader* BrickedVolumeRAMLoader::clone() const {
+    return new BrickedVolumeRAMLoader(*this);
+}
+
+std::shared_ptr<VolumeRepresentation> BrickedVolumeRAMLoader::createRepresentation() const {
+    return readRegion(size3_t{0}, dimensions_);
+}
+
+void BrickedVolumeRAMLoader::updateRepresentation(
+    std::shared_ptr<VolumeRepresentation> dest) const {
+    auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+
+    if (dimensions_ != volumeDst->getDimensions()) {
+        throw Exception("Mismatching volume dimensions, can't update", IVW_CONTEXT);
+    }
+    readInto(*volumeDst, size3_t{0});
+}
+
+std::shared_ptr<VolumeRAM> BrickedVolumeRAMLoader::readRegion(size3_t offset,
+                                                              size3_t dims) const {
+    if (glm::any(glm::greaterThan(offset + dims, dimensions_))) {
+        throw Exception("Region [" + toString(offset) + ", " + toString(offset + dims) +
+                            ") outside of volume of dimensions " + toString(dimensions_),
+                        IVW_CONTEXT);
+    }
+    auto volumeDst = createVolumeRAM(dims, format_);
+    readInto(*volumeDst, offset);
+    return volumeDst;
+}
+
+std::shared_ptr<VolumeRAM> BrickedVolumeRAMLoader::readSlices(size_t zBegin, size_t zEnd) const {
+    if (zBegin > zEnd || zEnd > dimensions_.z) {
+        throw Exception("Slice range [" + toString(zBegin) + ", " + toString(zEnd) +
+                            ") outside of volume with " + toString(dimensions_.z) + " slices",
+                        IVW_CONTEXT);
+    }
+    return readRegion(size3_t{0, 0, zBegin},
+                      size3_t{dimensions_.x, dimensions_.y, zEnd - zBegin});
+}
+
+size3_t BrickedVolumeRAMLoader::getDimensions() const { return dimensions_; }
+
+size3_t BrickedVolumeRAMLoader::getBrickSize() const { return brickSize_; }
+
+const DataFormatBase* BrickedVolumeRAMLoader::getDataFormat() const { return format_; }
+
+bool BrickedVolumeRAMLoader::isLittleEndian() const { return littleEndian_; }
+
+void BrickedVolumeRAMLoader::readInto(VolumeRAM& dest, size3_t offset) const {
+    const auto dims = dest.getDimensions();
+    if (voxels(dims) == 0) return;
+
+    const auto bricks = brickCounts(dimensions_, brickSize_);
+    const auto first = offset / brickSize_;
+    const auto last = (offset + dims - size3_t{1}) / brickSize_;
+    std::vector<size3_t> needed;
+    needed.reserve(voxels(last - first + size3_t{1}));
+    for (size_t z = first.z; z <= last.z; ++z) {
+        for (size_t y = first.y; y <= last.y; ++y) {
+            for (size_t x = first.x; x <= last.x; ++x) needed.emplace_back(x, y, z);
+        }
+    }
+
+    const auto elemSize = format_->getSize();
+    const auto componentSize = elemSize / format_->getComponents();
+    const bool swap = littleEndian_ != isLittleEndianHost();
+    const auto dst = static_cast<char*>(dest.getData());
+    const auto& index = *index_;
+
+    // Each brick covers a distinct part of the destination, hence no synchronization is needed
+    util::forEachRangeParallel(
+        needed.size(),
+        [&](size_t begin, size_t end) {
+            auto file = filesystem::ifstream(brickFile_, std::ios::in | std::ios::binary);
+            if (!file.is_open()) {
+                throw DataReaderException("Error could not open brick file: " + brickFile_,
+                                          IVW_CONTEXT);
+            }
+            std::vector<char> stored;
+            std::vector<char> raw;
+            for (size_t i = begin; i < end; ++i) {
+                const auto brick = needed[i];
+                const auto brickIndex = brick.x + bricks.x * (brick.y + bricks.y * brick.z);
+                const auto pos = brick * brickSize_;
+                const auto extent = glm::min(brickSize_, dimensions_ - pos);
+                const auto rawSize = voxels(extent) * elemSize;
+                const auto storedSize =
+                    static_cast<size_t>(index[brickIndex + 1] - index[brickIndex]);
+                if (storedSize > rawSize) {
+                    throw DataReaderException("Invalid size of brick " + toString(brick) +
+                                                  " in brick file: " + brickFile_,
+                                              IVW_CONTEXT);
+                }
+
+                stored.resize(storedSize);
+                file.seekg(index[brickIndex]);
+                file.read(stored.data(), storedSize);
+                if (!file) {
+                    throw DataReaderException("Error reading brick " + toString(brick) +
+                                                  " from brick file: " + brickFile_,
+                                              IVW_CONTEXT);
+                }
+
+                char* src = stored.data();
+                if (storedSize < rawSize) {
+                    raw.resize(rawSize);
+                    uLongf rawLength = static_cast<uLongf>(rawSize);
+                    if (uncompress(reinterpret_cast<Bytef*>(raw.data()), &rawLength,
+                                   reinterpret_cast<const Bytef*>(stored.data()),
+                                   static_cast<uLong>(storedSize)) != Z_OK ||
+                        rawLength != rawSize) {
+                        throw DataReaderException("Error decompressing brick " +
+                                                      toString(brick) +
+                                                      " from brick file: " + brickFile_,
+                                                  IVW_CONTEXT);
+                    }
+                    src = raw.data();
+                }
+                if (swap) swapBytes(src, rawSize, componentSize);
+
+                // copy the part of the brick that intersects the region, row by row
+                const auto lo = glm::max(pos, offset);
+                const auto hi = glm::min(pos + extent, offset + dims);
+                const auto rowSize = (hi.x - lo.x) * elemSize;
+                for (size_t z = lo.z; z < hi.z; ++z) {
+                    for (size_t y = lo.y; y < hi.y; ++y) {
+                        const auto d = ((z - offset.z) * dims.y + (y - offset.y)) * dims.x +
+                                       (lo.x - offset.x);
+                        const auto s =
+                            ((z - pos.z) * extent.y + (y - pos.y)) * extent.x + (lo.x - pos.x);
+                        std::memcpy(dst + d * elemSize, src + s * elemSize, rowSize);
+                    }
+                }
+            }
+        },
+        1);
+}
+
+void util::writeBrickedVolume(const VolumeRAM& volume, const std::string& filePath,
+                              size3_t brickSize, int compressionLevel) {
+    if (glm::any(glm::equal(brickSize, size3_t{0}))) {
+        throw Exception("Invalid brick size " + toString(brickSize),
+                        IVW_CONTEXT_CUSTOM("util::writeBrickedVolume"));
+    }
+    if (compressionLevel < -1 || compressionLevel > 9) {
+        throw Exception("Invalid compression level " + toString(compressionLevel),
+                        IVW_CONTEXT_CUSTOM("util::writeBrickedVolume"));
+    }
+
+    const auto dims = volume.getDimensions();
+    const auto format = volume.getDataFormat();
+    const auto elemSize = format->getSize();
+    const auto bricks = brickCounts(dims, brickSize);
+    const auto brickCount = voxels(bricks);
+
+    auto file = filesystem::ofstream(filePath, std::ios::out | std::ios::binary);
+    if (!file.is_open()) {
+        throw FileException("Could not open file \"" + filePath + "\" for writing",
+                            IVW_CONTEXT_CUSTOM("util::writeBrickedVolume"));
+    }
+
+    const std::string formatName = format->getString();
+    file.write(magic.data(), magic.size());
+    write(file, version);
+    write(file, static_cast<std::uint32_t>(formatName.size()));
+    file.write(formatName.data(), formatName.size());
+    write(file, zlibCompression);
+    write(file, static_cast<std::uint32_t>(isLittleEndianHost() ? 1 : 0));
+    for (size_t i = 0; i < 3; ++i) write(file, static_cast<std::uint64_t>(dims[i]));
+    for (size_t i = 0; i < 3; ++i) write(file, static_cast<std::uint64_t>(brickSize[i]));
+    write(file, static_cast<std::uint64_t>(brickCount));
+
+    // The index is written once all brick sizes are known
+    std::vector<std::uint64_t> index(brickCount + 1, 0);
+    write(file, index);
+    const auto fixedSize = headerSize(formatName);
+    index[0] = fixedSize + index.size() * sizeof(std::uint64_t);
+
+    const auto src = static_cast<const char*>(volume.getData());
+    const auto layerSize = bricks.x * bricks.y;
+    std::vector<std::vector<char>> stored(layerSize);
+    for (size_t bz = 0; bz < bricks.z; ++bz) {
+        util::forEachRangeParallel(
+            layerSize,
+            [&](size_t begin, size_t end) {
+                std::vector<char> raw;
+                for (size_t i = begin; i < end; ++i) {
+                    const auto pos = size3_t{i % bricks.x, i / bricks.x, bz} * brickSize;
+                    const auto extent = glm::min(brickSize, dims - pos);
+                    const auto rowSize = extent.x * elemSize;
+                    raw.resize(voxels(extent) * elemSize);
+                    for (size_t z = 0; z < extent.z; ++z) {
+                        for (size_t y = 0; y < extent.y; ++y) {
+                            const auto s = ((pos.z + z) * dims.y + pos.y + y) * dims.x + pos.x;
+                            std::memcpy(raw.data() + (z * extent.y + y) * rowSize,
+                                        src + s * elemSize, rowSize);
+                        }
+                    }
+                    stored[i] = compressBrick(raw, compressionLevel);
+                }
+            },
+            1);
+
+        for (size_t i = 0; i < layerSize; ++i) {
+            const auto brickIndex = bz * layerSize + i;
+            file.write(stored[i].data(), stored[i].size());
+            index[brickIndex + 1] = index[brickIndex] + stored[i].size();
+            stored[i] = std::vector<char>{};
+        }
+    }
+
+    file.seekp(fixedSize);
+    write(file, index);
+    if (!file) {
+        throw FileException("Error writing to file \"" + filePath + "\"",
+                            IVW_CONTEXT_CUSTOM("util::writeBrickedVolume"));
+    }
+}
+
+}  // namespace inviwo
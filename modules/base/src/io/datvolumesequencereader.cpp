@@ -307,8 +307,12 @@ std::shared_ptr<DatVolumeSequenceReader::VolumeSequence> DatVolumeSequenceReader
         for (size_t t = 0; t < sequences; ++t) {
             if (t == 0)
                 volumes->push_back(std::move(volume));
-            else
+            else {
+                // Only keep the disk representation, the representations of the first time step
+                // may already have been loaded to compute the data range
                 volumes->push_back(std::shared_ptr<Volume>(volumes->front()->clone()));
+                volumes->back()->clearRepresentations();
+            }
             auto diskRepr = std::make_shared<VolumeDisk>(fileName, dimensions_, format_);
             filePos_ = t * bytes;
 
@@ -28,6 +28,7 @@
  *********************************************************************************/
 
 #include <modules/base/io/ivfvolumereader.h>
+#include <modules/base/io/brickedvolumeio.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/datastructures/volume/volumedisk.h>
 #include <inviwo/core/util/filesystem.h>
@@ -45,6 +46,7 @@ IvfVolumeReader::IvfVolumeReader()
     , dimensions_(size3_t(0))
     , format_(nullptr) {
     addExtension(FileExtension("ivf", "Inviwo ivf file format"));
+    addExtension(FileExtension("ivfb", "Inviwo ivf file format, compressed bricks"));
 }
 
 IvfVolumeReader* IvfVolumeReader::clone() const { return new IvfVolumeReader(*this); }
@@ -80,11 +82,30 @@ std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
 
     volume->getMetaDataMap()->deserialize(d);
     littleEndian_ = volume->getMetaData<BoolMetaData>("LittleEndian", littleEndian_);
+    size3_t brickSize{0};
+    d.deserialize("BrickSize", brickSize);
+
     auto vd = std::make_shared<VolumeDisk>(filePath, dimensions_, format_);
 
-    auto loader = std::make_unique<RawVolumeRAMLoader>(rawFile_, filePos_, dimensions_,
-                                                       littleEndian_, format_);
-    vd->setLoader(loader.release());
+    if (glm::any(glm::greaterThan(brickSize, size3_t{0}))) {
+        auto loader = std::make_unique<BrickedVolumeRAMLoader>(rawFile_);
+        if (loader->getDataFormat() != format_) {
+            throw DataReaderException("Error brick file " + rawFile_ + " has format " +
+                                          loader->getDataFormat()->getString() + " but " +
+                                          filePath + " has format " + formatFlag,
+                                      IVW_CONTEXT);
+        }
+        if (loader->getDimensions() != dimensions_) {
+            throw DataReaderException("Error brick file " + rawFile_ +
+                                          " does not match the dimensions of: " + filePath,
+                                      IVW_CONTEXT);
+        }
+        vd->setLoader(loader.release());
+    } else {
+        auto loader = std::make_unique<RawVolumeRAMLoader>(rawFile_, filePos_, dimensions_,
+                                                           littleEndian_, format_);
+        vd->setLoader(loader.release());
+    }
 
     volume->addRepresentation(vd);
     return volume;
@@ -28,20 +28,34 @@
  *********************************************************************************/
 
 #include <modules/base/io/ivfvolumewriter.h>
+#include <modules/base/io/brickedvolumeio.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/io/datawriterexception.h>
 
 namespace inviwo {
 
-IvfVolumeWriter::IvfVolumeWriter() : DataWriterType<Volume>() {
+IvfVolumeWriter::IvfVolumeWriter()
+    : DataWriterType<Volume>(), brickSize_{0}, compressionLevel_{-1} {
     addExtension(FileExtension("ivf", "Inviwo ivf file format"));
 }
 
-IvfVolumeWriter::IvfVolumeWriter(const IvfVolumeWriter& rhs) : DataWriterType<Volume>(rhs) {}
+IvfVolumeWriter::IvfVolumeWriter(size3_t brickSize, int compressionLevel)
+    : DataWriterType<Volume>(), brickSize_{brickSize}, compressionLevel_{compressionLevel} {
+    addExtension(FileExtension("ivfb", "Inviwo ivf file format, compressed bricks"));
+}
+
+IvfVolumeWriter::IvfVolumeWriter(const IvfVolumeWriter& rhs)
+    : DataWriterType<Volume>(rhs)
+    , brickSize_{rhs.brickSize_}
+    , compressionLevel_{rhs.compressionLevel_} {}
 
 IvfVolumeWriter& IvfVolumeWriter::operator=(const IvfVolumeWriter& that) {
-    if (this != &that) DataWriterType<Volume>::operator=(that);
+    if (this != &that) {
+        DataWriterType<Volume>::operator=(that);
+        brickSize_ = that.brickSize_;
+        compressionLevel_ = that.compressionLevel_;
+    }
 
     return *this;
 }
@@ -49,7 +63,9 @@ IvfVolumeWriter& IvfVolumeWriter::operator=(const IvfVolumeWriter& that) {
 IvfVolumeWriter* IvfVolumeWriter::clone() const { return new IvfVolumeWriter(*this); }
 
 void IvfVolumeWriter::writeData(const Volume* volume, const std::string filePath) const {
-    std::string rawPath = filesystem::replaceFileExtension(filePath, "raw");
+    const bool bricked = glm::all(glm::greaterThan(brickSize_, size3_t{0}));
+    const std::string dataExt = bricked ? "ivb" : "raw";
+    std::string rawPath = filesystem::replaceFileExtension(filePath, dataExt);
 
     if (filesystem::fileExists(filePath) && !overwrite_)
         throw DataWriterException("Error: Output file: " + filePath + " already exists",
@@ -62,7 +78,7 @@ void IvfVolumeWriter::writeData(const Volume* volume, const std::string filePath
     std::string fileName = filesystem::getFileNameWithoutExtension(filePath);
     const VolumeRAM* vr = volume->getRepresentation<VolumeRAM>();
     Serializer s(filePath);
-    s.serialize("RawFile", fileName + ".raw");
+    s.serialize("RawFile", fileName + "." + dataExt);
     s.serialize("Format", vr->getDataFormatString());
     s.serialize("BasisAndOffset", volume->getModelMatrix());
     s.serialize("WorldTransform", volume->getWorldMatrix());
@@ -70,9 +86,16 @@ void IvfVolumeWriter::writeData(const Volume* volume, const std::string filePath
     s.serialize("DataRange", volume->dataMap_.dataRange);
     s.serialize("ValueRange", volume->dataMap_.valueRange);
     s.serialize("Unit", volume->dataMap_.valueUnit);
+    if (bricked) s.serialize("BrickSize", brickSize_);
 
     volume->getMetaDataMap()->serialize(s);
     s.writeFile();
+
+    if (bricked) {
+        util::writeBrickedVolume(*vr, rawPath, brickSize_, compressionLevel_);
+        return;
+    }
+
     std::fstream fout(rawPath.c_str(), std::ios::out | std::ios::binary);
 
     if (fout.good()) {
@@ -85,4 +108,14 @@ void IvfVolumeWriter::writeData(const Volume* volume, const std::string filePath
     fout.close();
 }
 
+void IvfVolumeWriter::setBrickSize(size3_t brickSize) { brickSize_ = brickSize; }
+
+size3_t IvfVolumeWriter::getBrickSize() const { return brickSize_; }
+
+void IvfVolumeWriter::setCompressionLevel(int compressionLevel) {
+    compressionLevel_ = compressionLevel;
+}
+
+int IvfVolumeWriter::getCompressionLevel() const { return compressionLevel_; }
+
 }  // namespace inviwo
@@ -44,7 +44,7 @@ const ProcessorInfo DistanceTransformRAM::processorInfo_{
 const ProcessorInfo DistanceTransformRAM::getProcessorInfo() const { return processorInfo_; }
 
 DistanceTransformRAM::DistanceTransformRAM()
-    : Processor()
+    : PoolProcessor()
     , volumePort_("inputVolume")
     , outport_("outputVolume")
     , threshold_("threshold", "Threshold", 0.5, 0.0, 1.0)
@@ -65,8 +65,7 @@ DistanceTransformRAM::DistanceTransformRAM()
                        std::numeric_limits<double>::max(), 0.01, 0.0,
                        InvalidationLevel::InvalidOutput, PropertySemantics::Text)
     , btnForceUpdate_("forceUpdate", "Update Distance Map")
-    , distTransformDirty_(true)
-    , hasNewData_(false) {
+    , distTransformDirty_(true) {
 
     addPort(volumePort_);
     addPort(outport_);
@@ -103,110 +102,84 @@ DistanceTransformRAM::DistanceTransformRAM()
     addProperty(btnForceUpdate_);
 
     btnForceUpdate_.onChange([this]() { distTransformDirty_ = true; });
-
-    progressBar_.hide();
 }
 
 DistanceTransformRAM::~DistanceTransformRAM() = default;
 
-void DistanceTransformRAM::invalidate(InvalidationLevel invalidationLevel, Property* source) {
-    notifyObserversInvalidationBegin(this);
-    PropertyOwner::invalidate(invalidationLevel, source);
-    if (!isValid() && hasNewData_) {
-        for (auto& port : getOutports()) port->invalidate(InvalidationLevel::InvalidOutput);
-    }
-    notifyObserversInvalidationEnd(this);
-}
-
 void DistanceTransformRAM::process() {
-    if (util::is_future_ready(newVolume_)) {
-        try {
-            auto vol = newVolume_.get();
-            dataRangeOutput_.set(vol->dataMap_.dataRange);
-            outport_.setData(vol);
-            hasNewData_ = false;
-            btnForceUpdate_.setDisplayName("Update Distance Map");
-        } catch (Exception&) {
-            // Need to reset the future, VS bug:
-            // http://stackoverflow.com/questions/33899615/stdfuture-still-valid-after-calling-get-which-throws-an-exception
-            newVolume_ = {};
-            outport_.setData(nullptr);
-            hasNewData_ = false;
-            throw;
-        }
-    } else if (!newVolume_.valid()) {  // We are not waiting for a calculation
+    if (volumePort_.isChanged() || distTransformDirty_) {
+        updateOutport();
+    } else {
         btnForceUpdate_.setDisplayName("Update Distance Map (dirty)");
-        if (volumePort_.isChanged() || distTransformDirty_) {
-            updateOutport();
-        }
     }
 }
 
 void DistanceTransformRAM::updateOutport() {
-    auto done = [this]() {
-        dispatchFront([this]() {
-            distTransformDirty_ = false;
-            hasNewData_ = true;
-            invalidate(InvalidationLevel::InvalidOutput);
-        });
-    };
-
-    auto calc = [pb = &progressBar_,
-                 upsample = uniformUpsampling_.get() ? size3_t(upsampleFactorUniform_.get())
-                                                     : upsampleFactorVec3_.get(),
-                 threshold = threshold_.get(), normalize = normalize_.get(), flip = flip_.get(),
-                 square = resultSquaredDist_.get(), scale = resultDistScale_.get(),
-                 dataRangeMode = dataRangeMode_.get(), customDataRange = customDataRange_.get(),
-                 done](std::shared_ptr<const Volume> volume) -> std::shared_ptr<const Volume> {
-        auto volDim = glm::max(volume->getDimensions(), size3_t(1u));
-        auto dstRepr = std::make_shared<VolumeRAMPrecision<float>>(upsample * volDim);
-
-        const auto progress = [pb](double f) {
-            dispatchFront([f, pb]() {
-                f < 1.0 ? pb->show() : pb->hide();
-                pb->updateProgress(static_cast<float>(f));
-            });
-        };
-        util::volumeDistanceTransform(volume.get(), dstRepr.get(), upsample, threshold, normalize,
-                                      flip, square, scale, progress);
-
-        auto dstVol = std::make_shared<Volume>(dstRepr);
-        // pass meta data on
-        dstVol->setModelMatrix(volume->getModelMatrix());
-        dstVol->setWorldMatrix(volume->getWorldMatrix());
-        dstVol->copyMetaDataFrom(*volume);
-
-        switch (dataRangeMode) {
-            case DistanceTransformRAM::DataRangeMode::Diagonal: {
-                const auto basis = volume->getBasis();
-                const auto diagonal = basis[0] + basis[1] + basis[2];
-                const auto maxDist = square ? glm::length2(diagonal) : glm::length(diagonal);
-                dstVol->dataMap_.dataRange = dvec2(0.0, maxDist);
-                dstVol->dataMap_.valueRange = dvec2(0.0, maxDist);
-                break;
+    distTransformDirty_ = false;
+    btnForceUpdate_.setDisplayName("Update Distance Map");
+
+    const auto upsample = uniformUpsampling_.get() ? size3_t(upsampleFactorUniform_.get())
+                                                   : upsampleFactorVec3_.get();
+
+    const auto calc = [volume = volumePort_.getData(), threshold = threshold_.get(),
+                       normalize = normalize_.get(), flip = flip_.get(),
+                       square = resultSquaredDist_.get(), scale = resultDistScale_.get(),
+                       dataRangeMode = dataRangeMode_.get(),
+                       customDataRange = customDataRange_.get()](size3_t upsample) {
+        return [=](pool::Stop stop, pool::Progress progress) -> std::shared_ptr<const Volume> {
+            auto volDim = glm::max(volume->getDimensions(), size3_t(1u));
+            auto dstRepr = std::make_shared<VolumeRAMPrecision<float>>(upsample * volDim);
+
+            util::volumeDistanceTransform(
+                volume.get(), dstRepr.get(), upsample, threshold, normalize, flip, square, scale,
+                [progress](double f) { progress(static_cast<float>(f)); });
+            if (stop()) return nullptr;
+
+            auto dstVol = std::make_shared<Volume>(dstRepr);
+            // pass meta data on
+            dstVol->setModelMatrix(volume->getModelMatrix());
+            dstVol->setWorldMatrix(volume->getWorldMatrix());
+            dstVol->copyMetaDataFrom(*volume);
+
+            switch (dataRangeMode) {
+                case DistanceTransformRAM::DataRangeMode::Diagonal: {
+                    const auto basis = volume->getBasis();
+                    const auto diagonal = basis[0] + basis[1] + basis[2];
+                    const auto maxDist = square ? glm::length2(diagonal) : glm::length(diagonal);
+                    dstVol->dataMap_.dataRange = dvec2(0.0, maxDist);
+                    dstVol->dataMap_.valueRange = dvec2(0.0, maxDist);
+                    break;
+                }
+                case DistanceTransformRAM::DataRangeMode::MinMax: {
+                    auto minmax = util::dataMinMax(dstRepr->getDataTyped(),
+                                                   glm::compMul(dstRepr->getDimensions()));
+
+                    dstVol->dataMap_.dataRange = dvec2(minmax.first[0], minmax.second[0]);
+                    dstVol->dataMap_.valueRange = dvec2(minmax.first[0], minmax.second[0]);
+                    break;
+                }
+                case DistanceTransformRAM::DataRangeMode::Custom: {
+                    dstVol->dataMap_.dataRange = customDataRange;
+                    dstVol->dataMap_.valueRange = customDataRange;
+                    break;
+                }
+                default:
+                    break;
             }
-            case DistanceTransformRAM::DataRangeMode::MinMax: {
-                auto minmax = util::dataMinMax(dstRepr->getDataTyped(),
-                                               glm::compMul(dstRepr->getDimensions()));
 
-                dstVol->dataMap_.dataRange = dvec2(minmax.first[0], minmax.second[0]);
-                dstVol->dataMap_.valueRange = dvec2(minmax.first[0], minmax.second[0]);
-                break;
-            }
-            case DistanceTransformRAM::DataRangeMode::Custom: {
-                dstVol->dataMap_.dataRange = customDataRange;
-                dstVol->dataMap_.valueRange = customDataRange;
-                break;
-            }
-            default:
-                break;
-        }
-
-        done();
-        return dstVol;
+            return dstVol;
+        };
     };
 
-    newVolume_ = dispatchPool(calc, volumePort_.getData());
+    // Up sampling multiplies the cost, show a preview at the input resolution in the meantime
+    std::vector<decltype(calc(upsample))> jobs;
+    if (upsample != size3_t(1)) jobs.push_back(calc(size3_t(1)));
+    jobs.push_back(calc(upsample));
+
+    dispatchProgressive(std::move(jobs), [this](std::shared_ptr<const Volume> volume) {
+        dataRangeOutput_.set(volume->dataMap_.dataRange);
+        outport_.setData(volume);
+    });
 }
 
 }  // namespace inviwo
@@ -39,6 +39,7 @@
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/io/datareaderfactory.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/foreach.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/vectoroperations.h>
 #include <inviwo/core/util/zip.h>
@@ -46,6 +47,7 @@
 #include <inviwo/core/io/datareaderexception.h>
 
 #include <algorithm>
+#include <map>
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
@@ -206,54 +208,69 @@ std::shared_ptr<Volume> ImageStackVolumeSource::load() {
                 std::fill(volData + s * sliceOffset, volData + (s + 1) * sliceOffset, ValueType{0});
             };
 
-            const auto read = [&](const auto& file, auto reader) -> std::shared_ptr<Layer> {
-                try {
+            // Decode the slices concurrently, each job writes directly into its slices of the
+            // volume. Readers are not thread safe so every job uses its own copies, and a job
+            // only has one file open at a time. Warnings are collected and logged afterwards
+            // since logging is not thread safe.
+            std::vector<std::string> warnings(slices.size());
+            const auto loadSlices = [&](size_t begin, size_t end) {
+                std::map<const DataReaderType<Layer>*, std::unique_ptr<DataReaderType<Layer>>>
+                    readers;
+                const auto read = [&](const std::string& file, const DataReaderType<Layer>* proto) {
+                    auto& reader = readers[proto];
+                    if (!reader) reader.reset(proto->clone());
                     return reader->readData(file);
-                } catch (DataReaderException const& e) {
-                    LogProcessorWarn(
-                        fmt::format("Could not load image: {}, {}", file, e.getMessage()));
-                    return nullptr;
+                };
+
+                for (size_t slice = begin; slice < end; ++slice) {
+                    const auto& file = slices[slice].first;
+                    const auto proto = slices[slice].second;
+                    if (!proto) {
+                        fill(slice);
+                        continue;
+                    }
+
+                    std::shared_ptr<Layer> layer;
+                    try {
+                        layer = read(file, proto);
+                    } catch (DataReaderException const& e) {
+                        warnings[slice] =
+                            fmt::format("Could not load image: {}, {}", file, e.getMessage());
+                        fill(slice);
+                        continue;
+                    }
+                    const auto layerRAM = layer->template getRepresentation<LayerRAM>();
+
+                    const auto format = layerRAM->getDataFormat();
+                    if ((format->getNumericType() != NumericType::Float) &&
+                        (format->getPrecision() > 32)) {
+                        warnings[slice] =
+                            fmt::format("Unsupported integer bit depth: {}, for image: {}",
+                                        format->getPrecision(), file);
+                        fill(slice);
+                        continue;
+                    }
+
+                    if (layerRAM->getDimensions() != layerDims) {
+                        warnings[slice] =
+                            fmt::format("Unexpected dimensions: {} , expected: {}, for image: {}",
+                                        layer->getDimensions(), layerDims, file);
+                        fill(slice);
+                        continue;
+                    }
+                    layerRAM->template dispatch<void, FloatOrIntMax32>([&](auto layerpr) {
+                        const auto data = layerpr->getDataTyped();
+                        std::transform(data, data + sliceOffset, volData + slice * sliceOffset,
+                                       [](auto value) {
+                                           return util::glm_convert_normalized<ValueType>(value);
+                                       });
+                    });
                 }
             };
+            util::forEachRangeParallel(slices.size(), loadSlices, 1);
 
-            for (auto&& elem : util::enumerate(slices)) {
-                const auto slice = elem.first();
-                const auto file = elem.second().first;
-                const auto reader = elem.second().second;
-                if (!reader) {
-                    fill(slice);
-                    continue;
-                }
-
-                const auto layer = read(file, reader);
-                if (!layer) {
-                    fill(slice);
-                    continue;
-                }
-                const auto layerRAM = layer->template getRepresentation<LayerRAM>();
-
-                const auto format = layerRAM->getDataFormat();
-                if ((format->getNumericType() != NumericType::Float) &&
-                    (format->getPrecision() > 32)) {
-                    LogProcessorWarn(fmt::format("Unsupported integer bit depth: {}, for image: {}",
-                                                 format->getPrecision(), file));
-                    fill(slice);
-                    continue;
-                }
-
-                if (layerRAM->getDimensions() != layerDims) {
-                    LogProcessorWarn(
-                        fmt::format("Unexpected dimensions: {} , expected: {}, for image: {}",
-                                    layer->getDimensions(), layerDims, file));
-                    fill(slice);
-                    continue;
-                }
-                layerRAM->template dispatch<void, FloatOrIntMax32>([&](auto layerpr) {
-                    const auto data = layerpr->getDataTyped();
-                    std::transform(
-                        data, data + sliceOffset, volData + slice * sliceOffset,
-                        [](auto value) { return util::glm_convert_normalized<ValueType>(value); });
-                });
+            for (const auto& warning : warnings) {
+                if (!warning.empty()) LogProcessorWarn(warning);
             }
 
             auto volume = std::make_shared<Volume>(volumeRAM);
@@ -171,27 +171,29 @@ void MeshMapping::process() {
         auto srcBuffer =
             inputMesh->getBuffer(buffer_.getSelectedIndex())->getRepresentation<BufferRAM>();
 
-        // fill color vector
-        std::vector<vec4> colorsOut(srcBuffer->getSize());
+        // map the values to TF positions and fill the color vector
+        std::vector<double> positions(srcBuffer->getSize());
 
         srcBuffer->dispatch<void>(
             [comp = component_.getSelectedIndex(),
              range = useCustomDataRange_.get() ? customDataRange_.get() : dataRange_.get(),
-             dst = &colorsOut, tf = &tf_.get()](auto pBuffer) {
+             dst = &positions](auto pBuffer) {
                 auto& vec = pBuffer->getDataContainer();
                 std::transform(vec.begin(), vec.end(), dst->begin(), [&](auto& v) {
                     auto value = util::glmcomp(v, comp);
-                    double pos = (static_cast<double>(value) - range.x) / (range.y - range.x);
-                    return tf->sample(pos);
+                    return (static_cast<double>(value) - range.x) / (range.y - range.x);
                 });
             });
 
+        std::vector<vec4> colorsOut;
+        tf_.get().sample(positions, colorsOut);
+
         // create a new mesh containing all buffers of the input mesh
         // The first color buffer, if existing, is replaced with the mapped colors.
         // Otherwise, a new color buffer will be added.
 
-        auto colBuffer =
-            std::make_shared<Buffer<vec4>>(std::make_shared<BufferRAMPrecision<vec4>>(colorsOut));
+        auto colBuffer = std::make_shared<Buffer<vec4>>(
+            std::make_shared<BufferRAMPrecision<vec4>>(std::move(colorsOut)));
 
         auto mesh = inputMesh->clone();
         // look for suitable color buffer
@@ -33,7 +33,6 @@
 #include <modules/base/algorithm/volume/marchingtetrahedron.h>
 #include <modules/base/algorithm/volume/marchingcubes.h>
 #include <modules/base/algorithm/volume/marchingcubesopt.h>
-#include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <numeric>
 
@@ -52,7 +51,7 @@ const ProcessorInfo SurfaceExtraction::getProcessorInfo() const { return process
 // extraction when volume change or iso change)
 
 SurfaceExtraction::SurfaceExtraction()
-    : Processor()
+    : PoolProcessor()
     , volume_("volume")
     , outport_("mesh")
     , method_("method", "Method",
@@ -63,8 +62,7 @@ SurfaceExtraction::SurfaceExtraction()
     , isoValue_("iso", "ISO Value", 0.5f, 0.0f, 1.0f, 0.01f)
     , invertIso_("invert", "Invert ISO", false)
     , encloseSurface_("enclose", "Enclose Surface", true)
-    , colors_("meshColors", "Mesh Colors")
-    , dirty_(false) {
+    , colors_("meshColors", "Mesh Colors") {
 
     addPort(volume_);
     addPort(outport_);
@@ -75,8 +73,6 @@ SurfaceExtraction::SurfaceExtraction()
     addProperty(encloseSurface_);
     addProperty(colors_);
 
-    getProgressBar().hide();
-
     volume_.onChange([this]() {
         updateColors();
         if (volume_.hasData()) {
@@ -98,84 +94,83 @@ SurfaceExtraction::SurfaceExtraction()
 SurfaceExtraction::~SurfaceExtraction() {}
 
 void SurfaceExtraction::process() {
-    if (!meshes_) {
-        meshes_ = std::make_shared<std::vector<std::shared_ptr<Mesh>>>();
-    }
-
     auto data = volume_.getSourceVectorData();
     auto changed = volume_.getChangedOutports();
-    result_.resize(data.size());
-    meshes_->resize(data.size());
+    const bool removed = surfaces_.size() > data.size();
+    surfaces_.resize(data.size());
 
+    // The surfaces that have to be extracted again, with their index
+    std::vector<std::pair<size_t, Surface>> todo;
     for (size_t i = 0; i < data.size(); ++i) {
-        auto vol = data[i].second;
-
-        if (util::is_future_ready(result_[i].result)) {
-            (*meshes_)[i] = result_[i].result.get();
-            result_[i].status = 1.0f;
-            dirty_ = false;
-            auto meshes = std::make_shared<std::vector<std::shared_ptr<Mesh>>>();
-            std::copy_if(meshes_->begin(), meshes_->end(), std::back_inserter(*meshes),
-                         [](const auto& m) { return m != nullptr; });
-            if (!meshes->empty()) {
-                outport_.setData(meshes);
-            } else {
-                outport_.setData(nullptr);
-            }
+        Surface surface{data[i].second,
+                        nullptr,
+                        method_.get(),
+                        isoValue_.get(),
+                        static_cast<FloatVec4Property*>(colors_[i])->get(),
+                        invertIso_.get(),
+                        encloseSurface_.get()};
+        if (util::contains(changed, data[i].first) || !surfaces_[i].isSame(surface)) {
+            // Keep the surface outdated until the new mesh arrives, the job might be superseded
+            surfaces_[i].volume.reset();
+            todo.emplace_back(i, std::move(surface));
         }
+    }
 
-        Method method = method_.get();
-        float iso = isoValue_.get();
-        vec4 color = static_cast<FloatVec4Property*>(colors_[i])->get();
-        bool invert = invertIso_.get();
-        bool enclose = encloseSurface_.get();
-        if (!result_[i].result.valid() &&
-            (util::contains(changed, data[i].first) ||
-             !result_[i].isSame(method, iso, color, invert, enclose))) {
-            result_[i].set(method, iso, color, invert, enclose, 0.0f,
-                           dispatchPool([this, vol, method, iso, color, invert, enclose,
-                                         i]() -> std::shared_ptr<Mesh> {
-                               auto progressCallBack = [this, i](float s) {
-                                   this->result_[i].status = s;
-                                   float status = 0;
-                                   for (const auto& e : this->result_) status += e.status;
-                                   status /= result_.size();
-                                   dispatchFront(
-                                       [status](ProgressBar& pb) {
-                                           pb.updateProgress(status);
-                                           if (status < 1.0f)
-                                               pb.show();
-                                           else
-                                               pb.hide();
-                                       },
-                                       std::ref(this->getProgressBar()));
-                               };
+    if (todo.empty()) {
+        if (removed) {
+            updateOutport();
+            newResults();
+        }
+        return;
+    }
 
-                               std::shared_ptr<Mesh> m;
-                               switch (method) {
-                                   case Method::MarchingCubes:
-                                       m = util::marchingcubes(vol, iso, color, invert, enclose,
-                                                               progressCallBack);
-                                       break;
-                                   case Method::MarchingCubesOpt:
-                                       m = util::marchingCubesOpt(vol, iso, color, invert, enclose,
-                                                                  progressCallBack);
-                                       break;
-                                   case Method::MarchingTetrahedron:
-                                   default:
-                                       m = util::marchingtetrahedron(vol, iso, color, invert,
-                                                                     enclose, progressCallBack);
-                                       break;
-                               }
+    dispatchOne(
+        [todo](pool::Stop stop, pool::Progress progress) mutable {
+            for (size_t k = 0; k < todo.size() && !stop(); ++k) {
+                todo[k].second.mesh = extract(
+                    todo[k].second,
+                    [&](float f) {
+                        progress((static_cast<float>(k) + f) / static_cast<float>(todo.size()));
+                    },
+                    stop);
+            }
+            return todo;
+        },
+        [this](std::vector<std::pair<size_t, Surface>> result) {
+            for (auto& item : result) {
+                if (item.first < surfaces_.size()) surfaces_[item.first] = std::move(item.second);
+            }
+            updateOutport();
+        });
+}
 
-                               dispatchFront([this]() {
-                                   dirty_ = true;
-                                   invalidate(InvalidationLevel::InvalidOutput);
-                               });
+void SurfaceExtraction::updateOutport() {
+    auto meshes = std::make_shared<std::vector<std::shared_ptr<Mesh>>>();
+    for (const auto& surface : surfaces_) {
+        if (surface.mesh) meshes->push_back(surface.mesh);
+    }
+    if (!meshes->empty()) {
+        outport_.setData(meshes);
+    } else {
+        outport_.setData(nullptr);
+    }
+}
 
-                               return m;
-                           }));
-        }
+std::shared_ptr<Mesh> SurfaceExtraction::extract(const Surface& s,
+                                                 std::function<void(float)> progressCallback,
+                                                 std::function<bool()> stopCallback) {
+    switch (s.method) {
+        case Method::MarchingCubes:
+            return util::marchingcubes(
+                s.volume, s.iso, s.color, s.invert, s.enclose, progressCallback,
+                [](const size3_t&) { return true; }, stopCallback);
+        case Method::MarchingCubesOpt:
+            return util::marchingCubesOpt(s.volume, s.iso, s.color, s.invert, s.enclose,
+                                          progressCallback, nullptr, stopCallback);
+        case Method::MarchingTetrahedron:
+        default:
+            return util::marchingtetrahedron(s.volume, s.iso, s.color, s.invert, s.enclose,
+                                             progressCallback);
     }
 }
 
@@ -217,53 +212,9 @@ void SurfaceExtraction::updateColors() {
 }
 #include <warn/pop>
 
-// This will stop the invalidation of the network unless the dirty flag is set.
-void SurfaceExtraction::invalidate(InvalidationLevel invalidationLevel,
-                                   Property* modifiedProperty) {
-    notifyObserversInvalidationBegin(this);
-    PropertyOwner::invalidate(invalidationLevel, modifiedProperty);
-
-    if (dirty_ || volume_.isChanged()) outport_.invalidate(InvalidationLevel::InvalidOutput);
-
-    notifyObserversInvalidationEnd(this);
-}
-
-SurfaceExtraction::task::task(task&& rhs)
-    : result(std::move(rhs.result))
-    , method(rhs.method)
-    , iso(rhs.iso)
-    , color(std::move(rhs.color))
-    , invert(rhs.invert)
-    , enclose(rhs.enclose)
-    , status(rhs.status) {}
-
-bool SurfaceExtraction::task::isSame(Method m, float i, vec4 c, bool inv, bool enc) const {
-    return method == m && iso == i && color == c && inv == invert && enc == enclose;
-}
-
-void SurfaceExtraction::task::set(Method m, float i, vec4 c, bool inv, bool enc, float s,
-                                  std::future<std::shared_ptr<Mesh>>&& r) {
-    method = m;
-    iso = i;
-    color = c;
-    invert = inv;
-    enclose = enc;
-    status = s;
-    result = std::move(r);
-}
-
-SurfaceExtraction::task& SurfaceExtraction::task::operator=(task&& that) {
-    if (this != &that) {
-        result = std::move(that.result);
-        method = that.method;
-        iso = that.iso;
-        invert = that.invert;
-        enclose = that.enclose;
-        color = std::move(that.color);
-        status = that.status;
-    }
-
-    return *this;
+bool SurfaceExtraction::Surface::isSame(const Surface& rhs) const {
+    return volume == rhs.volume && method == rhs.method && iso == rhs.iso &&
+           color == rhs.color && invert == rhs.invert && enclose == rhs.enclose;
 }
 
 }  // namespace inviwo
@@ -28,6 +28,7 @@
  *********************************************************************************/
 
 #include <modules/base/processors/volumeexport.h>
+#include <inviwo/core/util/volumeconversion.h>
 
 namespace inviwo {
 
@@ -40,6 +41,34 @@ const ProcessorInfo VolumeExport::processorInfo_{
 };
 const ProcessorInfo VolumeExport::getProcessorInfo() const { return processorInfo_; }
 
-const Volume* VolumeExport::getData() { return port_.getData().get(); }
+VolumeExport::VolumeExport()
+    : DataExport<Volume, VolumeInport>()
+    , format_{"format",
+              "Format",
+              {{"input", "Same as input", DataFormatId::NotSpecialized},
+               {"uint8", "UInt8", DataFormatId::UInt8},
+               {"uint16", "UInt16", DataFormatId::UInt16},
+               {"int16", "Int16", DataFormatId::Int16},
+               {"float16", "Float16", DataFormatId::Float16},
+               {"float32", "Float32", DataFormatId::Float32},
+               {"float64", "Float64", DataFormatId::Float64}},
+              0} {
+    addProperty(format_);
+}
+
+const Volume* VolumeExport::getData() {
+    converted_.reset();
+    auto volume = port_.getData();
+    if (format_.get() == DataFormatId::NotSpecialized) return volume.get();
+
+    // Keep the number of components of the input, only the scalar type changes
+    const auto scalar = DataFormatBase::get(format_.get());
+    const auto format = DataFormatBase::get(
+        scalar->getNumericType(), volume->getDataFormat()->getComponents(), scalar->getPrecision());
+    if (format == volume->getDataFormat()) return volume.get();
+
+    converted_ = util::convertVolume(*volume, format);
+    return converted_.get();
+}
 
 }  // namespace inviwo
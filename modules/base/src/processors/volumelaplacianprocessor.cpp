@@ -41,7 +41,7 @@ const ProcessorInfo VolumeLaplacianProcessor::processorInfo_{
 const ProcessorInfo VolumeLaplacianProcessor::getProcessorInfo() const { return processorInfo_; }
 
 VolumeLaplacianProcessor::VolumeLaplacianProcessor()
-    : Processor()
+    : PoolProcessor()
     , inport_("inport")
     , outport_("outport")
     , postProcessing_(
@@ -74,28 +74,15 @@ void VolumeLaplacianProcessor::process() {
     auto invol = inport_.getData();
     inVolume_.updateForNewVolume(*invol.get());
 
-    auto calc = [this](std::shared_ptr<const Volume> volume,
-                       util::VolumeLaplacianPostProcessing postProcessing,
-                       double scale) -> std::shared_ptr<Volume> {
-        auto res = util::volumeLaplacian(volume, postProcessing, scale);
-        dispatchFront([this]() { invalidate(InvalidationLevel::InvalidOutput); });
-        return res;
+    auto calc = [invol, postProcessing = postProcessing_.get(), scale = scale_.get()](
+                    pool::Stop, pool::Progress) {
+        return util::volumeLaplacian(invol, postProcessing, scale);
     };
 
-    if (!result_.valid()) {
-        getActivityIndicator().setActive(true);
-        result_ = dispatchPool(calc, invol, postProcessing_.get(), scale_.get());
-    } else if (util::is_future_ready(result_)) {
-        auto outvol = result_.get();
+    dispatchOne(calc, [this](std::shared_ptr<Volume> outvol) {
         outport_.setData(outvol);
         outVolume_.updateForNewVolume(*outvol.get());
-        getActivityIndicator().setActive(false);
-    }
-}
-
-void VolumeLaplacianProcessor::invalidate(InvalidationLevel invalidationLevel,
-                                          Property* modifiedProperty) {
-    Processor::invalidate(invalidationLevel, modifiedProperty);
+    });
 }
 
 }  // namespace inviwo
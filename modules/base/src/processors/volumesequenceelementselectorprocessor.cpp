@@ -42,9 +42,29 @@ const ProcessorInfo VolumeSequenceElementSelectorProcessor::getProcessorInfo() c
     return processorInfo_;
 }
 VolumeSequenceElementSelectorProcessor::VolumeSequenceElementSelectorProcessor()
-    : VectorElementSelectorProcessor<Volume>() {
+    : VectorElementSelectorProcessor<Volume>()
+    , streaming_("streaming", "Streaming", false, InvalidationLevel::InvalidOutput)
+    , maxResident_("maxResident", "Resident Time Steps", 8, 1, 256, 1, InvalidationLevel::Valid)
+    , prefetch_("prefetch", "Prefetch", 4, 0, 64, 1, InvalidationLevel::Valid)
+    , residency_(maxResident_, prefetch_) {
     timeStep_.index_.autoLinkToProperty<VolumeSequenceElementSelectorProcessor>(
         "timeStep.selectedSequenceIndex");
+
+    streaming_.addProperties(maxResident_, prefetch_);
+    addProperty(streaming_);
+    maxResident_.onChange([this]() { residency_.setMaxResident(maxResident_); });
+    prefetch_.onChange([this]() { residency_.setPrefetch(prefetch_); });
+}
+
+void VolumeSequenceElementSelectorProcessor::process() {
+    VectorElementSelectorProcessor<Volume>::process();
+
+    if (streaming_.isChecked() && inport_.hasData()) {
+        residency_.setSequence(inport_.getData());
+        residency_.select(timeStep_.index_.get() - 1);
+    } else {
+        residency_.setSequence(nullptr);
+    }
 }
 
 }  // namespace inviwo
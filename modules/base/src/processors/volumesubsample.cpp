@@ -28,8 +28,6 @@
  *********************************************************************************/
 
 #include <modules/base/processors/volumesubsample.h>
-#include <inviwo/core/common/inviwoapplication.h>
-#include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 
 namespace inviwo {
@@ -44,60 +42,63 @@ const ProcessorInfo VolumeSubsample::processorInfo_{
 const ProcessorInfo VolumeSubsample::getProcessorInfo() const { return processorInfo_; }
 
 VolumeSubsample::VolumeSubsample()
-    : Processor()
+    : PoolProcessor()
     , inport_("inputVolume")
     , outport_("outputVolume")
     , enabled_("enabled", "Enable Operation", true)
     , waitForCompletion_("waitForCompletion", "Wait For Subsample Completion", false)
-    , subSampleFactors_("subSampleFactors", "Factors", ivec3(1), ivec3(1), ivec3(8))
-    , dirty_(false) {
+    , subSampleFactors_("subSampleFactors", "Factors", dvec3(1.0), dvec3(1.0), dvec3(16.0),
+                        dvec3(0.25))
+    , filter_("filter", "Filter",
+              {{"box", "Box", util::SubsampleFilter::Box},
+               {"gaussian", "Gaussian", util::SubsampleFilter::Gaussian},
+               {"lanczos", "Lanczos", util::SubsampleFilter::Lanczos},
+               {"max", "Max", util::SubsampleFilter::Max}},
+              0) {
     addPort(inport_);
     addPort(outport_);
     addProperty(enabled_);
     addProperty(waitForCompletion_);
 
     addProperty(subSampleFactors_);
-
-    waitForCompletion_.onChange([this]() { dirty_ = waitForCompletion_.get(); });
+    addProperty(filter_);
 }
 
 void VolumeSubsample::process() {
-    const size3_t factors =
-        glm::min(static_cast<size3_t>(glm::max(subSampleFactors_.get(), ivec3(1))),
-                 inport_.getData()->getDimensions());
+    const dvec3 factors = glm::min(glm::max(subSampleFactors_.get(), dvec3(1.0)),
+                                   dvec3(inport_.getData()->getDimensions()));
 
-    if (enabled_.get() && factors != size3_t(1, 1, 1)) {
+    if (enabled_.get() && factors != dvec3(1.0)) {
         if (waitForCompletion_.get()) {
-            outport_.setData(subsample(inport_.getData(), factors));
+            stopJobs();
+            outport_.setData(subsample(inport_.getData(), factors, filter_.get()));
+            newResults();
         } else {
-            if (!result_.valid()) {
-                getActivityIndicator().setActive(true);
-                result_ = dispatchPool(
-                    [this](std::shared_ptr<const Volume> volume,
-                           size3_t f) -> std::shared_ptr<Volume> {
-                        auto sample = subsample(volume, f);
-                        dispatchFront([this]() {
-                            dirty_ = true;
-                            invalidate(InvalidationLevel::InvalidOutput);
-                        });
-                        return sample;
-                    },
-                    inport_.getData(), factors);
-            } else if (util::is_future_ready(result_)) {
-                outport_.setData(result_.get());
-                getActivityIndicator().setActive(false);
-                dirty_ = false;
-            }
+            dispatchOne(
+                [volume = inport_.getData(), factors, filter = filter_.get()](
+                    pool::Stop stop, pool::Progress progress) {
+                    return subsample(volume, factors, filter, stop, progress);
+                },
+                [this](std::shared_ptr<Volume> result) { outport_.setData(result); });
         }
     } else {
+        stopJobs();
         outport_.setData(inport_.getData());
+        newResults();
     }
 }
 
-std::shared_ptr<Volume> VolumeSubsample::subsample(std::shared_ptr<const Volume> volume,
-                                                   size3_t f) {
-    auto vol = volume->getRepresentation<VolumeRAM>();
-    auto sample = std::make_shared<Volume>(util::volumeSubSample(vol, f));
+std::shared_ptr<Volume> VolumeSubsample::subsample(std::shared_ptr<const Volume> volume, dvec3 f,
+                                                   util::SubsampleFilter filter, pool::Stop stop,
+                                                   pool::Progress progress) {
+    // Streams the slices from disk if the volume is not loaded yet
+    auto ram = util::volumeSubSample(util::volumeSliceSource(*volume), volume->getDimensions(),
+                                     volume->getDataFormat(), f, filter, util::defaultSlabMemory,
+                                     progress, stop);
+    if (!ram) return nullptr;
+
+    auto sample = std::make_shared<Volume>(ram);
+    sample->setSwizzleMask(volume->getSwizzleMask());
     sample->copyMetaDataFrom(*volume);
     sample->dataMap_ = volume->dataMap_;
     sample->setModelMatrix(volume->getModelMatrix());
@@ -105,15 +106,4 @@ std::shared_ptr<Volume> VolumeSubsample::subsample(std::shared_ptr<const Volume>
     return sample;
 }
 
-void VolumeSubsample::invalidate(InvalidationLevel invalidationLevel, Property* modifiedProperty) {
-    notifyObserversInvalidationBegin(this);
-    PropertyOwner::invalidate(invalidationLevel, modifiedProperty);
-
-    if (dirty_ || inport_.isChanged() || !enabled_.get()) {
-        outport_.invalidate(InvalidationLevel::InvalidOutput);
-    }
-
-    notifyObserversInvalidationEnd(this);
-}
-
 }  // namespace inviwo
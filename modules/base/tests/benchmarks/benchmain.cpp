@@ -32,6 +32,12 @@
 #endif
 
 #include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/common/coremodulesharedlibrary.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/consolelogger.h>
+#include <inviwo/core/util/raiiutils.h>
+#include <modules/base/basemodulesharedlibrary.h>
 #include <modules/base/algorithm/volume/volumegeneration.h>
 
 #include <modules/base/algorithm/volume/marchingcubes.h>
@@ -145,6 +151,21 @@ BENCHMARK(RippleNew)->RangeMultiplier(2)->Range(8, 8 << 5);
 // BENCHMARK(SphereNew)->Arg(5);
 
 int main(int argc, char** argv) {
+    LogCentral::init();
+    util::OnScopeExit deleteLogcentral([]() { LogCentral::deleteInstance(); });
+    auto logger = std::make_shared<ConsoleLogger>();
+    LogCentral::getPtr()->setVerbosity(LogVerbosity::Error);
+    LogCentral::getPtr()->registerLogger(logger);
+
+    // The application provides the thread pool and the processor factory used by the benchmarks
+    InviwoApplication app(argc, argv, "Inviwo-Benchmarks-Base");
+    {
+        std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+        modules.emplace_back(createInviwoCore());
+        modules.emplace_back(createBaseModule());
+        app.registerModules(std::move(modules));
+    }
+    app.processFront();
 
     benchmark::Initialize(&argc, argv);
     benchmark::RunSpecifiedBenchmarks();
@@ -0,0 +1,165 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/io/rawvolumereader.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/filesystem.h>
+#include <modules/base/algorithm/volume/volumegeneration.h>
+#include <modules/base/algorithm/volume/volumeramsubsample.h>
+#include <modules/base/io/ivfvolumereader.h>
+#include <modules/base/io/ivfvolumewriter.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <benchmark/benchmark.h>
+#include <warn/pop>
+
+#include <cstdio>
+
+using namespace inviwo;
+
+namespace {
+
+size3_t cube(const benchmark::State& state) { return size3_t{static_cast<size_t>(state.range(0))}; }
+
+int64_t volumeBytes(const Volume& volume) {
+    return static_cast<int64_t>(glm::compMul(volume.getDimensions()) *
+                                volume.getDataFormat()->getSize());
+}
+
+}  // namespace
+
+static void VolumeSubSample(benchmark::State& state) {
+    const auto volume = util::makeRippleVolume(cube(state));
+    const auto ram = volume->getRepresentation<VolumeRAM>();
+
+    for (auto _ : state) {
+        auto res = util::volumeSubSample(ram, size3_t{2});
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetBytesProcessed(state.iterations() * volumeBytes(*volume));
+}
+
+static void VolumeSubSampleFilter(benchmark::State& state, util::SubsampleFilter filter) {
+    const auto volume = util::makeRippleVolume(cube(state));
+    const auto ram = volume->getRepresentation<VolumeRAM>();
+
+    for (auto _ : state) {
+        auto res = util::volumeSubSample(ram, dvec3{2.5}, filter);
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetBytesProcessed(state.iterations() * volumeBytes(*volume));
+}
+
+/**
+ * Subsampling of a volume on disk, the slices are read in slabs of at most 16MB
+ */
+static void VolumeSubSampleStreaming(benchmark::State& state) {
+    const auto volume = util::makeRippleVolume(cube(state));
+    const auto ram = volume->getRepresentation<VolumeRAM>();
+
+    util::TempFileHandle file("benchmark", ".raw");
+    {
+        auto out = filesystem::ofstream(file.getFileName(), std::ios::out | std::ios::binary);
+        out.write(static_cast<const char*>(ram->getData()), volumeBytes(*volume));
+    }
+
+    RawVolumeReader reader;
+    reader.setParameters(volume->getDataFormat(), ivec3{volume->getDimensions()}, true,
+                         volume->dataMap_);
+    const auto onDisk = reader.readData(file.getFileName());
+
+    for (auto _ : state) {
+        auto res = util::volumeSubSample(util::volumeSliceSource(*onDisk), onDisk->getDimensions(),
+                                         onDisk->getDataFormat(), dvec3{2.0},
+                                         util::SubsampleFilter::Box, size_t{16} << 20);
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetBytesProcessed(state.iterations() * volumeBytes(*volume));
+}
+
+static void RawVolumeLoading(benchmark::State& state) {
+    const auto volume = util::makeRippleVolume(cube(state));
+    const auto ram = volume->getRepresentation<VolumeRAM>();
+
+    util::TempFileHandle file("benchmark", ".raw");
+    {
+        auto out = filesystem::ofstream(file.getFileName(), std::ios::out | std::ios::binary);
+        out.write(static_cast<const char*>(ram->getData()), volumeBytes(*volume));
+    }
+
+    RawVolumeReader reader;
+    reader.setParameters(volume->getDataFormat(), ivec3{volume->getDimensions()}, true,
+                         volume->dataMap_);
+
+    for (auto _ : state) {
+        auto loaded = reader.readData(file.getFileName());
+        benchmark::DoNotOptimize(loaded->getRepresentation<VolumeRAM>()->getData());
+    }
+    state.SetBytesProcessed(state.iterations() * volumeBytes(*volume));
+}
+
+static void IvfVolumeLoading(benchmark::State& state) {
+    const auto volume = util::makeRippleVolume(cube(state));
+
+    util::TempFileHandle file("benchmark", ".ivf");
+    const auto rawFile = filesystem::replaceFileExtension(file.getFileName(), "raw");
+    IvfVolumeWriter writer;
+    writer.setOverwrite(true);
+    writer.writeData(volume.get(), file.getFileName());
+
+    IvfVolumeReader reader;
+    for (auto _ : state) {
+        auto loaded = reader.readData(file.getFileName());
+        benchmark::DoNotOptimize(loaded->getRepresentation<VolumeRAM>()->getData());
+    }
+    state.SetBytesProcessed(state.iterations() * volumeBytes(*volume));
+
+    std::remove(rawFile.c_str());
+}
+
+BENCHMARK(VolumeSubSample)->RangeMultiplier(2)->Range(64, 256)->UseRealTime();
+BENCHMARK_CAPTURE(VolumeSubSampleFilter, Gaussian, util::SubsampleFilter::Gaussian)
+    ->RangeMultiplier(2)
+    ->Range(64, 256)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(VolumeSubSampleFilter, Lanczos, util::SubsampleFilter::Lanczos)
+    ->RangeMultiplier(2)
+    ->Range(64, 256)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(VolumeSubSampleFilter, Max, util::SubsampleFilter::Max)
+    ->RangeMultiplier(2)
+    ->Range(64, 256)
+    ->UseRealTime();
+BENCHMARK(VolumeSubSampleStreaming)->RangeMultiplier(2)->Range(64, 256)->UseRealTime();
+BENCHMARK(RawVolumeLoading)->RangeMultiplier(2)->Range(64, 256);
+BENCHMARK(IvfVolumeLoading)->RangeMultiplier(2)->Range(64, 256);
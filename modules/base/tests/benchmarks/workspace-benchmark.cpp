@@ -0,0 +1,95 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/workspacemanager.h>
+#include <inviwo/core/processors/processorfactory.h>
+#include <inviwo/core/util/filesystem.h>
+#include <modules/base/processors/volumesubsample.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <benchmark/benchmark.h>
+#include <warn/pop>
+
+#include <sstream>
+
+using namespace inviwo;
+
+/**
+ * Deserialization of a workspace with a chain of connected processors, stored in the given format.
+ */
+static void WorkspaceDeserialization(benchmark::State& state, SerializationFormat format) {
+    auto app = InviwoApplication::getPtr();
+    auto network = app->getProcessorNetwork();
+    auto manager = app->getWorkspaceManager();
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto refPath = filesystem::getWorkingDirectory() + "/benchmark.inv";
+    const auto& classIdentifier = VolumeSubsample::processorInfo_.classIdentifier;
+
+    manager->clear();
+    {
+        NetworkLock lock(network);
+        Outport* prev = nullptr;
+        for (size_t i = 0; i < count; ++i) {
+            auto processor =
+                network->addProcessor(app->getProcessorFactory()->create(classIdentifier));
+            if (prev) network->addConnection(prev, processor->getInports().front());
+            prev = processor->getOutports().front();
+        }
+    }
+    std::stringstream ss;
+    manager->save(ss, refPath, StandardExceptionHandler(), WorkspaceSaveMode::Disk, format);
+    const auto workspace = ss.str();
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        manager->clear();
+        std::istringstream is(workspace);
+        state.ResumeTiming();
+
+        manager->load(is, refPath);
+    }
+    manager->clear();
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * workspace.size()));
+    state.counters["Processors"] = static_cast<double>(count);
+}
+
+BENCHMARK_CAPTURE(WorkspaceDeserialization, Xml, SerializationFormat::Xml)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(WorkspaceDeserialization, Binary, SerializationFormat::Binary)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,157 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/filesystem.h>
+#include <modules/base/io/brickedvolumeio.h>
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+
+namespace inviwo {
+
+namespace {
+
+// Noise in the lower half of the volume, which does not compress, and zeros in the upper half
+std::shared_ptr<VolumeRAMPrecision<std::uint16_t>> makeVolume(size3_t dims) {
+    auto volume = std::make_shared<VolumeRAMPrecision<std::uint16_t>>(dims);
+    auto data = volume->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        data[i] = i < glm::compMul(dims) / 2
+                      ? static_cast<std::uint16_t>((i * 2654435761u) >> 7)
+                      : std::uint16_t{0};
+    }
+    return volume;
+}
+
+}  // namespace
+
+TEST(BrickedVolumeIO, roundTrip) {
+    // Not a multiple of the brick size, to get cropped bricks at the borders
+    const size3_t dims{37, 20, 19};
+    const size3_t brickSize{8, 8, 4};
+    auto volume = makeVolume(dims);
+
+    util::TempFileHandle tmpFile("base", ".ivb");
+    util::writeBrickedVolume(*volume, tmpFile.getFileName(), brickSize);
+
+    BrickedVolumeRAMLoader loader(tmpFile.getFileName());
+    EXPECT_EQ(dims, loader.getDimensions());
+    EXPECT_EQ(brickSize, loader.getBrickSize());
+    EXPECT_EQ(volume->getDataFormat(), loader.getDataFormat());
+
+    auto loaded = std::static_pointer_cast<VolumeRAM>(loader.createRepresentation());
+    ASSERT_EQ(dims, loaded->getDimensions());
+    const auto src = volume->getDataTyped();
+    const auto dst = static_cast<const std::uint16_t*>(loaded->getData());
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        ASSERT_EQ(src[i], dst[i]);
+    }
+}
+
+TEST(BrickedVolumeIO, readRegion) {
+    const size3_t dims{37, 20, 19};
+    auto volume = makeVolume(dims);
+
+    util::TempFileHandle tmpFile("base", ".ivb");
+    util::writeBrickedVolume(*volume, tmpFile.getFileName(), size3_t{8}, 1);
+    BrickedVolumeRAMLoader loader(tmpFile.getFileName());
+
+    const size3_t offset{5, 9, 3};
+    const size3_t regionDims{20, 11, 14};
+    auto region = loader.readRegion(offset, regionDims);
+    ASSERT_EQ(regionDims, region->getDimensions());
+
+    const util::IndexMapper3D srcIndex(dims);
+    const util::IndexMapper3D dstIndex(regionDims);
+    const auto src = volume->getDataTyped();
+    const auto dst = static_cast<const std::uint16_t*>(region->getData());
+    for (size_t z = 0; z < regionDims.z; ++z) {
+        for (size_t y = 0; y < regionDims.y; ++y) {
+            for (size_t x = 0; x < regionDims.x; ++x) {
+                ASSERT_EQ(src[srcIndex(offset + size3_t{x, y, z})], dst[dstIndex(x, y, z)]);
+            }
+        }
+    }
+
+    EXPECT_THROW(loader.readRegion(size3_t{30, 0, 0}, size3_t{8, 1, 1}), Exception);
+}
+
+TEST(BrickedVolumeIO, headerByteOrder) {
+    const size3_t dims{10, 9, 8};
+    auto volume = makeVolume(dims);
+
+    util::TempFileHandle tmpFile("base", ".ivb");
+    // Level 0 does not make the bricks smaller, hence they are stored uncompressed
+    util::writeBrickedVolume(*volume, tmpFile.getFileName(), size3_t{4}, 0);
+
+    std::string bytes;
+    {
+        auto file = filesystem::ifstream(tmpFile.getFileName(), std::ios::in | std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    // The header is little endian and holds the format string, after the magic and the version
+    const std::string format = volume->getDataFormat()->getString();
+    ASSERT_LT(16 + format.size() + 8, bytes.size());
+    EXPECT_EQ(std::string("\x02\0\0\0", 4), bytes.substr(8, 4));
+    EXPECT_EQ(static_cast<char>(format.size()), bytes[12]);
+    EXPECT_EQ(std::string(3, '\0'), bytes.substr(13, 3));
+    EXPECT_EQ(format, bytes.substr(16, format.size()));
+
+    // Flip the byte order of the voxel data, which is stored after the compression
+    const auto byteOrder = 16 + format.size() + 4;
+    const bool littleEndian = bytes[byteOrder] != 0;
+    bytes[byteOrder] = littleEndian ? 0 : 1;
+    {
+        auto file = filesystem::ofstream(tmpFile.getFileName(), std::ios::out | std::ios::binary);
+        file.write(bytes.data(), bytes.size());
+    }
+
+    BrickedVolumeRAMLoader loader(tmpFile.getFileName());
+    EXPECT_EQ(!littleEndian, loader.isLittleEndian());
+    EXPECT_EQ(volume->getDataFormat(), loader.getDataFormat());
+    auto loaded = std::static_pointer_cast<VolumeRAM>(loader.createRepresentation());
+    ASSERT_EQ(dims, loaded->getDimensions());
+    const auto src = volume->getDataTyped();
+    const auto dst = static_cast<const std::uint16_t*>(loaded->getData());
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        ASSERT_EQ(static_cast<std::uint16_t>((src[i] >> 8) | (src[i] << 8)), dst[i]);
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,146 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/datastructures/flatkdtree.h>
+
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<vec3> randomPoints(size_t count, unsigned int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<vec3> points(count);
+    for (auto& p : points) p = vec3{dist(gen), dist(gen), dist(gen)};
+    return points;
+}
+
+std::vector<std::pair<float, size_t>> bruteForce(const std::vector<vec3>& points,
+                                                 const vec3& pos) {
+    std::vector<std::pair<float, size_t>> res;
+    for (size_t i = 0; i < points.size(); ++i) {
+        res.emplace_back(glm::distance2(points[i], pos), i);
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+}  // namespace
+
+TEST(FlatKDTreeTests, empty) {
+    Flat3DTree<float> tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.findNearest(vec3{0.0f}), Flat3DTree<float>::npos);
+
+    std::vector<std::pair<float, size_t>> res;
+    tree.findNNearest(vec3{0.0f}, 3, res);
+    EXPECT_TRUE(res.empty());
+}
+
+TEST(FlatKDTreeTests, nearest) {
+    const auto points = randomPoints(1000, 0);
+    const auto queries = randomPoints(100, 1);
+    Flat3DTree<float> tree(points);
+    EXPECT_EQ(tree.size(), points.size());
+
+    for (const auto& q : queries) {
+        const auto expected = bruteForce(points, q);
+        EXPECT_EQ(tree.findNearest(q), expected.front().second);
+    }
+}
+
+TEST(FlatKDTreeTests, nNearest) {
+    const auto points = randomPoints(1000, 2);
+    const auto queries = randomPoints(50, 3);
+    Flat3DTree<float> tree(points);
+
+    const size_t k = 8;
+    const auto batch = tree.findNNearest(queries, k);
+    ASSERT_EQ(batch.indices.size(), queries.size() * k);
+
+    std::vector<std::pair<float, size_t>> res;
+    for (size_t q = 0; q < queries.size(); ++q) {
+        const auto expected = bruteForce(points, queries[q]);
+        tree.findNNearest(queries[q], k, res);
+        ASSERT_EQ(res.size(), k);
+        for (size_t i = 0; i < k; ++i) {
+            EXPECT_EQ(res[i].second, expected[i].second);
+            EXPECT_EQ(batch.indices[q * k + i], expected[i].second);
+        }
+    }
+}
+
+TEST(FlatKDTreeTests, nNearestMoreThanSize) {
+    const auto points = randomPoints(5, 4);
+    Flat3DTree<float> tree(points);
+    const auto batch = tree.findNNearest(std::vector<vec3>{vec3{0.5f}}, 8);
+    for (size_t i = 0; i < 5; ++i) EXPECT_NE(batch.indices[i], Flat3DTree<float>::npos);
+    for (size_t i = 5; i < 8; ++i) EXPECT_EQ(batch.indices[i], Flat3DTree<float>::npos);
+}
+
+TEST(FlatKDTreeTests, closeTo) {
+    const auto points = randomPoints(1000, 5);
+    const auto queries = randomPoints(50, 6);
+    Flat3DTree<float> tree(points);
+
+    const float radius = 0.15f;
+    const auto batch = tree.findCloseTo(queries, radius);
+    ASSERT_EQ(batch.offsets.size(), queries.size() + 1);
+
+    for (size_t q = 0; q < queries.size(); ++q) {
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < points.size(); ++i) {
+            if (glm::distance2(points[i], queries[q]) <= radius * radius) expected.push_back(i);
+        }
+        std::vector<size_t> res(batch.indices.begin() + batch.offsets[q],
+                                batch.indices.begin() + batch.offsets[q + 1]);
+        std::sort(res.begin(), res.end());
+        EXPECT_EQ(res, expected);
+    }
+}
+
+TEST(FlatKDTreeTests, duplicates) {
+    std::vector<vec3> points(100, vec3{0.25f});
+    points.push_back(vec3{0.75f});
+    Flat3DTree<float> tree(points);
+    EXPECT_EQ(tree.findNearest(vec3{1.0f}), 100);
+
+    std::vector<size_t> res;
+    tree.findCloseTo(vec3{0.25f}, 0.01f, res);
+    EXPECT_EQ(res.size(), 100);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,120 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <modules/base/algorithm/mesh/meshplaneclipping.h>
+
+#include "testmeshes.h"
+
+#include <cmath>
+
+namespace inviwo {
+
+namespace {
+
+// Area of the triangles lying in the plane z = 0.5, with the sign of their z normal
+float capArea(const SimpleMesh& mesh) {
+    const auto& pos = mesh.getVertexList()->getRAMRepresentation()->getDataContainer();
+    const auto& ind = mesh.getIndexList()->getRAMRepresentation()->getDataContainer();
+    float area = 0.0f;
+    for (size_t t = 0; t + 2 < ind.size(); t += 3) {
+        const auto a = pos[ind[t]];
+        const auto b = pos[ind[t + 1]];
+        const auto c = pos[ind[t + 2]];
+        if (std::abs(a.z - 0.5f) < 1e-6f && std::abs(b.z - 0.5f) < 1e-6f &&
+            std::abs(c.z - 0.5f) < 1e-6f) {
+            area += 0.5f * glm::cross(b - a, c - a).z;
+        }
+    }
+    return area;
+}
+
+}  // namespace
+
+TEST(MeshPlaneClipping, cubeIsCapped) {
+    std::vector<vec3> positions;
+    std::vector<unsigned int> indices;
+    testutil::makeCube(positions, indices);
+
+    // Keep the lower half of the cube
+    const Plane plane{vec3{0.0f, 0.0f, 0.5f}, vec3{0.0f, 0.0f, -1.0f}};
+    auto mesh = meshutil::clipMeshAgainstPlane(positions, {}, {}, indices,
+                                               ConnectivityType::None, plane);
+
+    const auto& pos = mesh->getVertexList()->getRAMRepresentation()->getDataContainer();
+    const auto& ind = mesh->getIndexList()->getRAMRepresentation()->getDataContainer();
+    ASSERT_EQ(0u, ind.size() % 3);
+    for (auto i : ind) {
+        ASSERT_TRUE(i < pos.size());
+        EXPECT_TRUE(pos[i].z <= 0.5f + 1e-6f);
+    }
+    // The cap closes the unit square, facing out of the remaining part
+    EXPECT_NEAR(1.0f, capArea(*mesh), 1e-5f);
+
+    auto uncapped = meshutil::clipMeshAgainstPlane(positions, {}, {}, indices,
+                                                   ConnectivityType::None, plane, false);
+    EXPECT_NEAR(0.0f, capArea(*uncapped), 1e-6f);
+}
+
+TEST(MeshPlaneClipping, clusterBoundsGiveSameResult) {
+    std::vector<vec3> positions;
+    std::vector<unsigned int> indices;
+    testutil::makeCube(positions, indices);
+    // Many copies of the cube side by side, to get several clusters on both sides of the plane
+    const auto cubeVertices = static_cast<unsigned int>(positions.size());
+    const auto cubeIndices = indices;
+    for (unsigned int copy = 1; copy < 64; ++copy) {
+        for (unsigned int i = 0; i < cubeVertices; ++i) {
+            positions.push_back(positions[i] + vec3{2.0f * copy, 0.0f, 0.0f});
+        }
+        for (auto i : cubeIndices) indices.push_back(i + copy * cubeVertices);
+    }
+
+    const Plane plane{vec3{40.3f, 0.0f, 0.0f}, vec3{-1.0f, 0.0f, 0.0f}};
+    const meshutil::TriangleClusterBounds bounds(positions, indices, ConnectivityType::None, 12);
+    EXPECT_EQ(indices.size() / 3, bounds.getNumberOfTriangles());
+
+    auto plain = meshutil::clipMeshAgainstPlane(positions, {}, {}, indices,
+                                                ConnectivityType::None, plane);
+    auto accelerated = meshutil::clipMeshAgainstPlane(positions, {}, {}, indices,
+                                                      ConnectivityType::None, plane, true, &bounds);
+
+    const auto& a = plain->getIndexList()->getRAMRepresentation()->getDataContainer();
+    const auto& b = accelerated->getIndexList()->getRAMRepresentation()->getDataContainer();
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(plain->getVertexList()->getRAMRepresentation()->getDataContainer(),
+              accelerated->getVertexList()->getRAMRepresentation()->getDataContainer());
+}
+
+}  // namespace inviwo
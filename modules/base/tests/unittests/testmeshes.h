@@ -0,0 +1,81 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_BASE_TESTMESHES_H
+#define IVW_BASE_TESTMESHES_H
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+namespace testutil {
+
+/**
+ * A closed unit cube with shared vertices and outward facing triangles, i.e. 8 positions and 12
+ * triangles.
+ */
+inline void makeCube(std::vector<vec3>& positions, std::vector<std::uint32_t>& indices) {
+    positions.clear();
+    for (unsigned int i = 0; i < 8; ++i) {
+        positions.emplace_back(i & 1 ? 1.0f : 0.0f, i & 2 ? 1.0f : 0.0f, i & 4 ? 1.0f : 0.0f);
+    }
+    indices = {0, 2, 1, 1, 2, 3,  // z = 0
+               4, 5, 6, 5, 7, 6,  // z = 1
+               0, 1, 4, 1, 5, 4,  // y = 0
+               2, 6, 3, 3, 6, 7,  // y = 1
+               0, 4, 2, 2, 4, 6,  // x = 0
+               1, 3, 5, 3, 7, 5};  // x = 1
+}
+
+/**
+ * The cube of makeCube as a mesh with a position buffer and one triangle index buffer
+ */
+inline std::shared_ptr<Mesh> makeCubeMesh() {
+    std::vector<vec3> positions;
+    std::vector<std::uint32_t> indices;
+    makeCube(positions, indices);
+
+    auto mesh = std::make_shared<Mesh>(DrawType::Triangles, ConnectivityType::None);
+    mesh->addBuffer(BufferType::PositionAttrib, util::makeBuffer(std::move(positions)));
+    mesh->addIndicies(Mesh::MeshInfo(DrawType::Triangles, ConnectivityType::None),
+                      util::makeIndexBuffer(std::move(indices)));
+    return mesh;
+}
+
+}  // namespace testutil
+
+}  // namespace inviwo
+
+#endif  // IVW_BASE_TESTMESHES_H
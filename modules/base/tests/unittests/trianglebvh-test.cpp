@@ -0,0 +1,145 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <modules/base/algorithm/mesh/trianglebvh.h>
+
+#include "testmeshes.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace inviwo {
+
+TEST(TriangleBVH, cubeQueries) {
+    auto bvh = meshutil::createTriangleBVH(*testutil::makeCubeMesh(), 1);
+    EXPECT_EQ(size_t{12}, bvh->getTriangles().size());
+
+    auto hit = bvh->raycast(vec3{0.25f, 0.5f, -1.0f}, vec3{0.0f, 0.0f, 1.0f});
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_NEAR(1.0f, hit->t, 1e-6f);
+    EXPECT_LT(hit->triangle, size_t{2});
+    EXPECT_FALSE(bvh->raycast(vec3{2.0f, 2.0f, -1.0f}, vec3{0.0f, 0.0f, 1.0f}).has_value());
+    EXPECT_FALSE(bvh->raycast(vec3{0.5f, 0.5f, -1.0f}, vec3{0.0f, 0.0f, 1.0f}, 0.0f, 0.5f)
+                     .has_value());
+
+    auto closest = bvh->closestPoint(vec3{0.5f, 0.5f, 2.0f});
+    ASSERT_TRUE(closest.has_value());
+    EXPECT_NEAR(1.0f, closest->distance, 1e-6f);
+    EXPECT_NEAR(1.0f, closest->point.z, 1e-6f);
+
+    EXPECT_TRUE(bvh->isInside(vec3{0.5f, 0.5f, 0.5f}));
+    EXPECT_TRUE(bvh->isInside(vec3{0.1f, 0.9f, 0.2f}));
+    EXPECT_FALSE(bvh->isInside(vec3{1.5f, 0.5f, 0.5f}));
+    EXPECT_FALSE(bvh->isInside(vec3{-0.1f, 0.5f, 0.5f}));
+}
+
+TEST(TriangleBVH, matchesBruteForce) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> pos(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+
+    std::vector<vec3> positions;
+    std::vector<uvec3> triangles;
+    for (unsigned int i = 0; i < 2000; ++i) {
+        const vec3 center{pos(rng), pos(rng), pos(rng)};
+        for (int j = 0; j < 3; ++j) {
+            positions.push_back(center + vec3{offset(rng), offset(rng), offset(rng)});
+        }
+        triangles.emplace_back(3 * i, 3 * i + 1, 3 * i + 2);
+    }
+    meshutil::TriangleBVH bvh(positions, triangles);
+
+    // Every triangle is in exactly one leaf, within the bounds of the leaf
+    std::vector<int> seen(triangles.size(), 0);
+    for (const auto& node : bvh.getNodes()) {
+        if (!node.isLeaf()) continue;
+        for (auto i = node.offset; i < node.offset + node.count; ++i) {
+            ++seen[bvh.getTriangleIndices()[i]];
+            for (int k = 0; k < 3; ++k) {
+                const auto& p = positions[bvh.getTriangles()[i][k]];
+                EXPECT_TRUE(glm::all(glm::greaterThanEqual(p, node.min)));
+                EXPECT_TRUE(glm::all(glm::lessThanEqual(p, node.max)));
+            }
+        }
+    }
+    for (auto count : seen) EXPECT_EQ(1, count);
+
+    for (int q = 0; q < 50; ++q) {
+        const vec3 origin{pos(rng), pos(rng), pos(rng)};
+        const auto dir = glm::normalize(vec3{pos(rng), pos(rng), pos(rng)});
+
+        // Brute force using single triangle hierarchies
+        float tBest = std::numeric_limits<float>::max();
+        float dBest = std::numeric_limits<float>::max();
+        for (const auto& tri : triangles) {
+            meshutil::TriangleBVH single({positions[tri.x], positions[tri.y], positions[tri.z]},
+                                         {uvec3{0, 1, 2}});
+            if (auto hit = single.raycast(origin, dir)) tBest = std::min(tBest, hit->t);
+            dBest = std::min(dBest, single.closestPoint(origin)->distance);
+        }
+
+        const auto hit = bvh.raycast(origin, dir);
+        EXPECT_EQ(tBest < std::numeric_limits<float>::max(), hit.has_value());
+        if (hit) {
+            EXPECT_NEAR(tBest, hit->t, 1e-4f);
+            EXPECT_TRUE(bvh.occluded(origin, dir));
+        }
+        EXPECT_NEAR(dBest, bvh.closestPoint(origin)->distance, 1e-4f);
+    }
+}
+
+TEST(TriangleBVH, cacheRebuildsOnChange) {
+    auto mesh = testutil::makeCubeMesh();
+    auto positions = std::static_pointer_cast<Buffer<vec3>>(mesh->getBuffers()[0].second);
+    meshutil::TriangleBVHCache cache;
+
+    auto first = cache.get(mesh);
+    EXPECT_EQ(first, cache.get(mesh));
+
+    // Editing the positions should invalidate the hierarchy
+    for (auto& p : positions->getEditableRAMRepresentation()->getDataContainer()) p += vec3{1.0f};
+    auto second = cache.get(mesh);
+    EXPECT_NE(first, second);
+    EXPECT_NEAR(1.0f, second->getBounds().first.x, 1e-6f);
+    EXPECT_EQ(second, cache.get(mesh));
+
+    std::shared_ptr<Mesh> copy(mesh->clone());
+    EXPECT_NE(second, cache.get(copy));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,120 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <modules/base/algorithm/volume/volumegeneration.h>
+#include <modules/base/algorithm/volume/volumederivatives.h>
+#include <modules/base/algorithm/volume/volumestencil.h>
+
+#include <numeric>
+
+namespace inviwo {
+
+TEST(VolumeStencil, visitsAllVoxels) {
+    const size3_t dims{13, 7, 5};
+    std::vector<int> data(glm::compMul(dims), 0);
+    std::vector<int> visits(data.size(), 0);
+    util::forEachVoxelStencil(
+        data.data(), dims,
+        [&](const size3_t& pos, size_t index, const util::StencilNeighbourhood<int>&) {
+            EXPECT_EQ(index, pos.x + pos.y * dims.x + pos.z * dims.x * dims.y);
+            ++visits[index];
+        },
+        size3_t{4, 3, 2});
+    for (auto v : visits) EXPECT_EQ(v, 1);
+}
+
+TEST(VolumeStencil, neighbourhood) {
+    const size3_t dims{4, 3, 2};
+    std::vector<int> data(glm::compMul(dims));
+    std::iota(data.begin(), data.end(), 0);
+    util::forEachVoxelStencil(
+        data.data(), dims,
+        [&](const size3_t& pos, size_t index, const util::StencilNeighbourhood<int>& n) {
+            const int i = static_cast<int>(index);
+            EXPECT_EQ(n.center, i);
+            EXPECT_EQ(n.xm, pos.x > 0 ? i - 1 : i);
+            EXPECT_EQ(n.xp, pos.x + 1 < dims.x ? i + 1 : i);
+            EXPECT_EQ(n.ym, pos.y > 0 ? i - 4 : i);
+            EXPECT_EQ(n.yp, pos.y + 1 < dims.y ? i + 4 : i);
+            EXPECT_EQ(n.zm, pos.z > 0 ? i - 12 : i);
+            EXPECT_EQ(n.zp, pos.z + 1 < dims.z ? i + 12 : i);
+        },
+        size3_t{3, 2, 1});
+}
+
+TEST(VolumeDerivatives, linearField) {
+    const size3_t dims{8, 6, 5};
+    // Basis chosen such that the voxel spacing is one in all directions
+    const mat3 basis{vec3{7.0f, 0.0f, 0.0f}, vec3{0.0f, 5.0f, 0.0f}, vec3{0.0f, 0.0f, 4.0f}};
+    auto vol = util::generateVolume(dims, basis, [](const size3_t& ind) {
+        return vec3{ind.x + 2.0f * ind.y, 2.0f * ind.y, 3.0f * ind.z - ind.x};
+    });
+
+    auto res = util::volumeDerivatives(
+        *vol, VolumeDerivative::Gradient | VolumeDerivative::Divergence | VolumeDerivative::Curl,
+        0);
+    ASSERT_TRUE(res.gradient);
+    ASSERT_TRUE(res.divergence);
+    ASSERT_TRUE(res.curl);
+
+    const auto size = glm::compMul(dims);
+    auto gradient = static_cast<const vec3*>(res.gradient->getRepresentation<VolumeRAM>()->getData());
+    auto divergence =
+        static_cast<const float*>(res.divergence->getRepresentation<VolumeRAM>()->getData());
+    auto curl = static_cast<const vec3*>(res.curl->getRepresentation<VolumeRAM>()->getData());
+
+    for (size_t i = 0; i < size; ++i) {
+        EXPECT_FLOAT_EQ(gradient[i].x, 1.0f);
+        EXPECT_FLOAT_EQ(gradient[i].y, 2.0f);
+        EXPECT_NEAR(gradient[i].z, 0.0f, 1e-5f);
+        EXPECT_FLOAT_EQ(divergence[i], 6.0f);
+        EXPECT_NEAR(curl[i].x, 0.0f, 1e-5f);
+        EXPECT_FLOAT_EQ(curl[i].y, 1.0f);
+        EXPECT_FLOAT_EQ(curl[i].z, -2.0f);
+    }
+}
+
+TEST(VolumeDerivatives, onlyRequested) {
+    auto vol = util::generateVolume(size3_t{4}, mat3(1.0f),
+                                    [](const size3_t& ind) { return static_cast<float>(ind.x); });
+    auto res = util::volumeDerivatives(*vol, VolumeDerivative::Gradient);
+    EXPECT_TRUE(res.gradient);
+    EXPECT_FALSE(res.divergence);
+    EXPECT_FALSE(res.curl);
+
+    EXPECT_THROW(util::volumeDerivatives(*vol, VolumeDerivative::Curl), Exception);
+}
+
+}  // namespace inviwo
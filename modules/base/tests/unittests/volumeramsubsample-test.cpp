@@ -0,0 +1,128 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <modules/base/algorithm/volume/volumeramsubsample.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<VolumeRAMPrecision<unsigned char>> makeVolume(size3_t dims) {
+    auto volume = std::make_shared<VolumeRAMPrecision<unsigned char>>(dims);
+    auto data = volume->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        data[i] = static_cast<unsigned char>((i * 37) % 251);
+    }
+    return volume;
+}
+
+}  // namespace
+
+TEST(VolumeSubSample, boxAverage) {
+    const size3_t dims{8, 6, 10};
+    const size3_t f{2, 3, 2};
+    const auto volume = makeVolume(dims);
+    const auto src = volume->getDataTyped();
+
+    const auto res = util::volumeSubSample(volume.get(), f);
+    ASSERT_EQ(dims / f, res->getDimensions());
+    const auto dst = static_cast<const unsigned char*>(res->getData());
+
+    const util::IndexMapper3D srcIndex(dims);
+    const util::IndexMapper3D dstIndex(dims / f);
+    for (size_t z = 0; z < dims.z / f.z; ++z) {
+        for (size_t y = 0; y < dims.y / f.y; ++y) {
+            for (size_t x = 0; x < dims.x / f.x; ++x) {
+                double sum = 0.0;
+                for (size_t k = 0; k < f.z; ++k) {
+                    for (size_t j = 0; j < f.y; ++j) {
+                        for (size_t i = 0; i < f.x; ++i) {
+                            sum += src[srcIndex(x * f.x + i, y * f.y + j, z * f.z + k)];
+                        }
+                    }
+                }
+                EXPECT_EQ(std::round(sum / glm::compMul(f)), dst[dstIndex(x, y, z)]);
+            }
+        }
+    }
+}
+
+TEST(VolumeSubSample, constantVolume) {
+    const size3_t dims{9, 7, 11};
+    VolumeRAMPrecision<float> volume(dims);
+    std::fill(volume.getDataTyped(), volume.getDataTyped() + glm::compMul(dims), 3.5f);
+
+    for (auto filter : {util::SubsampleFilter::Box, util::SubsampleFilter::Gaussian,
+                        util::SubsampleFilter::Lanczos, util::SubsampleFilter::Max}) {
+        const auto res = util::volumeSubSample(&volume, dvec3{1.5, 2.5, 1.7}, filter);
+        ASSERT_EQ(size3_t(6, 2, 6), res->getDimensions());
+        const auto dst = static_cast<const float*>(res->getData());
+        for (size_t i = 0; i < glm::compMul(res->getDimensions()); ++i) {
+            EXPECT_NEAR(3.5f, dst[i], 1.0e-5f);
+        }
+    }
+}
+
+TEST(VolumeSubSample, slabsMatchFullVolume) {
+    const size3_t dims{8, 6, 10};
+    const auto volume = makeVolume(dims);
+
+    size_t reads = 0;
+    const util::VolumeSliceSource source = [&](size_t zBegin, size_t) {
+        ++reads;
+        return std::shared_ptr<const void>(volume->getDataTyped() + zBegin * dims.x * dims.y,
+                                           [](const void*) {});
+    };
+
+    for (auto filter : {util::SubsampleFilter::Box, util::SubsampleFilter::Lanczos}) {
+        const auto full = util::volumeSubSample(volume.get(), dvec3{1.5, 2.0, 1.3}, filter);
+        reads = 0;
+        // A budget of one byte forces one slab per output slice
+        const auto slabs = util::volumeSubSample(source, dims, volume->getDataFormat(),
+                                                 dvec3{1.5, 2.0, 1.3}, filter, 1);
+        EXPECT_EQ(full->getDimensions().z, reads);
+
+        const auto a = static_cast<const unsigned char*>(full->getData());
+        const auto b = static_cast<const unsigned char*>(slabs->getData());
+        EXPECT_TRUE(std::equal(a, a + glm::compMul(full->getDimensions()), b));
+    }
+}
+
+}  // namespace inviwo
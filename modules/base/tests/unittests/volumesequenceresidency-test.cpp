@@ -0,0 +1,151 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/datastructures/volumesequenceresidency.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace {
+
+class CountingLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    CountingLoader(size_t& loads) : loads_(loads) {}
+    virtual CountingLoader* clone() const override { return new CountingLoader(*this); }
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation() const override {
+        ++loads_;
+        return std::make_shared<VolumeRAMPrecision<float>>(size3_t(4));
+    }
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation>) const override {
+        ++loads_;
+    }
+
+private:
+    size_t& loads_;
+};
+
+std::shared_ptr<VolumeSequence> createSequence(size_t size, size_t& loads) {
+    auto sequence = std::make_shared<VolumeSequence>();
+    for (size_t i = 0; i < size; ++i) {
+        auto volume = std::make_shared<Volume>(size3_t(4), DataFloat32::get());
+        volume->clearRepresentations();
+        auto disk = std::make_shared<VolumeDisk>(size3_t(4), DataFloat32::get());
+        disk->setLoader(new CountingLoader(loads));
+        volume->addRepresentation(disk);
+        sequence->push_back(volume);
+    }
+    return sequence;
+}
+
+std::vector<size_t> loaded(const VolumeSequence& sequence) {
+    std::vector<size_t> res;
+    for (size_t i = 0; i < sequence.size(); ++i) {
+        if (sequence[i]->hasRepresentation<VolumeRAM>()) res.push_back(i);
+    }
+    return res;
+}
+
+}  // namespace
+
+TEST(VolumeSequenceResidency, PrefetchForward) {
+    size_t loads = 0;
+    auto sequence = createSequence(10, loads);
+    VolumeSequenceResidency residency(4, 2);
+    residency.setSequence(sequence);
+
+    residency.select(0);
+    (*sequence)[0]->getRepresentation<VolumeRAM>();
+    EXPECT_EQ((std::vector<size_t>{0, 1, 2}), loaded(*sequence));
+
+    residency.select(1);
+    EXPECT_EQ((std::vector<size_t>{0, 1, 2, 3}), loaded(*sequence));
+    EXPECT_EQ(4, loads);
+}
+
+TEST(VolumeSequenceResidency, EvictsLeastRecentlyUsed) {
+    size_t loads = 0;
+    auto sequence = createSequence(10, loads);
+    VolumeSequenceResidency residency(3, 1);
+    residency.setSequence(sequence);
+
+    for (size_t i = 0; i < 6; ++i) residency.select(i);
+    EXPECT_EQ((std::vector<size_t>{4, 5, 6}), loaded(*sequence));
+    EXPECT_EQ(3, residency.getResident().size());
+    EXPECT_EQ(5, residency.getResident().front());
+
+    // Evicted volumes fall back to the disk representation and can be loaded again
+    EXPECT_TRUE((*sequence)[0]->hasRepresentation<VolumeDisk>());
+    (*sequence)[0]->getRepresentation<VolumeRAM>();
+    EXPECT_EQ(7, loads);
+}
+
+TEST(VolumeSequenceResidency, KeepsReferencedVolumes) {
+    size_t loads = 0;
+    auto sequence = createSequence(10, loads);
+    VolumeSequenceResidency residency(3, 1);
+    residency.setSequence(sequence);
+
+    auto held = (*sequence)[0];
+    residency.select(0);
+    held->getRepresentation<VolumeRAM>();
+    for (size_t i = 1; i < 6; ++i) residency.select(i);
+
+    // The referenced volume stays resident and the next least recently used ones are evicted
+    EXPECT_EQ((std::vector<size_t>{0, 5, 6}), loaded(*sequence));
+    EXPECT_EQ((std::list<size_t>{5, 6, 0}), residency.getResident());
+
+    // Once the reference is gone it is evicted by the next selection
+    held.reset();
+    residency.select(6);
+    EXPECT_EQ((std::vector<size_t>{5, 6, 7}), loaded(*sequence));
+    EXPECT_EQ((std::list<size_t>{6, 7, 5}), residency.getResident());
+}
+
+TEST(VolumeSequenceResidency, PrefetchBackwardAndWrap) {
+    size_t loads = 0;
+    auto sequence = createSequence(10, loads);
+    VolumeSequenceResidency residency(4, 2);
+    residency.setSequence(sequence);
+
+    residency.select(1);
+    residency.select(0);
+    // Moving backward wraps around to the end of the sequence
+    EXPECT_TRUE((*sequence)[9]->hasRepresentation<VolumeRAM>());
+    EXPECT_TRUE((*sequence)[8]->hasRepresentation<VolumeRAM>());
+}
+
+}  // namespace inviwo
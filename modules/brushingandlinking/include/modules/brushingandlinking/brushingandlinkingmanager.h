@@ -41,9 +41,15 @@ class BrushingAndLinkingProcessor;
 /**
  * \class BrushingAndLinkingManager
  * \brief Manages row filtering, row selection and column selection from multiple sources.
+ *
+ * Indices are stored in compressed BitSets. Listeners can register for the indices added and
+ * removed by each change through onSelectionChange() and onFilteringChange() instead of
+ * comparing the complete sets.
  */
 class IVW_MODULE_BRUSHINGANDLINKING_API BrushingAndLinkingManager {
 public:
+    using DeltaCallback = IndexList::Callback;
+
     BrushingAndLinkingManager(Processor* p,
                               InvalidationLevel validationLevel = InvalidationLevel::InvalidOutput);
     virtual ~BrushingAndLinkingManager();
@@ -64,22 +70,40 @@ public:
 
     bool isColumnSelected(size_t column) const;
 
-    void setSelected(const BrushingAndLinkingInport* src, const std::unordered_set<size_t>& idx);
+    /*
+     * Replace the selection. Use BitSet::range() to select a range of rows.
+     */
+    void setSelected(const BrushingAndLinkingInport* src, const BitSet& indices);
 
-    void setFiltered(const BrushingAndLinkingInport* src, const std::unordered_set<size_t>& idx);
+    /*
+     * Set the rows filtered by \p src, the filtered rows are the union of all sources.
+     */
+    void setFiltered(const BrushingAndLinkingInport* src, const BitSet& indices);
 
-    void setSelectedColumn(const BrushingAndLinkingInport* src,
-                           const std::unordered_set<size_t>& columnIndices);
+    void setSelectedColumn(const BrushingAndLinkingInport* src, const BitSet& columnIndices);
 
-    const std::unordered_set<size_t>& getSelectedIndices() const;
-    const std::unordered_set<size_t>& getFilteredIndices() const;
-    const std::unordered_set<size_t>& getSelectedColumns() const;
+    const BitSet& getSelectedIndices() const;
+    const BitSet& getFilteredIndices() const;
+    const BitSet& getSelectedColumns() const;
+
+    /*
+     * Register a callback that is invoked with the added and removed row indices whenever the
+     * selection changes.
+     */
+    std::shared_ptr<DeltaCallback> onSelectionChange(DeltaCallback callback);
+    /*
+     * Register a callback that is invoked with the added and removed row indices whenever the
+     * set of filtered rows changes.
+     */
+    std::shared_ptr<DeltaCallback> onFilteringChange(DeltaCallback callback);
 
 private:
-    std::unordered_set<size_t> selected_;
-    std::unordered_set<size_t> selectedColumns_;
+    BitSet selected_;
+    BitSet selectedColumns_;
     IndexList filtered_;  // Use IndexList to be able to remove filtered rows on port disconnection
-    std::shared_ptr<std::function<void()>> onFilteringChangeCallback_;
+    std::shared_ptr<DeltaCallback> onFilteringChangeCallback_;
+    Dispatcher<void(const BitSet&, const BitSet&)> onSelectionChange_;
+    Dispatcher<void(const BitSet&, const BitSet&)> onFilteringChange_;
 
     Processor* owner_;  // Non-owning reference
     InvalidationLevel invalidationLevel_;
@@ -88,7 +112,8 @@ private:
 inline bool BrushingAndLinkingManager::isFiltered(size_t idx) const { return filtered_.has(idx); }
 
 inline bool BrushingAndLinkingManager::isSelected(size_t idx) const {
-    return selected_.find(idx) != selected_.end();
+    return idx <= std::numeric_limits<std::uint32_t>::max() &&
+           selected_.contains(static_cast<std::uint32_t>(idx));
 }
 
 }  // namespace inviwo
@@ -0,0 +1,207 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_BITSET_H
+#define IVW_BITSET_H
+
+#include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <bitset>
+#include <cstdint>
+#include <initializer_list>
+#include <unordered_set>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class BitSet
+ * \brief A compressed set of 32-bit indices, i.e. row indices, following the layout of Roaring
+ * bitmaps.
+ *
+ * The index space is split into chunks of 2^16 indices, grouped by the high 16 bits of each
+ * index. Only non-empty chunks are stored, each in the most compact of three containers:
+ *   * __Array__ a sorted list of the low 16 bits, used for sparse chunks (at most 4096 indices)
+ *   * __Bitmap__ a 2^16 bit bitmap, used for dense chunks
+ *   * __Run__ a sorted list of intervals, used for chunks made up of long consecutive ranges
+ *
+ * Membership tests are a binary search among the chunks followed by a constant time (bitmap) or
+ * logarithmic (array, run) lookup within the chunk. Union, intersection and difference are
+ * computed chunk by chunk, mostly as word-wise operations. A range of ten million rows is hence
+ * stored as one run per chunk instead of one entry per row.
+ */
+class IVW_MODULE_BRUSHINGANDLINKING_API BitSet {
+public:
+    BitSet() = default;
+    BitSet(std::initializer_list<std::uint32_t> values);
+    explicit BitSet(const std::vector<std::uint32_t>& values);
+    explicit BitSet(const std::unordered_set<size_t>& values);
+    BitSet(const BitSet&) = default;
+    BitSet(BitSet&&) noexcept = default;
+    BitSet& operator=(const BitSet&) = default;
+    BitSet& operator=(BitSet&&) noexcept = default;
+    ~BitSet() = default;
+
+    /**
+     * Creates a BitSet containing the indices in [begin, end)
+     */
+    static BitSet range(std::uint32_t begin, std::uint32_t end);
+
+    /**
+     * Returns the number of indices in the set
+     */
+    size_t size() const;
+    bool empty() const;
+    bool contains(std::uint32_t index) const;
+
+    void add(std::uint32_t index);
+    /**
+     * Add all indices in [begin, end)
+     */
+    void addRange(std::uint32_t begin, std::uint32_t end);
+    void remove(std::uint32_t index);
+    void clear();
+
+    BitSet& operator|=(const BitSet& rhs);
+    BitSet& operator&=(const BitSet& rhs);
+    /**
+     * Remove all indices in \p rhs
+     */
+    BitSet& operator-=(const BitSet& rhs);
+
+    bool operator==(const BitSet& rhs) const;
+    bool operator!=(const BitSet& rhs) const;
+
+    /**
+     * Call \p callback with each index of the set in increasing order
+     */
+    template <typename Callback>
+    void forEach(Callback callback) const;
+
+    std::vector<std::uint32_t> toVector() const;
+    std::unordered_set<size_t> toUnorderedSet() const;
+
+    /**
+     * Convert each chunk into its most compact representation. Performed automatically by the
+     * range and set operations, but can be worth calling after adding many single indices.
+     */
+    void optimize();
+
+    /**
+     * Returns the approximate memory footprint of the stored indices
+     */
+    size_t getSizeInBytes() const;
+
+private:
+    struct Run {
+        std::uint16_t start;
+        std::uint16_t length;  ///< the run covers [start, start + length]
+        bool operator==(const Run& rhs) const {
+            return start == rhs.start && length == rhs.length;
+        }
+    };
+
+    struct Container {
+        enum class Type : std::uint8_t { Array, Bitmap, Run };
+        static constexpr size_t maxArraySize = 4096;
+        static constexpr size_t numWords = 1024;
+
+        bool contains(std::uint16_t value) const;
+        void add(std::uint16_t value);
+        void remove(std::uint16_t value);
+        void toBitmap();
+        void toArray();
+        void optimize();
+        std::vector<std::uint64_t> bitmapWords() const;
+        bool operator==(const Container& rhs) const;
+
+        template <typename Callback>
+        void forEach(std::uint32_t high, Callback& callback) const;
+
+        Type type = Type::Array;
+        std::uint32_t cardinality = 0;
+        std::vector<std::uint16_t> values;  // Array
+        std::vector<std::uint64_t> words;   // Bitmap
+        std::vector<Run> runs;              // Run
+    };
+
+    Container* find(std::uint16_t key);
+    const Container* find(std::uint16_t key) const;
+    Container& findOrCreate(std::uint16_t key);
+    void removeEmpty();
+
+    static size_t countTrailingZeros(std::uint64_t word);
+
+    std::vector<std::uint16_t> keys_;
+    std::vector<Container> containers_;
+};
+
+IVW_MODULE_BRUSHINGANDLINKING_API BitSet operator|(BitSet lhs, const BitSet& rhs);
+IVW_MODULE_BRUSHINGANDLINKING_API BitSet operator&(BitSet lhs, const BitSet& rhs);
+IVW_MODULE_BRUSHINGANDLINKING_API BitSet operator-(BitSet lhs, const BitSet& rhs);
+
+inline size_t BitSet::countTrailingZeros(std::uint64_t word) {
+    return std::bitset<64>((word & (~word + 1)) - 1).count();
+}
+
+template <typename Callback>
+void BitSet::Container::forEach(std::uint32_t high, Callback& callback) const {
+    switch (type) {
+        case Type::Array:
+            for (auto v : values) callback(high | v);
+            break;
+        case Type::Bitmap:
+            for (size_t i = 0; i < words.size(); ++i) {
+                auto word = words[i];
+                while (word != 0) {
+                    callback(high | static_cast<std::uint32_t>(i * 64 + countTrailingZeros(word)));
+                    word &= word - 1;
+                }
+            }
+            break;
+        case Type::Run:
+            for (const auto& run : runs) {
+                const std::uint32_t end = std::uint32_t{run.start} + run.length;
+                for (std::uint32_t v = run.start; v <= end; ++v) callback(high | v);
+            }
+            break;
+    }
+}
+
+template <typename Callback>
+void BitSet::forEach(Callback callback) const {
+    for (size_t i = 0; i < keys_.size(); ++i) {
+        containers_[i].forEach(std::uint32_t{keys_[i]} << 16, callback);
+    }
+}
+
+}  // namespace inviwo
+
+#endif  // IVW_BITSET_H
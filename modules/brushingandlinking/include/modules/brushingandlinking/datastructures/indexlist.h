@@ -33,35 +33,50 @@
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/util/dispatcher.h>
 #include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
+#include <modules/brushingandlinking/datastructures/bitset.h>
+
+#include <limits>
 
 namespace inviwo {
 class BrushingAndLinkingInport;
 class BrushingAndLinkingManager;
 
+/**
+ * \class IndexList
+ * \brief Keeps track of the indices set by each source and of the union of all of them.
+ */
 class IVW_MODULE_BRUSHINGANDLINKING_API IndexList {
 public:
+    using Callback = std::function<void(const BitSet &added, const BitSet &removed)>;
+
     IndexList() = default;
 
     size_t getSize() const;
     bool has(size_t idx) const;
 
-    void set(const BrushingAndLinkingInport *src, const std::unordered_set<size_t> &incices);
+    void set(const BrushingAndLinkingInport *src, const BitSet &indices);
     void remove(const BrushingAndLinkingInport *src);
 
-    std::shared_ptr<std::function<void()>> onChange(std::function<void()> V);
+    /**
+     * Register a callback that is called with the indices added to and removed from the union
+     * whenever it changes.
+     */
+    std::shared_ptr<Callback> onChange(Callback callback);
 
     void update();
     void clear();
-    const std::unordered_set<size_t> &getIndices() const { return indices_; }
+    const BitSet &getIndices() const { return indices_; }
 
 private:
-    std::unordered_map<const BrushingAndLinkingInport *, std::unordered_set<size_t>>
-        indicesBySource_;
-    std::unordered_set<size_t> indices_;
-    Dispatcher<void()> onUpdate_;
+    std::unordered_map<const BrushingAndLinkingInport *, BitSet> indicesBySource_;
+    BitSet indices_;
+    Dispatcher<void(const BitSet &, const BitSet &)> onUpdate_;
 };
 
-inline bool IndexList::has(size_t idx) const { return indices_.find(idx) != indices_.end(); }
+inline bool IndexList::has(size_t idx) const {
+    return idx <= std::numeric_limits<std::uint32_t>::max() &&
+           indices_.contains(static_cast<std::uint32_t>(idx));
+}
 
 }  // namespace inviwo
 
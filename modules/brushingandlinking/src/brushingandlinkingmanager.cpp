@@ -42,8 +42,12 @@ BrushingAndLinkingManager::BrushingAndLinkingManager(Processor* p,
             op->onDisconnect([=]() { filtered_.update(); });
         }
     }
-    onFilteringChangeCallback_ =
-        filtered_.onChange([p, validationLevel]() { p->invalidate(validationLevel); });
+    onFilteringChangeCallback_ = filtered_.onChange(
+        [this, p, validationLevel](const BitSet& added, const BitSet& removed) {
+            if (added.empty() && removed.empty()) return;
+            onFilteringChange_.invoke(added, removed);
+            p->invalidate(validationLevel);
+        });
 }
 
 BrushingAndLinkingManager::~BrushingAndLinkingManager() {}
@@ -57,36 +61,49 @@ void BrushingAndLinkingManager::remove(const BrushingAndLinkingInport* src) {
 }
 
 bool BrushingAndLinkingManager::isColumnSelected(size_t idx) const {
-    return selectedColumns_.find(idx) != selectedColumns_.end();
+    return idx <= std::numeric_limits<std::uint32_t>::max() &&
+           selectedColumns_.contains(static_cast<std::uint32_t>(idx));
 }
 
 void BrushingAndLinkingManager::setSelected(const BrushingAndLinkingInport*,
-                                            const std::unordered_set<size_t>& indices) {
+                                            const BitSet& indices) {
+    const auto added = indices - selected_;
+    const auto removed = selected_ - indices;
+    if (added.empty() && removed.empty()) return;
+
     selected_ = indices;
+    onSelectionChange_.invoke(added, removed);
     owner_->invalidate(invalidationLevel_);
 }
 
 void BrushingAndLinkingManager::setFiltered(const BrushingAndLinkingInport* src,
-                                            const std::unordered_set<size_t>& indices) {
+                                            const BitSet& indices) {
     filtered_.set(src, indices);
 }
 
 void BrushingAndLinkingManager::setSelectedColumn(const BrushingAndLinkingInport*,
-                                                  const std::unordered_set<size_t>& indices) {
+                                                  const BitSet& indices) {
+    if (selectedColumns_ == indices) return;
     selectedColumns_ = indices;
     owner_->invalidate(invalidationLevel_);
 }
 
-const std::unordered_set<size_t>& BrushingAndLinkingManager::getSelectedIndices() const {
-    return selected_;
-}
+const BitSet& BrushingAndLinkingManager::getSelectedIndices() const { return selected_; }
 
-const std::unordered_set<size_t>& BrushingAndLinkingManager::getFilteredIndices() const {
+const BitSet& BrushingAndLinkingManager::getFilteredIndices() const {
     return filtered_.getIndices();
 }
 
-const std::unordered_set<size_t>& BrushingAndLinkingManager::getSelectedColumns() const {
-    return selectedColumns_;
+const BitSet& BrushingAndLinkingManager::getSelectedColumns() const { return selectedColumns_; }
+
+std::shared_ptr<BrushingAndLinkingManager::DeltaCallback>
+BrushingAndLinkingManager::onSelectionChange(DeltaCallback callback) {
+    return onSelectionChange_.add(callback);
+}
+
+std::shared_ptr<BrushingAndLinkingManager::DeltaCallback>
+BrushingAndLinkingManager::onFilteringChange(DeltaCallback callback) {
+    return onFilteringChange_.add(callback);
 }
 
 }  // namespace inviwo
@@ -0,0 +1,480 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/brushingandlinking/datastructures/bitset.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace inviwo {
+
+namespace {
+
+using Word = std::uint64_t;
+
+constexpr std::uint16_t high(std::uint32_t index) { return static_cast<std::uint16_t>(index >> 16); }
+constexpr std::uint16_t low(std::uint32_t index) {
+    return static_cast<std::uint16_t>(index & 0xFFFF);
+}
+
+size_t popcount(Word word) { return std::bitset<64>(word).count(); }
+
+/**
+ * Set the bits [begin, end] (inclusive) in words
+ */
+void setBits(std::vector<Word>& words, std::uint32_t begin, std::uint32_t end) {
+    const auto firstWord = begin / 64;
+    const auto lastWord = end / 64;
+    const Word firstMask = ~Word{0} << (begin % 64);
+    const Word lastMask = ~Word{0} >> (63 - end % 64);
+    if (firstWord == lastWord) {
+        words[firstWord] |= firstMask & lastMask;
+        return;
+    }
+    words[firstWord] |= firstMask;
+    std::fill(words.begin() + firstWord + 1, words.begin() + lastWord, ~Word{0});
+    words[lastWord] |= lastMask;
+}
+
+size_t countBits(const std::vector<Word>& words) {
+    size_t count = 0;
+    for (auto word : words) count += popcount(word);
+    return count;
+}
+
+// number of runs of consecutive set bits
+size_t countRuns(const std::vector<Word>& words) {
+    size_t runs = 0;
+    for (size_t i = 0; i < words.size(); ++i) {
+        const Word word = words[i];
+        const Word carry = i > 0 ? words[i - 1] >> 63 : 0;
+        // count the bits starting a run, i.e. set bits with the previous bit cleared
+        runs += popcount(word & ~((word << 1) | carry));
+    }
+    return runs;
+}
+
+}  // namespace
+
+bool BitSet::Container::contains(std::uint16_t value) const {
+    switch (type) {
+        case Type::Array:
+            return std::binary_search(values.begin(), values.end(), value);
+        case Type::Bitmap:
+            return (words[value / 64] >> (value % 64)) & Word{1};
+        case Type::Run: {
+            auto it = std::upper_bound(runs.begin(), runs.end(), value,
+                                       [](std::uint16_t v, const Run& run) { return v < run.start; });
+            if (it == runs.begin()) return false;
+            --it;
+            return std::uint32_t{value} <= std::uint32_t{it->start} + it->length;
+        }
+    }
+    return false;
+}
+
+void BitSet::Container::add(std::uint16_t value) {
+    if (type == Type::Run) {
+        if (contains(value)) return;
+        if (cardinality < maxArraySize) {
+            toArray();
+        } else {
+            toBitmap();
+        }
+    }
+    if (type == Type::Array) {
+        auto it = std::lower_bound(values.begin(), values.end(), value);
+        if (it != values.end() && *it == value) return;
+        values.insert(it, value);
+        ++cardinality;
+        if (values.size() > maxArraySize) toBitmap();
+    } else {
+        auto& word = words[value / 64];
+        const Word mask = Word{1} << (value % 64);
+        if ((word & mask) == 0) {
+            word |= mask;
+            ++cardinality;
+        }
+    }
+}
+
+void BitSet::Container::remove(std::uint16_t value) {
+    if (!contains(value)) return;
+    if (type == Type::Run) {
+        if (cardinality <= maxArraySize) {
+            toArray();
+        } else {
+            toBitmap();
+        }
+    }
+    if (type == Type::Array) {
+        values.erase(std::lower_bound(values.begin(), values.end(), value));
+        --cardinality;
+    } else {
+        words[value / 64] &= ~(Word{1} << (value % 64));
+        --cardinality;
+        if (cardinality <= maxArraySize) toArray();
+    }
+}
+
+std::vector<Word> BitSet::Container::bitmapWords() const {
+    if (type == Type::Bitmap) return words;
+
+    std::vector<Word> result(numWords, 0);
+    if (type == Type::Array) {
+        for (auto v : values) result[v / 64] |= Word{1} << (v % 64);
+    } else {
+        for (const auto& run : runs) {
+            setBits(result, run.start, std::uint32_t{run.start} + run.length);
+        }
+    }
+    return result;
+}
+
+void BitSet::Container::toBitmap() {
+    if (type == Type::Bitmap) return;
+    words = bitmapWords();
+    values = {};
+    runs = {};
+    type = Type::Bitmap;
+}
+
+void BitSet::Container::toArray() {
+    if (type == Type::Array) return;
+    std::vector<std::uint16_t> result;
+    result.reserve(cardinality);
+    auto append = [&](std::uint32_t v) { result.push_back(static_cast<std::uint16_t>(v)); };
+    forEach(0, append);
+    values = std::move(result);
+    words = {};
+    runs = {};
+    type = Type::Array;
+}
+
+void BitSet::Container::optimize() {
+    auto bitmap = bitmapWords();
+    cardinality = static_cast<std::uint32_t>(countBits(bitmap));
+    const auto numRuns = countRuns(bitmap);
+
+    const size_t arrayBytes = cardinality * sizeof(std::uint16_t);
+    const size_t bitmapBytes = numWords * sizeof(Word);
+    const size_t runBytes = numRuns * sizeof(Run);
+
+    if (runBytes < std::min(arrayBytes, bitmapBytes)) {
+        std::vector<Run> result;
+        result.reserve(numRuns);
+        std::uint32_t i = 0;
+        while (i < 65536) {
+            const Word word = bitmap[i / 64] >> (i % 64);
+            if (word == 0) {
+                i = (i / 64 + 1) * 64;
+                continue;
+            }
+            i += static_cast<std::uint32_t>(countTrailingZeros(word));
+            const auto start = i;
+            while (i < 65536 && ((bitmap[i / 64] >> (i % 64)) & Word{1})) {
+                if (i % 64 == 0 && bitmap[i / 64] == ~Word{0}) {
+                    i += 64;
+                } else {
+                    ++i;
+                }
+            }
+            result.push_back(
+                Run{static_cast<std::uint16_t>(start), static_cast<std::uint16_t>(i - 1 - start)});
+        }
+        runs = std::move(result);
+        values = {};
+        words = {};
+        type = Type::Run;
+    } else if (cardinality <= maxArraySize) {
+        if (type == Type::Bitmap) words = std::move(bitmap);
+        toArray();
+    } else {
+        words = std::move(bitmap);
+        values = {};
+        runs = {};
+        type = Type::Bitmap;
+    }
+}
+
+bool BitSet::Container::operator==(const Container& rhs) const {
+    if (cardinality != rhs.cardinality) return false;
+    if (type == rhs.type) {
+        switch (type) {
+            case Type::Array:
+                return values == rhs.values;
+            case Type::Bitmap:
+                return words == rhs.words;
+            case Type::Run:
+                return runs == rhs.runs;
+        }
+    }
+    return bitmapWords() == rhs.bitmapWords();
+}
+
+BitSet::BitSet(std::initializer_list<std::uint32_t> values) {
+    for (auto v : values) add(v);
+}
+
+BitSet::BitSet(const std::vector<std::uint32_t>& values) {
+    for (auto v : values) add(v);
+    optimize();
+}
+
+BitSet::BitSet(const std::unordered_set<size_t>& values) {
+    for (auto v : values) add(static_cast<std::uint32_t>(v));
+    optimize();
+}
+
+BitSet BitSet::range(std::uint32_t begin, std::uint32_t end) {
+    BitSet result;
+    result.addRange(begin, end);
+    return result;
+}
+
+size_t BitSet::size() const {
+    size_t size = 0;
+    for (const auto& container : containers_) size += container.cardinality;
+    return size;
+}
+
+bool BitSet::empty() const { return containers_.empty(); }
+
+bool BitSet::contains(std::uint32_t index) const {
+    const auto container = find(high(index));
+    return container && container->contains(low(index));
+}
+
+void BitSet::add(std::uint32_t index) { findOrCreate(high(index)).add(low(index)); }
+
+void BitSet::addRange(std::uint32_t begin, std::uint32_t end) {
+    if (begin >= end) return;
+    const std::uint32_t last = end - 1;
+    for (std::uint32_t key = high(begin); key <= high(last); ++key) {
+        const std::uint32_t first = key == high(begin) ? low(begin) : 0;
+        const std::uint32_t final = key == high(last) ? low(last) : 0xFFFF;
+
+        auto& container = findOrCreate(static_cast<std::uint16_t>(key));
+        if (container.cardinality == 0) {
+            container.runs = {Run{static_cast<std::uint16_t>(first),
+                                  static_cast<std::uint16_t>(final - first)}};
+            container.values = {};
+            container.type = Container::Type::Run;
+            container.cardinality = final - first + 1;
+        } else {
+            container.toBitmap();
+            setBits(container.words, first, final);
+            container.optimize();
+        }
+    }
+}
+
+void BitSet::remove(std::uint32_t index) {
+    if (auto container = find(high(index))) {
+        container->remove(low(index));
+        if (container->cardinality == 0) removeEmpty();
+    }
+}
+
+void BitSet::clear() {
+    keys_.clear();
+    containers_.clear();
+}
+
+BitSet& BitSet::operator|=(const BitSet& rhs) {
+    for (size_t i = 0; i < rhs.keys_.size(); ++i) {
+        const auto& other = rhs.containers_[i];
+        auto& container = findOrCreate(rhs.keys_[i]);
+        if (container.cardinality == 0) {
+            container = other;
+        } else if (container.type == Container::Type::Array &&
+                   other.type == Container::Type::Array &&
+                   container.cardinality + other.cardinality <= Container::maxArraySize) {
+            std::vector<std::uint16_t> result;
+            result.reserve(container.cardinality + other.cardinality);
+            std::set_union(container.values.begin(), container.values.end(),
+                           other.values.begin(), other.values.end(),
+                           std::back_inserter(result));
+            container.values = std::move(result);
+            container.cardinality = static_cast<std::uint32_t>(container.values.size());
+        } else {
+            container.toBitmap();
+            const auto otherWords = other.bitmapWords();
+            for (size_t w = 0; w < Container::numWords; ++w) {
+                container.words[w] |= otherWords[w];
+            }
+            container.optimize();
+        }
+    }
+    return *this;
+}
+
+BitSet& BitSet::operator&=(const BitSet& rhs) {
+    for (size_t i = 0; i < keys_.size(); ++i) {
+        auto& container = containers_[i];
+        const auto other = rhs.find(keys_[i]);
+        if (!other) {
+            container.cardinality = 0;
+        } else if (container.type == Container::Type::Array) {
+            auto& values = container.values;
+            values.erase(std::remove_if(values.begin(), values.end(),
+                                        [&](std::uint16_t v) { return !other->contains(v); }),
+                         values.end());
+            container.cardinality = static_cast<std::uint32_t>(values.size());
+        } else if (other->type == Container::Type::Array) {
+            std::vector<std::uint16_t> result;
+            std::copy_if(other->values.begin(), other->values.end(), std::back_inserter(result),
+                         [&](std::uint16_t v) { return container.contains(v); });
+            container.values = std::move(result);
+            container.words = {};
+            container.runs = {};
+            container.type = Container::Type::Array;
+            container.cardinality = static_cast<std::uint32_t>(container.values.size());
+        } else {
+            container.toBitmap();
+            const auto otherWords = other->bitmapWords();
+            for (size_t w = 0; w < Container::numWords; ++w) {
+                container.words[w] &= otherWords[w];
+            }
+            container.optimize();
+        }
+    }
+    removeEmpty();
+    return *this;
+}
+
+BitSet& BitSet::operator-=(const BitSet& rhs) {
+    for (size_t i = 0; i < keys_.size(); ++i) {
+        auto& container = containers_[i];
+        const auto other = rhs.find(keys_[i]);
+        if (!other) continue;
+        if (container.type == Container::Type::Array) {
+            auto& values = container.values;
+            values.erase(std::remove_if(values.begin(), values.end(),
+                                        [&](std::uint16_t v) { return other->contains(v); }),
+                         values.end());
+            container.cardinality = static_cast<std::uint32_t>(values.size());
+        } else {
+            container.toBitmap();
+            const auto otherWords = other->bitmapWords();
+            for (size_t w = 0; w < Container::numWords; ++w) {
+                container.words[w] &= ~otherWords[w];
+            }
+            container.optimize();
+        }
+    }
+    removeEmpty();
+    return *this;
+}
+
+bool BitSet::operator==(const BitSet& rhs) const {
+    return keys_ == rhs.keys_ && containers_ == rhs.containers_;
+}
+
+bool BitSet::operator!=(const BitSet& rhs) const { return !(*this == rhs); }
+
+std::vector<std::uint32_t> BitSet::toVector() const {
+    std::vector<std::uint32_t> result;
+    result.reserve(size());
+    forEach([&](std::uint32_t v) { result.push_back(v); });
+    return result;
+}
+
+std::unordered_set<size_t> BitSet::toUnorderedSet() const {
+    std::unordered_set<size_t> result;
+    result.reserve(size());
+    forEach([&](std::uint32_t v) { result.insert(v); });
+    return result;
+}
+
+void BitSet::optimize() {
+    for (auto& container : containers_) container.optimize();
+}
+
+size_t BitSet::getSizeInBytes() const {
+    size_t bytes = keys_.size() * (sizeof(std::uint16_t) + sizeof(Container));
+    for (const auto& container : containers_) {
+        bytes += container.values.size() * sizeof(std::uint16_t) +
+                 container.words.size() * sizeof(Word) + container.runs.size() * sizeof(Run);
+    }
+    return bytes;
+}
+
+BitSet::Container* BitSet::find(std::uint16_t key) {
+    auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+    if (it == keys_.end() || *it != key) return nullptr;
+    return &containers_[std::distance(keys_.begin(), it)];
+}
+
+const BitSet::Container* BitSet::find(std::uint16_t key) const {
+    auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+    if (it == keys_.end() || *it != key) return nullptr;
+    return &containers_[std::distance(keys_.begin(), it)];
+}
+
+BitSet::Container& BitSet::findOrCreate(std::uint16_t key) {
+    auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+    const auto pos = std::distance(keys_.begin(), it);
+    if (it == keys_.end() || *it != key) {
+        keys_.insert(it, key);
+        containers_.insert(containers_.begin() + pos, Container{});
+    }
+    return containers_[pos];
+}
+
+void BitSet::removeEmpty() {
+    size_t dst = 0;
+    for (size_t i = 0; i < keys_.size(); ++i) {
+        if (containers_[i].cardinality == 0) continue;
+        if (dst != i) {
+            keys_[dst] = keys_[i];
+            containers_[dst] = std::move(containers_[i]);
+        }
+        ++dst;
+    }
+    keys_.resize(dst);
+    containers_.resize(dst);
+}
+
+BitSet operator|(BitSet lhs, const BitSet& rhs) {
+    lhs |= rhs;
+    return lhs;
+}
+
+BitSet operator&(BitSet lhs, const BitSet& rhs) {
+    lhs &= rhs;
+    return lhs;
+}
+
+BitSet operator-(BitSet lhs, const BitSet& rhs) {
+    lhs -= rhs;
+    return lhs;
+}
+
+}  // namespace inviwo
@@ -34,8 +34,7 @@ namespace inviwo {
 
 size_t IndexList::getSize() const { return indices_.size(); }
 
-void IndexList::set(const BrushingAndLinkingInport *src,
-                    const std::unordered_set<size_t> &indices) {
+void IndexList::set(const BrushingAndLinkingInport *src, const BitSet &indices) {
     indicesBySource_[src] = indices;
     update();
 }
@@ -45,28 +44,30 @@ void IndexList::remove(const BrushingAndLinkingInport *src) {
     update();
 }
 
-std::shared_ptr<std::function<void()>> IndexList::onChange(std::function<void()> V) {
-    return onUpdate_.add(V);
+std::shared_ptr<IndexList::Callback> IndexList::onChange(Callback callback) {
+    return onUpdate_.add(callback);
 }
 
 void IndexList::update() {
-    indices_.clear();
-
-    using T = std::unordered_map<const BrushingAndLinkingInport *,
-                                 std::unordered_set<size_t>>::value_type;
+    using T = std::unordered_map<const BrushingAndLinkingInport *, BitSet>::value_type;
     util::map_erase_remove_if(indicesBySource_, [](const T &p) {
         return !p.first->isConnected() ||
                p.second.empty();  // remove if port is disconnected or if the set is empty
     });
 
-    for (auto p : indicesBySource_) {
-        indices_.insert(p.second.begin(), p.second.end());
+    BitSet indices;
+    for (const auto &p : indicesBySource_) {
+        indices |= p.second;
     }
-    onUpdate_.invoke();
+
+    const auto added = indices - indices_;
+    const auto removed = indices_ - indices;
+    indices_ = std::move(indices);
+    onUpdate_.invoke(added, removed);
 }
 
 void IndexList::clear() {
-    indices_.clear();
+    indicesBySource_.clear();
     update();
 }
 
@@ -31,8 +31,7 @@
 
 namespace inviwo {
 
-SelectionEvent::SelectionEvent(const BrushingAndLinkingInport* src,
-                               const std::unordered_set<size_t>& indices)
+SelectionEvent::SelectionEvent(const BrushingAndLinkingInport* src, const BitSet& indices)
     : BrushingAndLinkingEvent(src, indices) {}
 
 }  // namespace inviwo
@@ -0,0 +1,143 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/brushingandlinking/datastructures/bitset.h>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<std::uint32_t> toVector(const std::set<std::uint32_t>& set) {
+    return std::vector<std::uint32_t>(set.begin(), set.end());
+}
+
+}  // namespace
+
+TEST(BitSet, AddRemoveContains) {
+    BitSet set;
+    EXPECT_TRUE(set.empty());
+
+    set.add(3);
+    set.add(70000);
+    set.add(3);
+    EXPECT_EQ(2, set.size());
+    EXPECT_TRUE(set.contains(3));
+    EXPECT_TRUE(set.contains(70000));
+    EXPECT_FALSE(set.contains(4));
+
+    set.remove(3);
+    EXPECT_EQ(1, set.size());
+    EXPECT_FALSE(set.contains(3));
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(BitSet, Range) {
+    const auto set = BitSet::range(100, 10000000);
+    EXPECT_EQ(10000000 - 100, set.size());
+    EXPECT_FALSE(set.contains(99));
+    EXPECT_TRUE(set.contains(100));
+    EXPECT_TRUE(set.contains(9999999));
+    EXPECT_FALSE(set.contains(10000000));
+    // Stored as runs, not one entry per index
+    EXPECT_LT(set.getSizeInBytes(), 64u * 1024u);
+}
+
+TEST(BitSet, SetOperations) {
+    const auto a = BitSet::range(0, 100000);
+    const auto b = BitSet::range(50000, 150000);
+
+    EXPECT_EQ(BitSet::range(0, 150000), a | b);
+    EXPECT_EQ(BitSet::range(50000, 100000), a & b);
+    EXPECT_EQ(BitSet::range(0, 50000), a - b);
+    EXPECT_TRUE((a - a).empty());
+}
+
+TEST(BitSet, ForEachIsOrdered) {
+    BitSet set{5, 1, 200000, 70000};
+    std::vector<std::uint32_t> values;
+    set.forEach([&](std::uint32_t i) { values.push_back(i); });
+    EXPECT_EQ((std::vector<std::uint32_t>{1, 5, 70000, 200000}), values);
+    EXPECT_EQ(values, set.toVector());
+}
+
+TEST(BitSet, MatchesStdSet) {
+    std::mt19937 gen(4711);
+    std::uniform_int_distribution<std::uint32_t> value(0, 300000);
+    std::uniform_int_distribution<std::uint32_t> length(0, 20000);
+
+    BitSet a, b;
+    std::set<std::uint32_t> refA, refB;
+    for (int i = 0; i < 20; ++i) {
+        const auto begin = value(gen);
+        const auto end = begin + length(gen);
+        a.addRange(begin, end);
+        for (auto v = begin; v < end; ++v) refA.insert(v);
+    }
+    for (int i = 0; i < 20000; ++i) {
+        const auto v = value(gen);
+        b.add(v);
+        refB.insert(v);
+        if (i % 3 == 0) {
+            const auto r = value(gen);
+            a.remove(r);
+            refA.erase(r);
+        }
+    }
+    ASSERT_EQ(toVector(refA), a.toVector());
+    ASSERT_EQ(toVector(refB), b.toVector());
+
+    std::set<std::uint32_t> refUnion(refA), refIntersection, refDifference;
+    refUnion.insert(refB.begin(), refB.end());
+    std::set_intersection(refA.begin(), refA.end(), refB.begin(), refB.end(),
+                          std::inserter(refIntersection, refIntersection.end()));
+    std::set_difference(refA.begin(), refA.end(), refB.begin(), refB.end(),
+                        std::inserter(refDifference, refDifference.end()));
+
+    EXPECT_EQ(toVector(refUnion), (a | b).toVector());
+    EXPECT_EQ(toVector(refIntersection), (a & b).toVector());
+    EXPECT_EQ(toVector(refDifference), (a - b).toVector());
+
+    auto optimized = a;
+    optimized.optimize();
+    EXPECT_EQ(a, optimized);
+}
+
+}  // namespace inviwo
@@ -102,7 +102,9 @@ void* loadTIFFLayerData(void* dst, const std::string& filePath, TIFFHeader heade
                         bool rescaleToDim = false);
 
 /**
- * Load TIFF stack as volume.
+ * Load TIFF stack as volume. The pages are decoded concurrently on the thread pool, in ranges of
+ * pages written directly into dst. If dst is null the data is allocated as an array of the type
+ * of header.format.
  * \see TIFFStackVolumeRAMLoader
  * \see getTIFFHeader
  */
@@ -31,10 +31,12 @@
 #include <modules/cimg/cimgsavebuffer.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 #include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/foreach.h>
 #include <inviwo/core/io/datawriterexception.h>
 #include <inviwo/core/io/datareaderexception.h>
 #include <algorithm>
 #include <limits>
+#include <memory>
 
 #include <warn/push>
 #include <warn/ignore/all>
@@ -429,6 +431,50 @@ struct CImgLoadVolumeDispatcher {
     }
 };
 
+struct CImgLoadTIFFVolumeDispatcher {
+    using type = void*;
+    template <typename Result, typename DF>
+    void* operator()(void* dst, const std::string& filePath, size3_t dimensions) {
+        using P = typename DF::primitive;
+
+        std::unique_ptr<typename DF::type[]> alloc;
+        if (!dst) {
+            alloc = std::make_unique<typename DF::type[]>(glm::compMul(dimensions));
+            dst = alloc.get();
+        }
+        const auto data = static_cast<P*>(dst);
+        const size_t sliceSize = dimensions.x * dimensions.y * DF::comp;
+
+        // Decode ranges of pages concurrently, every job opens the file once and decodes its
+        // pages directly into the destination.
+        util::forEachRangeParallel(
+            dimensions.z,
+            [&](size_t begin, size_t end) {
+                try {
+                    cimg_library::CImg<P> img;
+                    img.load_tiff(filePath.c_str(), static_cast<unsigned int>(begin),
+                                  static_cast<unsigned int>(end - 1));
+                    if (size3_t(img.width(), img.height(), img.depth()) !=
+                        size3_t(dimensions.x, dimensions.y, end - begin)) {
+                        throw DataReaderException(
+                            "Unexpected dimensions of pages " + toString(begin) + " to " +
+                                toString(end - 1) + " in " + filePath,
+                            IVW_CONTEXT);
+                    }
+                    // Image is up-side-down
+                    img.mirror('y');
+                    CImgToVoidConvert<P>::convert(data + begin * sliceSize, &img);
+                } catch (cimg_library::CImgIOException& e) {
+                    throw DataReaderException(std::string(e.what()), IVW_CONTEXT);
+                }
+            },
+            16);
+
+        alloc.release();
+        return dst;
+    }
+};
+
 ////////////////////// CImgUtils ///////////////////////////////////////////////////
 
 void* loadLayerData(void* dst, const std::string& filePath, uvec2& dimensions,
@@ -469,11 +515,9 @@ void* loadTIFFLayerData(void* dst, const std::string& filePath, TIFFHeader heade
 }
 
 void* loadTIFFVolumeData(void* dst, const std::string& filePath, TIFFHeader header) {
-    CImgLoadVolumeDispatcher disp;
-    DataFormatId formatId = header.format->getId();
-    size3_t dims{header.dimensions};
-    return dispatching::dispatch<void*, dispatching::filter::All>(formatId, disp, dst, filePath,
-                                                                  dims, formatId);
+    CImgLoadTIFFVolumeDispatcher disp;
+    return dispatching::dispatch<void*, dispatching::filter::All>(header.format->getId(), disp, dst,
+                                                                  filePath, header.dimensions);
 }
 
 void saveLayer(const std::string& filePath, const Layer* inputLayer) {
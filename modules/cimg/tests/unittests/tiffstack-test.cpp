@@ -0,0 +1,122 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <modules/cimg/tiffstackvolumereader.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+unsigned char pageValue(size_t x, size_t row, size_t page) {
+    return static_cast<unsigned char>((x + 3 * row + 7 * page) % 256);
+}
+
+// Writes an uncompressed 8-bit grayscale little endian TIFF with one page per slice
+void writeTIFFStack(const std::string& file, size3_t dims) {
+    auto out = filesystem::ofstream(file, std::ios::out | std::ios::binary);
+    const auto u16 = [&](std::uint16_t v) { out.write(reinterpret_cast<const char*>(&v), 2); };
+    const auto u32 = [&](std::uint32_t v) { out.write(reinterpret_cast<const char*>(&v), 4); };
+    const auto entry = [&](std::uint16_t tag, std::uint16_t type, std::uint32_t value) {
+        u16(tag);
+        u16(type);
+        u32(1);
+        if (type == 3) {  // short, left justified
+            u16(static_cast<std::uint16_t>(value));
+            u16(0);
+        } else {
+            u32(value);
+        }
+    };
+
+    const auto pageSize = static_cast<std::uint32_t>(dims.x * dims.y + (dims.x * dims.y) % 2);
+    const std::uint32_t ifdSize = 2 + 9 * 12 + 4;
+    out.write("II", 2);
+    u16(42);
+    u32(8 + pageSize);  // first IFD after the first page
+
+    for (size_t page = 0; page < dims.z; ++page) {
+        const auto dataOffset = static_cast<std::uint32_t>(8 + page * (pageSize + ifdSize));
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) out.put(static_cast<char>(pageValue(x, y, page)));
+        }
+        if ((dims.x * dims.y) % 2) out.put(0);
+
+        u16(9);
+        entry(256, 4, static_cast<std::uint32_t>(dims.x));          // width
+        entry(257, 4, static_cast<std::uint32_t>(dims.y));          // length
+        entry(258, 3, 8);                                           // bits per sample
+        entry(259, 3, 1);                                           // no compression
+        entry(262, 3, 1);                                           // black is zero
+        entry(273, 4, dataOffset);                                  // strip offset
+        entry(277, 3, 1);                                           // samples per pixel
+        entry(278, 4, static_cast<std::uint32_t>(dims.y));          // rows per strip
+        entry(279, 4, static_cast<std::uint32_t>(dims.x * dims.y));  // strip byte count
+        u32(page + 1 < dims.z ? dataOffset + pageSize + ifdSize + pageSize : 0);
+    }
+}
+
+}  // namespace
+
+TEST(TIFFStackVolumeReader, parallelPages) {
+    // Enough pages to be split into several ranges that are decoded concurrently
+    const size3_t dims{13, 9, 100};
+
+    util::TempFileHandle tmpFile("cimg", ".tif");
+    writeTIFFStack(tmpFile.getFileName(), dims);
+
+    TIFFStackVolumeReader reader;
+    const auto volume = reader.readData(tmpFile.getFileName());
+    ASSERT_EQ(dims, volume->getDimensions());
+    const auto ram = volume->getRepresentation<VolumeRAM>();
+    const auto data = static_cast<const unsigned char*>(ram->getData());
+
+    // The images are flipped in y when loaded
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                ASSERT_EQ(pageValue(x, dims.y - 1 - y, z),
+                          data[x + dims.x * (y + dims.y * z)]);
+            }
+        }
+    }
+}
+
+}  // namespace inviwo
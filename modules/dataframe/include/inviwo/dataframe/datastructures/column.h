@@ -200,6 +200,15 @@ public:
 
     virtual void add(const std::string &value) override;
 
+    /**
+     * \brief append a number of values given as indices into \p categories.
+     * The given categories are merged with the existing categories of the column.
+     *
+     * @param ids         indices into categories, one per value
+     * @param categories  the categorical values referred to by ids
+     */
+    void append(const std::vector<std::uint32_t> &ids, const std::vector<std::string> &categories);
+
     /**
      * Returns the unique set of categorical values.
      */
@@ -0,0 +1,144 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/datastructures/rowbitmap.h>
+
+#include <functional>
+
+namespace inviwo {
+
+/**
+ * \class DataFrameView
+ * \brief A subset of the rows of a DataFrame given as a list of row indices.
+ * The view refers to the rows of the DataFrame, no column data is copied.
+ */
+class IVW_MODULE_DATAFRAME_API DataFrameView {
+public:
+    DataFrameView(std::shared_ptr<const DataFrame> dataFrame, std::vector<std::uint32_t> rows);
+    DataFrameView(std::shared_ptr<const DataFrame> dataFrame, const RowBitmap& selection);
+
+    std::shared_ptr<const DataFrame> getDataFrame() const;
+    const std::vector<std::uint32_t>& getRows() const;
+
+    /**
+     * Returns the number of rows in the view
+     */
+    size_t size() const;
+    bool empty() const;
+    /**
+     * Returns the row index in the DataFrame of the \p i-th row of the view
+     */
+    std::uint32_t operator[](size_t i) const;
+
+    std::vector<std::uint32_t>::const_iterator begin() const;
+    std::vector<std::uint32_t>::const_iterator end() const;
+
+private:
+    std::shared_ptr<const DataFrame> dataFrame_;
+    std::vector<std::uint32_t> rows_;
+};
+
+/**
+ * \class DataFrameQuery
+ * \brief A predicate over the rows of a DataFrame, evaluated column-wise into a RowBitmap.
+ *
+ * Queries are built from range and categorical membership predicates and combined with the
+ * logical operators. Each predicate is evaluated in a tight loop directly over the column buffer,
+ * producing 64 rows per bitmap word, and large columns are split over the thread pool. Combining
+ * predicates then only requires bitwise operations on the resulting bitmaps.
+ *
+ * Example, selecting all rows with 0 <= x <= 1 that belong to category "a" or "b":
+ * ```{.cpp}
+ * auto query = DataFrameQuery::range("x", 0.0, 1.0) && DataFrameQuery::oneOf("type", {"a", "b"});
+ * RowBitmap selected = query.evaluate(*dataFrame);
+ * size_t count = selected.count();
+ * DataFrameView view = query.select(dataFrame);
+ * ```
+ *
+ * Columns can be referred to by index or by header, the latter are looked up during evaluation.
+ * Rows past the end of a column that is shorter than the DataFrame are treated as not matching
+ * the predicates on that column.
+ */
+class IVW_MODULE_DATAFRAME_API DataFrameQuery {
+public:
+    using Evaluator = std::function<RowBitmap(const DataFrame&)>;
+
+    /**
+     * Creates a query matching all rows
+     */
+    DataFrameQuery();
+    explicit DataFrameQuery(Evaluator evaluator);
+
+    /**
+     * Matches rows where the value of \p column is in the closed interval [min, max]. NaN values
+     * never match.
+     * @throws Exception during evaluation if the column is not of a scalar type
+     */
+    static DataFrameQuery range(size_t column, double min, double max);
+    static DataFrameQuery range(const std::string& header, double min, double max);
+
+    /**
+     * Matches rows where the categorical \p column has one of the given \p categories.
+     * Categories not present in the column are ignored.
+     * @throws Exception during evaluation if the column is not a CategoricalColumn
+     */
+    static DataFrameQuery oneOf(size_t column, std::vector<std::string> categories);
+    static DataFrameQuery oneOf(const std::string& header, std::vector<std::string> categories);
+
+    /**
+     * Returns a bitmap of the size of the DataFrame with all rows matching the query set
+     * @throws Exception if a referred column does not exist or has an unsupported type
+     */
+    RowBitmap evaluate(const DataFrame& dataFrame) const;
+    /**
+     * Returns the number of rows matching the query
+     */
+    size_t count(const DataFrame& dataFrame) const;
+    /**
+     * Returns a view of the rows matching the query
+     */
+    DataFrameView select(std::shared_ptr<const DataFrame> dataFrame) const;
+
+    friend IVW_MODULE_DATAFRAME_API DataFrameQuery operator&&(DataFrameQuery lhs,
+                                                              DataFrameQuery rhs);
+    friend IVW_MODULE_DATAFRAME_API DataFrameQuery operator||(DataFrameQuery lhs,
+                                                              DataFrameQuery rhs);
+    friend IVW_MODULE_DATAFRAME_API DataFrameQuery operator!(DataFrameQuery query);
+
+private:
+    Evaluator evaluator_;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,159 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class RowBitmap
+ * \brief A dense bitmap holding one bit per row of a DataFrame.
+ *
+ * The bits are packed into 64-bit words, which makes combining bitmaps with the bitwise
+ * operators and counting the number of set bits a word-wise operation. Bits past size() are
+ * always kept zero.
+ * \see DataFrameQuery
+ */
+class IVW_MODULE_DATAFRAME_API RowBitmap {
+public:
+    using Word = std::uint64_t;
+    static constexpr size_t wordSize = 64;
+
+    explicit RowBitmap(size_t size = 0, bool value = false);
+
+    size_t size() const;
+
+    bool test(size_t row) const;
+    void set(size_t row, bool value = true);
+    /**
+     * Set all bits in the range [begin, end) to \p value
+     */
+    void setRange(size_t begin, size_t end, bool value = true);
+    void reset();
+    RowBitmap& flip();
+
+    /**
+     * Returns the number of set bits
+     */
+    size_t count() const;
+    bool any() const;
+    bool none() const;
+
+    /**
+     * The bitwise operators require both bitmaps to be of the same size.
+     * @throws Exception if the sizes differ
+     */
+    RowBitmap& operator&=(const RowBitmap& rhs);
+    RowBitmap& operator|=(const RowBitmap& rhs);
+    RowBitmap& operator^=(const RowBitmap& rhs);
+    /**
+     * Clear all bits that are set in \p rhs
+     */
+    RowBitmap& subtract(const RowBitmap& rhs);
+
+    bool operator==(const RowBitmap& rhs) const;
+    bool operator!=(const RowBitmap& rhs) const;
+
+    /**
+     * Returns the indices of all set bits in increasing order
+     */
+    std::vector<std::uint32_t> indices() const;
+
+    /**
+     * Call \p callback with the index of each set bit in increasing order
+     */
+    template <typename Callback>
+    void forEach(Callback callback) const;
+
+    /**
+     * Direct access to the underlying words. Bit i is stored in word i / wordSize at bit position
+     * i % wordSize. Bits past size() in the last word must be left zero.
+     */
+    const std::vector<Word>& words() const;
+    std::vector<Word>& words();
+
+    static size_t numberOfWords(size_t size);
+    static size_t popcount(Word word);
+    static size_t countTrailingZeros(Word word);
+
+private:
+    void clearPadding();
+
+    size_t size_;
+    std::vector<Word> words_;
+};
+
+IVW_MODULE_DATAFRAME_API RowBitmap operator&(RowBitmap lhs, const RowBitmap& rhs);
+IVW_MODULE_DATAFRAME_API RowBitmap operator|(RowBitmap lhs, const RowBitmap& rhs);
+IVW_MODULE_DATAFRAME_API RowBitmap operator^(RowBitmap lhs, const RowBitmap& rhs);
+IVW_MODULE_DATAFRAME_API RowBitmap operator~(RowBitmap bitmap);
+
+inline size_t RowBitmap::size() const { return size_; }
+
+inline bool RowBitmap::test(size_t row) const {
+    return (words_[row / wordSize] >> (row % wordSize)) & Word{1};
+}
+
+inline void RowBitmap::set(size_t row, bool value) {
+    const Word mask = Word{1} << (row % wordSize);
+    if (value) {
+        words_[row / wordSize] |= mask;
+    } else {
+        words_[row / wordSize] &= ~mask;
+    }
+}
+
+inline size_t RowBitmap::popcount(Word word) { return std::bitset<wordSize>(word).count(); }
+
+inline size_t RowBitmap::countTrailingZeros(Word word) {
+    if (word == 0) return wordSize;
+    return popcount((word & (~word + 1)) - 1);
+}
+
+inline size_t RowBitmap::numberOfWords(size_t size) { return (size + wordSize - 1) / wordSize; }
+
+template <typename Callback>
+void RowBitmap::forEach(Callback callback) const {
+    for (size_t i = 0; i < words_.size(); ++i) {
+        auto word = words_[i];
+        while (word != 0) {
+            callback(i * wordSize + countTrailingZeros(word));
+            word &= word - 1;
+        }
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,141 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <inviwo/core/io/datareader.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/fileextension.h>
+#include <inviwo/core/datastructures/diskrepresentation.h>
+#include <inviwo/core/datastructures/buffer/bufferrepresentation.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+
+namespace inviwo {
+
+/**
+ * \brief Compression applied to the column data of a binary DataFrame file.
+ * \see BinaryDataFrameWriter
+ */
+enum class DataFrameCompression : std::uint8_t { None = 0, Zlib = 1 };
+
+/**
+ * \class BinaryDataFrameReader
+ * \ingroup dataio
+ *
+ * \brief A reader for binary columnar DataFrame files (*.ivdf).
+ *
+ * Only the file header, holding the name, type, categories, and location of each column, is
+ * parsed when reading. Each column is backed by a BufferDisk and the column data is read, and
+ * decompressed if needed, the first time the column is accessed. Opening a large file is thereby
+ * cheap and only the columns actually used are loaded into memory.
+ *
+ * \see BinaryDataFrameWriter
+ */
+class IVW_MODULE_DATAFRAME_API BinaryDataFrameReader : public DataReaderType<DataFrame> {
+public:
+    BinaryDataFrameReader();
+    BinaryDataFrameReader(const BinaryDataFrameReader&) = default;
+    BinaryDataFrameReader(BinaryDataFrameReader&&) noexcept = default;
+    BinaryDataFrameReader& operator=(const BinaryDataFrameReader&) = default;
+    BinaryDataFrameReader& operator=(BinaryDataFrameReader&&) noexcept = default;
+    virtual BinaryDataFrameReader* clone() const override;
+    virtual ~BinaryDataFrameReader() = default;
+
+    using DataReaderType<DataFrame>::readData;
+
+    /**
+     * Reads the header of the file and sets up columns which are loaded on first access.
+     * @throws FileException if the file cannot be accessed
+     * @throws DataReaderException if the file is not a valid binary DataFrame file
+     */
+    virtual std::shared_ptr<DataFrame> readData(const std::string& fileName) override;
+};
+
+/**
+ * \class BinaryDataFrameWriter
+ * \ingroup dataio
+ *
+ * \brief Writes a DataFrame into a binary columnar file (*.ivdf) which can be read by the
+ * BinaryDataFrameReader.
+ *
+ * The file starts with a header listing all columns together with their data format, categories,
+ * and the offset and size of their data. The data of each column is stored as one contiguous
+ * block, optionally compressed. Compressed blocks that turn out larger than the raw data are
+ * stored uncompressed. The index column is not stored but recreated when reading.
+ */
+class IVW_MODULE_DATAFRAME_API BinaryDataFrameWriter {
+public:
+    BinaryDataFrameWriter(DataFrameCompression compression = DataFrameCompression::Zlib);
+
+    void setCompression(DataFrameCompression compression);
+    DataFrameCompression getCompression() const;
+
+    /**
+     * @throws FileException if the file cannot be opened for writing
+     * @throws Exception if the DataFrame contains columns of non-scalar type
+     */
+    void writeData(const DataFrame& dataFrame, const std::string& filePath) const;
+
+    static const FileExtension extension;
+
+private:
+    DataFrameCompression compression_;
+};
+
+/**
+ * \brief Loads the data of a single column of a binary DataFrame file into a BufferRAM.
+ * \see BinaryDataFrameReader
+ */
+class IVW_MODULE_DATAFRAME_API BinaryDataFrameColumnLoader
+    : public DiskRepresentationLoader<BufferRepresentation> {
+public:
+    BinaryDataFrameColumnLoader(const std::string& fileName, std::uint64_t offset,
+                                std::uint64_t storedSize, DataFrameCompression compression,
+                                size_t size, const DataFormatBase* format);
+    virtual BinaryDataFrameColumnLoader* clone() const override;
+    virtual ~BinaryDataFrameColumnLoader() = default;
+
+    virtual std::shared_ptr<BufferRepresentation> createRepresentation() const override;
+    virtual void updateRepresentation(std::shared_ptr<BufferRepresentation> dest) const override;
+
+private:
+    void readInto(void* dest) const;
+
+    std::string fileName_;
+    std::uint64_t offset_;
+    std::uint64_t storedSize_;
+    DataFrameCompression compression_;
+    size_t size_;
+    const DataFormatBase* format_;
+};
+
+}  // namespace inviwo
@@ -58,6 +58,10 @@ public:
  *
  * \brief A reader for comma separated value (CSV) files with customizable delimiters.
  * The default delimiter is ',' and headers are included
+ *
+ * The data is read into memory in one go. The column types are derived from the first rows,
+ * after which the data is split at record boundaries into chunks that are parsed concurrently on
+ * the thread pool directly into the column buffers.
  */
 class IVW_MODULE_DATAFRAME_API CSVReader : public DataReaderType<DataFrame> {
 public:
@@ -71,6 +75,12 @@ public:
 
     void setDelimiters(const std::string& delim);
     void setFirstRowHeader(bool hasHeader);
+    /**
+     * Set the minimum size of the chunks that are parsed concurrently, default is 1 MiB.
+     * There are at most four chunks per thread of the pool. Without pool threads, or without an
+     * InviwoApplication, the chunks are parsed one after another.
+     */
+    void setMinChunkSize(size_t bytes);
     using DataReaderType<DataFrame>::readData;
 
     /**
@@ -99,8 +109,11 @@ public:
     std::shared_ptr<DataFrame> readData(std::istream& stream) const;
 
 private:
+    std::shared_ptr<DataFrame> parse(const std::string& data) const;
+
     std::string delimiters_;
     bool firstRowHeader_;
+    size_t minChunkSize_;
 };
 
 }  // namespace inviwo
@@ -51,10 +51,10 @@ namespace inviwo {
 
 /** \docpage{org.inviwo.DataFrameExporter, DataFrame Exporter}
  * ![](org.inviwo.DataFrameExporter.png?classIdentifier=org.inviwo.DataFrameExporter)
- * This processor exports a DataFrame into a CSV or XML file.
+ * This processor exports a DataFrame into a CSV, XML, or binary DataFrame (ivdf) file.
  *
  * ### Inports
- *   * __<Inport>__ source DataFrame which is saved as CSV or XML file
+ *   * __<Inport>__ source DataFrame which is saved as CSV, XML, or ivdf file
  *
  */
 
@@ -74,6 +74,7 @@ protected:
 private:
     void exportAsCSV(bool separateVectorTypesIntoColumns = true);
     void exportAsXML();
+    void exportAsBinary();
 
     DataInport<DataFrame> dataFrame_;
 
@@ -84,9 +85,11 @@ private:
     BoolProperty separateVectorTypesIntoColumns_;
     BoolProperty quoteStrings_;
     StringProperty delimiter_;
+    BoolProperty compressBinary_;
 
     static FileExtension csvExtension_;
     static FileExtension xmlExtension_;
+    static FileExtension binaryExtension_;
 
     bool export_;
 };
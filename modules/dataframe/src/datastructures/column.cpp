@@ -29,6 +29,8 @@
 
 #include <inviwo/dataframe/datastructures/column.h>
 
+#include <unordered_map>
+
 namespace inviwo {
 
 CategoricalColumn::CategoricalColumn(const std::string &header)
@@ -59,6 +61,26 @@ void CategoricalColumn::add(const std::string &value) {
     getTypedBuffer()->getEditableRAMRepresentation()->add(id);
 }
 
+void CategoricalColumn::append(const std::vector<std::uint32_t> &ids,
+                               const std::vector<std::string> &categories) {
+    std::unordered_map<std::string, std::uint32_t> existing;
+    for (size_t i = 0; i < lookUpTable_.size(); ++i) {
+        existing.emplace(lookUpTable_[i], static_cast<std::uint32_t>(i));
+    }
+    std::vector<std::uint32_t> translation;
+    translation.reserve(categories.size());
+    for (const auto &category : categories) {
+        auto res = existing.emplace(category, static_cast<std::uint32_t>(lookUpTable_.size()));
+        if (res.second) lookUpTable_.push_back(category);
+        translation.push_back(res.first->second);
+    }
+
+    auto &data = getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer();
+    data.reserve(data.size() + ids.size());
+    std::transform(ids.begin(), ids.end(), std::back_inserter(data),
+                   [&](std::uint32_t id) { return translation[id]; });
+}
+
 glm::uint32_t CategoricalColumn::addOrGetID(const std::string &str) {
     auto it = std::find(lookUpTable_.begin(), lookUpTable_.end(), str);
     if (it != lookUpTable_.end()) {
@@ -0,0 +1,273 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/datastructures/dataframequery.h>
+#include <inviwo/dataframe/datastructures/column.h>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/util/formatdispatching.h>
+
+#include <cmath>
+#include <future>
+#include <limits>
+#include <type_traits>
+
+namespace inviwo {
+
+namespace {
+
+// number of bitmap words, i.e. 64 rows each, handled by one job on the thread pool
+constexpr size_t wordsPerJob = 1 << 12;
+
+template <typename Func>
+void forEachWordRange(size_t numWords, Func&& func) {
+    const size_t jobs = (numWords + wordsPerJob - 1) / wordsPerJob;
+    if (jobs <= 1 || !InviwoApplication::isInitialized() ||
+        InviwoApplication::getPtr()->getPoolSize() == 0) {
+        func(size_t{0}, numWords);
+        return;
+    }
+    std::vector<std::future<void>> futures;
+    for (size_t job = 0; job < jobs; ++job) {
+        const auto first = job * wordsPerJob;
+        const auto last = std::min(first + wordsPerJob, numWords);
+        futures.push_back(dispatchPool([&func, first, last]() { func(first, last); }));
+    }
+    for (const auto& f : futures) {
+        f.wait();
+    }
+}
+
+/**
+ * Evaluate \p pred for the first \p size elements of data and store the result in the bitmap.
+ * The bits of a word are assembled in a branch free inner loop that the compiler can vectorize.
+ */
+template <typename T, typename Pred>
+void fillBitmap(const T* data, size_t size, RowBitmap& bitmap, Pred pred) {
+    using Word = RowBitmap::Word;
+    Word* words = bitmap.words().data();
+    forEachWordRange(RowBitmap::numberOfWords(size), [&](size_t first, size_t last) {
+        for (size_t w = first; w < last; ++w) {
+            const size_t begin = w * RowBitmap::wordSize;
+            const size_t end = std::min(begin + RowBitmap::wordSize, size);
+            Word word = 0;
+            for (size_t i = begin; i < end; ++i) {
+                word |= static_cast<Word>(pred(data[i])) << (i - begin);
+            }
+            words[w] = word;
+        }
+    });
+}
+
+size_t findColumn(const DataFrame& dataFrame, const std::string& header) {
+    for (size_t i = 0; i < dataFrame.getNumberOfColumns(); ++i) {
+        if (dataFrame.getHeader(i) == header) return i;
+    }
+    throw Exception("DataFrame has no column \"" + header + "\"",
+                    IVW_CONTEXT_CUSTOM("DataFrameQuery"));
+}
+
+std::shared_ptr<const Column> getColumn(const DataFrame& dataFrame, size_t column) {
+    if (column >= dataFrame.getNumberOfColumns()) {
+        throw Exception("Column index " + std::to_string(column) + " out of range, DataFrame has " +
+                            std::to_string(dataFrame.getNumberOfColumns()) + " columns",
+                        IVW_CONTEXT_CUSTOM("DataFrameQuery"));
+    }
+    return dataFrame.getColumn(column);
+}
+
+RowBitmap evaluateRange(const DataFrame& dataFrame, size_t column, double min, double max) {
+    RowBitmap bitmap(dataFrame.getNumberOfRows());
+    auto col = getColumn(dataFrame, column);
+    auto bufferRAM = col->getBuffer()->getRepresentation<BufferRAM>();
+    if (bufferRAM->getDataFormat()->getComponents() != 1) {
+        throw Exception("Range queries require a scalar column, \"" + col->getHeader() +
+                            "\" is of type " + bufferRAM->getDataFormat()->getString(),
+                        IVW_CONTEXT_CUSTOM("DataFrameQuery"));
+    }
+    const auto size = std::min(bufferRAM->getSize(), bitmap.size());
+    if (!(min <= max)) return bitmap;
+
+    bufferRAM->dispatch<void, dispatching::filter::Scalars>([&](auto brprecision) {
+        using ValueType = util::PrecisionValueType<decltype(brprecision)>;
+        const ValueType* data = brprecision->getDataContainer().data();
+
+        if constexpr (std::is_integral<ValueType>::value) {
+            // compare in the value type of the column, with the bounds rounded inwards
+            using limits = std::numeric_limits<ValueType>;
+            const double lo = std::ceil(min);
+            const double hi = std::floor(max);
+            if (lo > hi || lo > static_cast<double>(limits::max()) ||
+                hi < static_cast<double>(limits::min())) {
+                return;
+            }
+            const auto lower = lo <= static_cast<double>(limits::min())
+                                   ? limits::min()
+                                   : static_cast<ValueType>(lo);
+            const auto upper = hi >= static_cast<double>(limits::max())
+                                   ? limits::max()
+                                   : static_cast<ValueType>(hi);
+            fillBitmap(data, size, bitmap,
+                       [lower, upper](ValueType v) { return v >= lower && v <= upper; });
+        } else {
+            fillBitmap(data, size, bitmap, [min, max](ValueType v) {
+                const auto d = static_cast<double>(v);
+                return d >= min && d <= max;
+            });
+        }
+    });
+    return bitmap;
+}
+
+RowBitmap evaluateOneOf(const DataFrame& dataFrame, size_t column,
+                        const std::vector<std::string>& categories) {
+    RowBitmap bitmap(dataFrame.getNumberOfRows());
+    auto col = getColumn(dataFrame, column);
+    auto categorical = std::dynamic_pointer_cast<const CategoricalColumn>(col);
+    if (!categorical) {
+        throw Exception("Category queries require a categorical column, \"" + col->getHeader() +
+                            "\" is not categorical",
+                        IVW_CONTEXT_CUSTOM("DataFrameQuery"));
+    }
+
+    // lookup table from category id to membership
+    const auto& columnCategories = categorical->getCategories();
+    std::vector<std::uint8_t> member(columnCategories.size(), 0);
+    for (size_t i = 0; i < columnCategories.size(); ++i) {
+        member[i] = std::find(categories.begin(), categories.end(), columnCategories[i]) !=
+                    categories.end();
+    }
+
+    const auto& data = categorical->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+    const auto size = std::min(data.size(), bitmap.size());
+    const auto numCategories = member.size();
+    const auto lut = member.data();
+    fillBitmap(data.data(), size, bitmap, [lut, numCategories](std::uint32_t id) {
+        return id < numCategories && lut[id] != 0;
+    });
+    return bitmap;
+}
+
+}  // namespace
+
+DataFrameView::DataFrameView(std::shared_ptr<const DataFrame> dataFrame,
+                             std::vector<std::uint32_t> rows)
+    : dataFrame_(std::move(dataFrame)), rows_(std::move(rows)) {}
+
+DataFrameView::DataFrameView(std::shared_ptr<const DataFrame> dataFrame,
+                             const RowBitmap& selection)
+    : DataFrameView(std::move(dataFrame), selection.indices()) {}
+
+std::shared_ptr<const DataFrame> DataFrameView::getDataFrame() const { return dataFrame_; }
+
+const std::vector<std::uint32_t>& DataFrameView::getRows() const { return rows_; }
+
+size_t DataFrameView::size() const { return rows_.size(); }
+
+bool DataFrameView::empty() const { return rows_.empty(); }
+
+std::uint32_t DataFrameView::operator[](size_t i) const { return rows_[i]; }
+
+std::vector<std::uint32_t>::const_iterator DataFrameView::begin() const { return rows_.begin(); }
+
+std::vector<std::uint32_t>::const_iterator DataFrameView::end() const { return rows_.end(); }
+
+DataFrameQuery::DataFrameQuery()
+    : evaluator_{[](const DataFrame& dataFrame) {
+        return RowBitmap(dataFrame.getNumberOfRows(), true);
+    }} {}
+
+DataFrameQuery::DataFrameQuery(Evaluator evaluator) : evaluator_{std::move(evaluator)} {}
+
+DataFrameQuery DataFrameQuery::range(size_t column, double min, double max) {
+    return DataFrameQuery{[column, min, max](const DataFrame& dataFrame) {
+        return evaluateRange(dataFrame, column, min, max);
+    }};
+}
+
+DataFrameQuery DataFrameQuery::range(const std::string& header, double min, double max) {
+    return DataFrameQuery{[header, min, max](const DataFrame& dataFrame) {
+        return evaluateRange(dataFrame, findColumn(dataFrame, header), min, max);
+    }};
+}
+
+DataFrameQuery DataFrameQuery::oneOf(size_t column, std::vector<std::string> categories) {
+    return DataFrameQuery{[column, categories = std::move(categories)](const DataFrame& dataFrame) {
+        return evaluateOneOf(dataFrame, column, categories);
+    }};
+}
+
+DataFrameQuery DataFrameQuery::oneOf(const std::string& header,
+                                     std::vector<std::string> categories) {
+    return DataFrameQuery{[header, categories = std::move(categories)](const DataFrame& dataFrame) {
+        return evaluateOneOf(dataFrame, findColumn(dataFrame, header), categories);
+    }};
+}
+
+RowBitmap DataFrameQuery::evaluate(const DataFrame& dataFrame) const {
+    return evaluator_(dataFrame);
+}
+
+size_t DataFrameQuery::count(const DataFrame& dataFrame) const {
+    return evaluate(dataFrame).count();
+}
+
+DataFrameView DataFrameQuery::select(std::shared_ptr<const DataFrame> dataFrame) const {
+    auto selection = evaluate(*dataFrame);
+    return DataFrameView(std::move(dataFrame), selection);
+}
+
+DataFrameQuery operator&&(DataFrameQuery lhs, DataFrameQuery rhs) {
+    return DataFrameQuery{[lhs = std::move(lhs.evaluator_),
+                           rhs = std::move(rhs.evaluator_)](const DataFrame& dataFrame) {
+        // Always evaluate both sides, such that invalid columns are reported independent of the
+        // data
+        auto result = lhs(dataFrame);
+        result &= rhs(dataFrame);
+        return result;
+    }};
+}
+
+DataFrameQuery operator||(DataFrameQuery lhs, DataFrameQuery rhs) {
+    return DataFrameQuery{[lhs = std::move(lhs.evaluator_),
+                           rhs = std::move(rhs.evaluator_)](const DataFrame& dataFrame) {
+        auto result = lhs(dataFrame);
+        result |= rhs(dataFrame);
+        return result;
+    }};
+}
+
+DataFrameQuery operator!(DataFrameQuery query) {
+    return DataFrameQuery{[eval = std::move(query.evaluator_)](const DataFrame& dataFrame) {
+        return ~eval(dataFrame);
+    }};
+}
+
+}  // namespace inviwo
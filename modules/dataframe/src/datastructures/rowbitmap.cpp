@@ -0,0 +1,166 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/datastructures/rowbitmap.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace {
+
+void checkSize(const RowBitmap& lhs, const RowBitmap& rhs) {
+    if (lhs.size() != rhs.size()) {
+        throw Exception("Size mismatch between RowBitmaps (" + std::to_string(lhs.size()) +
+                            " and " + std::to_string(rhs.size()) + ")",
+                        IVW_CONTEXT_CUSTOM("RowBitmap"));
+    }
+}
+
+}  // namespace
+
+RowBitmap::RowBitmap(size_t size, bool value)
+    : size_(size), words_(numberOfWords(size), value ? ~Word{0} : Word{0}) {
+    clearPadding();
+}
+
+void RowBitmap::setRange(size_t begin, size_t end, bool value) {
+    end = std::min(end, size_);
+    if (begin >= end) return;
+
+    const auto apply = [&](size_t word, Word mask) {
+        if (value) {
+            words_[word] |= mask;
+        } else {
+            words_[word] &= ~mask;
+        }
+    };
+    const auto firstWord = begin / wordSize;
+    const auto lastWord = (end - 1) / wordSize;
+    const Word firstMask = ~Word{0} << (begin % wordSize);
+    const Word lastMask = ~Word{0} >> (wordSize - 1 - (end - 1) % wordSize);
+
+    if (firstWord == lastWord) {
+        apply(firstWord, firstMask & lastMask);
+        return;
+    }
+    apply(firstWord, firstMask);
+    std::fill(words_.begin() + firstWord + 1, words_.begin() + lastWord,
+              value ? ~Word{0} : Word{0});
+    apply(lastWord, lastMask);
+}
+
+void RowBitmap::reset() { std::fill(words_.begin(), words_.end(), Word{0}); }
+
+RowBitmap& RowBitmap::flip() {
+    for (auto& word : words_) word = ~word;
+    clearPadding();
+    return *this;
+}
+
+size_t RowBitmap::count() const {
+    size_t sum = 0;
+    for (auto word : words_) sum += popcount(word);
+    return sum;
+}
+
+bool RowBitmap::any() const {
+    return std::any_of(words_.begin(), words_.end(), [](Word word) { return word != 0; });
+}
+
+bool RowBitmap::none() const { return !any(); }
+
+RowBitmap& RowBitmap::operator&=(const RowBitmap& rhs) {
+    checkSize(*this, rhs);
+    for (size_t i = 0; i < words_.size(); ++i) words_[i] &= rhs.words_[i];
+    return *this;
+}
+
+RowBitmap& RowBitmap::operator|=(const RowBitmap& rhs) {
+    checkSize(*this, rhs);
+    for (size_t i = 0; i < words_.size(); ++i) words_[i] |= rhs.words_[i];
+    return *this;
+}
+
+RowBitmap& RowBitmap::operator^=(const RowBitmap& rhs) {
+    checkSize(*this, rhs);
+    for (size_t i = 0; i < words_.size(); ++i) words_[i] ^= rhs.words_[i];
+    return *this;
+}
+
+RowBitmap& RowBitmap::subtract(const RowBitmap& rhs) {
+    checkSize(*this, rhs);
+    for (size_t i = 0; i < words_.size(); ++i) words_[i] &= ~rhs.words_[i];
+    return *this;
+}
+
+bool RowBitmap::operator==(const RowBitmap& rhs) const {
+    return size_ == rhs.size_ && words_ == rhs.words_;
+}
+
+bool RowBitmap::operator!=(const RowBitmap& rhs) const { return !(*this == rhs); }
+
+std::vector<std::uint32_t> RowBitmap::indices() const {
+    std::vector<std::uint32_t> result;
+    result.reserve(count());
+    forEach([&](size_t i) { result.push_back(static_cast<std::uint32_t>(i)); });
+    return result;
+}
+
+const std::vector<RowBitmap::Word>& RowBitmap::words() const { return words_; }
+
+std::vector<RowBitmap::Word>& RowBitmap::words() { return words_; }
+
+void RowBitmap::clearPadding() {
+    if (const auto rest = size_ % wordSize; rest != 0) {
+        words_.back() &= ~Word{0} >> (wordSize - rest);
+    }
+}
+
+RowBitmap operator&(RowBitmap lhs, const RowBitmap& rhs) {
+    lhs &= rhs;
+    return lhs;
+}
+
+RowBitmap operator|(RowBitmap lhs, const RowBitmap& rhs) {
+    lhs |= rhs;
+    return lhs;
+}
+
+RowBitmap operator^(RowBitmap lhs, const RowBitmap& rhs) {
+    lhs ^= rhs;
+    return lhs;
+}
+
+RowBitmap operator~(RowBitmap bitmap) {
+    bitmap.flip();
+    return bitmap;
+}
+
+}  // namespace inviwo
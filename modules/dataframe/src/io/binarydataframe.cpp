@@ -0,0 +1,363 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/io/binarydataframe.h>
+#include <inviwo/dataframe/datastructures/column.h>
+
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/datastructures/buffer/bufferdisk.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/formatdispatching.h>
+
+#include <array>
+#include <limits>
+#include <sstream>
+
+#include <zlib.h>
+
+namespace inviwo {
+
+namespace {
+
+constexpr std::array<char, 8> magic = {'I', 'V', 'W', 'D', 'F', 'R', 'A', 'M'};
+constexpr std::uint32_t version = 1;
+// magic, version, column count, row count, data offset
+constexpr std::uint64_t fixedHeaderSize = 8 + 4 + 4 + 8 + 8;
+
+enum class ColumnKind : std::uint8_t { Plain = 0, Categorical = 1 };
+
+template <typename T>
+void write(std::ostream& os, const T& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void write(std::ostream& os, const std::string& str) {
+    write(os, static_cast<std::uint32_t>(str.size()));
+    os.write(str.data(), str.size());
+}
+
+template <typename T>
+T read(std::istream& is) {
+    T value{};
+    is.read(reinterpret_cast<char*>(&value), sizeof(T));
+    if (!is) {
+        throw DataReaderException("Unexpected end of binary DataFrame header",
+                                  IVW_CONTEXT_CUSTOM("BinaryDataFrameReader"));
+    }
+    return value;
+}
+
+std::string readString(std::istream& is) {
+    const auto size = read<std::uint32_t>(is);
+    std::string str(size, '\0');
+    is.read(&str[0], size);
+    if (!is) {
+        throw DataReaderException("Unexpected end of binary DataFrame header",
+                                  IVW_CONTEXT_CUSTOM("BinaryDataFrameReader"));
+    }
+    return str;
+}
+
+/**
+ * Returns the zlib compressed data, or an empty vector if compression failed or did not
+ * reduce the size.
+ */
+std::vector<char> compress(const char* data, size_t size) {
+    if (size == 0 || size > std::numeric_limits<uLong>::max()) return {};
+    uLongf compressedSize = compressBound(static_cast<uLong>(size));
+    std::vector<char> compressed(compressedSize);
+    if (compress2(reinterpret_cast<Bytef*>(compressed.data()), &compressedSize,
+                  reinterpret_cast<const Bytef*>(data), static_cast<uLong>(size),
+                  Z_DEFAULT_COMPRESSION) != Z_OK ||
+        compressedSize >= size) {
+        return {};
+    }
+    compressed.resize(compressedSize);
+    return compressed;
+}
+
+struct LazyColumnDispatcher {
+    template <typename Result, typename Format>
+    Result operator()(DataFrame& dataFrame, const std::string& header,
+                      std::shared_ptr<BufferDisk> disk) {
+        using T = typename Format::type;
+        auto buffer = std::make_shared<Buffer<T>>(disk->getSize());
+        buffer->addRepresentation(disk);
+        dataFrame.addColumn<T>(header)->setBuffer(buffer);
+    }
+};
+
+}  // namespace
+
+BinaryDataFrameReader::BinaryDataFrameReader() {
+    addExtension(BinaryDataFrameWriter::extension);
+}
+
+BinaryDataFrameReader* BinaryDataFrameReader::clone() const {
+    return new BinaryDataFrameReader(*this);
+}
+
+std::shared_ptr<DataFrame> BinaryDataFrameReader::readData(const std::string& fileName) {
+    auto file = filesystem::ifstream(fileName, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        throw FileException(
+            std::string("BinaryDataFrameReader: Could not open file \"" + fileName + "\"."),
+            IVW_CONTEXT);
+    }
+    file.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<std::uint64_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+
+    const auto fileMagic = read<std::array<char, 8>>(file);
+    if (fileMagic != magic) {
+        throw DataReaderException("Not a binary DataFrame file: \"" + fileName + "\"",
+                                  IVW_CONTEXT);
+    }
+    const auto fileVersion = read<std::uint32_t>(file);
+    if (fileVersion != version) {
+        throw DataReaderException("Unsupported binary DataFrame version " +
+                                      std::to_string(fileVersion) + " in \"" + fileName + "\"",
+                                  IVW_CONTEXT);
+    }
+    const auto columnCount = read<std::uint32_t>(file);
+    const auto rowCount = read<std::uint64_t>(file);
+    const auto dataOffset = read<std::uint64_t>(file);
+    if (rowCount > std::numeric_limits<std::uint32_t>::max()) {
+        throw DataReaderException("Too many rows in binary DataFrame \"" + fileName + "\"",
+                                  IVW_CONTEXT);
+    }
+
+    auto dataFrame = std::make_shared<DataFrame>(static_cast<std::uint32_t>(rowCount));
+    for (std::uint32_t i = 0; i < columnCount; ++i) {
+        const auto header = readString(file);
+        const auto kind = static_cast<ColumnKind>(read<std::uint8_t>(file));
+        const auto compression = static_cast<DataFrameCompression>(read<std::uint8_t>(file));
+        const auto formatId = static_cast<DataFormatId>(read<std::uint32_t>(file));
+        const auto size = read<std::uint64_t>(file);
+        const auto offset = dataOffset + read<std::uint64_t>(file);
+        const auto storedSize = read<std::uint64_t>(file);
+
+        const auto format = DataFormatBase::get(formatId);
+        if (!format || format->getComponents() != 1) {
+            throw DataReaderException("Unsupported data format of column \"" + header + "\"",
+                                      IVW_CONTEXT);
+        }
+        if (compression != DataFrameCompression::None &&
+            compression != DataFrameCompression::Zlib) {
+            throw DataReaderException("Unsupported compression of column \"" + header + "\"",
+                                      IVW_CONTEXT);
+        }
+        if (offset + storedSize > fileSize) {
+            throw DataReaderException("Data of column \"" + header + "\" exceeds file size",
+                                      IVW_CONTEXT);
+        }
+
+        auto disk = std::make_shared<BufferDisk>(fileName, static_cast<size_t>(size), format);
+        disk->setLoader(new BinaryDataFrameColumnLoader(
+            fileName, offset, storedSize, compression, static_cast<size_t>(size), format));
+
+        if (kind == ColumnKind::Categorical) {
+            if (formatId != DataFormatId::UInt32) {
+                throw DataReaderException(
+                    "Categorical column \"" + header + "\" has to be of type uint32",
+                    IVW_CONTEXT);
+            }
+            std::vector<std::string> categories(read<std::uint32_t>(file));
+            for (auto& category : categories) category = readString(file);
+
+            auto col = dataFrame->addCategoricalColumn(header);
+            // register the categories while the column still holds its empty RAM buffer
+            col->append({}, categories);
+            auto buffer = std::make_shared<Buffer<std::uint32_t>>(static_cast<size_t>(size));
+            buffer->addRepresentation(disk);
+            col->setBuffer(buffer);
+        } else {
+            dispatching::dispatch<void, dispatching::filter::Scalars>(
+                formatId, LazyColumnDispatcher{}, *dataFrame, header, disk);
+        }
+    }
+
+    return dataFrame;
+}
+
+const FileExtension BinaryDataFrameWriter::extension{"ivdf", "Inviwo Binary DataFrame"};
+
+BinaryDataFrameWriter::BinaryDataFrameWriter(DataFrameCompression compression)
+    : compression_(compression) {}
+
+void BinaryDataFrameWriter::setCompression(DataFrameCompression compression) {
+    compression_ = compression;
+}
+
+DataFrameCompression BinaryDataFrameWriter::getCompression() const { return compression_; }
+
+void BinaryDataFrameWriter::writeData(const DataFrame& dataFrame,
+                                      const std::string& filePath) const {
+    struct Block {
+        const char* data;
+        std::uint64_t size;
+        std::vector<char> compressed;
+    };
+    std::vector<Block> blocks;
+
+    // column 0 is the index column, which is recreated when reading
+    std::ostringstream entries;
+    std::uint64_t offset = 0;
+    for (size_t i = 1; i < dataFrame.getNumberOfColumns(); ++i) {
+        auto col = dataFrame.getColumn(i);
+        auto bufferRAM = col->getBuffer()->getRepresentation<BufferRAM>();
+        const auto format = bufferRAM->getDataFormat();
+        if (format->getComponents() != 1) {
+            throw Exception("Column \"" + col->getHeader() + "\" of type " +
+                                format->getString() + " is not supported, only scalar types",
+                            IVW_CONTEXT);
+        }
+        auto categorical = dynamic_cast<const CategoricalColumn*>(col.get());
+
+        Block block{static_cast<const char*>(bufferRAM->getData()),
+                    bufferRAM->getSize() * format->getSize(),
+                    {}};
+        if (compression_ == DataFrameCompression::Zlib) {
+            block.compressed = compress(block.data, static_cast<size_t>(block.size));
+        }
+        const auto compression = block.compressed.empty() ? DataFrameCompression::None
+                                                          : DataFrameCompression::Zlib;
+        const std::uint64_t storedSize =
+            block.compressed.empty() ? block.size : block.compressed.size();
+
+        write(entries, col->getHeader());
+        write(entries, static_cast<std::uint8_t>(categorical ? ColumnKind::Categorical
+                                                             : ColumnKind::Plain));
+        write(entries, static_cast<std::uint8_t>(compression));
+        write(entries, static_cast<std::uint32_t>(format->getId()));
+        write(entries, static_cast<std::uint64_t>(bufferRAM->getSize()));
+        write(entries, offset);
+        write(entries, storedSize);
+        if (categorical) {
+            const auto& categories = categorical->getCategories();
+            write(entries, static_cast<std::uint32_t>(categories.size()));
+            for (const auto& category : categories) write(entries, category);
+        }
+
+        offset += storedSize;
+        blocks.push_back(std::move(block));
+    }
+
+    auto file = filesystem::ofstream(filePath, std::ios::out | std::ios::binary);
+    if (!file.is_open()) {
+        throw FileException("Could not open file \"" + filePath + "\" for writing",
+                            IVW_CONTEXT);
+    }
+
+    const auto header = entries.str();
+    file.write(magic.data(), magic.size());
+    write(file, version);
+    write(file, static_cast<std::uint32_t>(blocks.size()));
+    write(file, static_cast<std::uint64_t>(dataFrame.getNumberOfRows()));
+    write(file, fixedHeaderSize + static_cast<std::uint64_t>(header.size()));
+    file.write(header.data(), header.size());
+    for (const auto& block : blocks) {
+        if (block.compressed.empty()) {
+            file.write(block.data, block.size);
+        } else {
+            file.write(block.compressed.data(), block.compressed.size());
+        }
+    }
+    if (!file) {
+        throw FileException("Error writing to file \"" + filePath + "\"", IVW_CONTEXT);
+    }
+}
+
+BinaryDataFrameColumnLoader::BinaryDataFrameColumnLoader(const std::string& fileName,
+                                                         std::uint64_t offset,
+                                                         std::uint64_t storedSize,
+                                                         DataFrameCompression compression,
+                                                         size_t size,
+                                                         const DataFormatBase* format)
+    : fileName_(fileName)
+    , offset_(offset)
+    , storedSize_(storedSize)
+    , compression_(compression)
+    , size_(size)
+    , format_(format) {}
+
+BinaryDataFrameColumnLoader* BinaryDataFrameColumnLoader::clone() const {
+    return new BinaryDataFrameColumnLoader(*this);
+}
+
+std::shared_ptr<BufferRepresentation> BinaryDataFrameColumnLoader::createRepresentation() const {
+    auto bufferRAM = createBufferRAM(size_, format_, BufferUsage::Static, BufferTarget::Data);
+    readInto(bufferRAM->getData());
+    return bufferRAM;
+}
+
+void BinaryDataFrameColumnLoader::updateRepresentation(
+    std::shared_ptr<BufferRepresentation> dest) const {
+    auto bufferRAM = std::static_pointer_cast<BufferRAM>(dest);
+    bufferRAM->setSize(size_);
+    readInto(bufferRAM->getData());
+}
+
+void BinaryDataFrameColumnLoader::readInto(void* dest) const {
+    const std::uint64_t rawSize = size_ * format_->getSize();
+    if (rawSize == 0) return;
+
+    auto file = filesystem::ifstream(fileName_, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        throw FileException("Could not open file \"" + fileName_ + "\"", IVW_CONTEXT);
+    }
+    file.seekg(offset_);
+
+    if (compression_ == DataFrameCompression::None) {
+        if (storedSize_ != rawSize) {
+            throw DataReaderException("Invalid column size in \"" + fileName_ + "\"",
+                                      IVW_CONTEXT);
+        }
+        file.read(static_cast<char*>(dest), rawSize);
+        if (!file) {
+            throw DataReaderException("Could not read column data from \"" + fileName_ + "\"",
+                                      IVW_CONTEXT);
+        }
+    } else {
+        std::vector<char> compressed(storedSize_);
+        file.read(compressed.data(), storedSize_);
+        uLongf destSize = static_cast<uLongf>(rawSize);
+        if (!file ||
+            uncompress(static_cast<Bytef*>(dest), &destSize,
+                       reinterpret_cast<const Bytef*>(compressed.data()),
+                       static_cast<uLong>(storedSize_)) != Z_OK ||
+            destSize != rawSize) {
+            throw DataReaderException(
+                "Could not decompress column data from \"" + fileName_ + "\"", IVW_CONTEXT);
+        }
+    }
+}
+
+}  // namespace inviwo
@@ -31,17 +31,316 @@
 
 #include <inviwo/dataframe/datastructures/column.h>
 #include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/stringconversion.h>
 
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <deque>
 #include <fstream>
+#include <future>
+#include <locale>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
 
 namespace inviwo {
 
+namespace {
+
+/**
+ * Extracts fields from an in-memory CSV buffer. Fields are returned as views into the buffer,
+ * only fields containing CR line breaks inside quotes have to be copied to normalize the line
+ * breaks.
+ */
+class CSVParser {
+public:
+    CSVParser(const char* begin, const char* end, const std::string& delimiters, size_t line)
+        : cur_{begin}, end_{end}, line_{line} {
+        isDelimiter_.fill(false);
+        for (auto c : delimiters) isDelimiter_[static_cast<unsigned char>(c)] = true;
+    }
+
+    /**
+     * extract exactly one field from the current position, the bool return value indicates
+     * whether a line break was detected following the field
+     */
+    std::pair<std::string_view, bool> extractField() {
+        const char* begin = cur_;
+        size_t quoteCount = 0;
+        size_t quoteBeginLine = 0;
+        bool hasCR = false;
+        char prev = 0;
+
+        while (cur_ != end_) {
+            const char* pos = cur_;
+            char ch = *cur_++;
+            const bool cr = ch == '\r';
+            const bool linebreak = cr || ch == '\n';
+            if (cr && cur_ != end_ && *cur_ == '\n') {
+                // consume potential LF (\n) following CR (\r)
+                ++cur_;
+            }
+            if (linebreak) {
+                ++line_;
+                ch = '\n';
+                // consume line break, if inside quotes
+                if ((quoteCount & 1) != 0) {
+                    hasCR |= cr;
+                    prev = ch;
+                    continue;
+                }
+            }
+            if (ch == '"') {  // found a quote
+                if (quoteCount == 0) quoteBeginLine = line_;
+                ++quoteCount;
+            } else if (isDelimiter_[static_cast<unsigned char>(ch)] || linebreak) {
+                // found a delimiter/newline, ensure that it isn't enclosed by quotes,
+                // i.e. a quote count of 0 or an even count of quotes if the previous
+                // character was a quote
+                if ((quoteCount == 0) || ((prev == '"') && ((quoteCount & 1) == 0))) {
+                    return {value(begin, pos, hasCR), linebreak};
+                }
+            }
+            hasCR |= cr;
+            prev = ch;
+        }
+        eof_ = true;
+        if ((quoteCount & 1) != 0) {
+            throw CSVDataReaderException("Unmatched quotes (starting in line " +
+                                         std::to_string(quoteBeginLine) + ")");
+        }
+        return {value(begin, end_, hasCR), false};
+    }
+
+    bool eof() const { return eof_; }
+    size_t line() const { return line_; }
+    const char* position() const { return cur_; }
+    void clearStorage() { storage_.clear(); }
+
+private:
+    std::string_view value(const char* begin, const char* end, bool hasCR) {
+        if (!hasCR) return std::string_view(begin, end - begin);
+        // Store CR and CRLF line breaks inside quotes as LF
+        auto& str = storage_.emplace_back();
+        for (auto it = begin; it != end; ++it) {
+            if (*it == '\r') {
+                str += '\n';
+                if (it + 1 != end && *(it + 1) == '\n') ++it;
+            } else {
+                str += *it;
+            }
+        }
+        return str;
+    }
+
+    const char* cur_;
+    const char* end_;
+    size_t line_;
+    bool eof_ = false;
+    std::array<bool, 256> isDelimiter_;
+    std::deque<std::string> storage_;
+};
+
+std::string_view trimView(std::string_view str) {
+    const auto isSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+    while (!str.empty() && isSpace(str.front())) str.remove_prefix(1);
+    while (!str.empty() && isSpace(str.back())) str.remove_suffix(1);
+    return str;
+}
+
+/**
+ * extract one row from the current position into values, returns false if the end of the data
+ * was reached. Empty lines result in an empty row.
+ */
+bool extractRow(CSVParser& parser, std::vector<std::string_view>& values,
+                size_t maxColCount = std::numeric_limits<size_t>::max()) {
+    values.clear();
+    parser.clearStorage();
+
+    auto val = parser.extractField();
+    if (parser.eof() && val.first.empty()) {
+        // reached end of file, no more data
+        return false;
+    } else if (val.first.empty() && val.second) {
+        // empty line, ignore
+        return true;
+    }
+    values.push_back(val.first);
+    while (!val.second && !parser.eof()) {
+        val = parser.extractField();
+        values.push_back(trimView(val.first));
+    }
+    // ignore last field _if_ it is empty and would be inserted in the maxColCount+1 column
+    if (values.back().empty() && (values.size() - 1 == maxColCount)) {
+        values.pop_back();
+    } else if ((values.size() != maxColCount) &&
+               (maxColCount != std::numeric_limits<size_t>::max())) {
+        // mismatch in the number of columns
+        throw CSVDataReaderException("Column counts do not match (line " +
+                                     std::to_string(parser.line()) + ": " +
+                                     std::to_string(values.size()) + " fields; DataFrame has " +
+                                     std::to_string(maxColCount) + " columns)");
+    }
+    return true;
+}
+
+std::vector<std::string> toStrings(const std::vector<std::string_view>& values) {
+    return std::vector<std::string>(values.begin(), values.end());
+}
+
+/**
+ * Parse a float like `std::istream >> float` in the classic "C" locale: leading white space and
+ * an optional sign followed by decimal digits with '.' as decimal point and an optional exponent.
+ * Trailing characters are ignored, the global C and C++ locales are not used. Anything else,
+ * including "inf", "nan" and out of range values, results in NaN. Hexadecimal floats are not
+ * recognized, "0x1p3" reads as 0.
+ */
+float parseFloat(std::string_view str) {
+    constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+    str = trimView(str);
+    size_t first = 0;
+    if (!str.empty() && str.front() == '+') {
+        str.remove_prefix(1);
+    } else if (!str.empty() && str.front() == '-') {
+        first = 1;
+    }
+    if (first >= str.size() ||
+        !(std::isdigit(static_cast<unsigned char>(str[first])) || str[first] == '.')) {
+        return nan;
+    }
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    float result = 0.0f;
+    const auto res = std::from_chars(str.data(), str.data() + str.size(), result);
+    return res.ec == std::errc{} ? result : nan;
+#else
+    // No floating point from_chars in this standard library
+    std::istringstream stream{std::string(str)};
+    stream.imbue(std::locale::classic());
+    float result = 0.0f;
+    stream >> result;
+    return stream.fail() ? nan : result;
+#endif
+}
+
+/**
+ * A part of the data starting and ending at a record boundary
+ */
+struct Chunk {
+    const char* begin;
+    const char* end;
+    size_t line;  // line number at begin
+};
+
+/**
+ * Split the data into about count chunks at record boundaries. This is a light-weight sequential
+ * pass applying the same quoting rules as CSVParser::extractField without extracting any values.
+ */
+std::vector<Chunk> findChunks(const char* begin, const char* end, size_t line, size_t count,
+                              const std::string& delimiters) {
+    std::array<bool, 256> isDelimiter;
+    isDelimiter.fill(false);
+    for (auto c : delimiters) isDelimiter[static_cast<unsigned char>(c)] = true;
+
+    const size_t size = static_cast<size_t>(end - begin);
+    std::vector<Chunk> chunks;
+    Chunk current{begin, begin, line};
+
+    size_t quoteCount = 0;
+    char prev = 0;
+    const char* cur = begin;
+    while (cur != end && chunks.size() + 1 < count) {
+        char ch = *cur++;
+        const bool linebreak = ch == '\r' || ch == '\n';
+        if (ch == '\r' && cur != end && *cur == '\n') ++cur;
+        if (linebreak) {
+            ++line;
+            ch = '\n';
+            if ((quoteCount & 1) != 0) {
+                prev = ch;
+                continue;
+            }
+        }
+        if (ch == '"') {
+            ++quoteCount;
+        } else if (isDelimiter[static_cast<unsigned char>(ch)] || linebreak) {
+            if ((quoteCount == 0) || ((prev == '"') && ((quoteCount & 1) == 0))) {
+                quoteCount = 0;
+                if (linebreak &&
+                    static_cast<size_t>(cur - begin) >= size * (chunks.size() + 1) / count) {
+                    current.end = cur;
+                    chunks.push_back(current);
+                    current = Chunk{cur, cur, line};
+                }
+                prev = 0;
+                continue;
+            }
+        }
+        prev = ch;
+    }
+    current.end = end;
+    chunks.push_back(current);
+    return chunks;
+}
+
+/**
+ * Column values of one chunk, categorical values are stored as indices into a chunk local list of
+ * categories which is merged once all chunks are done.
+ */
+struct ChunkColumn {
+    bool categorical = false;
+    std::vector<float> values;
+    std::vector<std::uint32_t> ids;
+    std::vector<std::string> categories;
+    std::unordered_map<std::string, std::uint32_t> lookup;
+};
+
+std::vector<ChunkColumn> parseChunk(const Chunk& chunk, const std::vector<bool>& categorical,
+                                    const std::string& delimiters) {
+    std::vector<ChunkColumn> columns(categorical.size());
+    for (size_t i = 0; i < categorical.size(); ++i) columns[i].categorical = categorical[i];
+
+    CSVParser parser(chunk.begin, chunk.end, delimiters, chunk.line);
+    std::vector<std::string_view> row;
+    while (extractRow(parser, row, categorical.size())) {
+        // Do not add empty rows, i.e. rows with only delimiters (,,,,) or newline
+        if (std::all_of(row.begin(), row.end(), [](const auto& a) { return a.empty(); })) {
+            continue;
+        }
+        for (size_t i = 0; i < row.size(); ++i) {
+            auto& col = columns[i];
+            if (col.categorical) {
+                auto res = col.lookup.emplace(std::string(row[i]),
+                                              static_cast<std::uint32_t>(col.categories.size()));
+                if (res.second) col.categories.push_back(res.first->first);
+                col.ids.push_back(res.first->second);
+            } else {
+                col.values.push_back(parseFloat(row[i]));
+            }
+        }
+    }
+    return columns;
+}
+
+size_t numberOfChunks(size_t size, size_t minChunkSize) {
+    // Only split large inputs, smaller ones are not worth the overhead
+    const size_t count = std::max<size_t>(1, size / std::max<size_t>(1, minChunkSize));
+    if (!InviwoApplication::isInitialized()) return count;
+    // Without pool threads the chunks are parsed one after another
+    const size_t threads = InviwoApplication::getPtr()->getPoolSize();
+    return threads == 0 ? count : std::min(count, 4 * threads);
+}
+
+}  // namespace
+
 CSVDataReaderException::CSVDataReaderException(const std::string& message, ExceptionContext context)
     : DataReaderException("CSVReader: " + message, context) {}
 
-CSVReader::CSVReader() : DataReaderType<DataFrame>(), delimiters_(","), firstRowHeader_(true) {
+CSVReader::CSVReader()
+    : DataReaderType<DataFrame>(), delimiters_(","), firstRowHeader_(true), minChunkSize_(1 << 20) {
     addExtension(FileExtension("csv", "Comma Separated Values"));
 }
 
@@ -51,8 +350,10 @@ void CSVReader::setDelimiters(const std::string& delim) { delimiters_ = delim; }
 
 void CSVReader::setFirstRowHeader(bool hasHeader) { firstRowHeader_ = hasHeader; }
 
+void CSVReader::setMinChunkSize(size_t bytes) { minChunkSize_ = bytes; }
+
 std::shared_ptr<DataFrame> CSVReader::readData(const std::string& fileName) {
-    auto file = filesystem::ifstream(fileName);
+    auto file = filesystem::ifstream(fileName, std::ios::in | std::ios::binary);
 
     if (!file.is_open()) {
         throw FileException(std::string("CSVReader: Could not open file \"" + fileName + "\"."),
@@ -77,137 +378,63 @@ std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
         throw CSVDataReaderException("Input stream in a bad state", IVW_CONTEXT);
     }
 
-    // create a string stream from input stream for buffering
-    std::stringstream in;
-    in << stream.rdbuf();
-    if (in.fail()) {
+    // read the remaining stream in one go, if the stream is seekable its size is known upfront
+    std::string data;
+    const auto start = stream.tellg();
+    stream.seekg(0, std::ios::end);
+    const auto stop = stream.tellg();
+    stream.seekg(start);
+    if (start != std::streampos(-1) && stop != std::streampos(-1) && stream.good()) {
+        data.resize(static_cast<size_t>(stop - start));
+        stream.read(&data[0], data.size());
+        data.resize(static_cast<size_t>(stream.gcount()));
+    } else {
+        stream.clear();
+        data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+    if (data.empty()) {
         throw CSVDataReaderException("No data", IVW_CONTEXT);
     }
 
-    // current line
-    size_t lineNumber = 1u;
-
-    // extract exactly one field from the current stream position, the bool return value indicates
-    // whether a line break was detected following the field
-    auto extractField = [&in, &lineNumber, delims = delimiters_]() -> std::pair<std::string, bool> {
-        std::string value;
-        size_t quoteCount = 0;
-        size_t quoteBeginLine = 0;
-        char prev = 0;
-
-        auto isLineBreak = [](const char ch, std::istream& stream) {
-            if (ch == '\r') {
-                // consume potential LF (\n) following CR (\r)
-                if (stream.peek() == '\n') {
-                    stream.get();
-                }
-                return true;
-            } else {
-                return (ch == '\n');
-            }
-        };
+    return parse(data);
+}
 
-        char ch;
-        while (in.get(ch) && in.good()) {
-            bool linebreak = isLineBreak(ch, in);
-            if (linebreak) {
-                ++lineNumber;  // increase line counter
-                // ensure that ch is equal to '\n'
-                ch = '\n';
-                // consume line break, if inside quotes
-                if ((quoteCount & 1) != 0) {
-                    value += ch;
-                    prev = ch;
-                    continue;
-                }
-            }
-            if (ch == '"') {  // found a quote
-                if (quoteCount == 0) quoteBeginLine = lineNumber;
-                ++quoteCount;
-            } else if (util::contains(delims, ch) || linebreak) {
-                // found a delimiter/newline, ensure that it isn't enclosed by quotes,
-                // i.e. a quote count of 0 or an even count of quotes if the previous
-                // character was a quote
-                if ((quoteCount == 0) || ((prev == '"') && ((quoteCount & 1) == 0))) {
-                    return {value, linebreak};
-                }
-            }
-            prev = ch;
-            value += ch;
-        }
-        if (((quoteCount & 1) != 0) && in.eof()) {
-            throw CSVDataReaderException("Unmatched quotes (starting in line " +
-                                         std::to_string(quoteBeginLine) + ")");
-        }
-        return {value, false};
-    };
-
-    // extract one row from the current stream position, the bool return value indicates whether
-    // the end-of-file was detected
-    auto extractRow = [&in, extractField,
-                       &lineNumber](size_t maxColCount = std::numeric_limits<size_t>::max())
-        -> std::pair<std::vector<std::string>, bool> {
-        auto val = extractField();
-        if (in.eof() && val.first.empty()) {
-            // reached end of file, no more data
-            return {{}, true};
-        } else if (val.first.empty() && val.second) {
-            // empty line, ignore
-            return {{}, false};
-        }
-        std::vector<std::string> values;
-        values.push_back(val.first);
-        while (!val.second && !in.eof()) {
-            val = extractField();
-            values.push_back(trim(val.first));
-        }
-        // ignore last field _if_ it is empty and would be inserted in the maxColCount+1 column
-        if (values.back().empty() && (values.size() - 1 == maxColCount)) {
-            values.resize(values.size() - 1);
-        } else if ((values.size() != maxColCount) &&
-                   (maxColCount != std::numeric_limits<size_t>::max())) {
-            // mismatch in the number of columns
-            throw CSVDataReaderException("Column counts do not match (line " +
-                                         std::to_string(lineNumber) + ": " +
-                                         std::to_string(values.size()) + " fields; DataFrame has " +
-                                         std::to_string(maxColCount) + " columns)");
-        }
-        return {values, false};
-    };
+std::shared_ptr<DataFrame> CSVReader::parse(const std::string& data) const {
+    const char* begin = data.data();
+    const char* end = data.data() + data.size();
+    CSVParser parser(begin, end, delimiters_, 1u);
+    std::vector<std::string_view> row;
 
     std::vector<std::string> headers;
     size_t maxColCount = std::numeric_limits<size_t>::max();
     if (firstRowHeader_) {
         // read headers
-        auto row = extractRow();
-        if (row.second || row.first.empty()) {
+        if (!extractRow(parser, row) || row.empty()) {
             throw CSVDataReaderException("Empty file, column headers not found");
         }
-        headers = row.first;
+        headers = toStrings(row);
         maxColCount = headers.size();
     }
 
+    // Remember the start of the data, the example rows are parsed again as part of the data
+    CSVParser dataStart = parser;
+
     std::vector<std::vector<std::string>> exampleRows;
     std::vector<size_t> exampleLineNumbers;  // line numbers matching the example rows
-    std::streampos streamPos = in.tellg();
     for (auto exampleRow = 0u; exampleRow < 50u; ++exampleRow) {
-        size_t currentLine = lineNumber;
-        auto row = extractRow(maxColCount);
-        if (row.second) {
+        size_t currentLine = parser.line();
+        if (!extractRow(parser, row, maxColCount)) {
             // reached end-of-file
             if (exampleRow == 0) {
                 throw CSVDataReaderException("Empty file, no data");
             }
-            in.clear();  // clear eof-bit
             break;
-        } else if (!row.first.empty()) {  // ignore empty lines
-            exampleRows.emplace_back(row.first);
+        } else if (!row.empty()) {  // ignore empty lines
+            exampleRows.emplace_back(toStrings(row));
             exampleLineNumbers.emplace_back(currentLine);
         }
     }
 
-    // Rewind to start position
-    in.seekg(streamPos, std::ios::beg);
     if (!firstRowHeader_) {
         // assign default column headers
         for (size_t i = 0; i < exampleRows.front().size(); ++i) {
@@ -230,20 +457,72 @@ std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
 
     auto dataFrame = createDataFrame(exampleRows, headers);
 
-    size_t rowIndex = firstRowHeader_ ? 1 : 0;
-    auto row = extractRow(maxColCount);
-    while (!row.second) {
-        // Do not add empty rows, i.e. rows with only delimiters (,,,,) or newline
-        auto emptyIt = std::find_if(std::begin(row.first), std::end(row.first),
-                                    [](const auto& a) { return !a.empty(); });
-        if (emptyIt != row.first.end()) {
-            // May throw DataTypeMismatch, but do not catch it here since it indicates
-            // that the DataFrame is in an invalid state
-            dataFrame->addRow(row.first);
+    std::vector<bool> categorical;
+    for (size_t i = 1; i < dataFrame->getNumberOfColumns(); ++i) {
+        categorical.push_back(
+            static_cast<bool>(std::dynamic_pointer_cast<CategoricalColumn>(dataFrame->getColumn(i))));
+    }
+
+    // Split the data at record boundaries and parse the chunks concurrently
+    const char* dataBegin = dataStart.position();
+    const auto chunks =
+        findChunks(dataBegin, end, dataStart.line(),
+                   numberOfChunks(static_cast<size_t>(end - dataBegin), minChunkSize_), delimiters_);
+
+    std::vector<std::vector<ChunkColumn>> results(chunks.size());
+    if (chunks.size() == 1 || !InviwoApplication::isInitialized()) {
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            results[i] = parseChunk(chunks[i], categorical, delimiters_);
+        }
+    } else {
+        std::vector<std::future<void>> futures;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            futures.push_back(dispatchPool([&, i]() {
+                results[i] = parseChunk(chunks[i], categorical, delimiters_);
+            }));
         }
-        row = extractRow(maxColCount);
-        ++rowIndex;
+        // Wait for all chunks before rethrowing any errors, in order of appearance
+        for (auto& f : futures) f.wait();
+        for (auto& f : futures) f.get();
     }
+
+    // Merge the chunks into the columns of the DataFrame
+    for (size_t i = 0; i < categorical.size(); ++i) {
+        auto column = dataFrame->getColumn(i + 1);
+        if (categorical[i]) {
+            std::vector<std::string> categories;
+            std::unordered_map<std::string, std::uint32_t> lookup;
+            std::vector<std::uint32_t> ids;
+            for (auto& result : results) {
+                auto& col = result[i];
+                std::vector<std::uint32_t> translation;
+                for (auto& category : col.categories) {
+                    auto res = lookup.emplace(category, static_cast<std::uint32_t>(lookup.size()));
+                    if (res.second) categories.push_back(category);
+                    translation.push_back(res.first->second);
+                }
+                std::transform(col.ids.begin(), col.ids.end(), std::back_inserter(ids),
+                               [&](std::uint32_t id) { return translation[id]; });
+                col = ChunkColumn{};
+            }
+            std::static_pointer_cast<CategoricalColumn>(column)->append(ids, categories);
+        } else {
+            auto& values = std::static_pointer_cast<TemplateColumn<float>>(column)
+                               ->getTypedBuffer()
+                               ->getEditableRAMRepresentation()
+                               ->getDataContainer();
+            for (auto& result : results) {
+                auto& col = result[i];
+                if (values.empty()) {
+                    values = std::move(col.values);
+                } else {
+                    values.insert(values.end(), col.values.begin(), col.values.end());
+                }
+                col = ChunkColumn{};
+            }
+        }
+    }
+
     dataFrame->updateIndexBuffer();
     return dataFrame;
 }
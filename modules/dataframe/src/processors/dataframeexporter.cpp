@@ -29,6 +29,7 @@
 
 #include <inviwo/dataframe/processors/dataframeexporter.h>
 #include <inviwo/dataframe/datastructures/dataframeutil.h>
+#include <inviwo/dataframe/io/binarydataframe.h>
 
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/ostreamjoiner.h>
@@ -40,17 +41,19 @@ namespace inviwo {
 
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
 const ProcessorInfo DataFrameExporter::processorInfo_{
-    "org.inviwo.DataFrameExporter",      // Class identifier
-    "DataFrame Exporter",                // Display name
-    "Data Output",                       // Category
-    CodeState::Stable,                   // Code state
-    "CPU, DataFrame, Export, CSV, XML",  // Tags
+    "org.inviwo.DataFrameExporter",              // Class identifier
+    "DataFrame Exporter",                        // Display name
+    "Data Output",                               // Category
+    CodeState::Stable,                           // Code state
+    "CPU, DataFrame, Export, CSV, XML, Binary",  // Tags
 };
 
 const ProcessorInfo DataFrameExporter::getProcessorInfo() const { return processorInfo_; }
 
 FileExtension DataFrameExporter::csvExtension_ = FileExtension("csv", "CSV");
 FileExtension DataFrameExporter::xmlExtension_ = FileExtension("xml", "XML");
+FileExtension DataFrameExporter::binaryExtension_ =
+    FileExtension("ivdf", "Inviwo Binary DataFrame");
 
 DataFrameExporter::DataFrameExporter()
     : Processor()
@@ -63,11 +66,13 @@ DataFrameExporter::DataFrameExporter()
                                       "Separate Vector Types Into Columns", true)
     , quoteStrings_("quoteStrings", "Quote Strings", true)
     , delimiter_("delimiter", "Delimiter", ",")
+    , compressBinary_("compressBinary", "Compress Binary Columns", true)
     , export_(false) {
 
     exportFile_.clearNameFilters();
     exportFile_.addNameFilter(csvExtension_);
     exportFile_.addNameFilter(xmlExtension_);
+    exportFile_.addNameFilter(binaryExtension_);
 
     addPort(dataFrame_);
     addProperty(exportFile_);
@@ -77,11 +82,14 @@ DataFrameExporter::DataFrameExporter()
     addProperty(separateVectorTypesIntoColumns_);
     addProperty(quoteStrings_);
     addProperty(delimiter_);
+    addProperty(compressBinary_);
 
     exportFile_.setAcceptMode(AcceptMode::Save);
     exportFile_.onChange([this]() {
-        separateVectorTypesIntoColumns_.setReadOnly(exportFile_.getSelectedExtension().extension_ ==
-                                                    xmlExtension_.extension_);
+        const auto& ext = exportFile_.getSelectedExtension().extension_;
+        separateVectorTypesIntoColumns_.setReadOnly(ext == xmlExtension_.extension_ ||
+                                                    ext == binaryExtension_.extension_);
+        compressBinary_.setReadOnly(ext != binaryExtension_.extension_);
     });
     exportButton_.onChange([&]() { export_ = true; });
 
@@ -100,6 +108,8 @@ void DataFrameExporter::exportNow() {
     }
     if (exportFile_.getSelectedExtension() == xmlExtension_) {
         exportAsXML();
+    } else if (exportFile_.getSelectedExtension() == binaryExtension_) {
+        exportAsBinary();
     } else if (exportFile_.getSelectedExtension() == csvExtension_) {
         exportAsCSV(separateVectorTypesIntoColumns_);
     } else {
@@ -215,4 +225,11 @@ void DataFrameExporter::exportAsXML() {
     LogInfo("XML file exported to " << exportFile_);
 }
 
+void DataFrameExporter::exportAsBinary() {
+    BinaryDataFrameWriter writer(compressBinary_ ? DataFrameCompression::Zlib
+                                                 : DataFrameCompression::None);
+    writer.writeData(*dataFrame_.getData(), exportFile_);
+    LogInfo("Binary DataFrame exported to " << exportFile_);
+}
+
 }  // namespace inviwo
@@ -0,0 +1,112 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/common/coremodulesharedlibrary.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/consolelogger.h>
+#include <inviwo/core/util/raiiutils.h>
+#include <inviwo/dataframe/io/csvreader.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <benchmark/benchmark.h>
+#include <warn/pop>
+
+#include <array>
+#include <random>
+#include <sstream>
+
+using namespace inviwo;
+
+namespace {
+
+std::string makeCSV(size_t rows) {
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> real(-1000.0, 1000.0);
+    std::uniform_int_distribution<int> integer(0, 100000);
+    const std::array<const char*, 4> categories = {"alpha", "beta", "gamma", "delta"};
+
+    std::ostringstream os;
+    os << "x,y,z,value,count,id,category,label\n";
+    for (size_t i = 0; i < rows; ++i) {
+        os << real(gen) << "," << real(gen) << "," << real(gen) << "," << real(gen) << ","
+           << integer(gen) << "," << i << "," << categories[i % categories.size()] << ",\"item "
+           << integer(gen) % 64 << "\"\n";
+    }
+    return os.str();
+}
+
+}  // namespace
+
+static void CSVReading(benchmark::State& state) {
+    const auto csv = makeCSV(static_cast<size_t>(state.range(0)));
+    CSVReader reader;
+
+    for (auto _ : state) {
+        std::istringstream is(csv);
+        auto dataframe = reader.readData(is);
+        benchmark::DoNotOptimize(dataframe);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * csv.size()));
+    state.counters["Rows"] = static_cast<double>(state.range(0));
+}
+
+BENCHMARK(CSVReading)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+int main(int argc, char** argv) {
+    LogCentral::init();
+    util::OnScopeExit deleteLogcentral([]() { LogCentral::deleteInstance(); });
+    auto logger = std::make_shared<ConsoleLogger>();
+    LogCentral::getPtr()->setVerbosity(LogVerbosity::Error);
+    LogCentral::getPtr()->registerLogger(logger);
+
+    // The application provides the thread pool used for parsing
+    InviwoApplication app(argc, argv, "Inviwo-Benchmarks-DataFrame");
+    {
+        std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+        modules.emplace_back(createInviwoCore());
+        app.registerModules(std::move(modules));
+    }
+    app.processFront();
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
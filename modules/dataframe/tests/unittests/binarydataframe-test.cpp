@@ -0,0 +1,125 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/dataframe/io/binarydataframe.h>
+#include <inviwo/dataframe/datastructures/column.h>
+
+#include <cstdio>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<DataFrame> createTestDataFrame() {
+    auto dataFrame = std::make_shared<DataFrame>();
+    auto floats = dataFrame->addColumn<float>("floats");
+    auto ints = dataFrame->addColumn<int>("ints");
+    auto categories = dataFrame->addCategoricalColumn("categories");
+    for (int i = 0; i < 1000; ++i) {
+        floats->add(static_cast<float>(i) * 0.5f);
+        ints->add(i % 7 - 3);
+        categories->add(i % 3 == 0 ? "red" : (i % 3 == 1 ? "green" : "blue"));
+    }
+    dataFrame->updateIndexBuffer();
+    return dataFrame;
+}
+
+void expectEqual(const DataFrame& expected, const DataFrame& result) {
+    ASSERT_EQ(expected.getNumberOfColumns(), result.getNumberOfColumns());
+    ASSERT_EQ(expected.getNumberOfRows(), result.getNumberOfRows());
+    for (size_t col = 0; col < expected.getNumberOfColumns(); ++col) {
+        EXPECT_EQ(expected.getHeader(col), result.getHeader(col));
+        EXPECT_EQ(expected.getColumn(col)->getBuffer()->getDataFormat(),
+                  result.getColumn(col)->getBuffer()->getDataFormat());
+        for (size_t row = 0; row < expected.getNumberOfRows(); ++row) {
+            EXPECT_EQ(expected.getColumn(col)->getAsString(row),
+                      result.getColumn(col)->getAsString(row))
+                << "column " << col << ", row " << row;
+        }
+    }
+}
+
+}  // namespace
+
+TEST(BinaryDataFrame, roundTrip) {
+    auto dataFrame = createTestDataFrame();
+
+    for (auto compression : {DataFrameCompression::None, DataFrameCompression::Zlib}) {
+        util::TempFileHandle tmpFile("", ".ivdf");
+        BinaryDataFrameWriter writer(compression);
+        writer.writeData(*dataFrame, tmpFile.getFileName());
+
+        BinaryDataFrameReader reader;
+        auto result = reader.readData(tmpFile.getFileName());
+        expectEqual(*dataFrame, *result);
+    }
+}
+
+TEST(BinaryDataFrame, lazyColumns) {
+    auto dataFrame = createTestDataFrame();
+    util::TempFileHandle tmpFile("", ".ivdf");
+    BinaryDataFrameWriter{}.writeData(*dataFrame, tmpFile.getFileName());
+
+    BinaryDataFrameReader reader;
+    auto result = reader.readData(tmpFile.getFileName());
+    ASSERT_EQ(4, result->getNumberOfColumns());
+    EXPECT_EQ(1000, result->getNumberOfRows());
+
+    auto categorical = std::dynamic_pointer_cast<CategoricalColumn>(result->getColumn(3));
+    ASSERT_TRUE(categorical);
+    EXPECT_EQ(std::vector<std::string>({"red", "green", "blue"}), categorical->getCategories());
+
+    for (size_t col = 1; col < result->getNumberOfColumns(); ++col) {
+        EXPECT_FALSE(result->getColumn(col)->getBuffer()->hasRepresentation<BufferRAM>())
+            << "column " << col << " loaded before being accessed";
+    }
+
+    EXPECT_EQ(-3, result->getColumn(2)->getAsDouble(0));
+    EXPECT_TRUE(result->getColumn(2)->getBuffer()->hasRepresentation<BufferRAM>());
+    EXPECT_FALSE(result->getColumn(1)->getBuffer()->hasRepresentation<BufferRAM>());
+    EXPECT_FALSE(result->getColumn(3)->getBuffer()->hasRepresentation<BufferRAM>());
+}
+
+TEST(BinaryDataFrame, invalidFile) {
+    util::TempFileHandle tmpFile("", ".ivdf");
+    std::fputs("not a binary DataFrame", tmpFile);
+    std::fflush(tmpFile);
+
+    BinaryDataFrameReader reader;
+    EXPECT_THROW(reader.readData(tmpFile.getFileName()), DataReaderException);
+}
+
+}  // namespace inviwo
@@ -33,9 +33,14 @@
 #include <warn/pop>
 
 #include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/raiiutils.h>
 #include <inviwo/dataframe/io/csvreader.h>
+#include <inviwo/dataframe/datastructures/column.h>
 
+#include <clocale>
+#include <limits>
 #include <sstream>
+#include <string>
 
 namespace inviwo {
 
@@ -136,6 +141,37 @@ TEST(CSVdata, emptyFields) {
     EXPECT_EQ("", value) << "empty field in middle of row";
 }
 
+TEST(CSVdata, decimalPointIndependentOfLocale) {
+    // Qt applications set the C locale from the environment, which might use a decimal comma
+    const std::string previous = std::setlocale(LC_NUMERIC, nullptr);
+    util::OnScopeExit restore{[&]() { std::setlocale(LC_NUMERIC, previous.c_str()); }};
+
+    const bool commaLocale = []() {
+        for (auto name : {"de_DE.UTF-8", "de_DE.utf8", "de_DE", "sv_SE.UTF-8", "sv_SE.utf8",
+                          "German_Germany.1252", "de-DE"}) {
+            if (std::setlocale(LC_NUMERIC, name) && std::localeconv()->decimal_point[0] == ',') {
+                return true;
+            }
+        }
+        return false;
+    }();
+    if (!commaLocale) GTEST_SKIP() << "no locale with a decimal comma available";
+
+    std::istringstream ss("1.5,-2.25e1\n0.125,+3\n");
+
+    CSVReader reader;
+    reader.setFirstRowHeader(false);
+
+    auto dataframe = reader.readData(ss);
+    ASSERT_EQ(3, dataframe->getNumberOfColumns()) << "column count does not match";
+    ASSERT_EQ(2, dataframe->getNumberOfRows()) << "row count does not match";
+
+    EXPECT_EQ(1.5, dataframe->getColumn(1)->getAsDouble(0));
+    EXPECT_EQ(0.125, dataframe->getColumn(1)->getAsDouble(1));
+    EXPECT_EQ(-22.5, dataframe->getColumn(2)->getAsDouble(0));
+    EXPECT_EQ(3.0, dataframe->getColumn(2)->getAsDouble(1));
+}
+
 TEST(CSVdata, columnCountMismatch) {
     // test for rows with varying column counts
     std::istringstream ss("1,2,3\n4,5\n7,8,9");
@@ -410,6 +446,23 @@ TEST(CSVquotes, multiline) {
     EXPECT_EQ("3", value) << "Column 3";
 }
 
+TEST(CSVquotes, multilineCRLF) {
+    std::istringstream ss(
+        "Col 1,Col 2\r\n"
+        "\"multiline \r\n quote\",2\r\n"
+        "single,3\r\n");
+
+    CSVReader reader;
+    reader.setFirstRowHeader(true);
+
+    auto dataframe = reader.readData(ss);
+    ASSERT_EQ(3, dataframe->getNumberOfColumns()) << "column count does not match";
+    ASSERT_EQ(2, dataframe->getNumberOfRows()) << "row count does not match";
+    EXPECT_EQ("\"multiline \n quote\"", dataframe->getColumn(1)->get(0, true)->toString());
+    EXPECT_EQ("single", dataframe->getColumn(1)->get(1, true)->toString());
+    EXPECT_EQ("3", dataframe->getColumn(2)->get(1, false)->toString());
+}
+
 TEST(CSVlinebreaks, CRonly) {
     std::istringstream ss("1,2,3\r4,5,6\r7,8,9");
 
@@ -465,4 +518,106 @@ TEST(CSVlinebreaks, mixed) {
     ASSERT_EQ(4, dataframe->getNumberOfRows()) << "row count does not match";
 }
 
+namespace {
+
+/**
+ * Rows with quoted fields, quoted line breaks, and categories that first appear after the 50
+ * example rows, i.e. in different chunks. Line breaks are CRLF.
+ */
+std::string chunkTestData(size_t rows) {
+    std::string data = "name,value,label\r\n";
+    for (size_t i = 0; i < rows; ++i) {
+        if (i % 7 == 0) {
+            data += "\"multi\r\nline, " + std::to_string(i) + "\"";
+        } else {
+            data += "\"quoted \"\"" + std::to_string(i / 3) + "\"\"\"";
+        }
+        data += "," + std::to_string(i) + ".5,cat" + std::to_string(i / 40) + "\r\n";
+        if (i % 31 == 0) data += "\r\n";
+    }
+    return data;
+}
+
+std::shared_ptr<DataFrame> readChunked(const std::string& data, size_t minChunkSize) {
+    std::istringstream ss(data);
+    CSVReader reader;
+    reader.setMinChunkSize(minChunkSize);
+    return reader.readData(ss);
+}
+
+std::string readError(const std::string& data, size_t minChunkSize) {
+    try {
+        readChunked(data, minChunkSize);
+    } catch (const CSVDataReaderException& e) {
+        return e.getMessage();
+    }
+    return "no error";
+}
+
+void expectEqual(const DataFrame& expected, const DataFrame& result) {
+    ASSERT_EQ(expected.getNumberOfColumns(), result.getNumberOfColumns());
+    ASSERT_EQ(expected.getNumberOfRows(), result.getNumberOfRows());
+    for (size_t col = 0; col < expected.getNumberOfColumns(); ++col) {
+        auto expectedCol = expected.getColumn(col);
+        auto resultCol = result.getColumn(col);
+        EXPECT_EQ(expectedCol->getHeader(), resultCol->getHeader());
+        if (auto cat = std::dynamic_pointer_cast<const CategoricalColumn>(expectedCol)) {
+            auto resultCat = std::dynamic_pointer_cast<const CategoricalColumn>(resultCol);
+            ASSERT_TRUE(resultCat) << "column " << col << " is not categorical";
+            EXPECT_EQ(cat->getCategories(), resultCat->getCategories());
+        }
+        for (size_t row = 0; row < expected.getNumberOfRows(); ++row) {
+            EXPECT_EQ(expectedCol->get(row, false)->toString(),
+                      resultCol->get(row, false)->toString())
+                << "column " << col << ", row " << row;
+            EXPECT_EQ(expectedCol->getAsString(row), resultCol->getAsString(row))
+                << "column " << col << ", row " << row;
+        }
+    }
+}
+
+constexpr size_t singleChunk = std::numeric_limits<size_t>::max();
+
+}  // namespace
+
+TEST(CSVchunks, sameAsSingleChunk) {
+    const auto data = chunkTestData(300);
+    auto expected = readChunked(data, singleChunk);
+    ASSERT_EQ(4, expected->getNumberOfColumns()) << "column count does not match";
+    ASSERT_EQ(300, expected->getNumberOfRows()) << "row count does not match";
+    EXPECT_EQ("\"multi\nline, 7\"", expected->getColumn(1)->get(7, true)->toString());
+    EXPECT_EQ("\"quoted \"\"0\"\"\"", expected->getColumn(1)->get(1, true)->toString());
+    EXPECT_EQ(8u, std::dynamic_pointer_cast<const CategoricalColumn>(expected->getColumn(3))
+                      ->getCategories()
+                      .size());
+
+    for (size_t minChunkSize : {1, 16, 100, 1000, 2000}) {
+        SCOPED_TRACE("chunk size " + std::to_string(minChunkSize));
+        auto result = readChunked(data, minChunkSize);
+        expectEqual(*expected, *result);
+    }
+}
+
+TEST(CSVchunks, columnCountMismatch) {
+    // the broken row comes after the example rows and after quoted line breaks
+    const auto data = chunkTestData(200) + "1,2\r\n" + chunkTestData(100).substr(18);
+    const auto expected = readError(data, singleChunk);
+    EXPECT_NE(std::string::npos, expected.find("Column counts do not match")) << expected;
+
+    for (size_t minChunkSize : {1, 16, 100, 1000, 2000}) {
+        EXPECT_EQ(expected, readError(data, minChunkSize)) << "chunk size " << minChunkSize;
+    }
+}
+
+TEST(CSVchunks, unmatchedQuotes) {
+    // after the header there are 200 rows, 29 of them with a quoted line break, and 7 empty lines
+    const auto data = chunkTestData(200) + "\"unmatched,1.5,cat0\r\n" + chunkTestData(10);
+    const auto expected = readError(data, singleChunk);
+    EXPECT_NE(std::string::npos, expected.find("starting in line 238")) << expected;
+
+    for (size_t minChunkSize : {1, 16, 100, 1000, 2000}) {
+        EXPECT_EQ(expected, readError(data, minChunkSize)) << "chunk size " << minChunkSize;
+    }
+}
+
 }  // namespace inviwo
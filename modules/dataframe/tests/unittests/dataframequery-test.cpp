@@ -0,0 +1,154 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/dataframe/datastructures/dataframequery.h>
+#include <inviwo/dataframe/datastructures/column.h>
+
+#include <array>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<DataFrame> createTestDataFrame(size_t rows) {
+    auto dataFrame = std::make_shared<DataFrame>();
+    auto x = dataFrame->addColumn<float>("x");
+    auto n = dataFrame->addColumn<int>("n");
+    auto type = dataFrame->addCategoricalColumn("type");
+    const std::array<std::string, 3> types = {"a", "b", "c"};
+    for (size_t i = 0; i < rows; ++i) {
+        x->add(static_cast<float>(i) * 0.5f);
+        n->add(static_cast<int>(i % 10) - 5);
+        type->add(types[i % 3]);
+    }
+    dataFrame->updateIndexBuffer();
+    return dataFrame;
+}
+
+template <typename Pred>
+RowBitmap reference(const DataFrame& dataFrame, Pred pred) {
+    RowBitmap bitmap(dataFrame.getNumberOfRows());
+    for (size_t i = 0; i < bitmap.size(); ++i) bitmap.set(i, pred(i));
+    return bitmap;
+}
+
+}  // namespace
+
+TEST(RowBitmap, operations) {
+    RowBitmap bitmap(130);
+    EXPECT_TRUE(bitmap.none());
+    bitmap.setRange(60, 70);
+    bitmap.set(129);
+    EXPECT_EQ(11, bitmap.count());
+    EXPECT_TRUE(bitmap.test(63));
+    EXPECT_TRUE(bitmap.test(64));
+    EXPECT_FALSE(bitmap.test(70));
+
+    auto inverted = ~bitmap;
+    EXPECT_EQ(119, inverted.count());
+    EXPECT_TRUE((bitmap & inverted).none());
+    EXPECT_EQ(RowBitmap(130, true), bitmap | inverted);
+
+    std::vector<std::uint32_t> expected{60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 129};
+    EXPECT_EQ(expected, bitmap.indices());
+
+    EXPECT_THROW(bitmap &= RowBitmap(10), Exception);
+}
+
+TEST(DataFrameQuery, range) {
+    auto dataFrame = createTestDataFrame(1000);
+
+    auto floats = DataFrameQuery::range("x", 10.0, 20.0).evaluate(*dataFrame);
+    EXPECT_EQ(reference(*dataFrame, [](size_t i) { return i >= 20 && i <= 40; }), floats);
+    EXPECT_EQ(21, floats.count());
+
+    auto ints = DataFrameQuery::range(2, -1.5, 1.5).evaluate(*dataFrame);
+    EXPECT_EQ(reference(*dataFrame,
+                        [](size_t i) {
+                            const int n = static_cast<int>(i % 10) - 5;
+                            return n >= -1 && n <= 1;
+                        }),
+              ints);
+
+    EXPECT_EQ(0, DataFrameQuery::range("x", 1.0, 0.0).count(*dataFrame));
+    EXPECT_EQ(1000, DataFrameQuery::range("n", -1e10, 1e10).count(*dataFrame));
+    EXPECT_THROW(DataFrameQuery::range("missing", 0.0, 1.0).evaluate(*dataFrame), Exception);
+}
+
+TEST(DataFrameQuery, categories) {
+    auto dataFrame = createTestDataFrame(1000);
+
+    auto selected = DataFrameQuery::oneOf("type", {"a", "c", "unknown"}).evaluate(*dataFrame);
+    EXPECT_EQ(reference(*dataFrame, [](size_t i) { return i % 3 != 1; }), selected);
+
+    EXPECT_THROW(DataFrameQuery::oneOf("x", {"a"}).evaluate(*dataFrame), Exception);
+}
+
+TEST(DataFrameQuery, combinations) {
+    auto dataFrame = createTestDataFrame(1000);
+
+    auto query =
+        (DataFrameQuery::range("x", 100.0, 200.0) && DataFrameQuery::oneOf("type", {"b"})) ||
+        !DataFrameQuery::range("n", -5.0, 3.0);
+    auto expected = reference(*dataFrame, [](size_t i) {
+        return (i >= 200 && i <= 400 && i % 3 == 1) || (i % 10) > 8;
+    });
+    EXPECT_EQ(expected, query.evaluate(*dataFrame));
+    EXPECT_EQ(expected.count(), query.count(*dataFrame));
+
+    auto view = query.select(dataFrame);
+    EXPECT_EQ(expected.count(), view.size());
+    EXPECT_EQ(dataFrame, view.getDataFrame());
+    for (auto row : view) {
+        EXPECT_TRUE(expected.test(row));
+    }
+
+    EXPECT_EQ(1000, DataFrameQuery{}.count(*dataFrame));
+}
+
+TEST(DataFrameQuery, invalidColumnWithEmptySelection) {
+    auto dataFrame = createTestDataFrame(100);
+
+    // the left hand side matches no rows, the right hand side is still checked
+    auto none = DataFrameQuery::range("x", 1000.0, 2000.0);
+    EXPECT_EQ(0, none.count(*dataFrame));
+    EXPECT_THROW((none && DataFrameQuery::range("missing", 0.0, 1.0)).evaluate(*dataFrame),
+                 Exception);
+    EXPECT_THROW((none && DataFrameQuery::oneOf(10, {"a"})).evaluate(*dataFrame), Exception);
+    EXPECT_THROW((none && DataFrameQuery::oneOf("x", {"a"})).evaluate(*dataFrame), Exception);
+    EXPECT_THROW((!DataFrameQuery{} && DataFrameQuery::range(10, 0.0, 1.0)).evaluate(*dataFrame),
+                 Exception);
+}
+
+}  // namespace inviwo
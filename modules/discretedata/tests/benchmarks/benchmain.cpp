@@ -0,0 +1,124 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <modules/discretedata/channels/bufferchannel.h>
+#include <modules/discretedata/channels/analyticchannel.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <benchmark/benchmark.h>
+#include <warn/pop>
+
+using namespace inviwo;
+using namespace inviwo::discretedata;
+
+namespace {
+
+std::shared_ptr<BufferChannel<float, 3>> makeChannel(ind size) {
+    auto channel = std::make_shared<BufferChannel<float, 3>>(size, "Position");
+    for (ind i = 0; i < size; ++i) {
+        (*channel)[i] = glm::vec3(static_cast<float>(i), 1.0f, -1.0f);
+    }
+    return channel;
+}
+
+}  // namespace
+
+static void BufferChannelIterate(benchmark::State& state) {
+    const auto size = static_cast<ind>(state.range(0));
+    auto channel = makeChannel(size);
+
+    for (auto _ : state) {
+        glm::vec3 sum{0.0f};
+        for (const glm::vec3& val : channel->all<glm::vec3>()) sum += val;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * size * sizeof(glm::vec3)));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+static void BufferChannelFill(benchmark::State& state) {
+    const auto size = static_cast<ind>(state.range(0));
+    auto channel = makeChannel(size);
+
+    for (auto _ : state) {
+        glm::vec3 sum{0.0f};
+        glm::vec3 val;
+        for (ind i = 0; i < size; ++i) {
+            channel->fill(val, i);
+            sum += val;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * size * sizeof(glm::vec3)));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+static void BufferChannelDirect(benchmark::State& state) {
+    const auto size = static_cast<ind>(state.range(0));
+    auto channel = makeChannel(size);
+
+    for (auto _ : state) {
+        glm::vec3 sum{0.0f};
+        for (ind i = 0; i < size; ++i) sum += (*channel)[i];
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * size * sizeof(glm::vec3)));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+static void AnalyticChannelIterate(benchmark::State& state) {
+    const auto size = static_cast<ind>(state.range(0));
+    AnalyticChannel<float, 3, glm::vec3> channel(
+        [](glm::vec3& dest, ind idx) { dest = glm::vec3(static_cast<float>(idx), 1.0f, -1.0f); },
+        size, "Position");
+
+    for (auto _ : state) {
+        glm::vec3 sum{0.0f};
+        for (const glm::vec3& val : channel.all<glm::vec3>()) sum += val;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * size * sizeof(glm::vec3)));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+BENCHMARK(BufferChannelIterate)->RangeMultiplier(8)->Range(1 << 12, 1 << 24);
+BENCHMARK(BufferChannelFill)->RangeMultiplier(8)->Range(1 << 12, 1 << 24);
+BENCHMARK(BufferChannelDirect)->RangeMultiplier(8)->Range(1 << 12, 1 << 24);
+BENCHMARK(AnalyticChannelIterate)->RangeMultiplier(8)->Range(1 << 12, 1 << 24);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,116 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_HDF5CHUNKCACHE_H
+#define IVW_HDF5CHUNKCACHE_H
+
+#include <modules/hdf5/hdf5moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+
+#include <H5Cpp.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace inviwo {
+
+namespace hdf5 {
+
+/**
+ * \class ChunkCache
+ * \brief A bounded least recently used cache of chunks read from the datasets of one HDF5 file.
+ *
+ * A chunk is the part of a dataset covered by one cell of the dataset's chunk grid, restricted to
+ * the samples of a strided selection. Chunks are identified by the dataset path, the chunk
+ * coordinates in the grid, and the stride and phase (start modulo stride) of the selection, and
+ * are kept in the native data type of the dataset. When the total size exceeds the limit the
+ * least recently used chunks are evicted. The cache is safe to use from multiple threads.
+ */
+class IVW_MODULE_HDF5_API ChunkCache {
+public:
+    struct IVW_MODULE_HDF5_API Key {
+        std::string path;
+        std::vector<hsize_t> coords;
+        std::vector<hsize_t> stride;
+        std::vector<hsize_t> phase;
+
+        bool operator==(const Key& rhs) const;
+        bool operator!=(const Key& rhs) const;
+    };
+    struct IVW_MODULE_HDF5_API KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+    struct Chunk {
+        std::vector<hsize_t> dims;  ///< Number of samples in each dimension, row major
+        std::shared_ptr<const BufferRAM> data;
+    };
+
+    static constexpr size_t defaultSize = size_t{512} * 1024 * 1024;
+
+    explicit ChunkCache(size_t maxSizeInBytes = defaultSize);
+
+    /**
+     * Returns the chunk for \p key, or nullptr if it is not in the cache.
+     */
+    std::shared_ptr<const Chunk> get(const Key& key);
+    void add(const Key& key, std::shared_ptr<const Chunk> chunk);
+
+    void clear();
+    /**
+     * Set the maximum total size of the cached chunks, evicting chunks if needed. A size of zero
+     * disables caching.
+     */
+    void setMaxSize(size_t maxSizeInBytes);
+    size_t getMaxSize() const;
+    /**
+     * Returns the total size of the cached chunks in bytes
+     */
+    size_t getSize() const;
+
+private:
+    using Entry = std::pair<Key, std::shared_ptr<const Chunk>>;
+    static size_t sizeOf(const Chunk& chunk);
+    void evict();
+
+    mutable std::mutex mutex_;
+    size_t maxSize_;
+    size_t size_ = 0;
+    std::list<Entry> entries_;  // Most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> lookup_;
+};
+
+}  // namespace hdf5
+
+}  // namespace inviwo
+
+#endif  // IVW_HDF5CHUNKCACHE_H
@@ -0,0 +1,108 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifndef IVW_HDF5CHUNKGRID_H
+#define IVW_HDF5CHUNKGRID_H
+
+#include <modules/hdf5/hdf5moduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <H5Cpp.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+namespace hdf5 {
+
+/**
+ * The samples of a strided selection along one dimension are the positions
+ * phase + k * stride, the selection covers k in [first, first + count).
+ */
+struct IVW_MODULE_HDF5_API Lattice {
+    hsize_t phase;
+    hsize_t stride;
+    hsize_t first;
+    hsize_t count;
+
+    /**
+     * The range of k for the positions in [begin, end), not restricted to the selection
+     */
+    std::pair<hsize_t, hsize_t> range(hsize_t begin, hsize_t end) const;
+
+    /**
+     * The range of k for the positions in chunk \p coord of a grid with chunks of size
+     * \p chunkSize over \p dataSize positions. The last chunk is cut at \p dataSize.
+     */
+    std::pair<hsize_t, hsize_t> chunkRange(hsize_t coord, hsize_t chunkSize,
+                                           hsize_t dataSize) const;
+
+    /**
+     * The coordinates of the chunks that contain selected samples, in increasing order
+     */
+    std::vector<hsize_t> chunks(hsize_t chunkSize, hsize_t dataSize) const;
+};
+
+/**
+ * Copy the box of size extent starting at srcOffset in src to dstOffset in dst, both row major
+ * with dimensions srcDims and dstDims.
+ */
+template <typename Dst, typename Src>
+void copyBox(const Src* src, const std::vector<hsize_t>& srcDims,
+             const std::vector<hsize_t>& srcOffset, Dst* dst, const std::vector<hsize_t>& dstDims,
+             const std::vector<hsize_t>& dstOffset, const std::vector<hsize_t>& extent) {
+    const size_t rank = extent.size();
+    const auto rowLength = extent[rank - 1];
+    std::vector<hsize_t> pos(rank, 0);
+    for (;;) {
+        size_t srcIndex = 0;
+        size_t dstIndex = 0;
+        for (size_t i = 0; i < rank; ++i) {
+            srcIndex = srcIndex * srcDims[i] + srcOffset[i] + pos[i];
+            dstIndex = dstIndex * dstDims[i] + dstOffset[i] + pos[i];
+        }
+        std::transform(src + srcIndex, src + srcIndex + rowLength, dst + dstIndex,
+                       [](const Src& v) { return static_cast<Dst>(v); });
+
+        size_t d = rank - 1;
+        for (; d > 0; --d) {
+            if (++pos[d - 1] < extent[d - 1]) break;
+            pos[d - 1] = 0;
+        }
+        if (d == 0) break;
+    }
+}
+
+}  // namespace hdf5
+
+}  // namespace inviwo
+
+#endif  // IVW_HDF5CHUNKGRID_H
@@ -31,6 +31,7 @@
 #define IVW_HDF5DATA_H
 
 #include <modules/hdf5/hdf5moduledefine.h>
+#include <modules/hdf5/datastructures/hdf5chunkcache.h>
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
@@ -78,10 +79,23 @@ public:
 
     Handle* getHandleForPath(const std::string& path) const;
 
+    /**
+     * Read the strided \p selection of the dataset at \p path into a volume of the given type,
+     * or of the dataset type if \p type is nullptr. The dataset is read chunk by chunk following
+     * its chunk layout (contiguous datasets are split into blocks of whole rows). Chunks that
+     * contain no selected samples are skipped, and read chunks are kept in the chunk cache of the
+     * file, so adjusting the selection only reads the chunks that were not read before. The
+     * chunks are copied and converted into the volume in parallel while the next chunk is read.
+     */
     std::shared_ptr<Volume> getVolumeAtPathAsType(const Path& path,
                                                   std::vector<Selection> selection,
                                                   const DataFormatBase* type) const;
 
+    /**
+     * The cache of chunks read from the file, shared by all handles to the same file.
+     */
+    ChunkCache& getChunkCache() const;
+
     template <typename T>
     std::vector<T> getVectorAtPath(const Path& path) const;
 
@@ -93,12 +107,15 @@ public:
     static const std::string dataName;
 
 private:
+    Handle(std::string filename, Path path, std::shared_ptr<ChunkCache> cache);
+
     double getMin(const DataFormatBase* type) const;
     double getMax(const DataFormatBase* type) const;
 
     H5::Group data_;
     std::string filename_;
     Path path_;
+    std::shared_ptr<ChunkCache> cache_;
 };
 
 template <typename T>
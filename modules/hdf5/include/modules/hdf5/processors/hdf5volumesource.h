@@ -81,6 +81,8 @@ namespace hdf5 {
  *   * __Source__ ...
  *   * __Convert to type__ ...
  *   * __Volume__ ...
+ *   * __Chunk Cache Size__ Maximum size in MB of the chunks kept in memory for each file, reused
+ *     when the selection changes
  *
  */
 class IVW_MODULE_HDF5_API HDF5ToVolume : public Processor {
@@ -168,6 +170,7 @@ private:
     OptionPropertyInt datatype_;
 
     DimSelections selection_;
+    IntSizeTProperty cacheSize_;
 
     bool dirty_;
 };
@@ -0,0 +1,119 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/hdf5/datastructures/hdf5chunkcache.h>
+#include <inviwo/core/util/hashcombine.h>
+
+namespace inviwo {
+
+namespace hdf5 {
+
+bool ChunkCache::Key::operator==(const Key& rhs) const {
+    return coords == rhs.coords && stride == rhs.stride && phase == rhs.phase && path == rhs.path;
+}
+
+bool ChunkCache::Key::operator!=(const Key& rhs) const { return !(*this == rhs); }
+
+size_t ChunkCache::KeyHash::operator()(const Key& key) const {
+    size_t seed = std::hash<std::string>{}(key.path);
+    for (auto v : key.coords) util::hash_combine(seed, v);
+    for (auto v : key.stride) util::hash_combine(seed, v);
+    for (auto v : key.phase) util::hash_combine(seed, v);
+    return seed;
+}
+
+ChunkCache::ChunkCache(size_t maxSizeInBytes) : maxSize_(maxSizeInBytes) {}
+
+std::shared_ptr<const ChunkCache::Chunk> ChunkCache::get(const Key& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = lookup_.find(key);
+    if (it == lookup_.end()) return nullptr;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+}
+
+void ChunkCache::add(const Key& key, std::shared_ptr<const Chunk> chunk) {
+    if (!chunk) return;
+    const auto chunkSize = sizeOf(*chunk);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (chunkSize > maxSize_) return;
+
+    auto it = lookup_.find(key);
+    if (it != lookup_.end()) {
+        size_ -= sizeOf(*it->second->second);
+        it->second->second = std::move(chunk);
+        entries_.splice(entries_.begin(), entries_, it->second);
+    } else {
+        entries_.emplace_front(key, std::move(chunk));
+        lookup_.emplace(key, entries_.begin());
+    }
+    size_ += chunkSize;
+    evict();
+}
+
+void ChunkCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lookup_.clear();
+    size_ = 0;
+}
+
+void ChunkCache::setMaxSize(size_t maxSizeInBytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxSize_ = maxSizeInBytes;
+    evict();
+}
+
+size_t ChunkCache::getMaxSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return maxSize_;
+}
+
+size_t ChunkCache::getSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+}
+
+size_t ChunkCache::sizeOf(const Chunk& chunk) {
+    return chunk.data ? chunk.data->getSize() * chunk.data->getDataFormat()->getSize() : 0;
+}
+
+void ChunkCache::evict() {
+    while (size_ > maxSize_ && !entries_.empty()) {
+        const auto& last = entries_.back();
+        size_ -= sizeOf(*last.second);
+        lookup_.erase(last.first);
+        entries_.pop_back();
+    }
+}
+
+}  // namespace hdf5
+
+}  // namespace inviwo
@@ -0,0 +1,60 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/hdf5/datastructures/hdf5chunkgrid.h>
+
+namespace inviwo {
+
+namespace hdf5 {
+
+std::pair<hsize_t, hsize_t> Lattice::range(hsize_t begin, hsize_t end) const {
+    const auto kBegin = begin <= phase ? 0 : (begin - phase + stride - 1) / stride;
+    const auto kEnd = end <= phase ? 0 : (end - 1 - phase) / stride + 1;
+    return {kBegin, std::max(kBegin, kEnd)};
+}
+
+std::pair<hsize_t, hsize_t> Lattice::chunkRange(hsize_t coord, hsize_t chunkSize,
+                                                hsize_t dataSize) const {
+    return range(coord * chunkSize, std::min((coord + 1) * chunkSize, dataSize));
+}
+
+std::vector<hsize_t> Lattice::chunks(hsize_t chunkSize, hsize_t dataSize) const {
+    std::vector<hsize_t> res;
+    const auto begin = (phase + first * stride) / chunkSize;
+    const auto end = (phase + (first + count - 1) * stride) / chunkSize + 1;
+    for (auto c = begin; c < end; ++c) {
+        const auto k = chunkRange(c, chunkSize, dataSize);
+        if (std::max(k.first, first) < std::min(k.second, first + count)) res.push_back(c);
+    }
+    return res;
+}
+
+}  // namespace hdf5
+
+}  // namespace inviwo
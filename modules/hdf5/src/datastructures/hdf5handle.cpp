@@ -28,35 +28,49 @@
  *********************************************************************************/
 
 #include <modules/hdf5/datastructures/hdf5handle.h>
+#include <modules/hdf5/datastructures/hdf5chunkgrid.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/formatdispatching.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/common/inviwoapplication.h>
 
 #include <modules/base/algorithm/dataminmax.h>
 
 #include <algorithm>
+#include <deque>
+#include <future>
 
 namespace inviwo {
 
 namespace hdf5 {
 
-Handle::Handle(std::string filename) : filename_(filename), path_("/") {
+Handle::Handle(std::string filename)
+    : filename_(filename), path_("/"), cache_(std::make_shared<ChunkCache>()) {
     H5::H5File hdfFile(filename_, H5F_ACC_RDONLY);
     data_ = hdfFile.openGroup(path_);
 }
 
-Handle::Handle(std::string filename, Path path) : filename_(filename), path_(path) {
+Handle::Handle(std::string filename, Path path)
+    : filename_(filename), path_(path), cache_(std::make_shared<ChunkCache>()) {
     H5::H5File hdfFile(filename_, H5F_ACC_RDONLY);
     data_ = hdfFile.openGroup(path_);
 }
 
-Handle::Handle(const Handle& rhs) : filename_(rhs.filename_), path_(rhs.path_) {
+Handle::Handle(std::string filename, Path path, std::shared_ptr<ChunkCache> cache)
+    : filename_(filename), path_(path), cache_(cache) {
     H5::H5File hdfFile(filename_, H5F_ACC_RDONLY);
     data_ = hdfFile.openGroup(path_);
 }
 
-Handle::Handle(Handle&& rhs) : filename_(rhs.filename_), path_(rhs.path_) {
+Handle::Handle(const Handle& rhs)
+    : filename_(rhs.filename_), path_(rhs.path_), cache_(rhs.cache_) {
+    H5::H5File hdfFile(filename_, H5F_ACC_RDONLY);
+    data_ = hdfFile.openGroup(path_);
+}
+
+Handle::Handle(Handle&& rhs) : filename_(rhs.filename_), path_(rhs.path_), cache_(rhs.cache_) {
     H5::H5File hdfFile(filename_, H5F_ACC_RDONLY);
     data_ = hdfFile.openGroup(path_);
 }
@@ -65,6 +79,7 @@ Handle& Handle::operator=(Handle&& that) {
     if (this != &that) {
         filename_ = that.filename_;
         path_ = that.path_;
+        cache_ = that.cache_;
         data_.close();
         H5::H5File hdfFile(filename_, H5F_ACC_RDONLY);
         data_ = hdfFile.openGroup(path_);
@@ -76,6 +91,7 @@ Handle& Handle::operator=(const Handle& that) {
     if (this != &that) {
         filename_ = that.filename_;
         path_ = that.path_;
+        cache_ = that.cache_;
         data_.close();
         H5::H5File hdfFile(filename_, H5F_ACC_RDONLY);
         data_ = hdfFile.openGroup(path_);
@@ -86,9 +102,11 @@ Handle& Handle::operator=(const Handle& that) {
 Handle::~Handle() { data_.close(); }
 
 Handle* Handle::getHandleForPath(const std::string& path) const {
-    return new Handle(this->filename_, path_ + path);
+    return new Handle(this->filename_, path_ + path, cache_);
 }
 
+ChunkCache& Handle::getChunkCache() const { return *cache_; }
+
 Document Handle::getInfo() const {
     Document doc;
     doc.append("p", "File: " + filename_ + path_);
@@ -122,6 +140,35 @@ double Handle::getMax(const DataFormatBase* type) const {
     }
 }
 
+namespace {
+
+// Target size of the blocks contiguous datasets are split into
+constexpr hsize_t virtualChunkSize = 4 * 1024 * 1024;
+
+std::vector<hsize_t> getChunkDimensions(const H5::DataSet& dataset,
+                                        const std::vector<hsize_t>& dataDimensions,
+                                        size_t elementSize) {
+    const size_t rank = dataDimensions.size();
+    std::vector<hsize_t> chunk(rank, 1);
+
+    const auto plist = dataset.getCreatePlist();
+    if (plist.getLayout() == H5D_CHUNKED) {
+        plist.getChunk(static_cast<int>(rank), chunk.data());
+        return chunk;
+    }
+
+    // Use whole rows of the fastest changing dimensions
+    hsize_t size = std::max<hsize_t>(1, elementSize);
+    for (size_t i = rank; i-- > 0;) {
+        chunk[i] = std::clamp<hsize_t>(virtualChunkSize / size, 1, dataDimensions[i]);
+        size *= chunk[i];
+        if (chunk[i] < dataDimensions[i]) break;
+    }
+    return chunk;
+}
+
+}  // namespace
+
 std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
                                                       std::vector<Selection> selection,
                                                       const DataFormatBase* type) const {
@@ -139,10 +186,6 @@ std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
     dataSpace.getSimpleExtentDims(dataDimensions.data());
     const hsize_t dataSize = dataSpace.getSelectNpoints();
 
-    std::vector<hsize_t> start(rank);
-    std::vector<hsize_t> count(rank);
-    std::vector<hsize_t> stride(rank);
-
     /*
      * Column major, i.e. the FIRST listed dimension is the fasted changing
      * Inviwo, OpenGL, matlab, Fortran
@@ -157,58 +200,174 @@ std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
 
     size3_t volumeDimensions(1);
     int resRank = 0;
-    std::vector<hsize_t> memoryDimensions{1, 1, 1};
+    std::vector<Lattice> lattice(rank);
+    std::vector<hsize_t> count(rank);
 
     for (size_t i = 0; i < rank; ++i) {
-        start[i] = selection[i].start;
-        count[i] =
-            static_cast<hsize_t>((selection[i].end - selection[i].start) / selection[i].stride);
-        stride[i] = selection[i].stride;
+        const auto stride = static_cast<hsize_t>(std::max<size_t>(1, selection[i].stride));
+        const auto start = static_cast<hsize_t>(selection[i].start);
+        count[i] = static_cast<hsize_t>((selection[i].end - selection[i].start) / stride);
+        if (count[i] == 0) throw Exception("Invalid selection, empty range", IVW_CONTEXT);
+        if (start + (count[i] - 1) * stride >= dataDimensions[i]) {
+            throw Exception("Invalid selection, outside of the data", IVW_CONTEXT);
+        }
+        lattice[i] = Lattice{start % stride, stride, start / stride, count[i]};
 
         if (count[i] > 1) {
             if (resRank > 2) throw Exception("Invalid selection, resulting rank > 3", IVW_CONTEXT);
-            memoryDimensions[resRank] = count[i];
             volumeDimensions[resRank] = count[i];
             resRank++;
         }
     }
 
-    dataSpace.selectHyperslab(H5S_SELECT_SET, count.data(), start.data(), stride.data(), nullptr);
+    const DataFormatBase* dataFormat = util::getDataFormatFromDataSet(dataset);
+    if (!dataFormat) throw Exception("HDF: unsupported data type", IVW_CONTEXT);
+    const DataFormatBase* format = type ? type : dataFormat;
 
-    H5::DataSpace memorySpace(3, memoryDimensions.data());
-    memorySpace.selectAll();
+    const auto chunkDimensions = getChunkDimensions(dataset, dataDimensions, dataFormat->getSize());
 
-    hsize_t selectionSize = memorySpace.getSelectNpoints();
+    // The chunks along each dimension that contain selected samples
+    std::vector<std::vector<hsize_t>> chunkCoords(rank);
+    for (size_t i = 0; i < rank; ++i) {
+        chunkCoords[i] = lattice[i].chunks(chunkDimensions[i], dataDimensions[i]);
+    }
 
     LogInfo("Data rank: " << rank << " dims " << joinString(dataDimensions, " x ") << " size "
-                          << dataSize << " selection " << dataSpace.getSelectNpoints()
-                          << " memory size " << memorySpace.getSelectNpoints() << " memory dim "
-                          << volumeDimensions);
+                          << dataSize << " chunk dims " << joinString(chunkDimensions, " x ")
+                          << " memory dim " << volumeDimensions);
+
+    const auto readChunk = [&](const std::vector<hsize_t>& coords) {
+        std::vector<hsize_t> start(rank);
+        std::vector<hsize_t> dims(rank);
+        std::vector<hsize_t> stride(rank);
+        for (size_t i = 0; i < rank; ++i) {
+            const auto& l = lattice[i];
+            const auto k = l.chunkRange(coords[i], chunkDimensions[i], dataDimensions[i]);
+            start[i] = l.phase + k.first * l.stride;
+            dims[i] = k.second - k.first;
+            stride[i] = l.stride;
+        }
+        H5::DataSpace fileSpace = dataset.getSpace();
+        fileSpace.selectHyperslab(H5S_SELECT_SET, dims.data(), start.data(), stride.data(),
+                                  nullptr);
+        H5::DataSpace memorySpace(static_cast<int>(rank), dims.data());
+        memorySpace.selectAll();
+
+        auto buffer = createBufferRAM(static_cast<size_t>(memorySpace.getSelectNpoints()),
+                                      dataFormat, BufferUsage::Static);
+        buffer->dispatch<void, dispatching::filter::Scalars>([&](auto brprecision) {
+            using ValueType = ::inviwo::util::PrecisionValueType<decltype(brprecision)>;
+            try {
+                dataset.read(brprecision->getDataTyped(), TypeMap<ValueType>::getType(),
+                             memorySpace, fileSpace);
+            } catch (H5::DataSetIException& e) {
+                throw Exception("HDF: unable to read data: " + e.getDetailMsg(), IVW_CONTEXT);
+            }
+        });
 
-    const DataFormatBase* format = type ? type : util::getDataFormatFromDataSet(dataset);
+        auto chunk = std::make_shared<ChunkCache::Chunk>();
+        chunk->dims = std::move(dims);
+        chunk->data = std::move(buffer);
+        return std::shared_ptr<const ChunkCache::Chunk>(std::move(chunk));
+    };
 
     // Reverse back the Column major
     std::reverse(&volumeDimensions[0], &volumeDimensions[0] + volumeDimensions.length());
     auto volumeram = createVolumeRAM(volumeDimensions, format);
 
-    auto minmax = volumeram->dispatch<std::pair<dvec4, dvec4>, dispatching::filter::Scalars>(
-        [&](auto vrprecision) {
-            using ValueType = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
+    const auto copyChunk = [&](const ChunkCache::Chunk& chunk, const std::vector<hsize_t>& coords) {
+        std::vector<hsize_t> srcOffset(rank);
+        std::vector<hsize_t> dstOffset(rank);
+        std::vector<hsize_t> extent(rank);
+        for (size_t i = 0; i < rank; ++i) {
+            const auto& l = lattice[i];
+            const auto k = l.chunkRange(coords[i], chunkDimensions[i], dataDimensions[i]);
+            const auto begin = std::max(k.first, l.first);
+            const auto end = std::min(k.second, l.first + l.count);
+            srcOffset[i] = begin - k.first;
+            dstOffset[i] = begin - l.first;
+            extent[i] = end - begin;
+        }
+        volumeram->dispatch<void, dispatching::filter::Scalars>([&](auto vrprecision) {
+            using Dst = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
+            auto dst = vrprecision->getDataTyped();
+            chunk.data->dispatch<void, dispatching::filter::Scalars>(
+                [&](auto brprecision) {
+                    copyBox(brprecision->getDataTyped(), chunk.dims, srcOffset, dst, count,
+                            dstOffset, extent);
+                });
+        });
+    };
+
+    // HDF5 is not thread safe, chunks are read sequentially on this thread while the copying and
+    // conversion of the already read chunks is done on the thread pool.
+    const bool parallel =
+        InviwoApplication::isInitialized() && InviwoApplication::getPtr()->getPoolSize() > 0;
+    const size_t maxInFlight =
+        parallel ? 2 * InviwoApplication::getPtr()->getPoolSize() : size_t{0};
+    std::deque<std::future<void>> futures;
+    ::inviwo::util::OnScopeExit waitForJobs{[&]() {
+        for (auto& f : futures) f.wait();
+    }};
+
+    auto& cache = getChunkCache();
+    const std::string pathStr = path;
+    std::vector<size_t> index(rank, 0);
+    size_t numRead = 0;
+    size_t numCached = 0;
+    for (;;) {
+        ChunkCache::Key key;
+        key.path = pathStr;
+        for (size_t i = 0; i < rank; ++i) {
+            key.coords.push_back(chunkCoords[i][index[i]]);
+            key.stride.push_back(lattice[i].stride);
+            key.phase.push_back(lattice[i].phase);
+        }
 
-            ValueType* data = vrprecision->getDataTyped();
+        auto chunk = cache.get(key);
+        if (chunk) {
+            ++numCached;
+        } else {
+            chunk = readChunk(key.coords);
+            cache.add(key, chunk);
+            ++numRead;
+        }
 
-            try {
-                dataset.read(data, TypeMap<ValueType>::getType(), memorySpace, dataSpace);
-            } catch (H5::DataSetIException& e) {
-                throw Exception("HDF: unable to read data: " + e.getDetailMsg(), IVW_CONTEXT);
+        if (parallel) {
+            while (futures.size() >= maxInFlight) {
+                futures.front().get();
+                futures.pop_front();
             }
+            futures.push_back(dispatchPool([&copyChunk, chunk, coords = key.coords]() {
+                copyChunk(*chunk, coords);
+            }));
+        } else {
+            copyChunk(*chunk, key.coords);
+        }
 
-            auto res = ::inviwo::util::dataMinMax(data, selectionSize);
+        size_t d = rank;
+        for (; d > 0; --d) {
+            if (++index[d - 1] < chunkCoords[d - 1].size()) break;
+            index[d - 1] = 0;
+        }
+        if (d == 0) break;
+    }
+    while (!futures.empty()) {
+        futures.front().get();
+        futures.pop_front();
+    }
+
+    auto minmax = volumeram->dispatch<std::pair<dvec4, dvec4>, dispatching::filter::Scalars>(
+        [&](auto vrprecision) {
+            using ValueType = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
+            const ValueType* data = vrprecision->getDataTyped();
+            auto res = ::inviwo::util::dataMinMax(data, glm::compMul(volumeDimensions));
 
             LogInfo("Read HDF volume type: " << DataFormat<ValueType>::str()
                                              << " data range: " << res.first << ", " << res.second
-                                             << " file: " << dataset.getFileName());
-
+                                             << " file: " << dataset.getFileName()
+                                             << " chunks read: " << numRead
+                                             << " cached: " << numCached);
             return res;
         });
 
@@ -89,6 +89,8 @@ HDF5ToVolume::HDF5ToVolume()
                  {"ushort", "Unsigned Short", 3}},
                 0)
     , selection_("selection", "Selection", 6)
+    , cacheSize_("chunkCacheSize", "Chunk Cache Size (MB)", ChunkCache::defaultSize / (1024 * 1024),
+                 0, 16384, 64, InvalidationLevel::Valid)
     , dirty_(false) {
 
     addPort(inport_);
@@ -133,6 +135,13 @@ HDF5ToVolume::HDF5ToVolume()
     });
 
     addProperty(outputGroup_);
+
+    addProperty(cacheSize_);
+    cacheSize_.onChange([this]() {
+        if (inport_.hasData()) {
+            inport_.getData()->getChunkCache().setMaxSize(cacheSize_ * 1024 * 1024);
+        }
+    });
 }
 
 HDF5ToVolume::~HDF5ToVolume() = default;
@@ -344,6 +353,7 @@ void HDF5ToVolume::makeVolume() {
                     break;
             }
 
+            data->getChunkCache().setMaxSize(cacheSize_ * 1024 * 1024);
             volume_ = std::shared_ptr<Volume>(
                 data->getVolumeAtPathAsType(Path(data->getGroup().getObjName()) + volumeMeta.path_,
                                             selection_.getSelection(), format));
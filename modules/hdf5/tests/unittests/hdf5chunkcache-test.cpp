@@ -0,0 +1,110 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/hdf5/datastructures/hdf5chunkcache.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<const hdf5::ChunkCache::Chunk> makeChunk(size_t size) {
+    auto chunk = std::make_shared<hdf5::ChunkCache::Chunk>();
+    chunk->dims = {size};
+    chunk->data = std::make_shared<BufferRAMPrecision<float>>(size);
+    return chunk;
+}
+
+hdf5::ChunkCache::Key makeKey(hsize_t coord, hsize_t stride = 1) {
+    return hdf5::ChunkCache::Key{"/data", {0, coord}, {1, stride}, {0, 0}};
+}
+
+}  // namespace
+
+TEST(HDF5ChunkCache, HitAndMiss) {
+    hdf5::ChunkCache cache(1024);
+    auto chunk = makeChunk(10);
+    cache.add(makeKey(0), chunk);
+
+    EXPECT_EQ(chunk, cache.get(makeKey(0)));
+    EXPECT_EQ(nullptr, cache.get(makeKey(1)));
+    // A different stride or path is a different chunk
+    EXPECT_EQ(nullptr, cache.get(makeKey(0, 2)));
+    auto other = makeKey(0);
+    other.path = "/other";
+    EXPECT_EQ(nullptr, cache.get(other));
+
+    EXPECT_EQ(40, cache.getSize());
+}
+
+TEST(HDF5ChunkCache, EvictsLeastRecentlyUsed) {
+    hdf5::ChunkCache cache(100);
+    cache.add(makeKey(0), makeChunk(10));
+    cache.add(makeKey(1), makeChunk(10));
+    EXPECT_EQ(80, cache.getSize());
+
+    // Using chunk 0 makes chunk 1 the least recently used one
+    EXPECT_NE(nullptr, cache.get(makeKey(0)));
+    cache.add(makeKey(2), makeChunk(10));
+    EXPECT_EQ(80, cache.getSize());
+    EXPECT_NE(nullptr, cache.get(makeKey(0)));
+    EXPECT_EQ(nullptr, cache.get(makeKey(1)));
+    EXPECT_NE(nullptr, cache.get(makeKey(2)));
+
+    // Chunks larger than the cache are not added
+    cache.add(makeKey(3), makeChunk(30));
+    EXPECT_EQ(nullptr, cache.get(makeKey(3)));
+    EXPECT_EQ(80, cache.getSize());
+
+    // Replacing a chunk updates the size
+    cache.add(makeKey(2), makeChunk(5));
+    EXPECT_EQ(60, cache.getSize());
+}
+
+TEST(HDF5ChunkCache, SetMaxSize) {
+    hdf5::ChunkCache cache(1024);
+    for (hsize_t i = 0; i < 4; ++i) cache.add(makeKey(i), makeChunk(10));
+    EXPECT_EQ(160, cache.getSize());
+
+    cache.setMaxSize(50);
+    EXPECT_EQ(40, cache.getSize());
+    EXPECT_NE(nullptr, cache.get(makeKey(3)));
+
+    cache.setMaxSize(0);
+    EXPECT_EQ(0, cache.getSize());
+    cache.add(makeKey(0), makeChunk(10));
+    EXPECT_EQ(nullptr, cache.get(makeKey(0)));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,130 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/hdf5/datastructures/hdf5chunkgrid.h>
+
+#include <numeric>
+
+namespace inviwo {
+
+using Range = std::pair<hsize_t, hsize_t>;
+
+TEST(HDF5ChunkGrid, ChunksOfStridedSelection) {
+    // Positions 1, 4, 7, 10 in 11 samples split into chunks of 4, the last one cut at 11
+    const hdf5::Lattice l{1, 3, 0, 4};
+    EXPECT_EQ((std::vector<hsize_t>{0, 1, 2}), l.chunks(4, 11));
+    EXPECT_EQ(Range(0, 1), l.chunkRange(0, 4, 11));
+    EXPECT_EQ(Range(1, 3), l.chunkRange(1, 4, 11));
+    EXPECT_EQ(Range(3, 4), l.chunkRange(2, 4, 11));
+}
+
+TEST(HDF5ChunkGrid, SkipsChunksWithoutSamples) {
+    // Positions 0, 8, 16 in chunks of 4
+    const hdf5::Lattice l{0, 8, 0, 3};
+    EXPECT_EQ((std::vector<hsize_t>{0, 2, 4}), l.chunks(4, 20));
+    EXPECT_EQ(Range(1, 1), l.chunkRange(1, 4, 20));
+    EXPECT_EQ(Range(2, 3), l.chunkRange(4, 4, 20));
+}
+
+TEST(HDF5ChunkGrid, SelectionStartingInsideChunk) {
+    // Positions 6, 8 of the lattice 0, 2, 4, ... in 9 samples
+    const hdf5::Lattice l{0, 2, 3, 2};
+    EXPECT_EQ((std::vector<hsize_t>{1, 2}), l.chunks(4, 9));
+    // The ranges cover all lattice positions in the chunk, also unselected ones
+    EXPECT_EQ(Range(2, 4), l.chunkRange(1, 4, 9));
+    EXPECT_EQ(Range(4, 5), l.chunkRange(2, 4, 9));
+}
+
+TEST(HDF5ChunkGrid, CopyBoxAtEdge) {
+    // Copy the 2 x 3 box in the bottom right corner of a 4 x 5 source
+    std::vector<int> src(20);
+    std::iota(src.begin(), src.end(), 0);
+    std::vector<float> dst(12, -1.0f);
+    hdf5::copyBox(src.data(), {4, 5}, {2, 2}, dst.data(), {3, 4}, {1, 1}, {2, 3});
+
+    const std::vector<float> expected{-1, -1, -1, -1,  //
+                                      -1, 12, 13, 14,  //
+                                      -1, 17, 18, 19};
+    EXPECT_EQ(expected, dst);
+}
+
+TEST(HDF5ChunkGrid, AssembleSelectionFromEdgeChunks) {
+    // A 7 x 10 row major dataset in chunks of 3 x 4, i.e. with partial chunks along both edges,
+    // and a selection of rows 1 to 6 and every third column starting at 2
+    const std::vector<hsize_t> dims{7, 10};
+    const std::vector<hsize_t> chunkDims{3, 4};
+    const std::vector<hdf5::Lattice> lattice{{0, 1, 1, 6}, {2, 3, 0, 3}};
+    const std::vector<hsize_t> count{6, 3};
+
+    std::vector<int> data(dims[0] * dims[1]);
+    std::iota(data.begin(), data.end(), 0);
+
+    // Read and copy chunk by chunk the same way as Handle::getVolumeAtPathAsType
+    std::vector<int> result(count[0] * count[1], -1);
+    for (auto c0 : lattice[0].chunks(chunkDims[0], dims[0])) {
+        for (auto c1 : lattice[1].chunks(chunkDims[1], dims[1])) {
+            const std::vector<hsize_t> coords{c0, c1};
+            std::vector<Range> k(2);
+            std::vector<hsize_t> chunkSize(2), srcOffset(2), dstOffset(2), extent(2);
+            for (size_t i = 0; i < 2; ++i) {
+                const auto& l = lattice[i];
+                k[i] = l.chunkRange(coords[i], chunkDims[i], dims[i]);
+                chunkSize[i] = k[i].second - k[i].first;
+                const auto begin = std::max(k[i].first, l.first);
+                const auto end = std::min(k[i].second, l.first + l.count);
+                srcOffset[i] = begin - k[i].first;
+                dstOffset[i] = begin - l.first;
+                extent[i] = end - begin;
+            }
+            std::vector<int> chunk;
+            for (auto k0 = k[0].first; k0 < k[0].second; ++k0) {
+                for (auto k1 = k[1].first; k1 < k[1].second; ++k1) {
+                    const auto row = lattice[0].phase + k0 * lattice[0].stride;
+                    const auto col = lattice[1].phase + k1 * lattice[1].stride;
+                    chunk.push_back(data[row * dims[1] + col]);
+                }
+            }
+            hdf5::copyBox(chunk.data(), chunkSize, srcOffset, result.data(), count, dstOffset,
+                          extent);
+        }
+    }
+
+    std::vector<int> expected;
+    for (hsize_t row = 1; row < 7; ++row) {
+        for (hsize_t col = 2; col < 10; col += 3) expected.push_back(data[row * dims[1] + col]);
+    }
+    EXPECT_EQ(expected, result);
+}
+
+}  // namespace inviwo
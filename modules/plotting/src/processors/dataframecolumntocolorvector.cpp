@@ -75,9 +75,10 @@ void DataFrameColumnToColorVector::process() {
                     double maxV = static_cast<double>(*minMax.second);
                     const double range = (maxV - minV);
 
-                    for (const auto &v : vec) {
-                        colors->push_back(tf_.get().sample((v - minV) / range));
-                    }
+                    std::vector<double> positions(vec.size());
+                    std::transform(vec.begin(), vec.end(), positions.begin(),
+                                   [&](const auto &v) { return (v - minV) / range; });
+                    tf_.get().sample(positions, *colors);
 
                     return colors;
                 }));
@@ -653,9 +653,9 @@ void ParallelCoordinates::linePicked(PickingEvent* p) {
 
         auto selection = brushingAndLinking_.getSelectedIndices();
         if (brushingAndLinking_.isSelected(indexCol[id])) {
-            selection.erase(indexCol[id]);
+            selection.remove(indexCol[id]);
         } else {
-            selection.insert(indexCol[id]);
+            selection.add(indexCol[id]);
         }
         brushingAndLinking_.sendSelectionEvent(selection);
 
@@ -682,12 +682,12 @@ void ParallelCoordinates::axisPicked(PickingEvent* p, size_t pickedID, PickType
 
         auto selection = brushingAndLinking_.getSelectedColumns();
         if (brushingAndLinking_.isColumnSelected(pickedID)) {
-            selection.erase(pickedID);
+            selection.remove(static_cast<std::uint32_t>(pickedID));
         } else if (axisSelection_.get() == AxisSelection::Multiple) {
-            selection.insert(pickedID);
+            selection.add(static_cast<std::uint32_t>(pickedID));
         } else if (axisSelection_.get() == AxisSelection::Single) {
             selection.clear();
-            selection.insert(pickedID);
+            selection.add(static_cast<std::uint32_t>(pickedID));
         }
         brushingAndLinking_.sendColumnSelectionEvent(selection);
 
@@ -701,9 +701,9 @@ void ParallelCoordinates::axisPicked(PickingEvent* p, size_t pickedID, PickType
         // undo spurious axis selection caused by the single click event prior to the double click
         auto selection = brushingAndLinking_.getSelectedColumns();
         if (brushingAndLinking_.isColumnSelected(pickedID)) {
-            selection.erase(pickedID);
+            selection.remove(static_cast<std::uint32_t>(pickedID));
         } else {
-            selection.insert(pickedID);
+            selection.add(static_cast<std::uint32_t>(pickedID));
         }
         brushingAndLinking_.sendColumnSelectionEvent(selection);
 
@@ -782,9 +782,9 @@ void ParallelCoordinates::updateBrushing() {
         }
     }
 
-    std::unordered_set<size_t> brushedID;
+    BitSet brushedID;
     for (size_t i = 0; i < nRows; ++i) {
-        if (brushed[i]) brushedID.insert(indexCol[i]);
+        if (brushed[i]) brushedID.add(indexCol[i]);
     }
     brushingAndLinking_.sendFilterEvent(brushedID);
 }
@@ -114,7 +114,8 @@ void exposeBuffer(pybind11::module &m) {
         .def("clone", [](BufferBase &self) { return self.clone(); })
         .def_property("size", &BufferBase::getSize, &BufferBase::setSize)
         .def_property("data",
-                      [&](BufferBase *buffer) -> py::array {
+                      [](py::object self) -> py::array {
+                          auto buffer = self.cast<BufferBase *>();
                           auto df = buffer->getDataFormat();
                           std::vector<size_t> shape = {buffer->getSize()};
                           std::vector<size_t> strides = {df->getSize()};
@@ -124,15 +125,16 @@ void exposeBuffer(pybind11::module &m) {
                               strides.push_back(df->getSize() / df->getComponents());
                           }
 
+                          // The array views the representation and keeps the buffer alive
                           auto data = buffer->getEditableRepresentation<BufferRAM>()->getData();
-                          return py::array(pyutil::toNumPyFormat(df), shape, strides, data,
-                                           py::cast<>(1));
+                          return py::array(pyutil::toNumPyFormat(df), shape, strides, data, self);
                       },
                       [](BufferBase *buffer, py::array data) {
                           auto rep = buffer->getEditableRepresentation<BufferRAM>();
                           pyutil::checkDataFormat<1>(rep->getDataFormat(), rep->getSize(), data);
 
-                          memcpy(rep->getData(), data.data(0), data.nbytes());
+                          auto dense = pyutil::toDenseArray(data, 1);
+                          memcpy(rep->getData(), dense.data(), dense.nbytes());
                       });
 
     util::for_each_type<DefaultDataFormats>{}(BufferRAMHelper{}, m);
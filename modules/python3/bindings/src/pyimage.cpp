@@ -77,7 +77,10 @@ void exposeImage(py::module &m) {
     py::class_<Layer, std::shared_ptr<Layer>>(m, "Layer")
         .def(py::init<size2_t, const DataFormatBase *>())
         .def("clone", [](Layer &self) { return self.clone(); })
-        .def(py::init([](py::array data) { return pyutil::createLayer(data).release(); }))
+        .def(py::init([](py::array data, bool copy) {
+                 return pyutil::createLayer(data, copy).release();
+             }),
+             py::arg("data"), py::arg("copy") = false)
         .def_property_readonly("dimensions", &Layer::getDimensions)
         .def("save",
              [](Layer &self, std::string filepath) {
@@ -93,7 +96,8 @@ void exposeImage(py::module &m) {
              })
         .def_property(
             "data",
-            [&](Layer *layer) -> py::array {
+            [](py::object self) -> py::array {
+                auto layer = self.cast<Layer *>();
                 auto df = layer->getDataFormat();
                 auto dims = layer->getDimensions();
 
@@ -105,14 +109,16 @@ void exposeImage(py::module &m) {
                     strides.push_back(df->getSize() / df->getComponents());
                 }
 
+                // The array views the representation and keeps the layer alive
                 auto data = layer->getEditableRepresentation<LayerRAM>()->getData();
-                return py::array(pyutil::toNumPyFormat(df), shape, strides, data, py::cast<>(1));
+                return py::array(pyutil::toNumPyFormat(df), shape, strides, data, self);
             },
             [](Layer *layer, py::array data) {
                 auto rep = layer->getEditableRepresentation<LayerRAM>();
                 pyutil::checkDataFormat<2>(rep->getDataFormat(), rep->getDimensions(), data);
 
-                memcpy(rep->getData(), data.data(0), data.nbytes());
+                auto dense = pyutil::toDenseArray(data, 2);
+                memcpy(rep->getData(), dense.data(), dense.nbytes());
             });
 
     exposeInport<ImageInport>(m, "Image");
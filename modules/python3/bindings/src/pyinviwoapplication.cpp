@@ -88,7 +88,8 @@ void exposeInviwoApplication(pybind11::module &m) {
         .def("getModuleSettings", &InviwoApplication::getModuleSettings,
              py::return_value_policy::reference)
 
-        .def("waitForPool", &InviwoApplication::waitForPool)
+        .def("waitForPool", &InviwoApplication::waitForPool,
+             py::call_guard<py::gil_scoped_release>())
         .def("closeInviwoApplication", &InviwoApplication::closeInviwoApplication)
 
         .def("getOutputPath",
@@ -109,7 +109,10 @@ void exposePickingMapper(pybind11::module &m) {
     py::class_<PickingMapper>(m, "PickingMapper")
         .def(py::init([](Processor *p, size_t size, pybind11::function callback) {
             return new PickingMapper(p, size,
-                                     [callback](PickingEvent *e) { callback(py::cast(e)); });
+                                     [callback](PickingEvent *e) {
+                                         py::gil_scoped_acquire gil;
+                                         callback(py::cast(e));
+                                     });
         }))
         .def("resize", &PickingMapper::resize)
         .def_property("enabled", &PickingMapper::isEnabled, &PickingMapper::setEnabled)
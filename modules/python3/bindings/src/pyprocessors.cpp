@@ -86,6 +86,7 @@ public:
     }
 
     virtual std::unique_ptr<Processor> create(InviwoApplication *app) override {
+        pybind11::gil_scoped_acquire gil;
         auto proc = createProcessor(app);
         auto p = std::unique_ptr<Processor>(proc.cast<Processor *>());
         proc.release();
@@ -103,6 +104,7 @@ public:
     }
 
     virtual std::unique_ptr<ProcessorWidget> create(Processor *processor) override {
+        pybind11::gil_scoped_acquire gil;
         auto proc = createWidget(processor);
         auto p = std::unique_ptr<ProcessorWidget>(proc.cast<ProcessorWidget *>());
         proc.release();
@@ -301,9 +303,17 @@ void exposeProcessors(pybind11::module &m) {
             writer->writeData(layer, filepath);
         });
 
-    py::class_<PythonScriptProcessor, Processor, ProcessorPtr<PythonScriptProcessor>>(
-        m, "PythonScriptProcessor", py::dynamic_attr{})
+    py::class_<PythonScriptProcessor, Processor, ProcessorPtr<PythonScriptProcessor>>
+        pythonScriptProcessor(m, "PythonScriptProcessor", py::dynamic_attr{});
+    pythonScriptProcessor
         .def("setInitializeResources", &PythonScriptProcessor::setInitializeResources)
-        .def("setProcess", &PythonScriptProcessor::setProcess);
+        .def("setProcess", &PythonScriptProcessor::setProcess)
+        .def("setProcessAsync", &PythonScriptProcessor::setProcessAsync, py::arg("process"),
+             py::arg("finish"));
+
+    py::class_<PythonScriptProcessor::Task, std::shared_ptr<PythonScriptProcessor::Task>>(
+        pythonScriptProcessor, "Task")
+        .def_property_readonly("cancelled", &PythonScriptProcessor::Task::isCancelled)
+        .def("progress", &PythonScriptProcessor::Task::progress);
 }
 }  // namespace inviwo
@@ -33,12 +33,17 @@
 #include <modules/python3/python3moduledefine.h>
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/progressbarowner.h>
 #include <inviwo/core/properties/fileproperty.h>
 #include <modules/python3/pythonscript.h>
 #include <inviwo/core/ports/meshport.h>
 #include <inviwo/core/ports/volumeport.h>
 #include <pybind11/pybind11.h>
 
+#include <atomic>
+#include <future>
+#include <memory>
+
 namespace inviwo {
 
 /** \docpage{org.inviwo.PythonScriptProcessor, Python Mesh Script Source}
@@ -91,6 +96,33 @@ namespace inviwo {
  * # Tell the PythonScriptProcessor about the 'process' function we want to use
  * self.setProcess(process)
  * \endcode
+ *
+ * ### Running in the background
+ * Instead of setProcess, a script can call `self.setProcessAsync(process, finish)`. Then
+ * `process(self)` is called on the main thread to read the inputs and returns a function
+ * `compute(task)`. That function is called on a pool thread and its return value is passed to
+ * `finish(self, result)`, again on the main thread, where the outports can be set. `compute` must
+ * not use the ports or properties of the processor. It should check `task.cancelled` now and then
+ * and can report progress with `task.progress(0.5)`. If the processor is invalidated while
+ * `compute` runs, the task is cancelled and a new one is started once it has returned.
+ * \code{.py}
+ * def process(self):
+ *     dim = self.properties.dim.value
+ *     def compute(task):
+ *         data = numpy.zeros((dim[0], dim[1], dim[2]), dtype=numpy.float32)
+ *         for z in range(dim[2]):
+ *             if task.cancelled:
+ *                 return None
+ *             data[:, :, z] = numpy.random.rand(dim[0], dim[1])
+ *             task.progress((z + 1) / dim[2])
+ *         return Volume(data)
+ *     return compute
+ *
+ * def finish(self, volume):
+ *     self.outports.outport.setData(volume)
+ *
+ * self.setProcessAsync(process, finish)
+ * \endcode
  */
 
 /**
@@ -98,26 +130,64 @@ namespace inviwo {
  * \brief Loads a mesh and volume via a python script. The processor is invalidated
  * as soon as the script changes on disk.
  */
-class IVW_MODULE_PYTHON3_API PythonScriptProcessor : public Processor {
+class IVW_MODULE_PYTHON3_API PythonScriptProcessor : public Processor, public ProgressBarOwner {
 public:
+    /**
+     * Passed to the compute function of setProcessAsync, which runs on a pool thread.
+     */
+    class IVW_MODULE_PYTHON3_API Task : public std::enable_shared_from_this<Task> {
+    public:
+        Task(PythonScriptProcessor* processor, pybind11::object compute);
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        ~Task();
+
+        bool isCancelled() const;
+        /**
+         * Update the progress bar of the processor, can be called from any thread.
+         */
+        void progress(float progress);
+
+    private:
+        friend PythonScriptProcessor;
+        std::atomic<bool> cancelled_{false};
+        PythonScriptProcessor* processor_;  // Only accessed on the main thread
+        pybind11::object compute_;
+        pybind11::object result_;
+        std::future<void> done_;
+    };
+
     PythonScriptProcessor(InviwoApplication* app);
-    virtual ~PythonScriptProcessor() = default;
+    virtual ~PythonScriptProcessor();
 
     virtual void initializeResources() override;
     virtual void process() override;
 
     void setInitializeResources(pybind11::function func);
     void setProcess(pybind11::function func);
+    /**
+     * Run the processing on a pool thread, see the class documentation.
+     * @param process called on the main thread, returns the function to run on a pool thread
+     * @param finish called on the main thread with the result of that function
+     */
+    void setProcessAsync(pybind11::function process, pybind11::function finish);
 
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
 
 private:
+    void processAsync();
+    void startTask();
+    void cancelTask();
+
     FileProperty scriptFileName_;
     PythonScriptDisk script_;
 
     pybind11::function initializeResources_;
     pybind11::function process_;
+    pybind11::function processAsync_;
+    pybind11::function finish_;
+    std::shared_ptr<Task> task_;
 };
 
 }  // namespace inviwo
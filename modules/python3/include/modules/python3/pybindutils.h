@@ -56,9 +56,39 @@ namespace pyutil {
 
 IVW_MODULE_PYTHON3_API pybind11::dtype toNumPyFormat(const DataFormatBase *df);
 IVW_MODULE_PYTHON3_API const DataFormatBase *getDataFormat(size_t components, pybind11::array &arr);
+
+/**
+ * Returns \p arr itself if its elements are stored without gaps with the first dimension fastest
+ * and the components innermost, like the arrays returned by the data properties, and in native
+ * byte order. Otherwise returns a copy of it in that layout. Element [x, y, z, c] is always
+ * voxel (x, y, z) component c, independent of how the array is stored, so a C ordered array of
+ * more than one spatial dimension is copied as well.
+ * @param arr the array
+ * @param spatialDims number of dimensions before the optional component dimension
+ */
+IVW_MODULE_PYTHON3_API pybind11::array toDenseArray(pybind11::array arr, size_t spatialDims);
+
+/**
+ * Create a buffer from an array of shape (size) or (size, components). The data is always
+ * copied (see toDenseArray).
+ */
 IVW_MODULE_PYTHON3_API std::unique_ptr<BufferBase> createBuffer(pybind11::array &arr);
-IVW_MODULE_PYTHON3_API std::unique_ptr<Layer> createLayer(pybind11::array &arr);
-IVW_MODULE_PYTHON3_API std::unique_ptr<Volume> createVolume(pybind11::array &arr);
+
+/**
+ * Create a layer from an array of shape (x, y) or (x, y, components). Unless \p copy is true the
+ * layer uses the memory of the array directly, and keeps a reference to it, if the array is
+ * writeable, aligned and dense (see toDenseArray). Otherwise the data is copied.
+ */
+IVW_MODULE_PYTHON3_API std::unique_ptr<Layer> createLayer(pybind11::array &arr,
+                                                         bool copy = false);
+
+/**
+ * Create a volume from an array of shape (x, y, z) or (x, y, z, components). Unless \p copy is
+ * true the volume uses the memory of the array directly, and keeps a reference to it, if the
+ * array is writeable, aligned and dense (see toDenseArray). Otherwise the data is copied.
+ */
+IVW_MODULE_PYTHON3_API std::unique_ptr<Volume> createVolume(pybind11::array &arr,
+                                                           bool copy = false);
 
 template <int Dim>
 void checkDataFormat(const DataFormatBase *format, const Vector<Dim, size_t> &dim,
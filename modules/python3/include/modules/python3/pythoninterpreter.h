@@ -37,6 +37,13 @@
 namespace inviwo {
 class Python3Module;
 
+/**
+ * \brief Initializes the embedded python interpreter if needed.
+ *
+ * When the interpreter is embedded the GIL is released once initialization is done, such that
+ * python code can run on other threads. All code calling into python has to hold the GIL, use
+ * pybind11::gil_scoped_acquire.
+ */
 class IVW_MODULE_PYTHON3_API PythonInterpreter : public PythonExecutionOutputObservable {
 public:
     PythonInterpreter();
@@ -50,6 +57,7 @@ public:
 private:
     bool embedded_;
     bool isInit_;
+    void* mainThreadState_;  // PyThreadState of the main thread while the GIL is released
 };
 
 }  // namespace inviwo
@@ -58,8 +58,11 @@ NumPyVolume::NumPyVolume()
 
 void NumPyVolume::process() {
     auto vol = std::make_shared<Volume>(size_.get(), DataFloat32::get());
-    auto volObj = pybind11::cast(vol.get());
-    script_.run({{"vol", volObj}});
+    {
+        pybind11::gil_scoped_acquire gil;
+        auto volObj = pybind11::cast(vol.get());
+        script_.run({{"vol", volObj}});
+    }
     vol->dataMap_.dataRange = dvec2(0, 1);
     outport_.setData(vol);
 }
@@ -31,6 +31,8 @@
 #include <modules/python3/python3module.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/datastructures/geometry/basicmesh.h>
+#include <inviwo/core/util/raiiutils.h>
+#include <inviwo/core/util/stdextensions.h>
 
 namespace inviwo {
 
@@ -44,8 +46,34 @@ const ProcessorInfo PythonScriptProcessor::processorInfo_{
 };
 const ProcessorInfo PythonScriptProcessor::getProcessorInfo() const { return processorInfo_; }
 
+PythonScriptProcessor::Task::Task(PythonScriptProcessor* processor, pybind11::object compute)
+    : processor_{processor}, compute_{std::move(compute)} {}
+
+PythonScriptProcessor::Task::~Task() {
+    // Might be destroyed on any thread, the python objects need the GIL
+    if (Py_IsInitialized()) {
+        pybind11::gil_scoped_acquire gil;
+        compute_ = pybind11::object{};
+        result_ = pybind11::object{};
+    } else {
+        compute_.release();
+        result_.release();
+    }
+}
+
+bool PythonScriptProcessor::Task::isCancelled() const { return cancelled_; }
+
+void PythonScriptProcessor::Task::progress(float progress) {
+    dispatchFront([task = shared_from_this(), progress]() {
+        if (task->processor_ && !task->isCancelled()) {
+            task->processor_->updateProgress(progress);
+        }
+    });
+}
+
 PythonScriptProcessor::PythonScriptProcessor(InviwoApplication* app)
     : Processor()
+    , ProgressBarOwner()
     , scriptFileName_("scriptFileName", "File Name",
                       app->getModuleByType<Python3Module>()->getPath(ModulePath::Data) +
                           "/scripts/scriptprocessorexample.py",
@@ -57,12 +85,16 @@ PythonScriptProcessor::PythonScriptProcessor(InviwoApplication* app)
     isSink_.setUpdate([]() { return true; });
 
     auto runscript = [this]() {
-        auto locals = py::globals();
-        locals["self"] = pybind11::cast(this);
-        try {
-            script_.run(locals);
-        } catch (std::exception& e) {
-            LogError(e.what())
+        cancelTask();
+        {
+            py::gil_scoped_acquire gil;
+            auto locals = py::globals();
+            locals["self"] = pybind11::cast(this);
+            try {
+                script_.run(locals);
+            } catch (std::exception& e) {
+                LogError(e.what())
+            }
         }
         invalidate(InvalidationLevel::InvalidOutput);
     };
@@ -75,20 +107,110 @@ PythonScriptProcessor::PythonScriptProcessor(InviwoApplication* app)
 
     script_.onChange([runscript]() { runscript(); });
 
+    progressBar_.hide();
+
     runscript();
 }
 
+PythonScriptProcessor::~PythonScriptProcessor() {
+    cancelTask();
+
+    pybind11::gil_scoped_acquire gil;
+    initializeResources_ = pybind11::function{};
+    process_ = pybind11::function{};
+    processAsync_ = pybind11::function{};
+    finish_ = pybind11::function{};
+}
+
 void PythonScriptProcessor::initializeResources() {
+    pybind11::gil_scoped_acquire gil;
     if (initializeResources_) initializeResources_(pybind11::cast(this));
 }
 
 void PythonScriptProcessor::process() {
-    if (process_) process_(pybind11::cast(this));
+    if (processAsync_) {
+        processAsync();
+    } else {
+        pybind11::gil_scoped_acquire gil;
+        if (process_) process_(pybind11::cast(this));
+    }
+}
+
+void PythonScriptProcessor::processAsync() {
+    pybind11::gil_scoped_acquire gil;
+
+    if (task_ && util::is_future_ready(task_->done_)) {
+        auto task = std::move(task_);
+        task->processor_ = nullptr;
+        progressBar_.hide();
+        if (!task->isCancelled()) {
+            task->done_.get();  // Rethrows any error from the compute function
+            if (finish_) finish_(pybind11::cast(this), task->result_);
+            return;
+        }
+    } else if (task_) {
+        // We got invalidated while the task is running, its result will be outdated. Start over
+        // once it has returned.
+        task_->cancelled_ = true;
+        return;
+    }
+
+    startTask();
+}
+
+void PythonScriptProcessor::startTask() {
+    namespace py = pybind11;
+
+    py::object compute = processAsync_(py::cast(this));
+    if (compute.is_none()) return;
+
+    task_ = std::make_shared<Task>(this, std::move(compute));
+    progressBar_.resetProgress();
+    progressBar_.show();
+
+    task_->done_ = dispatchPool([task = task_]() {
+        // Let the processor know that we are done, also in case of errors
+        util::OnScopeExit notify{[task]() {
+            dispatchFront([task]() {
+                if (task->processor_) {
+                    task->processor_->invalidate(InvalidationLevel::InvalidOutput);
+                }
+            });
+        }};
+
+        py::gil_scoped_acquire gil;
+        try {
+            auto func = std::move(task->compute_);
+            task->result_ = func(task);
+        } catch (const py::error_already_set& e) {
+            throw Exception(e.what(), IVW_CONTEXT_CUSTOM("PythonScriptProcessor"));
+        }
+    });
+}
+
+void PythonScriptProcessor::cancelTask() {
+    if (task_) {
+        task_->cancelled_ = true;
+        task_->processor_ = nullptr;
+        task_.reset();
+        progressBar_.hide();
+    }
 }
 
 void PythonScriptProcessor::setInitializeResources(pybind11::function func) {
     initializeResources_ = func;
 }
-void PythonScriptProcessor::setProcess(pybind11::function func) { process_ = func; }
+void PythonScriptProcessor::setProcess(pybind11::function func) {
+    process_ = func;
+    processAsync_ = pybind11::function{};
+    finish_ = pybind11::function{};
+}
+
+void PythonScriptProcessor::setProcessAsync(pybind11::function process,
+                                            pybind11::function finish) {
+    process_ = pybind11::function{};
+    processAsync_ = process;
+    finish_ = finish;
+}
 
 }  // namespace inviwo
@@ -48,6 +48,8 @@
 
 #include <inviwo/core/util/stdextensions.h>
 
+#include <cstdint>
+
 namespace inviwo {
 
 namespace pyutil {
@@ -90,6 +92,87 @@ const DataFormatBase *getDataFormat(size_t components, pybind11::array &arr) {
     return format;
 }
 
+namespace {
+
+/**
+ * A RAM representation that uses the memory of a numpy array directly. The array is referenced
+ * until the representation is destroyed, which can happen on any thread, hence the GIL is
+ * acquired to release it.
+ */
+template <typename Base>
+class NumPyRepresentation : public Base {
+public:
+    using T = typename Base::type;
+
+    template <typename Dims>
+    NumPyRepresentation(pybind11::array arr, Dims dims)
+        : Base(static_cast<T *>(arr.mutable_data()), dims), array_{std::move(arr)} {
+        this->removeDataOwnership();
+    }
+    NumPyRepresentation(const NumPyRepresentation &) = delete;
+    NumPyRepresentation &operator=(const NumPyRepresentation &) = delete;
+    virtual ~NumPyRepresentation() {
+        if (Py_IsInitialized()) {
+            pybind11::gil_scoped_acquire gil;
+            array_ = pybind11::array{};
+        } else {
+            array_.release();
+        }
+    }
+
+private:
+    pybind11::array array_;
+};
+
+bool isNative(const pybind11::array &arr) {
+    return arr.dtype().attr("isnative").cast<bool>();
+}
+
+/*
+ * Check if the array is stored without gaps in the layout of the data properties, with the
+ * first dimension fastest and the components innermost. Element [x, y, z, c] of an array is
+ * always voxel (x, y, z) component c, so this is the only layout we can use as is.
+ */
+bool isDense(const pybind11::array &arr, size_t spatialDims) {
+    auto expected = static_cast<pybind11::ssize_t>(arr.itemsize());
+    if (static_cast<size_t>(arr.ndim()) > spatialDims) {
+        if (arr.shape(spatialDims) > 1 && arr.strides(spatialDims) != expected) return false;
+        expected *= arr.shape(spatialDims);
+    }
+    for (size_t i = 0; i < spatialDims; ++i) {
+        if (arr.shape(i) > 1 && arr.strides(i) != expected) return false;
+        expected *= arr.shape(i);
+    }
+    return true;
+}
+
+/*
+ * Returns the array itself if it can be used as is, otherwise a copy with native byte order in
+ * the layout of the data properties. The copy is made by reversing the spatial axes, copying
+ * that in C order, and reversing them back.
+ */
+pybind11::array makeDense(pybind11::array arr, size_t spatialDims) {
+    if (!isNative(arr)) {
+        arr = arr.attr("astype")(arr.dtype().attr("newbyteorder")("="));
+    }
+    if (!isDense(arr, spatialDims)) {
+        pybind11::list axes;
+        for (size_t i = spatialDims; i-- > 0;) axes.append(i);
+        for (size_t i = spatialDims; i < static_cast<size_t>(arr.ndim()); ++i) axes.append(i);
+        const pybind11::tuple order(axes);
+
+        auto reversed = pybind11::array::ensure(arr.attr("transpose")(order),
+                                                pybind11::array::c_style);
+        arr = reversed.attr("transpose")(order);
+    }
+    return arr;
+}
+
+template <typename T>
+bool canWrap(const pybind11::array &arr) {
+    return arr.writeable() && reinterpret_cast<std::uintptr_t>(arr.data()) % alignof(T) == 0;
+}
+
 struct BufferFromArrayDispatcher {
     using type = std::unique_ptr<BufferBase>;
 
@@ -97,7 +180,7 @@ struct BufferFromArrayDispatcher {
     std::unique_ptr<BufferBase> operator()(pybind11::array &arr) {
         using Type = typename T::type;
         auto buf = std::make_unique<Buffer<Type>>(arr.shape(0));
-        memcpy(buf->getEditableRAMRepresentation()->getData(), arr.data(0), arr.nbytes());
+        memcpy(buf->getEditableRAMRepresentation()->getData(), arr.data(), arr.nbytes());
         return buf;
     }
 };
@@ -106,11 +189,15 @@ struct LayerFromArrayDispatcher {
     using type = std::unique_ptr<Layer>;
 
     template <typename Result, typename T>
-    std::unique_ptr<Layer> operator()(pybind11::array &arr) {
+    std::unique_ptr<Layer> operator()(pybind11::array &arr, bool copy) {
         using Type = typename T::type;
         size2_t dims(arr.shape(0), arr.shape(1));
+        if (!copy && canWrap<Type>(arr)) {
+            return std::make_unique<Layer>(
+                std::make_shared<NumPyRepresentation<LayerRAMPrecision<Type>>>(arr, dims));
+        }
         auto layerRAM = std::make_shared<LayerRAMPrecision<Type>>(dims);
-        memcpy(layerRAM->getData(), arr.data(0), arr.nbytes());
+        memcpy(layerRAM->getData(), arr.data(), arr.nbytes());
         return std::make_unique<Layer>(layerRAM);
     }
 };
@@ -119,40 +206,53 @@ struct VolumeFromArrayDispatcher {
     using type = std::unique_ptr<Volume>;
 
     template <typename Result, typename T>
-    std::unique_ptr<Volume> operator()(pybind11::array &arr) {
+    std::unique_ptr<Volume> operator()(pybind11::array &arr, bool copy) {
         using Type = typename T::type;
         size3_t dims(arr.shape(0), arr.shape(1), arr.shape(2));
+        if (!copy && canWrap<Type>(arr)) {
+            return std::make_unique<Volume>(
+                std::make_shared<NumPyRepresentation<VolumeRAMPrecision<Type>>>(arr, dims));
+        }
         auto volumeRAM = std::make_shared<VolumeRAMPrecision<Type>>(dims);
-        memcpy(volumeRAM->getData(), arr.data(0), arr.nbytes());
+        memcpy(volumeRAM->getData(), arr.data(), arr.nbytes());
         return std::make_unique<Volume>(volumeRAM);
     }
 };
 
+}  // namespace
+
+pybind11::array toDenseArray(pybind11::array arr, size_t spatialDims) {
+    return makeDense(std::move(arr), spatialDims);
+}
+
 std::unique_ptr<BufferBase> createBuffer(pybind11::array &arr) {
     auto ndim = arr.ndim();
     ivwAssert(ndim == 1 || ndim == 2, "ndims must be either 1 or 2");
     auto df = pyutil::getDataFormat(ndim == 1 ? 1 : arr.shape(1), arr);
+    auto dense = makeDense(arr, 1);
     BufferFromArrayDispatcher dispatcher;
     return dispatching::dispatch<std::unique_ptr<BufferBase>, dispatching::filter::All>(
-        df->getId(), dispatcher, arr);
+        df->getId(), dispatcher, dense);
 }
 
-std::unique_ptr<Layer> createLayer(pybind11::array &arr) {
+std::unique_ptr<Layer> createLayer(pybind11::array &arr, bool copy) {
     auto ndim = arr.ndim();
     ivwAssert(ndim == 2 || ndim == 3, "Ndims must be either 2 or 3");
     auto df = pyutil::getDataFormat(ndim == 2 ? 1 : arr.shape(2), arr);
+    auto dense = makeDense(arr, 2);
     LayerFromArrayDispatcher dispatcher;
-    return dispatching::dispatch<std::unique_ptr<Layer>, dispatching::filter::All>(df->getId(),
-                                                                                   dispatcher, arr);
+    return dispatching::dispatch<std::unique_ptr<Layer>, dispatching::filter::All>(
+        df->getId(), dispatcher, dense, copy);
 }
 
-std::unique_ptr<Volume> createVolume(pybind11::array &arr) {
+std::unique_ptr<Volume> createVolume(pybind11::array &arr, bool copy) {
     auto ndim = arr.ndim();
     ivwAssert(ndim == 3 || ndim == 4, "Ndims must be either 3 or 4");
     auto df = pyutil::getDataFormat(ndim == 3 ? 1 : arr.shape(3), arr);
+    auto dense = makeDense(arr, 3);
     VolumeFromArrayDispatcher dispatcher;
     return dispatching::dispatch<std::unique_ptr<Volume>, dispatching::filter::All>(
-        df->getId(), dispatcher, arr);
+        df->getId(), dispatcher, dense, copy);
 }
 
 }  // namespace pyutil
@@ -44,7 +44,8 @@
 
 namespace inviwo {
 
-PythonInterpreter::PythonInterpreter() : embedded_{false}, isInit_(false) {
+PythonInterpreter::PythonInterpreter()
+    : embedded_{false}, isInit_(false), mainThreadState_{nullptr} {
     namespace py = pybind11;
 
     if (isInit_) {
@@ -103,12 +104,16 @@ sys.stderr = OutputRedirector(1)
         } catch (const py::error_already_set& e) {
             throw ModuleInitException(e.what(), IVW_CONTEXT);
         }
+
+        // Let other threads run python, everyone calling into python has to acquire the GIL
+        mainThreadState_ = PyEval_SaveThread();
     }
 }
 
 PythonInterpreter::~PythonInterpreter() {
     namespace py = pybind11;
     if (embedded_) {
+        PyEval_RestoreThread(static_cast<PyThreadState*>(mainThreadState_));
         py::finalize_interpreter();
     }
 }
@@ -119,12 +124,14 @@ void PythonInterpreter::addModulePath(const std::string& path) {
 
 void PythonInterpreter::importModule(const std::string& moduleName) {
     namespace py = pybind11;
+    py::gil_scoped_acquire gil;
 
     auto dict = py::globals();
     dict[moduleName.c_str()] = py::module::import(moduleName.c_str());
 }
 
 bool PythonInterpreter::runString(std::string code) {
+    pybind11::gil_scoped_acquire gil;
     auto ret = PyRun_SimpleString(code.c_str());
     return ret == 0;
 }
@@ -54,6 +54,7 @@ std::unique_ptr<Processor> PythonProcessorFactoryObject::create(InviwoApplicatio
     namespace py = pybind11;
     const auto pi = getProcessorInfo();
 
+    py::gil_scoped_acquire gil;
     try {
         py::object proc = py::eval<py::eval_expr>(name_ + "(\"" + pi.displayName + "\", \"" +
                                                   pi.displayName + "\")");
@@ -116,6 +117,7 @@ PythonProcessorFactoryObjectData PythonProcessorFactoryObject::load(const std::s
         }
     }();
 
+    py::gil_scoped_acquire gil;
     try {
         py::exec(script);
     } catch (const std::exception& e) {
@@ -52,6 +52,7 @@ void addModulePath(const std::string& path) {
     std::string pathConv = path;
     replaceInString(pathConv, "\\", "/");
 
+    py::gil_scoped_acquire gil;
     py::module::import("sys").attr("path").cast<py::list>().append(pathConv);
 }
 
@@ -65,6 +66,7 @@ void removeModulePath(const std::string& path) {
     std::string pathConv = path;
     replaceInString(pathConv, "\\", "/");
 
+    py::gil_scoped_acquire gil;
     py::module::import("sys").attr("path").attr("remove")(pathConv);
 }
 
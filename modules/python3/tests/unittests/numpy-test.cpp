@@ -96,6 +96,74 @@ TEST(Python3Scripts, SimpleBufferTest) {
     EXPECT_TRUE(status);
 }
 
+TEST(NumPyInterop, VolumeSharesArrayMemory) {
+    PythonScript s;
+    // Transposing a C ordered array gives the layout of the data properties, x fastest
+    s.setSource("import numpy as np\na = np.arange(24, dtype=np.float32).reshape((4, 3, 2)).T\n");
+    bool status = false;
+    s.run([&](pybind11::dict dict) {
+        auto arr = pybind11::cast<pybind11::array>(dict["a"]);
+
+        auto volume = pyutil::createVolume(arr);
+        EXPECT_EQ(size3_t(2, 3, 4), volume->getDimensions());
+        EXPECT_EQ(arr.data(), volume->getRepresentation<VolumeRAM>()->getData());
+
+        auto copy = pyutil::createVolume(arr, true);
+        EXPECT_NE(arr.data(), copy->getRepresentation<VolumeRAM>()->getData());
+        auto data = static_cast<const float *>(copy->getRepresentation<VolumeRAM>()->getData());
+        for (int i = 0; i < 24; ++i) {
+            EXPECT_EQ(static_cast<float>(i), data[i]);
+        }
+        status = true;
+    });
+    EXPECT_TRUE(status);
+}
+
+TEST(NumPyInterop, VolumeRoundTrip) {
+    const size3_t dims{4, 3, 6};
+    auto ram = std::make_shared<VolumeRAMPrecision<int>>(dims);
+    auto src = ram->getDataTyped();
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                src[x + dims.x * (y + dims.y * z)] = static_cast<int>(x + 10 * y + 100 * z);
+            }
+        }
+    }
+    Volume volume(ram);
+
+    PythonScript s;
+    s.setSource(
+        "import numpy as np\n"
+        "from inviwopy.data import Volume\n"
+        "strided = Volume(v.data[:, :, ::2])\n"
+        "corder = Volume(np.ascontiguousarray(v.data[:, :, ::2]))\n"
+        "fortran = Volume(np.asfortranarray(v.data[:, :, ::2]))\n"
+        "assigned = Volume(np.zeros((4, 3, 3), dtype=np.int32))\n"
+        "assigned.data = v.data[:, :, ::2]\n");
+    bool status = false;
+    s.run({{"v", pybind11::cast(&volume, pybind11::return_value_policy::reference)}},
+          [&](pybind11::dict dict) {
+              for (auto name : {"strided", "corder", "fortran", "assigned"}) {
+                  auto result = pybind11::cast<Volume *>(dict[name]);
+                  ASSERT_EQ(size3_t(4, 3, 3), result->getDimensions()) << name;
+                  auto data =
+                      static_cast<const int *>(result->getRepresentation<VolumeRAM>()->getData());
+                  for (size_t z = 0; z < 3; ++z) {
+                      for (size_t y = 0; y < 3; ++y) {
+                          for (size_t x = 0; x < 4; ++x) {
+                              EXPECT_EQ(static_cast<int>(x + 10 * y + 200 * z),
+                                        data[x + 4 * (y + 3 * z)])
+                                  << name << " at " << x << ", " << y << ", " << z;
+                          }
+                      }
+                  }
+              }
+              status = true;
+          });
+    EXPECT_TRUE(status);
+}
+
 class DTypeTest : public ::testing::TestWithParam<std::string> {
 protected:
     virtual void SetUp() {}
@@ -157,11 +225,15 @@ protected:
                 auto dims = pLayer->getDimensions();
                 EXPECT_EQ(size2_t(2, 2), dims);
                 auto data = pLayer->getDataTyped();
-                int expected = 1;
-                for (int j = 0; j < 4; j++) {
-                    auto v = data[j];
-                    for (size_t i = 0; i < pLayer->getDataFormat()->getComponents(); i++) {
-                        EXPECT_EQ(expected++, (int)util::glmcomp(v, i));
+                const auto comps = pLayer->getDataFormat()->getComponents();
+                // Element [x, y, c] of the C ordered array is pixel (x, y) component c
+                for (size_t y = 0; y < 2; y++) {
+                    for (size_t x = 0; x < 2; x++) {
+                        auto v = data[x + 2 * y];
+                        for (size_t i = 0; i < comps; i++) {
+                            const auto expected = static_cast<int>(1 + (x * 2 + y) * comps + i);
+                            EXPECT_EQ(expected, (int)util::glmcomp(v, i));
+                        }
                     }
                 }
             });
@@ -194,11 +266,18 @@ protected:
                 auto dims = pLayer->getDimensions();
                 EXPECT_EQ(size3_t(2, 2, 2), dims);
                 auto data = pLayer->getDataTyped();
-                int expected = 1;
-                for (int j = 0; j < 4; j++) {
-                    auto v = data[j];
-                    for (size_t i = 0; i < pLayer->getDataFormat()->getComponents(); i++) {
-                        EXPECT_EQ(expected++, (int)util::glmcomp(v, i));
+                const auto comps = pLayer->getDataFormat()->getComponents();
+                // Element [x, y, z, c] of the C ordered array is voxel (x, y, z) component c
+                for (size_t z = 0; z < 2; z++) {
+                    for (size_t y = 0; y < 2; y++) {
+                        for (size_t x = 0; x < 2; x++) {
+                            auto v = data[x + 2 * (y + 2 * z)];
+                            for (size_t i = 0; i < comps; i++) {
+                                const auto expected =
+                                    static_cast<int>(1 + ((x * 2 + y) * 2 + z) * comps + i);
+                                EXPECT_EQ(expected, (int)util::glmcomp(v, i));
+                            }
+                        }
                     }
                 }
             });
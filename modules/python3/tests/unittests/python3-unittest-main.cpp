@@ -43,6 +43,7 @@
 #include <warn/push>
 #include <warn/ignore/all>
 #include <gtest/gtest.h>
+#include <pybind11/pybind11.h>
 #include <warn/pop>
 
 using namespace inviwo;
@@ -75,6 +76,8 @@ int main(int argc, char** argv) {
         ::testing::InitGoogleTest(&argc, argv);
 #endif
         ConfigurableGTestEventListener::setup();
+        // The tests call into python directly, hold the GIL while they run
+        pybind11::gil_scoped_acquire gil;
         ret = RUN_ALL_TESTS();
     }
 
@@ -36,6 +36,7 @@
 #include <modules/python3/python3module.h>
 #include <modules/python3/pythonscript.h>
 #include <modules/python3/pybindutils.h>
+#include <modules/python3/processors/pythonscriptprocessor.h>
 
 #include <inviwo/core/datastructures/image/image.h>
 #include <inviwo/core/datastructures/image/layer.h>
@@ -51,12 +52,17 @@
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 
 #include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/fileproperty.h>
+#include <inviwo/core/util/raiiutils.h>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
 #include <glm/gtc/epsilon.hpp>
 
+#include <chrono>
+#include <thread>
+
 namespace inviwo {
 
 namespace {
@@ -65,6 +71,27 @@ std::string getPath() {
         ModulePath::UnitTests);
     return path + "/scripts/";
 }
+
+/*
+ * Run the queued main thread jobs until pred is true, with the GIL released in between such that
+ * the pool threads can run python code. Returns false after a timeout.
+ */
+template <typename Pred>
+bool waitFor(Pred pred) {
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > timeout) return false;
+        {
+            pybind11::gil_scoped_release release;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        util::getInviwoApplication()->processFront();
+    }
+    return true;
+}
+
+size_t pyLen(const char* name) { return pybind11::len(pybind11::globals()[name]); }
+
 }  // namespace
 
 TEST(Python3Scripts, GrabReturnValues) {
@@ -218,4 +245,58 @@ TEST(Python3Scripts, OptionPropertyTest) {
     EXPECT_TRUE(status);
 }
 
+TEST(Python3Scripts, ProcessAsync) {
+    auto app = util::getInviwoApplication();
+    // The compute function has to run on a pool thread, the test would block otherwise
+    const auto poolSize = app->getPoolSize();
+    if (poolSize == 0) app->resizePool(2);
+    util::OnScopeExit restorePool{[&]() {
+        pybind11::gil_scoped_release release;
+        app->resizePool(poolSize);
+    }};
+
+    PythonScriptProcessor processor(app);
+    static_cast<FileProperty*>(processor.getPropertyByIdentifier("scriptFileName"))
+        ->set(getPath() + "async_processor.py");
+    pybind11::object release = pybind11::globals()["release"];
+    // Unblock the task also if an assertion fails, before the pool is restored, which would
+    // otherwise wait for it forever
+    util::OnScopeExit unblock{[&]() { release.attr("set")(); }};
+
+    // Mimic the network evaluator, which sets the processor valid after each process call
+    const auto evaluate = [&]() {
+        processor.process();
+        processor.setValid();
+    };
+    const auto invalidated = [&]() { return !processor.isValid(); };
+
+    evaluate();
+    ASSERT_TRUE(waitFor([]() { return pyLen("tasks") == 1; }));
+    EXPECT_EQ(1, pyLen("started"));
+
+    // Invalidating while the task runs cancels it without starting a new one
+    processor.invalidate(InvalidationLevel::InvalidOutput);
+    evaluate();
+    processor.invalidate(InvalidationLevel::InvalidOutput);
+    evaluate();
+    EXPECT_TRUE(pybind11::globals()["tasks"][pybind11::int_(0)].attr("cancelled").cast<bool>());
+    EXPECT_EQ(1, pyLen("started"));
+
+    // Once the cancelled task returns exactly one new task is started
+    release.attr("set")();
+    ASSERT_TRUE(waitFor(invalidated));
+    evaluate();
+    EXPECT_EQ(2, pyLen("started"));
+    EXPECT_EQ(0, pyLen("results"));
+
+    // The result of the new task is passed to finish
+    ASSERT_TRUE(waitFor(invalidated));
+    evaluate();
+    EXPECT_EQ(2, pyLen("started"));
+    ASSERT_EQ(1, pyLen("results"));
+    EXPECT_EQ(2, pybind11::globals()["results"][pybind11::int_(0)].cast<int>());
+    EXPECT_FALSE(
+        pybind11::globals()["tasks"][pybind11::int_(1)].attr("cancelled").cast<bool>());
+}
+
 }  // namespace inviwo
@@ -0,0 +1,22 @@
+#Inviwo Python script 
+import threading
+
+# Observed and controlled by the unit test
+started = []
+tasks = []
+results = []
+release = threading.Event()
+
+def process(self):
+    value = len(started) + 1
+    started.append(value)
+    def compute(task):
+        tasks.append(task)
+        release.wait()
+        return value
+    return compute
+
+def finish(self, result):
+    results.append(result)
+
+self.setProcessAsync(process, finish)
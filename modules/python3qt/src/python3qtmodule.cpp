@@ -68,12 +68,14 @@ Python3QtModule::Python3QtModule(InviwoApplication* app)
     namespace py = pybind11;
 
     try {
+        py::gil_scoped_acquire gil;
         auto inviwopy = py::module::import("inviwopy");
         auto m = inviwopy.def_submodule("qt", "Qt dependent stuff");
 
         m.def("prompt", &prompt, py::arg("title"), py::arg("message"),
               py::arg("defaultResponse") = "");
-        m.def("update", []() { QCoreApplication::instance()->processEvents(); });
+        m.def("update", []() { QCoreApplication::instance()->processEvents(); },
+              py::call_guard<py::gil_scoped_release>());
 
         py::class_<PropertyListWidget>(m, "PropertyListWidget")
             .def(py::init([](InviwoApplication* app) {
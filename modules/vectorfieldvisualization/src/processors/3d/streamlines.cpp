@@ -171,32 +171,35 @@ void StreamLinesDeprecated::process() {
         }
     }
 
+    // Reused for all lines, the colors of a line are looked up in one batch
+    std::vector<float> tfPositions;
+    std::vector<vec4> colors;
     for (auto &line : *lines) {
-        auto position = line.getPositions().begin();
-        auto velocity = line.getMetaData<dvec3>("velocity").begin();
+        const auto &positions = line.getPositions();
+        const auto &velocities = line.getMetaData<dvec3>("velocity");
 
-        auto size = line.getPositions().size();
+        auto size = positions.size();
         if (size <= 1) continue;
 
         auto indexBuffer = mesh->addIndexBuffer(DrawType::Lines, ConnectivityType::StripAdjacency);
 
         indexBuffer->add(0);
 
+        tfPositions.resize(size);
         for (size_t i = 0; i < size; i++) {
-            vec3 pos(*position);
-            vec3 v(*velocity);
-
-            float l = glm::length(vec3(*velocity));
-            float d = glm::clamp(l / velocityScale_.get(), 0.0f, 1.0f);
+            float l = glm::length(vec3(velocities[i]));
+            tfPositions[i] = glm::clamp(l / velocityScale_.get(), 0.0f, 1.0f);
             maxVelocity = std::max(maxVelocity, l);
-            auto c = vec4(tf_.get().sample(d));
+        }
+        tf_.get().sample(tfPositions, colors);
 
-            indexBuffer->add(static_cast<std::uint32_t>(vertices.size()));
+        for (size_t i = 0; i < size; i++) {
+            vec3 pos(positions[i]);
+            vec3 v(velocities[i]);
 
-            vertices.push_back({pos, glm::normalize(v), pos, c});
+            indexBuffer->add(static_cast<std::uint32_t>(vertices.size()));
 
-            position++;
-            velocity++;
+            vertices.push_back({pos, glm::normalize(v), pos, colors[i]});
         }
         indexBuffer->add(static_cast<std::uint32_t>(vertices.size() - 1));
     }
@@ -59,6 +59,7 @@
 #include <inviwo/core/util/fileobserver.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/rendercontext.h>
+#include <inviwo/core/util/profiler.h>
 #include <inviwo/core/util/settings/settings.h>
 #include <inviwo/core/util/systemcapabilities.h>
 #include <inviwo/core/util/vectoroperations.h>
@@ -111,6 +112,7 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
     , clearAllSingeltons_{[]() {
         PickingManager::deleteInstance();
         RenderContext::deleteInstance();
+        Profiler::deleteInstance();
     }}
     , resourceManager_{std::make_unique<ResourceManager>()}
     , cameraFactory_{std::make_unique<CameraFactory>()}
@@ -167,6 +169,14 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
     init(this);
     RenderContext::init();
     PickingManager::init();
+    Profiler::init();
+
+    Profiler::getPtr()->setCapacity(systemSettings_->profilerCapacity_);
+    Profiler::getPtr()->setEnabled(systemSettings_->enableProfiler_);
+    systemSettings_->profilerCapacity_.onChange(
+        [this]() { Profiler::getPtr()->setCapacity(systemSettings_->profilerCapacity_); });
+    systemSettings_->enableProfiler_.onChange(
+        [this]() { Profiler::getPtr()->setEnabled(systemSettings_->enableProfiler_); });
 
     workspaceManager_->registerFactory(getProcessorFactory());
     workspaceManager_->registerFactory(getMetaDataFactory());
@@ -36,10 +36,13 @@
 #include <inviwo/core/util/vectoroperations.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/capabilities.h>
+#include <inviwo/core/util/commandlineparser.h>
+#include <inviwo/core/util/foreach.h>
 #include <inviwo/core/network/processornetwork.h>
 
 #include <string>
 #include <functional>
+#include <iomanip>
 
 namespace inviwo {
 
@@ -74,18 +77,32 @@ bool ModuleManager::isRuntimeModuleReloadingEnabled() {
 }
 
 void ModuleManager::registerModules(std::vector<std::unique_ptr<InviwoModuleFactoryObject>> mfo) {
+    // The timings are per registration pass, keep only the modules of this pass. Their load times
+    // have just been measured when loading the libraries.
+    util::erase_remove_if(timings_, [&](const ModuleTiming& timing) {
+        return !util::contains_if(
+            mfo, [&](const auto& obj) { return iCaseCmp(obj->name, timing.name); });
+    });
+    for (auto& timing : timings_) timing.init = std::chrono::nanoseconds{0};
+
     factoryObjects_.insert(factoryObjects_.end(), std::make_move_iterator(mfo.begin()),
                            std::make_move_iterator(mfo.end()));
 
     // Topological sort to make sure that we load modules in correct order
     topologicalModuleFactoryObjectSort(std::begin(factoryObjects_), std::end(factoryObjects_));
 
+    using clock = std::chrono::high_resolution_clock;
+
+    std::vector<std::string> registered;
     for (auto& obj : factoryObjects_) {
         app_->postProgress("Loading module: " + obj->name);
         if (getModuleByIdentifier(obj->name)) continue;  // already loaded
         if (!checkDependencies(*obj)) continue;
         try {
+            const auto start = clock::now();
             registerModule(obj->create(app_));
+            moduleTiming(obj->name).init = clock::now() - start;
+            registered.push_back(obj->name);
         } catch (const ModuleInitException& e) {
             auto dereg = deregisterDependetModules(e.getModulesToDeregister());
             auto err = (!dereg.empty() ? "\nUnregistered dependent modules: " +
@@ -98,10 +115,31 @@ void ModuleManager::registerModules(std::vector<std::unique_ptr<InviwoModuleFact
 
     app_->postProgress("Loading Capabilities");
     for (auto& module : modules_) {
+        const auto start = clock::now();
         for (auto& elem : module->getCapabilities()) {
             elem->retrieveStaticInfo();
             elem->printInfo();
         }
+        // Modules kept from an earlier pass, e.g. protected ones, are not timed again
+        const auto& id = module->getIdentifier();
+        if (util::contains_if(registered, [&](const auto& name) { return iCaseCmp(name, id); })) {
+            moduleTiming(id).init += clock::now() - start;
+        }
+    }
+
+    if (app_->getCommandLineParser().getLogModuleTiming()) {
+        using ms = std::chrono::duration<double, std::milli>;
+        std::stringstream ss;
+        ss << "Module startup times (load / init, ms):";
+        std::chrono::nanoseconds total{0};
+        for (const auto& timing : timings_) {
+            ss << "\n  " << std::left << std::setw(30) << timing.name << std::right << std::fixed
+               << std::setprecision(1) << std::setw(9) << ms(timing.load).count() << " / "
+               << std::setw(9) << ms(timing.init).count();
+            total += timing.load + timing.init;
+        }
+        ss << "\n  Total: " << ms(total).count();
+        LogInfo(ss.str());
     }
 
     onModulesDidRegister_.invoke();
@@ -149,22 +187,41 @@ void ModuleManager::registerModules(RuntimeModuleLoading) {
     // 4. Start observing file if reloadLibrariesWhenChanged
     // 5. Pass module factories to registerModules
 
-    // Find unique files and directories in specified search paths
+    // Find unique files and directories in specified search paths. The search is recursive,
+    // hence paths inside of other search paths would only be listed again.
     auto librarySearchPaths = util::getLibrarySearchPaths();
-    std::set<std::string> libraryFiles;
+    for (auto& path : librarySearchPaths) path = filesystem::cleanupPath(path);
+#if WIN32
+    librarySearchPaths = util::removeNestedPaths(std::move(librarySearchPaths), false);
+#else
+    librarySearchPaths = util::removeNestedPaths(std::move(librarySearchPaths), true);
+#endif
+
+    // List the directories concurrently, network drives and large library folders make this
+    // slow. Results are kept per search path to preserve the search order.
+    std::vector<std::vector<std::string>> filesPerPath(librarySearchPaths.size());
+    std::vector<std::vector<std::string>> dirsPerPath(librarySearchPaths.size());
+    util::forEachRangeParallel(
+        librarySearchPaths.size(),
+        [&](size_t begin, size_t end) {
+            using namespace inviwo::filesystem;
+            for (size_t i = begin; i < end; ++i) {
+                try {
+                    filesPerPath[i] =
+                        getDirectoryContentsRecursively(librarySearchPaths[i], ListMode::Files);
+                    dirsPerPath[i] = getDirectoryContentsRecursively(librarySearchPaths[i],
+                                                                     ListMode::Directories);
+                } catch (FileException&) {  // Invalid path, ignore it
+                }
+            }
+        },
+        1);
+
+    std::vector<std::string> libraryFiles;
     LibrarySearchDirs searchDirectories{librarySearchPaths};
-    for (auto path : librarySearchPaths) {
-        using namespace inviwo::filesystem;
-        // Make sure that we have an absolute path to avoid duplicates
-        path = cleanupPath(path);
-        try {
-            auto files = getDirectoryContentsRecursively(path, ListMode::Files);
-            auto dirs = getDirectoryContentsRecursively(path, ListMode::Directories);
-            libraryFiles.insert(std::make_move_iterator(files.begin()),
-                                std::make_move_iterator(files.end()));
-            searchDirectories.add(dirs);
-        } catch (FileException&) {  // Invalid path, ignore it
-        }
+    for (size_t i = 0; i < librarySearchPaths.size(); ++i) {
+        util::append(libraryFiles, filesPerPath[i]);
+        searchDirectories.add(dirsPerPath[i]);
     }
     // Determines if a library is already loaded into the application
     auto isModuleLibraryLoaded = [&](const std::string path) {
@@ -177,12 +234,20 @@ void ModuleManager::registerModules(RuntimeModuleLoading) {
     auto isEnabled = getEnabledFilter();
     auto libraryTypes = SharedLibrary::libraryFileExtensions();
     // Remove unsupported files and files belonging to already loaded modules.
-    util::map_erase_remove_if(libraryFiles, [&](const auto& file) {
+    util::erase_remove_if(libraryFiles, [&](const auto& file) {
         return libraryTypes.count(filesystem::getFileExtension(file)) == 0 ||
                (file.find("inviwo-module") == std::string::npos &&
                 file.find("inviwo-core") == std::string::npos) ||
                isModuleLibraryLoaded(file) || !isEnabled(file);
     });
+    // Only load the first library of each module, the same module is often found both in the
+    // executable directory and in the library path.
+    {
+        std::set<std::string> moduleNames;
+        util::erase_remove_if(libraryFiles, [&](const auto& file) {
+            return !moduleNames.insert(toLower(util::stripModuleFileNameDecoration(file))).second;
+        });
+    }
 
     const auto tmpDir = [&]() -> std::string {
         if (isRuntimeModuleReloadingEnabled() && util::hasAddLibrarySearchDirsFunction()) {
@@ -202,34 +267,54 @@ void ModuleManager::registerModules(RuntimeModuleLoading) {
     auto isLoaded = [loaded = util::getLoadedLibraries()](const auto& path) {
         return util::contains_if(loaded, [&](const auto& lib) { return iCaseCmp(path, lib); });
     };
-    std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
-    for (const auto& filePath : libraryFiles) {
-        const auto tmpPath = [&]() -> std::string {
-            if (isRuntimeModuleReloadingEnabled() && util::hasAddLibrarySearchDirsFunction()) {
-                auto dstPath = tmpDir + "/" + filesystem::getFileNameWithExtension(filePath);
-                if (isLoaded(filePath)) {
-                    // Already loaded modules are loaded from the application dir
-                    dstPath = filePath;
-                    protected_.insert(util::stripModuleFileNameDecoration(filePath));
-                } else if (filesystem::fileModificationTime(filePath) !=
-                           filesystem::fileModificationTime(dstPath)) {
-                    // Load a copy of the file to make sure that we can overwrite the file.
-                    filesystem::copyFile(filePath, dstPath);
+    // Decide where to load each library from, copying changed libraries to the temporary
+    // directory concurrently
+    std::vector<std::string> loadPaths(libraryFiles.size());
+    std::vector<char> alreadyLoaded(libraryFiles.size(), 0);
+    util::forEachRangeParallel(
+        libraryFiles.size(),
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const auto& filePath = libraryFiles[i];
+                if (isRuntimeModuleReloadingEnabled() && util::hasAddLibrarySearchDirsFunction()) {
+                    auto dstPath = tmpDir + "/" + filesystem::getFileNameWithExtension(filePath);
+                    if (isLoaded(filePath)) {
+                        // Already loaded modules are loaded from the application dir
+                        dstPath = filePath;
+                        alreadyLoaded[i] = 1;
+                    } else if (filesystem::fileModificationTime(filePath) !=
+                               filesystem::fileModificationTime(dstPath)) {
+                        // Load a copy of the file to make sure that we can overwrite the file.
+                        filesystem::copyFile(filePath, dstPath);
+                    }
+                    loadPaths[i] = dstPath;
+                } else {
+                    loadPaths[i] = libraryFiles[i];
                 }
-                return dstPath;
-            } else {
-                return filePath;
             }
-        }();
+        },
+        1);
+
+    // The libraries are loaded sequentially, the dynamic loader serializes loading anyway and the
+    // static initializers of the modules are not written to run concurrently.
+    using clock = std::chrono::high_resolution_clock;
+    std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+    for (size_t i = 0; i < libraryFiles.size(); ++i) {
+        const auto& filePath = libraryFiles[i];
+        const auto& tmpPath = loadPaths[i];
+        if (alreadyLoaded[i]) {
+            protected_.insert(util::stripModuleFileNameDecoration(filePath));
+        }
 
         try {
+            const auto start = clock::now();
             // Load library. Will throw exception if failed to load
             auto sharedLib = std::make_unique<SharedLibrary>(tmpPath);
             // Only consider libraries with Inviwo module creation function
             if (auto moduleFunc = sharedLib->findSymbolTyped<f_getModule>("createModule")) {
                 // Add module factory object
                 modules.emplace_back(moduleFunc());
-                auto moduleName = toLower(modules.back()->name);
+                moduleTiming(modules.back()->name).load = clock::now() - start;
                 if (modules.back()->protectedModule == ProtectedModule::on) {
                     protected_.insert(modules.back()->name);
                 }
@@ -284,6 +369,17 @@ const std::vector<std::unique_ptr<InviwoModule>>& ModuleManager::getModules() co
     return modules_;
 }
 
+auto ModuleManager::getModuleTimings() const -> const std::vector<ModuleTiming>& {
+    return timings_;
+}
+
+auto ModuleManager::moduleTiming(const std::string& name) -> ModuleTiming& {
+    auto it = util::find_if(timings_, [&](const auto& t) { return iCaseCmp(t.name, name); });
+    if (it != timings_.end()) return *it;
+    timings_.push_back({name});
+    return timings_.back();
+}
+
 const std::vector<std::unique_ptr<InviwoModuleFactoryObject>>&
 ModuleManager::getModuleFactoryObjects() const {
     return factoryObjects_;
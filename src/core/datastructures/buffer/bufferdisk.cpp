@@ -0,0 +1,56 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/buffer/bufferdisk.h>
+
+namespace inviwo {
+
+BufferDisk::BufferDisk(size_t size, const DataFormatBase* format, BufferUsage usage,
+                       BufferTarget target)
+    : BufferRepresentation(format, usage, target)
+    , DiskRepresentation<BufferRepresentation>()
+    , size_(size) {}
+
+BufferDisk::BufferDisk(std::string srcFile, size_t size, const DataFormatBase* format,
+                       BufferUsage usage, BufferTarget target)
+    : BufferRepresentation(format, usage, target)
+    , DiskRepresentation<BufferRepresentation>(srcFile)
+    , size_(size) {}
+
+BufferDisk* BufferDisk::clone() const { return new BufferDisk(*this); }
+
+std::type_index BufferDisk::getTypeIndex() const { return std::type_index(typeid(BufferDisk)); }
+
+void BufferDisk::setSize(size_t) {
+    throw Exception("Can not set size of a Buffer Disk", IVW_CONTEXT);
+}
+
+size_t BufferDisk::getSize() const { return size_; }
+
+}  // namespace inviwo
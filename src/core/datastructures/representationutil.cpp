@@ -37,6 +37,7 @@
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 #include <inviwo/core/datastructures/image/layerramconverter.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/datastructures/buffer/bufferramconverter.h>
 
 #include <inviwo/core/datastructures/representationfactory.h>
 #include <inviwo/core/datastructures/representationfactoryobject.h>
@@ -153,6 +154,8 @@ void registerCoreRepresentationsHelper(T& obj) {
         std::make_unique<VolumeDisk2RAMConverter>());
     obj.template registerRepresentationConverter<LayerRepresentation>(
         std::make_unique<LayerDisk2RAMConverter>());
+    obj.template registerRepresentationConverter<BufferRepresentation>(
+        std::make_unique<BufferDisk2RAMConverter>());
 }
 
 }  // namespace
@@ -44,6 +44,7 @@
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/zip.h>
 
+#include <algorithm>
 #include <cmath>
 
 namespace inviwo {
@@ -81,7 +82,8 @@ TransferFunction& TransferFunction::operator=(const TransferFunction& rhs) {
         }
         maskMin_ = rhs.maskMin_;
         maskMax_ = rhs.maskMax_;
-        invalidData_ = rhs.invalidData_;
+        // The lookup table is not copied
+        invalidData_ = true;
 
         TFPrimitiveSet::operator=(rhs);
     }
@@ -162,6 +164,61 @@ vec4 TransferFunction::sample(double v) const { return interpolateColor(v); }
 
 vec4 TransferFunction::sample(float v) const { return interpolateColor(v); }
 
+namespace {
+
+template <typename T>
+void sampleLookupTable(const vec4* table, size_t size, const T* positions, vec4* result,
+                       size_t count) {
+    if (size < 2) {
+        std::fill(result, result + count, size == 1 ? table[0] : vec4(0.0f));
+        return;
+    }
+    const T scale = static_cast<T>(size - 1);
+    for (size_t i = 0; i < count; ++i) {
+        // Written such that NaN ends up at zero
+        const T v = positions[i] > T{0} ? std::min(positions[i], T{1}) * scale : T{0};
+        const size_t j = std::min(static_cast<size_t>(v), size - 2);
+        const float x = static_cast<float>(v - static_cast<T>(j));
+        result[i] = table[j] + (table[j + 1] - table[j]) * x;
+    }
+}
+
+}  // namespace
+
+void TransferFunction::sample(const double* positions, vec4* result, size_t count,
+                              bool applyMask) const {
+    if (applyMask) {
+        if (invalidData_) calcTransferValues();
+        sampleLookupTable(dataRepr_->getDataTyped(), getTextureSize(), positions, result, count);
+    } else {
+        std::transform(positions, positions + count, result,
+                       [&](double v) { return interpolateColor(v); });
+    }
+}
+
+void TransferFunction::sample(const float* positions, vec4* result, size_t count,
+                              bool applyMask) const {
+    if (applyMask) {
+        if (invalidData_) calcTransferValues();
+        sampleLookupTable(dataRepr_->getDataTyped(), getTextureSize(), positions, result, count);
+    } else {
+        std::transform(positions, positions + count, result,
+                       [&](float v) { return interpolateColor(v); });
+    }
+}
+
+void TransferFunction::sample(const std::vector<double>& positions, std::vector<vec4>& result,
+                              bool applyMask) const {
+    result.resize(positions.size());
+    sample(positions.data(), result.data(), positions.size(), applyMask);
+}
+
+void TransferFunction::sample(const std::vector<float>& positions, std::vector<vec4>& result,
+                              bool applyMask) const {
+    result.resize(positions.size());
+    sample(positions.data(), result.data(), positions.size(), applyMask);
+}
+
 std::vector<FileExtension> TransferFunction::getSupportedExtensions() const {
     return {{"itf", "Inviwo Transfer Function"}, {"png", "Transfer Function Image"}};
 }
@@ -282,6 +339,9 @@ std::vector<TFPrimitiveData> TransferFunction::simplify(const std::vector<TFPrim
 }
 
 void TransferFunction::calcTransferValues() const {
+    std::lock_guard<std::mutex> lock{dataMutex_};
+    if (!invalidData_) return;
+
     ivwAssert(std::is_sorted(sorted_.begin(), sorted_.end(), comparePtr{}), "Should be sorted");
 
     // We assume the the points a sorted here.
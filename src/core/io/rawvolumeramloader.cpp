@@ -58,4 +58,19 @@ void RawVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentati
     util::readBytesIntoBuffer(rawFile_, offset_, size * format_->getSize(), littleEndian_,
                               format_->getSize(), volumeDst->getData());
 }
+
+std::shared_ptr<VolumeRAM> RawVolumeRAMLoader::readSlices(size_t zBegin, size_t zEnd) const {
+    if (zBegin > zEnd || zEnd > dimensions_.z) {
+        throw Exception("Slice range [" + toString(zBegin) + ", " + toString(zEnd) +
+                            ") outside of volume with " + toString(dimensions_.z) + " slices",
+                        IVW_CONTEXT);
+    }
+
+    auto volumeDst = createVolumeRAM(size3_t{dimensions_.x, dimensions_.y, zEnd - zBegin}, format_);
+    const size_t sliceSize = dimensions_.x * dimensions_.y * format_->getSize();
+    util::readBytesIntoBuffer(rawFile_, offset_ + zBegin * sliceSize, (zEnd - zBegin) * sliceSize,
+                              littleEndian_, format_->getSize(), volumeDst->getData());
+    return volumeDst;
+}
+
 }  // namespace inviwo
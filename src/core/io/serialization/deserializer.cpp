@@ -30,6 +30,7 @@
 #include <inviwo/core/io/serialization/deserializer.h>
 #include <inviwo/core/io/serialization/serializable.h>
 #include <inviwo/core/io/serialization/versionconverter.h>
+#include <inviwo/core/io/serialization/serializebinary.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/processors/processorfactory.h>
 #include <inviwo/core/metadata/metadatafactory.h>
@@ -38,13 +39,17 @@
 #include <inviwo/core/util/factory.h>
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/util/filesystem.h>
 
 namespace inviwo {
 
 Deserializer::Deserializer(std::string fileName, bool allowReference)
     : SerializeBase(fileName, allowReference) {
     try {
-        doc_.LoadFile();
+        auto stream = filesystem::ifstream(fileName, std::ios::in | std::ios::binary);
+        if (!stream.is_open() || !util::readBinaryDocument(stream, doc_)) {
+            doc_.LoadFile();
+        }
         rootElement_ = doc_.FirstChildElement();
         storeReferences(rootElement_);
         rootElement_->GetAttribute(SerializeConstants::VersionAttribute, &inviwoWorkspaceVersion_,
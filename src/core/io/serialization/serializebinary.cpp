@@ -0,0 +1,246 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/serialization/serializebinary.h>
+#include <inviwo/core/io/serialization/serializationexception.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+// The first character can never start an xml document
+constexpr std::array<char, 4> magic = {'\x89', 'I', 'V', 'W'};
+constexpr std::uint8_t formatVersion = 1;
+
+enum class Tag : std::uint8_t { Element = 1, End = 2, Text = 3 };
+
+void writeSize(std::string& buffer, size_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+class BinaryWriter : public TiXmlVisitor {
+public:
+    virtual bool VisitEnter(const TiXmlElement& element, const TiXmlAttribute* first) override {
+        body_.push_back(static_cast<char>(Tag::Element));
+        writeString(element.ValueStr());
+        size_t count = 0;
+        for (auto attribute = first; attribute; attribute = attribute->Next()) ++count;
+        writeSize(body_, count);
+        for (auto attribute = first; attribute; attribute = attribute->Next()) {
+            writeString(attribute->NameTStr());
+            writeString(attribute->ValueStr());
+        }
+        return true;
+    }
+    virtual bool VisitExit(const TiXmlElement&) override {
+        body_.push_back(static_cast<char>(Tag::End));
+        return true;
+    }
+    virtual bool Visit(const TiXmlText& text) override {
+        body_.push_back(static_cast<char>(Tag::Text));
+        writeString(text.ValueStr());
+        return true;
+    }
+
+    void write(std::ostream& stream) const {
+        std::string header(magic.begin(), magic.end());
+        header.push_back(static_cast<char>(formatVersion));
+        writeSize(header, strings_.size());
+        stream.write(header.data(), header.size());
+
+        std::string lengths;
+        for (auto str : strings_) {
+            lengths.clear();
+            writeSize(lengths, str->size());
+            stream.write(lengths.data(), lengths.size());
+            stream.write(str->data(), str->size());
+        }
+        stream.write(body_.data(), body_.size());
+    }
+
+private:
+    void writeString(const std::string& str) {
+        auto res = ids_.emplace(str, strings_.size());
+        if (res.second) strings_.push_back(&res.first->first);
+        writeSize(body_, res.first->second);
+    }
+
+    std::unordered_map<std::string, size_t> ids_;
+    std::vector<const std::string*> strings_;  // in id order, points to the keys of ids_
+    std::string body_;
+};
+
+// Exposes the TinyXML element of a ticpp element so that the tree below it can be built without
+// creating a ticpp wrapper for every node. The ticpp element owns the tree until it is linked.
+class RootElement : public TxElement {
+public:
+    RootElement(const std::string& name) : TxElement(name) {}
+    TiXmlElement* get() const { return m_tiXmlPointer; }
+};
+
+class BinaryReader {
+public:
+    BinaryReader(const std::string& data) : pos_{data.data()}, end_{data.data() + data.size()} {
+        if (data.size() < magic.size() + 1 ||
+            !std::equal(magic.begin(), magic.end(), data.begin())) {
+            throw SerializationException("Invalid binary serialization header",
+                                         IVW_CONTEXT_CUSTOM("BinaryReader"));
+        }
+        pos_ += magic.size();
+        const auto version = static_cast<std::uint8_t>(*pos_++);
+        if (version != formatVersion) {
+            throw SerializationException(
+                "Unsupported binary serialization version: " + std::to_string(version),
+                IVW_CONTEXT_CUSTOM("BinaryReader"));
+        }
+
+        const auto count = readSize();
+        // Every string needs at least one byte for its length
+        if (count > static_cast<size_t>(end_ - pos_)) truncated();
+        strings_.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            const auto length = readSize();
+            if (length > static_cast<size_t>(end_ - pos_)) truncated();
+            strings_.emplace_back(pos_, length);
+            pos_ += length;
+        }
+    }
+
+    void read(TxDocument& doc) {
+        std::unique_ptr<RootElement> root;
+        std::vector<TiXmlElement*> stack;
+
+        while (pos_ != end_) {
+            switch (static_cast<Tag>(*pos_++)) {
+                case Tag::Element: {
+                    TiXmlElement* element = nullptr;
+                    if (stack.empty()) {
+                        root = std::make_unique<RootElement>(readString());
+                        element = root->get();
+                    } else {
+                        element = new TiXmlElement(readString());
+                        stack.back()->LinkEndChild(element);
+                    }
+                    stack.push_back(element);
+
+                    const auto count = readSize();
+                    for (size_t i = 0; i < count; ++i) {
+                        const auto& name = readString();
+                        element->SetAttribute(name, readString());
+                    }
+                    break;
+                }
+                case Tag::End: {
+                    if (stack.empty()) invalid();
+                    stack.pop_back();
+                    if (stack.empty()) {
+                        doc.LinkEndChild(root.get());
+                        root.reset();
+                    }
+                    break;
+                }
+                case Tag::Text: {
+                    if (stack.empty()) invalid();
+                    stack.back()->LinkEndChild(new TiXmlText(readString()));
+                    break;
+                }
+                default:
+                    invalid();
+            }
+        }
+        if (!stack.empty()) truncated();
+    }
+
+private:
+    size_t readSize() {
+        size_t value = 0;
+        for (size_t shift = 0; shift < 8 * sizeof(size_t); shift += 7) {
+            if (pos_ == end_) truncated();
+            const auto byte = static_cast<std::uint8_t>(*pos_++);
+            value |= static_cast<size_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return value;
+        }
+        invalid();
+        return value;
+    }
+
+    const std::string& readString() {
+        const auto id = readSize();
+        if (id >= strings_.size()) invalid();
+        return strings_[id];
+    }
+
+    [[noreturn]] void truncated() const {
+        throw SerializationException("Binary serialization data is truncated",
+                                     IVW_CONTEXT_CUSTOM("BinaryReader"));
+    }
+    [[noreturn]] void invalid() const {
+        throw SerializationException("Invalid binary serialization data",
+                                     IVW_CONTEXT_CUSTOM("BinaryReader"));
+    }
+
+    const char* pos_;
+    const char* end_;
+    std::vector<std::string> strings_;
+};
+
+}  // namespace
+
+void util::writeBinaryDocument(const TxDocument& doc, std::ostream& stream) {
+    BinaryWriter writer;
+    doc.Accept(&writer);
+    writer.write(stream);
+}
+
+bool util::readBinaryDocument(std::istream& stream, TxDocument& doc) {
+    if (stream.peek() != std::char_traits<char>::to_int_type(magic[0])) return false;
+
+    const std::string data{std::istreambuf_iterator<char>(stream),
+                           std::istreambuf_iterator<char>()};
+    BinaryReader reader(data);
+    reader.read(doc);
+    return true;
+}
+
+}  // namespace inviwo
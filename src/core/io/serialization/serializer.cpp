@@ -29,6 +29,7 @@
 
 #include <inviwo/core/io/serialization/serializable.h>
 #include <inviwo/core/io/serialization/serializer.h>
+#include <inviwo/core/io/serialization/serializebinary.h>
 #include <inviwo/core/util/exception.h>
 
 namespace inviwo {
@@ -96,4 +97,18 @@ void Serializer::writeFile(std::ostream& stream, bool format) {
     }
 }
 
+void Serializer::writeFile(std::ostream& stream, SerializationFormat format) {
+    if (format == SerializationFormat::Xml) {
+        writeFile(stream, true);
+        return;
+    }
+
+    try {
+        refDataContainer_.setReferenceAttributes();
+        util::writeBinaryDocument(doc_, stream);
+    } catch (TxException& e) {
+        throw SerializationException(e.what(), IVW_CONTEXT);
+    }
+}
+
 }  // namespace inviwo
@@ -130,6 +130,8 @@ void ProcessorNetwork::removeAndDeleteProcessor(Processor* processor) {
 }
 
 Processor* ProcessorNetwork::getProcessorByIdentifier(std::string identifier) const {
+    // Stored identifiers are already stripped, only strip the query if there is no direct match
+    if (auto processor = util::map_find_or_null(processors_, identifier)) return processor;
     return util::map_find_or_null(processors_, util::stripIdentifier(identifier));
 }
 
@@ -35,6 +35,7 @@
 #include <inviwo/core/network/networkutils.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/util/clock.h>
+#include <inviwo/core/util/profiler.h>
 
 namespace inviwo {
 
@@ -100,6 +101,8 @@ void ProcessorNetworkEvaluator::evaluate() {
     notifyObserversProcessorNetworkEvaluationBegin();
 
     IVW_CPU_PROFILING_IF(500, "Evaluated Processor Network");
+    ProfilerScope networkScope(Profiler::Category::Network,
+                               []() { return std::string("Evaluate Processor Network"); });
 
     for (auto processor : processorsSorted_) {
         if (!processor->isValid()) {
@@ -107,6 +110,8 @@ void ProcessorNetworkEvaluator::evaluate() {
                 try {
                     // re-initialize resources (e.g., shaders) if necessary
                     if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
+                        ProfilerScope scope(Profiler::Category::InitializeResources,
+                                            [&]() { return processor->getIdentifier(); });
                         processor->initializeResources();
                     }
                     // call onChange for all invalid inports
@@ -123,6 +128,8 @@ void ProcessorNetworkEvaluator::evaluate() {
 
                 try {
                     IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+                    ProfilerScope scope(Profiler::Category::Process,
+                                        [&]() { return processor->getIdentifier(); });
                     // do the actual processing
                     processor->process();
                 } catch (...) {
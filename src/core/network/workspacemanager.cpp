@@ -132,7 +132,8 @@ WorkspaceManager::~WorkspaceManager() = default;
 void WorkspaceManager::clear() { clears_.invoke(); }
 
 void WorkspaceManager::save(std::ostream& stream, const std::string& refPath,
-                            const ExceptionHandler& exceptionHandler, WorkspaceSaveMode mode) {
+                            const ExceptionHandler& exceptionHandler, WorkspaceSaveMode mode,
+                            SerializationFormat format) {
     Serializer serializer(refPath);
 
     if (mode != WorkspaceSaveMode::Undo) {
@@ -141,7 +142,7 @@ void WorkspaceManager::save(std::ostream& stream, const std::string& refPath,
     }
 
     serializers_.invoke(serializer, exceptionHandler, mode);
-    serializer.writeFile(stream, true);
+    serializer.writeFile(stream, format);
 }
 
 void WorkspaceManager::load(std::istream& stream, const std::string& refPath,
@@ -158,17 +159,21 @@ void WorkspaceManager::load(std::istream& stream, const std::string& refPath,
 }
 
 void WorkspaceManager::save(const std::string& path, const ExceptionHandler& exceptionHandler,
-                            WorkspaceSaveMode mode) {
-    auto ostream = filesystem::ofstream(path);
+                            WorkspaceSaveMode mode, SerializationFormat format) {
+    auto ostream = filesystem::ofstream(
+        path, format == SerializationFormat::Binary ? std::ios::out | std::ios::binary
+                                                    : std::ios::out);
     if (ostream.is_open()) {
-        save(ostream, path, exceptionHandler, mode);
+        save(ostream, path, exceptionHandler, mode, format);
     } else {
         throw AbortException("Could not open workspace file: " + path, IVW_CONTEXT);
     }
 }
 
 void WorkspaceManager::load(const std::string& path, const ExceptionHandler& exceptionHandler) {
-    auto istream = filesystem::ifstream(path);
+    // Binary mode, the file might be a binary workspace. Line endings in xml are handled by the
+    // parser.
+    auto istream = filesystem::ifstream(path, std::ios::in | std::ios::binary);
     if (istream.is_open()) {
         load(istream, path, exceptionHandler);
     } else {
@@ -0,0 +1,143 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/processors/poolprocessor.h>
+#include <inviwo/core/network/evaluationerrorhandler.h>
+#include <inviwo/core/ports/outport.h>
+
+#include <atomic>
+
+namespace inviwo {
+
+namespace pool {
+
+namespace detail {
+
+struct State {
+    State(PoolProcessor* p, size_t count) : processor{p}, count{count} {}
+
+    // Set when the whole series is superseded
+    std::atomic<bool> stop{false};
+    // Index after the last job that delivered, all jobs before it are stopped
+    std::atomic<size_t> next{0};
+    // Only accessed from the main thread, reset when the series is superseded
+    PoolProcessor* processor;
+    const size_t count;
+};
+
+}  // namespace detail
+
+Stop::Stop(std::shared_ptr<const detail::State> state, size_t job)
+    : state_{std::move(state)}, job_{job} {}
+
+bool Stop::operator()() const noexcept { return state_ && (state_->stop || job_ < state_->next); }
+
+Progress::Progress(std::shared_ptr<detail::State> state) : state_{std::move(state)} {}
+
+void Progress::operator()(float progress) const {
+    if (!state_ || state_->stop) return;
+    dispatchFront([state = state_, progress]() {
+        if (state->processor) state->processor->updateProgress(progress);
+    });
+}
+
+void Progress::operator()(size_t i, size_t max) const {
+    (*this)(max == 0 ? 1.0f : static_cast<float>(i) / static_cast<float>(max));
+}
+
+}  // namespace pool
+
+PoolProcessor::PoolProcessor(const std::string& identifier, const std::string& displayName)
+    : Processor(identifier, displayName), ProgressBarOwner() {
+    progressBar_.hide();
+}
+
+PoolProcessor::~PoolProcessor() { stopJobs(); }
+
+void PoolProcessor::invalidate(InvalidationLevel invalidationLevel, Property* modifiedProperty) {
+    notifyObserversInvalidationBegin(this);
+    PropertyOwner::invalidate(invalidationLevel, modifiedProperty);
+    notifyObserversInvalidationEnd(this);
+}
+
+void PoolProcessor::stopJobs() {
+    if (!state_) return;
+    state_->stop = true;
+    state_->processor = nullptr;
+    state_.reset();
+    progressBar_.hide();
+}
+
+void PoolProcessor::newResults() {
+    // The processor itself stays valid, setting the outports valid again marks the connected
+    // inports as changed and lets the network evaluate the processors below.
+    notifyObserversInvalidationBegin(this);
+    for (auto outport : getOutports()) {
+        outport->invalidate(InvalidationLevel::InvalidOutput);
+        outport->setValid();
+    }
+    notifyObserversInvalidationEnd(this);
+}
+
+std::shared_ptr<pool::detail::State> PoolProcessor::startJobs(size_t count) {
+    stopJobs();
+    state_ = std::make_shared<pool::detail::State>(this, count);
+    progressBar_.resetProgress();
+    progressBar_.show();
+    return state_;
+}
+
+bool PoolProcessor::accept(const std::shared_ptr<pool::detail::State>& state, size_t job) {
+    if (!state->processor || job < state->next) return false;
+    state->next = job + 1;
+    return true;
+}
+
+void PoolProcessor::delivered(const std::shared_ptr<pool::detail::State>& state, size_t job) {
+    if (auto processor = state->processor) {
+        // The final result, the series is done
+        if (job + 1 == state->count) processor->stopJobs();
+        processor->newResults();
+    }
+}
+
+void PoolProcessor::failed(const std::shared_ptr<pool::detail::State>& state, size_t job,
+                           std::exception_ptr exception) {
+    auto processor = state->processor;
+    if (!processor || job < state->next) return;
+    processor->stopJobs();
+    try {
+        std::rethrow_exception(exception);
+    } catch (...) {
+        StandardEvaluationErrorHandler{}(processor, EvaluationType::Process,
+                                         IVW_CONTEXT_CUSTOM("PoolProcessor"));
+    }
+}
+
+}  // namespace inviwo
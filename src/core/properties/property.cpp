@@ -79,9 +79,15 @@ Property::~Property() {
 std::string Property::getIdentifier() const { return identifier_; }
 Property& Property::setIdentifier(const std::string& identifier) {
     if (identifier_ != identifier) {
-        identifier_ = identifier;
-
         util::validateIdentifier(identifier, "Property", IVW_CONTEXT);
+        if (owner_ && owner_->getPropertyByIdentifier(identifier) != nullptr) {
+            throw Exception("Property identifier \"" + identifier + "\" already in use.",
+                            IVW_CONTEXT);
+        }
+
+        auto old = identifier_;
+        identifier_ = identifier;
+        if (owner_) owner_->propertyIdentifierChanged(this, old);
 
         notifyObserversOnSetIdentifier(this, identifier_);
         notifyAboutChange();
@@ -220,6 +226,7 @@ void Property::deserialize(Deserializer& d) {
         auto old = identifier_;
         d.deserialize("identifier", identifier_, SerializationTarget::Attribute);
         if (old != identifier_) {
+            if (owner_) owner_->propertyIdentifierChanged(this, old);
             notifyObserversOnSetIdentifier(this, identifier_);
         }
     }
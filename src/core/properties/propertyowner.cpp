@@ -83,6 +83,7 @@ void PropertyOwner::insertProperty(size_t index, Property* property, bool owner)
 
     notifyObserversWillAddProperty(property, index);
     properties_.insert(properties_.begin() + index, property);
+    propertyIndex_[property->getIdentifier()] = property;
     property->setOwner(this);
 
     if (dynamic_cast<EventProperty*>(property)) {
@@ -103,9 +104,10 @@ void PropertyOwner::insertProperty(size_t index, Property& property) {
 }
 
 Property* PropertyOwner::removeProperty(const std::string& identifier) {
-    return removeProperty(
-        std::find_if(properties_.begin(), properties_.end(),
-                     [&identifier](Property* p) { return p->getIdentifier() == identifier; }));
+    if (auto property = getPropertyByIdentifier(identifier)) {
+        return removeProperty(property);
+    }
+    return nullptr;
 }
 
 Property* PropertyOwner::removeProperty(Property* property) {
@@ -135,6 +137,7 @@ Property* PropertyOwner::removeProperty(std::vector<Property*>::iterator it) {
 
         prop->setOwner(nullptr);
         properties_.erase(it);
+        propertyIndex_.erase(prop->getIdentifier());
         notifyObserversDidRemoveProperty(prop, index);
 
         // This will delete the property if owned; in that case set prop to nullptr.
@@ -150,6 +153,13 @@ Property* PropertyOwner::removeProperty(std::vector<Property*>::iterator it) {
     return prop;
 }
 
+void PropertyOwner::propertyIdentifierChanged(Property* property,
+                                              const std::string& oldIdentifier) {
+    auto it = propertyIndex_.find(oldIdentifier);
+    if (it != propertyIndex_.end() && it->second == property) propertyIndex_.erase(it);
+    propertyIndex_[property->getIdentifier()] = property;
+}
+
 const std::vector<Property*>& PropertyOwner::getProperties() const { return properties_; }
 
 const std::vector<CompositeProperty*>& PropertyOwner::getCompositeProperties() const {
@@ -170,9 +180,7 @@ std::vector<Property*> PropertyOwner::getPropertiesRecursive() const {
 
 Property* PropertyOwner::getPropertyByIdentifier(const std::string& identifier,
                                                  bool recursiveSearch) const {
-    for (Property* property : properties_) {
-        if (property->getIdentifier() == identifier) return property;
-    }
+    if (auto property = util::map_find_or_null(propertyIndex_, identifier)) return property;
     if (recursiveSearch) {
         for (CompositeProperty* compositeProperty : compositeProperties_) {
             Property* p = compositeProperty->getPropertyByIdentifier(identifier, true);
@@ -183,22 +191,15 @@ Property* PropertyOwner::getPropertyByIdentifier(const std::string& identifier,
 }
 
 Property* PropertyOwner::getPropertyByPath(const std::vector<std::string>& path) const {
-    Property* property = getPropertyByIdentifier(path[0]);
-    if (property) {
-        size_t i = 1;
-        while (path.size() > i) {
-            CompositeProperty* comp = dynamic_cast<CompositeProperty*>(property);
-            if (comp) {
-                property = comp->getPropertyByIdentifier(path[i]);
-                if (!property) return nullptr;
-            } else {
-                return nullptr;
-            }
-            ++i;
-        }
-        return property;
+    const PropertyOwner* owner = this;
+    Property* property = nullptr;
+    for (const auto& identifier : path) {
+        if (!owner) return nullptr;
+        property = owner->getPropertyByIdentifier(identifier);
+        if (!property) return nullptr;
+        owner = dynamic_cast<CompositeProperty*>(property);
     }
-    return nullptr;
+    return property;
 }
 
 size_t PropertyOwner::size() const { return properties_.size(); }
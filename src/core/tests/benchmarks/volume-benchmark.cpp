@@ -0,0 +1,187 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumeramhistogram.h>
+#include <inviwo/core/util/volumeramutils.h>
+#include <inviwo/core/util/volumeconversion.h>
+#include <inviwo/core/util/volumesampler.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <benchmark/benchmark.h>
+#include <warn/pop>
+
+#include <random>
+
+using namespace inviwo;
+
+namespace {
+
+template <typename T>
+std::shared_ptr<VolumeRAMPrecision<T>> makeNoiseVolumeRAM(size3_t dims) {
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(dims);
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    auto data = ram->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        data[i] = util::glm_convert_normalized<T>(dist(gen));
+    }
+    return ram;
+}
+
+size3_t cube(const benchmark::State& state) { return size3_t{static_cast<size_t>(state.range(0))}; }
+
+}  // namespace
+
+/**
+ * Conversion from uint16 to float through the virtual per voxel accessors, which is what the
+ * generic code paths use when the formats are not known at compile time.
+ */
+static void VolumeRAMConvertAccessors(benchmark::State& state) {
+    const auto dims = cube(state);
+    auto src = makeNoiseVolumeRAM<unsigned short>(dims);
+    const VolumeRAM* in = src.get();
+
+    for (auto _ : state) {
+        VolumeRAMPrecision<float> dst(dims);
+        VolumeRAM* out = &dst;
+        util::forEachVoxel(*in, [&](const size3_t& pos) {
+            out->setFromNormalizedDouble(pos, in->getAsNormalizedDouble(pos));
+        });
+        benchmark::DoNotOptimize(dst.getDataTyped());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * glm::compMul(dims) * sizeof(unsigned short)));
+    state.counters["Voxels"] = static_cast<double>(glm::compMul(dims));
+}
+
+/**
+ * Conversion from uint16 to float with the formats resolved once through the format dispatcher.
+ */
+static void VolumeRAMConvertDispatch(benchmark::State& state) {
+    const auto dims = cube(state);
+    auto src = makeNoiseVolumeRAM<unsigned short>(dims);
+    const VolumeRAM* in = src.get();
+
+    for (auto _ : state) {
+        VolumeRAMPrecision<float> dst(dims);
+        auto out = dst.getDataTyped();
+        in->dispatch<void, dispatching::filter::Scalars>([&](auto ram) {
+            using T = util::PrecisionValueType<decltype(ram)>;
+            const T* data = ram->getDataTyped();
+            std::transform(data, data + glm::compMul(dims), out, [](const T& v) {
+                return util::glm_convert_normalized<float>(v);
+            });
+        });
+        benchmark::DoNotOptimize(out);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * glm::compMul(dims) * sizeof(unsigned short)));
+    state.counters["Voxels"] = static_cast<double>(glm::compMul(dims));
+}
+
+/**
+ * Conversion from uint16 to float with the bulk kernels, split over the thread pool.
+ */
+static void VolumeRAMConvertBulk(benchmark::State& state) {
+    const auto dims = cube(state);
+    auto src = makeNoiseVolumeRAM<unsigned short>(dims);
+
+    for (auto _ : state) {
+        auto dst = util::convertVolumeRAMNormalized(*src, DataFormat<float>::get());
+        benchmark::DoNotOptimize(dst->getData());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * glm::compMul(dims) * sizeof(unsigned short)));
+    state.counters["Voxels"] = static_cast<double>(glm::compMul(dims));
+}
+
+static void VolumeHistogram(benchmark::State& state) {
+    const auto dims = cube(state);
+    auto src = makeNoiseVolumeRAM<float>(dims);
+
+    for (auto _ : state) {
+        auto hist = util::calculateVolumeHistogram(src->getDataTyped(), dims, dvec2{0.0, 1.0});
+        benchmark::DoNotOptimize(hist);
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * glm::compMul(dims) * sizeof(float)));
+    state.counters["Voxels"] = static_cast<double>(glm::compMul(dims));
+}
+
+static void ForEachVoxelParallel(benchmark::State& state) {
+    const auto dims = cube(state);
+    auto src = makeNoiseVolumeRAM<float>(dims);
+    VolumeRAMPrecision<float> dst(dims);
+    const util::IndexMapper3D im(dims);
+    const auto in = src->getDataTyped();
+    auto out = dst.getDataTyped();
+
+    for (auto _ : state) {
+        util::forEachVoxelParallel(
+            *src, [&](const size3_t& pos) { out[im(pos)] = 2.0f * in[im(pos)] + 1.0f; });
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * glm::compMul(dims) * sizeof(float)));
+    state.counters["Voxels"] = static_cast<double>(glm::compMul(dims));
+}
+
+static void VolumeDoubleSamplerSample(benchmark::State& state) {
+    const auto dims = cube(state);
+    auto volume = std::make_shared<Volume>(makeNoiseVolumeRAM<vec3>(dims));
+    VolumeDoubleSampler<3> sampler(volume);
+
+    constexpr size_t samples = 1 << 16;
+    std::mt19937 gen(2);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<dvec3> positions(samples);
+    for (auto& p : positions) p = dvec3{dist(gen), dist(gen), dist(gen)};
+
+    for (auto _ : state) {
+        dvec3 sum{0.0};
+        for (const auto& p : positions) sum += sampler.sample(p);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * samples));
+}
+
+BENCHMARK(VolumeRAMConvertAccessors)->RangeMultiplier(2)->Range(32, 256);
+BENCHMARK(VolumeRAMConvertDispatch)->RangeMultiplier(2)->Range(32, 256);
+BENCHMARK(VolumeRAMConvertBulk)->RangeMultiplier(2)->Range(32, 256)->UseRealTime();
+BENCHMARK(VolumeHistogram)->RangeMultiplier(2)->Range(32, 256);
+BENCHMARK(ForEachVoxelParallel)->RangeMultiplier(2)->Range(32, 256)->UseRealTime();
+BENCHMARK(VolumeDoubleSamplerSample)->Arg(64);
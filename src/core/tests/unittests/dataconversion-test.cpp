@@ -0,0 +1,112 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/dataconversion.h>
+#include <inviwo/core/util/glm.h>
+
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+TEST(DataConversion, RangeInt16ToUInt8) {
+    const std::vector<std::int16_t> src{-32768, -1, 0, 1, 32767};
+    std::vector<std::uint8_t> dst(src.size());
+    util::convertRange(src.data(), dst.data(), src.size(), dvec2{-32768.0, 32767.0},
+                       dvec2{0.0, 255.0});
+
+    const std::vector<std::uint8_t> expected{0, 127, 128, 128, 255};
+    EXPECT_EQ(expected, dst);
+}
+
+TEST(DataConversion, RangeClampAndRound) {
+    const std::vector<float> src{-1.0f, 0.0f, 0.5f, 0.499f, 2.0f, 1e10f,
+                                 std::numeric_limits<float>::quiet_NaN()};
+    std::vector<std::uint8_t> dst(src.size());
+    util::convertRange(src.data(), dst.data(), src.size(), dvec2{0.0, 1.0}, dvec2{0.0, 255.0});
+
+    const std::vector<std::uint8_t> expected{0, 0, 128, 127, 255, 255, 0};
+    EXPECT_EQ(expected, dst);
+}
+
+TEST(DataConversion, RangeToFloat) {
+    const std::vector<std::int16_t> src{-100, 0, 100};
+    std::vector<float> dst(src.size());
+    util::convertRange(src.data(), dst.data(), src.size(), dvec2{-100.0, 100.0},
+                       dvec2{0.0, 1.0});
+
+    EXPECT_NEAR(0.0f, dst[0], 1.0e-6f);
+    EXPECT_NEAR(0.5f, dst[1], 1.0e-6f);
+    EXPECT_NEAR(1.0f, dst[2], 1.0e-6f);
+}
+
+TEST(DataConversion, RangeIdentity) {
+    std::vector<std::int32_t> src(1 << 18);
+    std::iota(src.begin(), src.end(), -(1 << 17));
+    std::vector<std::int32_t> dst(src.size());
+    util::convertRange(src.data(), dst.data(), src.size(), dvec2{0.0, 1.0}, dvec2{0.0, 1.0});
+    EXPECT_EQ(src, dst);
+
+    std::vector<double> dstDouble(src.size());
+    util::convertRange(src.data(), dstDouble.data(), src.size(), dvec2{0.0, 1.0},
+                       dvec2{0.0, 1.0});
+    EXPECT_TRUE(std::equal(src.begin(), src.end(), dstDouble.begin(),
+                           [](std::int32_t a, double b) { return static_cast<double>(a) == b; }));
+}
+
+template <typename To, typename From>
+void testNormalized() {
+    std::vector<From> src(1 << 17);
+    for (size_t i = 0; i < src.size(); ++i) {
+        src[i] = static_cast<From>(std::numeric_limits<From>::lowest() + i);
+    }
+    std::vector<To> dst(src.size());
+    util::convertNormalized(src.data(), dst.data(), src.size());
+
+    for (size_t i = 0; i < src.size(); ++i) {
+        ASSERT_EQ(util::glm_convert_normalized<To>(src[i]), dst[i]);
+    }
+}
+
+TEST(DataConversion, Normalized) {
+    testNormalized<float, std::uint16_t>();
+    testNormalized<std::uint8_t, std::uint16_t>();
+    testNormalized<std::int32_t, std::int16_t>();
+    testNormalized<double, std::int8_t>();
+}
+
+}  // namespace inviwo
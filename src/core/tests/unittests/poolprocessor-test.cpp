@@ -0,0 +1,136 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/processors/poolprocessor.h>
+#include <inviwo/core/util/exception.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace {
+
+struct TestPoolProcessor : PoolProcessor {
+    TestPoolProcessor() : PoolProcessor("pool", "Pool") {}
+
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+
+    virtual void process() override {}
+
+    template <typename Job>
+    void dispatch(Job&& job) {
+        dispatchOne(std::forward<Job>(job), [this](int result) { results.push_back(result); });
+    }
+    template <typename Job>
+    void dispatchSeries(std::vector<Job> jobs) {
+        dispatchProgressive(std::move(jobs), [this](int result) { results.push_back(result); });
+    }
+    using PoolProcessor::stopJobs;
+
+    std::vector<int> results;
+};
+
+const ProcessorInfo TestPoolProcessor::processorInfo_{
+    "org.inviwo.TestPoolProcessor",  // Class identifier
+    "TestPoolProcessor",             // Display name
+    "Testing",                       // Category
+    CodeState::Stable,               // Code state
+    Tags::CPU,                       // Tags
+};
+
+void finishJobs() {
+    InviwoApplication::getPtr()->waitForPool();
+    InviwoApplication::getPtr()->processFront();
+}
+
+auto constant(int value) {
+    return [value](pool::Stop, pool::Progress) { return value; };
+}
+
+}  // namespace
+
+TEST(PoolProcessor, DeliversResult) {
+    TestPoolProcessor p;
+    p.dispatch(constant(1));
+    finishJobs();
+    EXPECT_EQ(std::vector<int>{1}, p.results);
+    EXPECT_FALSE(p.getProgressBar().isVisible());
+}
+
+TEST(PoolProcessor, SupersedesOutdatedJobs) {
+    TestPoolProcessor p;
+    auto token = std::make_shared<pool::Stop>();
+    p.dispatch([token](pool::Stop stop, pool::Progress) {
+        *token = stop;
+        return 1;
+    });
+    InviwoApplication::getPtr()->waitForPool();
+    EXPECT_FALSE((*token)());
+
+    p.dispatch(constant(2));
+    EXPECT_TRUE((*token)());
+    finishJobs();
+    EXPECT_EQ(std::vector<int>{2}, p.results);
+}
+
+TEST(PoolProcessor, StopDiscardsResults) {
+    TestPoolProcessor p;
+    p.dispatch(constant(1));
+    p.stopJobs();
+    finishJobs();
+    EXPECT_TRUE(p.results.empty());
+}
+
+TEST(PoolProcessor, ProgressiveResultsRefine) {
+    TestPoolProcessor p;
+    p.dispatchSeries(std::vector<decltype(constant(0))>{constant(1), constant(2), constant(3)});
+    finishJobs();
+    ASSERT_FALSE(p.results.empty());
+    EXPECT_EQ(3, p.results.back());
+    EXPECT_TRUE(std::is_sorted(p.results.begin(), p.results.end()));
+}
+
+TEST(PoolProcessor, FailedJobDeliversNothing) {
+    TestPoolProcessor p;
+    p.dispatch([](pool::Stop, pool::Progress) -> int {
+        throw Exception("Job failed", IVW_CONTEXT_CUSTOM("PoolProcessorTest"));
+    });
+    finishJobs();
+    EXPECT_TRUE(p.results.empty());
+    EXPECT_FALSE(p.getProgressBar().isVisible());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,126 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/profiler.h>
+
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+Profiler::Event makeEvent(const std::string& name, Profiler::time_point start, int startMs,
+                          int durationMs, size_t bytes = 0) {
+    return Profiler::Event{name,
+                           Profiler::Category::Custom,
+                           std::this_thread::get_id(),
+                           start + std::chrono::milliseconds(startMs),
+                           std::chrono::milliseconds(durationMs),
+                           bytes};
+}
+
+}  // namespace
+
+TEST(Profiler, DisabledDoesNotRecord) {
+    Profiler profiler;
+    EXPECT_FALSE(profiler.isEnabled());
+
+    bool called = false;
+    {
+        // The global profiler is disabled by default
+        ProfilerScope scope(Profiler::Category::Custom, [&]() {
+            called = true;
+            return std::string("scope");
+        });
+        EXPECT_FALSE(scope.isRecording());
+    }
+    EXPECT_FALSE(called);
+}
+
+TEST(Profiler, RingBufferKeepsLatestEvents) {
+    Profiler profiler(4);
+    const auto start = Profiler::clock::now();
+    for (int i = 0; i < 10; ++i) {
+        profiler.record(makeEvent(std::to_string(i), start, i, 1));
+    }
+    const auto events = profiler.getEvents();
+    ASSERT_EQ(4u, events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(std::to_string(6 + i), events[i].name);
+    }
+    profiler.clear();
+    EXPECT_TRUE(profiler.getEvents().empty());
+}
+
+TEST(Profiler, FlameGraph) {
+    Profiler profiler;
+    const auto start = Profiler::clock::now();
+    // Events are recorded when they end, i.e. children before their parent
+    profiler.record(makeEvent("a", start, 1, 2, 16));
+    profiler.record(makeEvent("b", start, 4, 3));
+    profiler.record(makeEvent("a", start, 5, 1, 16));
+    profiler.record(makeEvent("network", start, 0, 10));
+    profiler.record(makeEvent("network", start, 20, 5));
+
+    const auto root = profiler.getFlameGraph();
+    ASSERT_EQ(1u, root.children.size());
+    const auto& network = root.children[0];
+    EXPECT_EQ("network", network.name);
+    EXPECT_EQ(2u, network.count);
+    EXPECT_EQ(std::chrono::milliseconds(15), network.total);
+
+    ASSERT_EQ(2u, network.children.size());
+    EXPECT_EQ("a", network.children[0].name);
+    EXPECT_EQ(1u, network.children[0].count);
+    EXPECT_EQ(16u, network.children[0].bytes);
+    EXPECT_EQ("b", network.children[1].name);
+    ASSERT_EQ(1u, network.children[1].children.size());
+    EXPECT_EQ("a", network.children[1].children[0].name);
+}
+
+TEST(Profiler, ChromeTrace) {
+    Profiler profiler;
+    const auto start = Profiler::clock::now();
+    profiler.record(makeEvent("a \"quoted\" name", start, 1, 2, 64));
+
+    std::stringstream ss;
+    profiler.exportChromeTrace(ss);
+    const auto json = ss.str();
+    EXPECT_NE(std::string::npos, json.find("\"traceEvents\""));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"a \\\"quoted\\\" name\""));
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, json.find("\"args\":{\"bytes\":64}"));
+}
+
+}  // namespace inviwo
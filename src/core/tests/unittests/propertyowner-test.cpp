@@ -0,0 +1,97 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/util/exception.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+namespace inviwo {
+
+TEST(PropertyOwner, LookupByIdentifier) {
+    CompositeProperty owner("owner", "Owner");
+    FloatProperty a("a", "A");
+    FloatProperty b("b", "B");
+    owner.addProperties(a, b);
+
+    EXPECT_EQ(&a, owner.getPropertyByIdentifier("a"));
+    EXPECT_EQ(&b, owner.getPropertyByIdentifier("b"));
+    EXPECT_EQ(nullptr, owner.getPropertyByIdentifier("c"));
+
+    owner.removeProperty(a);
+    EXPECT_EQ(nullptr, owner.getPropertyByIdentifier("a"));
+    EXPECT_EQ(&b, owner.removeProperty("b"));
+    EXPECT_EQ(nullptr, owner.getPropertyByIdentifier("b"));
+}
+
+TEST(PropertyOwner, LookupAfterRename) {
+    CompositeProperty owner("owner", "Owner");
+    FloatProperty a("a", "A");
+    FloatProperty b("b", "B");
+    owner.addProperties(a, b);
+
+    a.setIdentifier("c");
+    EXPECT_EQ(nullptr, owner.getPropertyByIdentifier("a"));
+    EXPECT_EQ(&a, owner.getPropertyByIdentifier("c"));
+
+    EXPECT_THROW(a.setIdentifier("b"), Exception);
+    EXPECT_EQ("c", a.getIdentifier());
+    EXPECT_EQ(&b, owner.getPropertyByIdentifier("b"));
+
+    owner.removeProperty(a);
+    a.setIdentifier("b");
+    EXPECT_EQ(&b, owner.getPropertyByIdentifier("b"));
+}
+
+TEST(PropertyOwner, LookupByPath) {
+    CompositeProperty owner("owner", "Owner");
+    CompositeProperty outer("outer", "Outer");
+    CompositeProperty inner("inner", "Inner");
+    FloatProperty value("value", "Value");
+    inner.addProperty(value);
+    outer.addProperty(inner);
+    owner.addProperty(outer);
+
+    EXPECT_EQ(&value, owner.getPropertyByPath({"outer", "inner", "value"}));
+    EXPECT_EQ(&inner, owner.getPropertyByPath({"outer", "inner"}));
+    EXPECT_EQ(nullptr, owner.getPropertyByPath({"outer", "value"}));
+    EXPECT_EQ(nullptr, owner.getPropertyByPath({"outer", "inner", "value", "more"}));
+    EXPECT_EQ(nullptr, owner.getPropertyByPath({}));
+    EXPECT_EQ(&value, owner.getPropertyByIdentifier("value", true));
+
+    inner.setIdentifier("renamed");
+    EXPECT_EQ(nullptr, owner.getPropertyByPath({"outer", "inner", "value"}));
+    EXPECT_EQ(&value, owner.getPropertyByPath({"outer", "renamed", "value"}));
+}
+
+}  // namespace inviwo
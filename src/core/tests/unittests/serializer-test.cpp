@@ -383,4 +383,34 @@ TEST(SerializationTest, mat4Tests) {
     for (int i = 0; i < s; i++)
         for (int j = 0; j < s; j++) EXPECT_EQ(inMat[i][j], outMat[i][j]);
 }
-}  // namespace inviwo
\ No newline at end of file
+
+TEST(SerializationTest, binaryFormatTest) {
+    std::vector<MinimumSerilizableClass> inVector{{0.1f}, {0.2f}, {0.3f}}, outVector;
+    std::map<std::string, std::string> inMap{{"a", "<&\"'>"}, {"b", "line\nbreak"}}, outMap;
+    std::string refpath = filesystem::findBasePath();
+    std::stringstream ss;
+    Serializer serializer(refpath);
+    serializer.serialize("serializedVector", inVector, "value");
+    serializer.serialize("serializedMap", inMap, "value");
+    serializer.writeFile(ss, SerializationFormat::Binary);
+
+    Deserializer deserializer(ss, refpath);
+    deserializer.deserialize("serializedVector", outVector, "value");
+    deserializer.deserialize("serializedMap", outMap, "value");
+    EXPECT_EQ(inVector, outVector);
+    EXPECT_EQ(inMap, outMap);
+}
+
+TEST(SerializationTest, binaryFormatTruncatedTest) {
+    std::string refpath = filesystem::findBasePath();
+    std::stringstream ss;
+    Serializer serializer(refpath);
+    serializer.serialize("serializedValue", MinimumSerilizableClass(1.0f));
+    serializer.writeFile(ss, SerializationFormat::Binary);
+    const auto data = ss.str();
+
+    std::stringstream truncated(data.substr(0, data.size() - 1));
+    EXPECT_THROW(Deserializer d(truncated, refpath), SerializationException);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,66 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/sharedlibrary.h>
+
+namespace inviwo {
+
+using Paths = std::vector<std::string>;
+
+TEST(SharedLibrary, RemoveNestedPaths) {
+    EXPECT_EQ((Paths{"/usr/lib", "/opt/inviwo"}),
+              util::removeNestedPaths({"/usr/lib", "/opt/inviwo", "/usr/lib/inviwo"}, true));
+    // Nested paths listed before the enclosing one are removed as well
+    EXPECT_EQ((Paths{"/opt/inviwo", "/usr/lib"}),
+              util::removeNestedPaths({"/usr/lib/inviwo", "/opt/inviwo", "/usr/lib"}, true));
+    // Only whole directory names are matched
+    EXPECT_EQ((Paths{"/usr/lib", "/usr/lib64"}),
+              util::removeNestedPaths({"/usr/lib", "/usr/lib64"}, true));
+}
+
+TEST(SharedLibrary, RemoveNestedPathsTrailingSlash) {
+    EXPECT_EQ((Paths{"C:/lib/"}), util::removeNestedPaths({"C:/lib/", "C:/lib/sub"}, true));
+    EXPECT_EQ((Paths{"C:/lib"}), util::removeNestedPaths({"C:/lib", "C:/lib/sub/"}, true));
+    EXPECT_EQ((Paths{"C:/lib/"}), util::removeNestedPaths({"C:/lib/", "C:/lib"}, true));
+    EXPECT_EQ((Paths{"/"}), util::removeNestedPaths({"/", "/usr/lib"}, true));
+}
+
+TEST(SharedLibrary, RemoveNestedPathsCase) {
+    EXPECT_EQ((Paths{"C:/Lib", "c:/lib"}),
+              util::removeNestedPaths({"C:/Lib", "c:/lib/sub", "c:/lib"}, true));
+    EXPECT_EQ((Paths{"C:/Lib"}),
+              util::removeNestedPaths({"C:/Lib", "c:/lib/sub", "c:/lib"}, false));
+}
+
+}  // namespace inviwo
@@ -82,4 +82,67 @@ TEST(TFSampling, linear) {
     EXPECT_EQ(color2, tf.sample(1.0));
 }
 
+TEST(TFSampling, batch) {
+    vec4 color1{0.0f, 1.0f, 0.0f, 0.5f};
+    vec4 color2{1.0f, 0.0f, 0.5f, 1.0f};
+    TransferFunction tf{{{0.0, color1}, {1.0, color2}}, 256};
+
+    std::vector<double> positions{-0.5, 0.0, 0.1, 0.25, 0.5, 0.77, 1.0, 1.5};
+    std::vector<vec4> result;
+    tf.sample(positions, result);
+    ASSERT_EQ(positions.size(), result.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const auto expected = tf.sample(positions[i]);
+        for (int c = 0; c < 4; ++c) {
+            EXPECT_NEAR(expected[c], result[i][c], 1e-5f) << "at " << positions[i];
+        }
+    }
+
+    // without the mask the alpha is kept
+    tf.setMaskMin(0.5);
+    std::vector<float> fpositions{0.25f, 0.75f};
+    std::vector<vec4> unmasked;
+    tf.sample(fpositions, unmasked);
+    EXPECT_EQ(tf.sample(0.25f), unmasked[0]);
+    EXPECT_EQ(tf.sample(0.75f), unmasked[1]);
+
+    // the masked version uses the lookup table, just like rendering
+    std::vector<vec4> masked;
+    tf.sample(fpositions, masked, true);
+    EXPECT_EQ(0.0f, masked[0].a);
+    EXPECT_NEAR(tf.sample(0.75f).a, masked[1].a, 1e-5f);
+}
+
+TEST(TFSampling, batchMasked) {
+    vec4 color1{0.0f, 1.0f, 0.0f, 0.5f};
+    vec4 color2{1.0f, 0.0f, 0.5f, 1.0f};
+    vec4 color3{0.2f, 0.4f, 1.0f, 0.0f};
+    // primitives on table entries, the table is then exact at the primitives
+    TransferFunction tf{{{0.0, color1}, {100.0 / 255.0, color2}, {1.0, color3}}, 256};
+    tf.setMaskMin(0.2);
+    tf.setMaskMax(0.8);
+
+    std::vector<double> positions;
+    for (int i = 0; i <= 100; ++i) positions.push_back(i / 100.0);
+
+    std::vector<vec4> unmasked;
+    tf.sample(positions, unmasked);
+    std::vector<vec4> masked;
+    tf.sample(positions, masked, true);
+    ASSERT_EQ(positions.size(), unmasked.size());
+    ASSERT_EQ(positions.size(), masked.size());
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const auto expected = tf.sample(positions[i]);
+        EXPECT_EQ(expected, unmasked[i]) << "at " << positions[i];
+        if (positions[i] < 0.21 || positions[i] > 0.79) continue;
+        for (int c = 0; c < 4; ++c) {
+            EXPECT_NEAR(expected[c], masked[i][c], 1e-5f) << "at " << positions[i];
+        }
+    }
+    EXPECT_EQ(0.0f, masked.front().a);
+    EXPECT_EQ(0.0f, masked[10].a);
+    EXPECT_EQ(0.0f, masked[90].a);
+}
+
 }  // namespace inviwo
@@ -0,0 +1,108 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/volumesequencesampler.h>
+#include <inviwo/core/util/volumesampler.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/metadata/metadata.h>
+
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<Volume> createVectorVolume(size3_t dims, unsigned int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    auto ram = std::make_shared<VolumeRAMPrecision<vec3>>(dims);
+    auto data = ram->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        data[i] = vec3(dist(gen), dist(gen), dist(gen));
+    }
+    return std::make_shared<Volume>(ram);
+}
+
+}  // namespace
+
+TEST(VolumeSequenceSampler, MatchesInterpolatedVolumeSamplers) {
+    auto sequence = std::make_shared<VolumeSequence>();
+    for (unsigned int i = 0; i < 4; ++i) {
+        auto volume = createVectorVolume(size3_t(6, 5, 4), i);
+        volume->setMetaData<DoubleMetaData, double>("timestamp", 0.5 * i);
+        sequence->push_back(volume);
+    }
+    VolumeSequenceSampler sampler(sequence, false);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> pos(0.0, 1.0);
+    std::uniform_real_distribution<double> time(0.0, 1.5);
+
+    std::vector<dvec4> positions;
+    for (int i = 0; i < 200; ++i) {
+        positions.emplace_back(pos(gen), pos(gen), pos(gen), time(gen));
+    }
+    std::vector<dvec3> batch;
+    sampler.sample(positions, batch);
+    ASSERT_EQ(positions.size(), batch.size());
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const auto& p = positions[i];
+        const size_t step = std::min<size_t>(static_cast<size_t>(p.w / 0.5), 2);
+        const double x = (p.w - 0.5 * step) / 0.5;
+        VolumeDoubleSampler<3> s0((*sequence)[step]);
+        VolumeDoubleSampler<3> s1((*sequence)[step + 1]);
+        const dvec3 expected = glm::mix(s0.sample(dvec3(p)), s1.sample(dvec3(p)), x);
+
+        const dvec3 single = sampler.sample(p);
+        for (int c = 0; c < 3; ++c) {
+            EXPECT_NEAR(expected[c], single[c], 1e-9);
+            EXPECT_NEAR(expected[c], batch[i][c], 1e-9);
+        }
+    }
+}
+
+TEST(VolumeSequenceSampler, OutsideTimeRange) {
+    auto sequence = std::make_shared<VolumeSequence>();
+    for (unsigned int i = 0; i < 3; ++i) {
+        auto volume = createVectorVolume(size3_t(4), i);
+        volume->setMetaData<DoubleMetaData, double>("timestamp", static_cast<double>(i));
+        sequence->push_back(volume);
+    }
+    VolumeSequenceSampler sampler(sequence, false);
+    EXPECT_EQ(dvec3(0), sampler.sample(dvec4(0.5, 0.5, 0.5, -1.0)));
+    EXPECT_EQ(dvec3(0), sampler.sample(dvec4(1.5, 0.5, 0.5, 0.5)));
+}
+
+}  // namespace inviwo
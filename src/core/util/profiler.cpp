@@ -0,0 +1,256 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/profiler.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <unordered_map>
+
+namespace inviwo {
+
+Profiler* Profiler::instance_ = nullptr;
+
+namespace {
+
+void writeJsonString(std::ostream& os, const std::string& str) {
+    os << '"';
+    for (auto c : str) {
+        switch (c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            case '\t':
+                os << "\\t";
+                break;
+            case '\r':
+                os << "\\r";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                       << static_cast<int>(c) << std::dec << std::setfill(' ');
+                } else {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
+double toMicroseconds(Profiler::duration d) {
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+}  // namespace
+
+Profiler::Profiler(size_t capacity)
+    : enabled_{false}, capacity_{std::max<size_t>(capacity, 1)}, epoch_{clock::now()} {}
+
+Profiler* Profiler::active() {
+    if (instance_ && instance_->enabled_.load(std::memory_order_relaxed)) return instance_;
+    return nullptr;
+}
+
+void Profiler::setEnabled(bool enabled) { enabled_ = enabled; }
+
+bool Profiler::isEnabled() const { return enabled_; }
+
+void Profiler::setCapacity(size_t capacity) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    capacity_ = std::max<size_t>(capacity, 1);
+    events_.clear();
+    events_.shrink_to_fit();
+    next_ = 0;
+}
+
+size_t Profiler::getCapacity() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+void Profiler::record(Event event) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (events_.size() < capacity_) {
+        events_.push_back(std::move(event));
+    } else {
+        events_[next_] = std::move(event);
+    }
+    next_ = (next_ + 1) % capacity_;
+}
+
+std::vector<Profiler::Event> Profiler::getEvents() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (events_.size() < capacity_) return events_;
+
+    // The buffer has wrapped, next_ points at the oldest event
+    std::vector<Event> res;
+    res.reserve(events_.size());
+    res.insert(res.end(), events_.begin() + next_, events_.end());
+    res.insert(res.end(), events_.begin(), events_.begin() + next_);
+    return res;
+}
+
+void Profiler::clear() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    events_.clear();
+    next_ = 0;
+    epoch_ = clock::now();
+}
+
+auto Profiler::getFlameGraph() const -> FlameNode {
+    auto events = getEvents();
+    // Group by thread, and within a thread let enclosing events come before the ones they contain
+    std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+        if (a.threadId != b.threadId) return a.threadId < b.threadId;
+        if (a.start != b.start) return a.start < b.start;
+        return a.duration > b.duration;
+    });
+
+    FlameNode root;
+    root.name = "root";
+
+    struct Open {
+        time_point end;
+        FlameNode* node;
+    };
+    std::vector<Open> stack;
+    std::thread::id thread;
+
+    for (const auto& event : events) {
+        const auto end = event.start + event.duration;
+        if (stack.empty() || event.threadId != thread) {
+            stack.clear();
+            thread = event.threadId;
+        }
+        while (!stack.empty() && end > stack.back().end) stack.pop_back();
+
+        auto& siblings = stack.empty() ? root.children : stack.back().node->children;
+        auto it = std::find_if(siblings.begin(), siblings.end(),
+                               [&](const FlameNode& n) { return n.name == event.name; });
+        if (it == siblings.end()) {
+            siblings.push_back(FlameNode{event.name, event.category, {}, 0, 0, {}});
+            it = siblings.end() - 1;
+        }
+        it->total += event.duration;
+        it->count += 1;
+        it->bytes += event.bytes;
+        if (stack.empty()) {
+            root.total += event.duration;
+            root.count += 1;
+            root.bytes += event.bytes;
+        }
+        // Pointers on the stack stay valid since we only ever append to the innermost node
+        stack.push_back(Open{end, &*it});
+    }
+    return root;
+}
+
+void Profiler::exportChromeTrace(std::ostream& os) const {
+    const auto events = getEvents();
+    time_point epoch;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        epoch = epoch_;
+    }
+
+    std::unordered_map<std::thread::id, size_t> threads;
+    auto tid = [&](std::thread::id id) {
+        return threads.emplace(id, threads.size() + 1).first->second;
+    };
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& event : events) {
+        if (!first) os << ",";
+        first = false;
+        os << "\n{\"name\":";
+        writeJsonString(os, event.name);
+        os << ",\"cat\":\"" << categoryName(event.category) << "\",\"ph\":\"X\""
+           << ",\"ts\":" << std::fixed << std::setprecision(3) << toMicroseconds(event.start - epoch)
+           << ",\"dur\":" << toMicroseconds(event.duration) << std::defaultfloat
+           << ",\"pid\":1,\"tid\":" << tid(event.threadId);
+        if (event.bytes > 0) os << ",\"args\":{\"bytes\":" << event.bytes << "}";
+        os << "}";
+    }
+    for (const auto& thread : threads) {
+        if (!first) os << ",";
+        first = false;
+        os << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.second
+           << ",\"args\":{\"name\":\"Thread " << thread.second << "\"}}";
+    }
+    os << "\n]}\n";
+}
+
+void Profiler::exportChromeTrace(const std::string& filename) const {
+    auto file = filesystem::ofstream(filename);
+    if (!file) {
+        throw FileException("Could not open file \"" + filename + "\" for writing", IVW_CONTEXT);
+    }
+    exportChromeTrace(file);
+}
+
+const char* Profiler::categoryName(Category category) {
+    switch (category) {
+        case Category::Network:
+            return "Network";
+        case Category::Process:
+            return "Process";
+        case Category::InitializeResources:
+            return "InitializeResources";
+        case Category::Conversion:
+            return "Conversion";
+        case Category::Custom:
+        default:
+            return "Custom";
+    }
+}
+
+ProfilerScope::~ProfilerScope() {
+    if (profiler_) {
+        event_.duration = Profiler::clock::now() - event_.start;
+        profiler_->record(std::move(event_));
+    }
+}
+
+void ProfilerScope::setBytes(size_t bytes) { event_.bytes = bytes; }
+
+bool ProfilerScope::isRecording() const { return profiler_ != nullptr; }
+
+}  // namespace inviwo
@@ -58,7 +58,9 @@ SystemSettings::SystemSettings(InviwoApplication* app)
                        MessageBreakLevel::Info},
                       0}
     , breakOnException_{"breakOnException", "Break on Exception", false}
-    , stackTraceInException_{"stackTraceInException", "Create Stack Trace for Exceptions", false} {
+    , stackTraceInException_{"stackTraceInException", "Create Stack Trace for Exceptions", false}
+    , enableProfiler_{"enableProfiler", "Enable Profiler", false}
+    , profilerCapacity_{"profilerCapacity", "Profiler Event Capacity", 65536, 1024, 1048576} {
 
     addProperty(workspaceAuthor_);
     addProperty(applicationUsageMode_);
@@ -74,6 +76,8 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     addProperty(breakOnMessage_);
     addProperty(breakOnException_);
     addProperty(stackTraceInException_);
+    addProperty(enableProfiler_);
+    addProperty(profilerCapacity_);
 
     logStackTraceProperty_.onChange(
         [this]() { LogCentral::getPtr()->setLogStacktrace(logStackTraceProperty_.get()); });
@@ -253,6 +253,27 @@ std::vector<std::string> getLibrarySearchPaths() {
     return paths;
 }
 
+std::vector<std::string> removeNestedPaths(std::vector<std::string> paths, bool caseSensitive) {
+    const auto normalized = util::transform(paths, [&](std::string path) {
+        while (!path.empty() && path.back() == '/') path.pop_back();
+        return caseSensitive ? path : toLower(path);
+    });
+    const auto isInside = [](const std::string& path, const std::string& other) {
+        return path.size() > other.size() && path.compare(0, other.size(), other) == 0 &&
+               path[other.size()] == '/';
+    };
+
+    std::vector<std::string> res;
+    std::set<std::string> unique;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        const auto& path = normalized[i];
+        const auto nested = util::contains_if(
+            normalized, [&](const std::string& other) { return isInside(path, other); });
+        if (!nested && unique.insert(path).second) res.push_back(std::move(paths[i]));
+    }
+    return res;
+}
+
 #if WIN32
 bool hasAddLibrarySearchDirsFunction() {
     // Get AddDllDirectory function.
@@ -0,0 +1,122 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2019 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/volumeconversion.h>
+#include <inviwo/core/util/dataconversion.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <type_traits>
+
+namespace inviwo {
+
+namespace {
+
+// Multi component formats are converted as flat arrays of their scalar type. That keeps the
+// number of instantiations of the kernels to the combinations of the scalar formats.
+const DataFormatBase* scalarFormat(const DataFormatBase* format) {
+    return DataFormatBase::get(format->getNumericType(), 1, format->getPrecision());
+}
+
+struct ConvertTo {
+    template <typename Result, typename Format, typename From, typename Kernel>
+    Result operator()(const From* src, void* dst, size_t count, Kernel kernel) {
+        kernel(src, static_cast<typename Format::type*>(dst), count);
+    }
+};
+
+struct ConvertFrom {
+    template <typename Result, typename Format, typename Kernel>
+    Result operator()(const void* src, DataFormatId dstId, void* dst, size_t count,
+                      Kernel kernel) {
+        dispatching::dispatch<void, dispatching::filter::Scalars>(
+            dstId, ConvertTo{}, static_cast<const typename Format::type*>(src), dst, count,
+            kernel);
+    }
+};
+
+template <typename Kernel>
+std::shared_ptr<VolumeRAM> convert(const VolumeRAM& volume, const DataFormatBase* format,
+                                   Kernel kernel) {
+    const auto srcFormat = volume.getDataFormat();
+    if (srcFormat->getComponents() != format->getComponents()) {
+        throw Exception("Can not convert volume from " + std::string(srcFormat->getString()) +
+                            " to " + std::string(format->getString()) +
+                            ", the number of components differ",
+                        IVW_CONTEXT_CUSTOM("util::convertVolume"));
+    }
+
+    const auto dims = volume.getDimensions();
+    auto res = createVolumeRAM(dims, format, nullptr, volume.getSwizzleMask());
+    const size_t count = dims.x * dims.y * dims.z * format->getComponents();
+
+    dispatching::dispatch<void, dispatching::filter::Scalars>(
+        scalarFormat(srcFormat)->getId(), ConvertFrom{}, volume.getData(),
+        scalarFormat(format)->getId(), res->getData(), count, kernel);
+    return res;
+}
+
+}  // namespace
+
+std::shared_ptr<VolumeRAM> util::convertVolumeRAMNormalized(const VolumeRAM& volume,
+                                                            const DataFormatBase* format) {
+    return convert(volume, format, [](auto src, auto dst, size_t count) {
+        using To = typename std::remove_pointer<decltype(dst)>::type;
+        util::convertNormalized<To>(src, dst, count);
+    });
+}
+
+std::shared_ptr<VolumeRAM> util::convertVolumeRAM(const VolumeRAM& volume,
+                                                  const DataFormatBase* format, dvec2 srcRange,
+                                                  dvec2 dstRange) {
+    return convert(volume, format, [srcRange, dstRange](auto src, auto dst, size_t count) {
+        util::convertRange(src, dst, count, srcRange, dstRange);
+    });
+}
+
+std::shared_ptr<Volume> util::convertVolume(const Volume& volume, const DataFormatBase* format) {
+    DataMapper dataMap{volume.dataMap_};
+    if (format->getNumericType() != NumericType::Float) {
+        dataMap.dataRange = DataMapper{format}.dataRange;
+    }
+
+    auto ram = util::convertVolumeRAM(*volume.getRepresentation<VolumeRAM>(), format,
+                                      volume.dataMap_.dataRange, dataMap.dataRange);
+    auto res = std::make_shared<Volume>(ram);
+    res->copyMetaDataFrom(volume);
+    res->dataMap_ = dataMap;
+    res->setModelMatrix(volume.getModelMatrix());
+    res->setWorldMatrix(volume.getWorldMatrix());
+    return res;
+}
+
+}  // namespace inviwo
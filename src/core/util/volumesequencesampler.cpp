@@ -29,46 +29,95 @@
 
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/util/volumesequencesampler.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/interpolation.h>
+
+#include <algorithm>
 
 namespace inviwo {
 
+namespace {
+
+template <typename T>
+void fetchCell(const void *data, const size3_t &dims, const size3_t &index, dvec3 *cell) {
+    const auto typed = static_cast<const T *>(data);
+    const size3_t last = dims - size3_t(1);
+    const size3_t i0 = glm::min(index, last);
+    const size3_t i1 = glm::min(index + size3_t(1), last);
+
+    const size_t x[2] = {i0.x, i1.x};
+    const size_t y[2] = {i0.y * dims.x, i1.y * dims.x};
+    const size_t z[2] = {i0.z * dims.x * dims.y, i1.z * dims.x * dims.y};
+
+    // Same order as VolumeDoubleSampler, x changing fastest
+    for (size_t i = 0; i < 8; ++i) {
+        cell[i] = util::glm_convert<dvec3>(typed[x[i & 1] + y[(i >> 1) & 1] + z[(i >> 2) & 1]]);
+    }
+}
+
+struct FetchCellDispatcher {
+    template <typename Result, typename Format>
+    Result operator()() {
+        return &fetchCell<typename Format::type>;
+    }
+};
+
+}  // namespace
+
 VolumeSequenceSampler::VolumeSequenceSampler(
     std::shared_ptr<const std::vector<std::shared_ptr<Volume>>> volumeSequence, bool allowLooping)
     : Spatial4DSampler<3, double>(volumeSequence->front())
-    , wrappers_()
+    , frames_()
     , allowLooping_(allowLooping)
     , timeRange_(0, 0)
-    , totDuration_(0) {
+    , totDuration_(0)
+    , lastFrame_(0) {
+
+    constexpr auto inf = std::numeric_limits<double>::infinity();
 
     for (const auto &vol : (*volumeSequence.get())) {
-        wrappers_.emplace_back(std::make_shared<Wrapper>(vol));
+        Frame frame;
+        frame.timestamp = inf;
+        frame.duration = inf;
+        if (vol->hasMetaData<DoubleMetaData>("timestamp")) {
+            frame.timestamp = vol->getMetaData<DoubleMetaData>("timestamp")->get();
+        }
+        if (vol->hasMetaData<DoubleMetaData>("duration")) {
+            frame.duration = vol->getMetaData<DoubleMetaData>("duration")->get();
+        }
+        frame.volume = vol;
+        const auto ram = vol->getRepresentation<VolumeRAM>();
+        frame.data = ram->getData();
+        frame.dims = ram->getDimensions();
+        frame.fetch = dispatching::dispatch<FetchCell, dispatching::filter::All>(
+            ram->getDataFormatId(), FetchCellDispatcher{});
+        frames_.push_back(std::move(frame));
     }
 
-    auto lastWrapper = wrappers_.back();
+    auto infsTime = std::count_if(frames_.begin(), frames_.end(),
+                                  [&](const Frame &f) -> bool { return f.timestamp == inf; });
 
-    auto infsTime = std::count_if(
-        wrappers_.begin(), wrappers_.end(), [&](const std::shared_ptr<Wrapper> &w) -> bool {
-            return w->timestamp_ == std::numeric_limits<double>::infinity();
-        });
-
-    auto infsDuration = std::count_if(
-        wrappers_.begin(), wrappers_.end(), [&](const std::shared_ptr<Wrapper> &w) -> bool {
-            return w->duration_ == std::numeric_limits<double>::infinity();
-        });
-    auto size = static_cast<decltype(infsTime)>(wrappers_.size());
+    auto infsDuration = std::count_if(frames_.begin(), frames_.end(),
+                                      [&](const Frame &f) -> bool { return f.duration == inf; });
+    auto size = static_cast<decltype(infsTime)>(frames_.size());
 
     if (infsTime == 0) {  // all volumes has timestamps, make sure the volumes are in sorted order,
-        std::sort(wrappers_.begin(), wrappers_.end(), [](auto a, auto b) { return *a < *b; });
+        std::stable_sort(frames_.begin(), frames_.end(), [](const Frame &a, const Frame &b) {
+            return a.timestamp < b.timestamp;
+        });
     }
 
     if (!(infsTime == 0 || infsTime == size)) {
         LogWarn("Failed to create VolumeSequenceSampler due to missing data");
         LogInfo(infsTime << " volumes of " << size << " is missing a timestamp");
+        frames_.clear();
         return;
     }
     if (!(infsDuration == 0 || infsDuration == size)) {
         LogWarn("Failed to create VolumeSequenceSampler due to missing data");
         LogInfo(infsDuration << " volumes of " << size << " has unknown duration ");
+        frames_.clear();
         return;
     }
 
@@ -87,53 +136,78 @@ VolumeSequenceSampler::VolumeSequenceSampler(
         }
     }
 
-    auto prev = wrappers_.begin();
-    for (auto it = prev + 1; it != wrappers_.end(); ++it) {
-        prev->get()->next_ = *it;
-        prev = it;
-    }
-
     if (infsTime == size && infsDuration == size) {
         double dur = 1.0 / (size - 1.0);
         double t = 0;
-        for (auto &w : wrappers_) {
-            w->duration_ = dur;
-            w->timestamp_ = t;
+        for (auto &f : frames_) {
+            f.duration = dur;
+            f.timestamp = t;
             t += dur;
         }
     } else if (infsTime == size && infsDuration == 0) {
         double t = 0;
-        for (auto &w : wrappers_) {
-            w->timestamp_ = t;
-            t += w->duration_;
+        for (auto &f : frames_) {
+            f.timestamp = t;
+            t += f.duration;
         }
     } else {  // timestamps are set
 
         if (infsDuration == size) {  // we do not have durations
-            for (auto &w : wrappers_) {
-                if (auto next = w->next_.lock()) {
-                    w->duration_ = next->timestamp_ - w->timestamp_;
-                }
+            for (size_t i = 0; i + 1 < frames_.size(); ++i) {
+                frames_[i].duration = frames_[i + 1].timestamp - frames_[i].timestamp;
             }
         }
     }
 
-    if (firstAndLastAreSame && wrappers_.size() > 1) {
-        wrappers_.pop_back();
+    if (firstAndLastAreSame && frames_.size() > 1) {
+        frames_.pop_back();
     }
 
     totDuration_ = 0;
-    for (auto &w : wrappers_) {
-        totDuration_ += w->duration_;
+    for (auto &f : frames_) {
+        totDuration_ += f.duration;
     }
 
-    timeRange_.x = wrappers_.front()->timestamp_;
-    timeRange_.y = wrappers_.back()->timestamp_ + wrappers_.back()->duration_;
+    timeRange_.x = frames_.front().timestamp;
+    timeRange_.y = frames_.back().timestamp + frames_.back().duration;
 }
 
 VolumeSequenceSampler::~VolumeSequenceSampler() {}
 
+size_t VolumeSequenceSampler::findFrame(double t) const {
+    const auto contains = [&](size_t i) {
+        return frames_[i].timestamp <= t &&
+               (i + 1 == frames_.size() || t < frames_[i + 1].timestamp);
+    };
+
+    // Consecutive queries are usually in the same or the following time step
+    const size_t hint = lastFrame_.load(std::memory_order_relaxed);
+    if (hint < frames_.size() && contains(hint)) return hint;
+    if (hint + 1 < frames_.size() && contains(hint + 1)) {
+        lastFrame_.store(hint + 1, std::memory_order_relaxed);
+        return hint + 1;
+    }
+
+    auto it = std::upper_bound(frames_.begin(), frames_.end(), t,
+                               [](double t2, const Frame &f) { return t2 < f.timestamp; });
+    const size_t frame = it == frames_.begin() ? 0 : std::distance(frames_.begin(), it) - 1;
+    lastFrame_.store(frame, std::memory_order_relaxed);
+    return frame;
+}
+
+dvec3 VolumeSequenceSampler::sampleFrame(const Frame &frame, const dvec3 &pos) {
+    const dvec3 samplePos = pos * dvec3(frame.dims - size3_t(1));
+    const size3_t indexPos = size3_t(samplePos);
+    const dvec3 interpolants = samplePos - dvec3(indexPos);
+
+    dvec3 cell[8];
+    frame.fetch(frame.data, frame.dims, indexPos, cell);
+    return Interpolation<dvec3>::trilinear(cell, interpolants);
+}
+
 dvec3 VolumeSequenceSampler::sampleDataSpace(const dvec4 &pos) const {
+    if (frames_.empty()) return dvec3(0);
+
     auto spatialPos = dvec3(pos);
     double t = pos.w;
 
@@ -149,22 +223,56 @@ dvec3 VolumeSequenceSampler::sampleDataSpace(const dvec4 &pos) const {
         }
     }
 
-    auto it = std::upper_bound(
-        wrappers_.begin(), wrappers_.end(), t,
-        [](double t2, const std::shared_ptr<Wrapper> a) { return t2 < a->timestamp_; });
-    --it;
-    auto wrapper = *it;
+    // Both time steps return zero outside of the volume
+    if (!withinBoundsDataSpace(dvec4(spatialPos, t))) {
+        return dvec3(0);
+    }
+
+    const size_t i = findFrame(t);
+    const auto &frame0 = frames_[i];
+    if (i + 1 == frames_.size()) {
+        return sampleFrame(frame0, spatialPos);
+    }
+    const auto &frame1 = frames_[i + 1];
+
+    dvec3 val0;
+    dvec3 val1;
+    if (frame0.dims == frame1.dims) {
+        // Same grid, only compute the cell position once
+        const dvec3 samplePos = spatialPos * dvec3(frame0.dims - size3_t(1));
+        const size3_t indexPos = size3_t(samplePos);
+        const dvec3 interpolants = samplePos - dvec3(indexPos);
 
-    auto val0 = dvec3(wrapper->sampler_.sample(spatialPos));
-    if (wrapper->next_.expired()) {
-        return val0;
+        dvec3 cell[8];
+        frame0.fetch(frame0.data, frame0.dims, indexPos, cell);
+        val0 = Interpolation<dvec3>::trilinear(cell, interpolants);
+        frame1.fetch(frame1.data, frame1.dims, indexPos, cell);
+        val1 = Interpolation<dvec3>::trilinear(cell, interpolants);
+    } else {
+        val0 = sampleFrame(frame0, spatialPos);
+        val1 = sampleFrame(frame1, spatialPos);
     }
-    auto val1 = dvec3(wrapper->next_.lock()->sampler_.sample(spatialPos));
 
-    double x = (t - wrapper->timestamp_) / wrapper->duration_;
+    double x = (t - frame0.timestamp) / frame0.duration;
     return Interpolation<dvec3>::linear(val0, val1, x);
 }
 
+void VolumeSequenceSampler::sample(const std::vector<dvec4> &positions,
+                                   std::vector<dvec3> &result, Space space) const {
+    result.resize(positions.size());
+    if (space == Space::Data) {
+        std::transform(positions.begin(), positions.end(), result.begin(),
+                       [this](const dvec4 &pos) { return sampleDataSpace(pos); });
+    } else {
+        const auto m = spatialEntity_->getCoordinateTransformer().getMatrix(space, Space::Data);
+        std::transform(positions.begin(), positions.end(), result.begin(),
+                       [this, &m](const dvec4 &pos) {
+                           auto p = m * vec4(static_cast<vec3>(pos), 1.0);
+                           return sampleDataSpace(dvec4(dvec3(vec3(p) / p.w), pos.w));
+                       });
+    }
+}
+
 bool VolumeSequenceSampler::withinBoundsDataSpace(const dvec4 &pos) const {
     // TODO check also time
     if (glm::any(glm::lessThan(dvec3(pos), dvec3(0.0)))) {